@@ -122,6 +122,9 @@ int main(int argc, char** argv)
     LvnGraphicsContext* graphicsctx;
     lvnCreateGraphicsContext(ctx, &graphicsctx, &graphicsCreateInfo);
 
+    // fails on the first run, the file is written on exit
+    lvnGraphicsContextLoadPipelineCache(graphicsctx, "sandbox_pipeline.cache");
+
     LvnSurfaceCreateInfo sci = {0};
     sci.nativeDisplayHandle = wldisplay;
     sci.nativeWindowHandle = wlsurface;
@@ -131,8 +134,8 @@ int main(int argc, char** argv)
     LvnSurface* surface;
     lvnCreateSurface(graphicsctx, &surface, &sci);
 
-    LvnFile vertfile = lvnLoadFileBin("res/shaders/vert.spv");
-    LvnFile fragfile = lvnLoadFileBin("res/shaders/frag.spv");
+    LvnFileView vertfile = lvnMapFile("res/shaders/vert.spv");
+    LvnFileView fragfile = lvnMapFile("res/shaders/frag.spv");
 
     LvnShaderCreateInfo vertShCreateInfo = {0};
     vertShCreateInfo.pCode = vertfile.data;
@@ -176,17 +179,44 @@ int main(int argc, char** argv)
     LvnPipeline* pipeline;
     lvnCreatePipeline(graphicsctx, &pipeline, &pipelineCreateInfo);
 
-    lvnDestroyShader(vertShader);
-    lvnDestroyShader(fragShader);
-    lvnUnloadFile(&vertfile);
-    lvnUnloadFile(&fragfile);
+    lvnUnmapFile(&vertfile);
+    lvnUnmapFile(&fragfile);
+
+    // shaders are kept alive so the pipeline can be rebuilt when the spir-v files are recompiled
+    LvnFileWatcher* watcher;
+    lvnCreateFileWatcher(ctx, &watcher);
+    lvnFileWatcherAddFile(watcher, "res/shaders/vert.spv", (uint64_t) (uintptr_t) vertShader);
+    lvnFileWatcherAddFile(watcher, "res/shaders/frag.spv", (uint64_t) (uintptr_t) fragShader);
 
     // while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
+
+        LvnFileWatchEvent events[2];
+        uint32_t eventCount = lvnFileWatcherPoll(watcher, events, LVN_ARRAY_LEN(events));
+        for (uint32_t i = 0; i < eventCount; i++)
+        {
+            LvnFile file = lvnLoadFileBin(events[i].filepath);
+            LvnShaderCreateInfo reloadCreateInfo = { .pCode = file.data, .codeSize = file.size };
+            lvnShaderQueueReload((LvnShader*) (uintptr_t) events[i].userData, &reloadCreateInfo);
+            lvnUnloadFile(&file);
+        }
+
+        // frame boundary, nothing is recorded past this point
+        lvnGraphicsContextApplyReloads(graphicsctx);
+        LVN_PROFILE_INSTANT("frame");
     }
 
+#ifdef LVN_ENABLE_PROFILER
+    lvnProfilerWriteTrace("sandbox_trace.json");
+#endif
+
+    lvnGraphicsContextSavePipelineCache(graphicsctx, "sandbox_pipeline.cache");
+
+    lvnDestroyFileWatcher(watcher);
     lvnDestroyPipeline(pipeline);
+    lvnDestroyShader(vertShader);
+    lvnDestroyShader(fragShader);
     lvnDestroySurface(surface);
     lvnDestroyGraphicsContext(graphicsctx);
 
@@ -22,6 +22,20 @@
     #define LVN_LOG_FATAL(logger, ...)
 #endif
 
+// profiler, scopes are recorded only when the library and the instrumented code are built with LVN_ENABLE_PROFILER
+// name must be a string literal or otherwise outlive the trace; every LVN_PROFILE_BEGIN needs a matching LVN_PROFILE_END on the same thread
+#ifdef LVN_ENABLE_PROFILER
+    #define LVN_PROFILE_BEGIN(name) lvnProfilerBegin(name)
+    #define LVN_PROFILE_END() lvnProfilerEnd()
+    #define LVN_PROFILE_INSTANT(name) lvnProfilerInstant(name)
+    #define LVN_PROFILE_THREAD_NAME(name) lvnProfilerSetThreadName(name)
+#else
+    #define LVN_PROFILE_BEGIN(name)
+    #define LVN_PROFILE_END()
+    #define LVN_PROFILE_INSTANT(name)
+    #define LVN_PROFILE_THREAD_NAME(name)
+#endif
+
 #define LVN_LOG_COLOR_TRACE                     "\x1b[0;37m"
 #define LVN_LOG_COLOR_DEBUG                     "\x1b[0;34m"
 #define LVN_LOG_COLOR_INFO                      "\x1b[0;32m"
@@ -37,6 +51,15 @@ typedef enum LvnFileType
     Lvn_FileType_Bin,
 } LvnFileType;
 
+typedef enum LvnHashImpl
+{
+    Lvn_HashImpl_Auto = 0,   // pick the fastest implementation supported by the cpu
+    Lvn_HashImpl_Scalar,
+    Lvn_HashImpl_Sse2,
+    Lvn_HashImpl_Avx2,
+    Lvn_HashImpl_Neon,
+} LvnHashImpl;
+
 typedef enum LvnLogLevel
 {
     Lvn_LogLevel_None = 0,
@@ -51,6 +74,9 @@ typedef enum LvnLogLevel
 
 typedef struct LvnContext LvnContext;
 typedef struct LvnLogger LvnLogger;
+typedef struct LvnFileLoader LvnFileLoader;
+typedef struct LvnPack LvnPack;
+typedef struct LvnFileWatcher LvnFileWatcher;
 
 
 typedef struct LvnFile
@@ -59,6 +85,105 @@ typedef struct LvnFile
     size_t size;
 } LvnFile;
 
+typedef struct LvnFileView
+{
+    const uint8_t* data;     // read-only pointer to the mapped file contents
+    size_t size;             // size of the mapped file in bytes
+} LvnFileView;
+
+typedef struct LvnHash128
+{
+    uint64_t low;
+    uint64_t high;
+} LvnHash128;
+
+// streaming hash state, the fields are private; the digest is identical to the one-shot lvnHash64/lvnHash128
+// of the concatenated input no matter how the input is split between updates
+typedef struct LvnHashState
+{
+    uint64_t acc[8];
+    uint64_t seed;
+    uint64_t totalSize;
+    uint64_t stripeCount;
+    uint32_t bufferSize;
+    uint8_t buffer[64];
+    uint8_t lastStripe[64];
+} LvnHashState;
+
+// calendar fields of the local time, all taken from the same conversion
+typedef struct LvnDate
+{
+    int year;                        // year number (eg. 2025)
+    int year02d;                     // last two digits of the year number (eg. 25)
+    int month;                       // month number (1...12)
+    int day;                         // date number (1...31)
+    int weekDay;                     // day of the week since sunday (0...6)
+    int hour;                        // hour in 24 hour format (0...23)
+    int hour12;                      // hour in 12 hour format (1...12)
+    int minute;                      // minute (0...59)
+    int second;                      // second (0...60)
+    size_t secondsSinceEpoch;        // seconds since 00:00:00 UTC 1 January 1970
+    const char* monthName;           // month name (eg. January, April)
+    const char* monthNameShort;      // shortened month name (eg. Jan, Apr)
+    const char* dayName;             // day name (eg. Monday, Friday)
+    const char* dayNameShort;        // shortened day name (eg. Mon, Fri)
+    const char* timeMeridiem;        // time meridiem (eg. AM, PM)
+    const char* timeMeridiemLower;   // time meridiem in lower case (eg. am, pm)
+} LvnDate;
+
+typedef void (*LvnJobFn)(void* userData);
+typedef void (*LvnJobRangeFn)(uint32_t begin, uint32_t end, void* userData);
+
+typedef struct LvnJobDesc
+{
+    LvnJobFn func;
+    void* userData;
+} LvnJobDesc;
+
+// counts unfinished jobs, zero initialize before use; the fields are private
+// a counter must stay alive until it reaches zero and any job submitted after it has been scheduled
+typedef struct LvnJobCounter
+{
+    uint32_t state;
+    void* pWaitingJobs;
+} LvnJobCounter;
+
+// stopwatch, zero initialize or call lvnTimerReset before use
+typedef struct LvnTimer
+{
+    uint64_t startNs;        // time of the last start while running
+    uint64_t elapsedNs;      // time accumulated before the last start
+    bool running;
+} LvnTimer;
+
+typedef struct LvnFileReadRequest
+{
+    const char* filepath;    // path of the file to read, the string only needs to stay valid during lvnFileLoaderSubmit
+    void* pDst;              // (optional) caller owned buffer to read into, the loader allocates a buffer if null
+    size_t dstSize;          // size of pDst in bytes, the read fails if the file does not fit
+    uint64_t userData;       // user value passed back with the completion
+} LvnFileReadRequest;
+
+typedef struct LvnFileReadCompletion
+{
+    LvnResult result;        // Lvn_Result_Success if the whole file was read
+    uint64_t userData;       // userData of the matching request
+    LvnFile file;            // data points to pDst or to a loader allocated buffer that must be freed with lvnUnloadFile, size is the number of bytes read
+} LvnFileReadCompletion;
+
+typedef struct LvnFileLoaderCreateInfo
+{
+    uint32_t queueDepth;     // max number of reads in flight at once, 0 uses the default (64)
+    uint32_t threadCount;    // number of worker threads used when io_uring is unavailable, 0 uses the default (2)
+    bool disableIoRing;      // always use the worker thread fallback even if io_uring is supported
+} LvnFileLoaderCreateInfo;
+
+typedef struct LvnFileWatchEvent
+{
+    const char* filepath;    // the path the file was registered with, valid until the file is removed from the watcher
+    uint64_t userData;       // userData the file was registered with
+} LvnFileWatchEvent;
+
 typedef struct LvnSink
 {
     void (*logFunc)(const char*);
@@ -99,6 +224,18 @@ typedef struct LvnContextCreateInfo
         const LvnSink* pCoreSinks;   // array of output sinks for the core logger
         uint32_t coreSinkCount;      // number of output sinks in pCoreSinks
     } logging;
+
+    struct
+    {
+        uint32_t workerThreadCount;  // number of job system worker threads, 0 uses one less than the cpu count (at least one)
+        const uint32_t* pWorkerCpus; // optional array of cpu indices, worker i is pinned to pWorkerCpus[i % workerCpuCount]; null leaves scheduling to the os
+        uint32_t workerCpuCount;     // number of cpu indices in pWorkerCpus
+    } jobs;
+
+    struct
+    {
+        bool enableTsc;              // read lvnTimeNowNs from the cpu time stamp counter when it is invariant, calibrated against the monotonic clock when the context is created
+    } time;
 } LvnContextCreateInfo;
 
 
@@ -115,12 +252,74 @@ extern "C" {
 LVN_API LvnResult               lvnCreateContext(LvnContext** ctx, const LvnContextCreateInfo* createInfo);                                         // create the core context
 LVN_API void                    lvnDestroyContext(LvnContext* ctx);                                                                                 // destroy the core context
 
-LVN_API LvnResult               lvnSetMemAllocCallbacks(LvnMemAllocFn allocFn, LvnMemFreeFn freeFn, LvnMemReallocFn reallocFn, void* userData);     // set memory allocation callback functions; all callback functions must be set, userData can be null
+LVN_API LvnResult               lvnSetMemAllocCallbacks(LvnMemAllocFn allocFn, LvnMemFreeFn freeFn, LvnMemReallocFn reallocFn, void* userData);     // set memory allocation callback functions; all callback functions must be set, userData can be null; call before any other thread uses the library, the callbacks must be thread safe
 LVN_API LvnFile                 lvnLoadFileSrc(const char* filepath);                      // load a source file from a file path
 LVN_API LvnFile                 lvnLoadFileBin(const char* filepath);                      // load a binary file from a file path
 LVN_API LvnFile                 lvnLoadFile(const char* filepath, LvnFileType type);       // load a file from a file path
 LVN_API void                    lvnUnloadFile(LvnFile* file);                              // unload a file from memory
-
+LVN_API LvnFileView             lvnMapFile(const char* filepath);                          // map a file into memory as a read-only view without copying, returns an empty view on failure
+LVN_API void                    lvnUnmapFile(LvnFileView* view);                           // unmap a file view created from lvnMapFile
+
+LVN_API LvnResult               lvnCreateFileLoader(const LvnContext* ctx, LvnFileLoader** loader, const LvnFileLoaderCreateInfo* createInfo); // create an asynchronous file loader, createInfo can be null to use the defaults; the loader must only be used by one thread at a time
+LVN_API void                    lvnDestroyFileLoader(LvnFileLoader* loader);                                   // destroy the file loader, blocks until reads in flight are finished; unpolled loader allocated buffers are freed
+LVN_API uint32_t                lvnFileLoaderSubmit(LvnFileLoader* loader, const LvnFileReadRequest* pRequests, uint32_t requestCount); // queue file reads without blocking on disk I/O, returns the number of requests queued
+LVN_API uint32_t                lvnFileLoaderPoll(LvnFileLoader* loader, LvnFileReadCompletion* pCompletions, uint32_t maxCompletions); // retrieve finished reads without blocking, returns the number of completions written
+LVN_API uint32_t                lvnFileLoaderWait(LvnFileLoader* loader, LvnFileReadCompletion* pCompletions, uint32_t maxCompletions); // same as poll but blocks until at least one read finishes, returns 0 only if no reads are pending
+LVN_API uint32_t                lvnFileLoaderGetPendingCount(const LvnFileLoader* loader);                     // get the number of submitted reads whose completions have not been retrieved yet
+LVN_API bool                    lvnFileLoaderUsesIoRing(const LvnFileLoader* loader);                          // returns true if the loader is backed by io_uring instead of worker threads
+
+LVN_API LvnResult               lvnCreateFileWatcher(const LvnContext* ctx, LvnFileWatcher** watcher);          // create a file watcher, uses inotify on linux and polls modification times on other platforms
+LVN_API void                    lvnDestroyFileWatcher(LvnFileWatcher* watcher);                                // destroy the file watcher
+LVN_API LvnResult               lvnFileWatcherAddFile(LvnFileWatcher* watcher, const char* filepath, uint64_t userData); // start watching a file for changes, the file does not need to exist yet
+LVN_API void                    lvnFileWatcherRemoveFile(LvnFileWatcher* watcher, const char* filepath);        // stop watching a file
+LVN_API uint32_t                lvnFileWatcherPoll(LvnFileWatcher* watcher, LvnFileWatchEvent* pEvents, uint32_t maxEvents); // get files that changed since the last poll without blocking, each file is reported at most once per poll
+
+LVN_API LvnResult               lvnCreatePack(const LvnContext* ctx, LvnPack** pack, const char* filepath);    // open a pack file built by the lvnpack tool, the whole pack is mapped into memory once
+LVN_API void                    lvnDestroyPack(LvnPack* pack);                                                 // unmap the pack, views returned from lvnPackGetView become invalid
+LVN_API uint64_t                lvnPackHashPath(const char* path);                                             // hash a path relative to the packed directory (eg. "shaders/vert.spv"), backslashes are treated as forward slashes
+LVN_API uint32_t                lvnPackGetEntryCount(const LvnPack* pack);                                     // get the number of files stored in the pack
+LVN_API bool                    lvnPackContains(const LvnPack* pack, uint64_t pathHash);                       // returns true if the pack has an entry for the path hash
+LVN_API LvnFileView             lvnPackGetView(const LvnPack* pack, uint64_t pathHash);                        // get a zero copy view of an entry, returns an empty view if the entry is missing or compressed
+LVN_API LvnFile                 lvnPackLoadFile(const LvnPack* pack, uint64_t pathHash);                       // copy or decompress an entry into a new buffer, free with lvnUnloadFile; returns an empty file on failure
+
+LVN_API LvnResult               lvnJobSubmit(LvnContext* ctx, const LvnJobDesc* pJobs, uint32_t jobCount, LvnJobCounter* counter); // schedule jobs on the context job system, counter is incremented by jobCount and decremented as each job finishes; counter can be null
+LVN_API LvnResult               lvnJobSubmitAfter(LvnContext* ctx, LvnJobCounter* dependency, const LvnJobDesc* pJobs, uint32_t jobCount, LvnJobCounter* counter); // same as lvnJobSubmit but the jobs only start once dependency reaches zero
+LVN_API void                    lvnJobWait(LvnContext* ctx, LvnJobCounter* counter);       // block until counter reaches zero, the calling thread runs other jobs while waiting
+LVN_API bool                    lvnJobCounterIsDone(const LvnJobCounter* counter);         // check if every job tracked by counter has finished
+LVN_API void                    lvnJobParallelFor(LvnContext* ctx, uint32_t count, uint32_t batchSize, LvnJobRangeFn func, void* userData); // call func over [0, count) split into batches across the workers and block until done, batchSize 0 picks one automatically
+LVN_API uint32_t                lvnJobGetWorkerCount(const LvnContext* ctx);               // get the number of job system worker threads
+LVN_API int32_t                 lvnJobGetWorkerIndex(const LvnContext* ctx);               // get the index of the calling worker thread (0...workerCount-1), or -1 if the calling thread is not a worker of ctx
+
+LVN_API uint64_t                lvnHash64(const void* data, size_t size, uint64_t seed);    // 64 bit non-cryptographic hash, the output is stable across platforms and implementations
+LVN_API LvnHash128              lvnHash128(const void* data, size_t size, uint64_t seed);  // 128 bit variant of lvnHash64, low is equal to lvnHash64 of the same input
+LVN_API void                    lvnHashStateInit(LvnHashState* state, uint64_t seed);      // reset a streaming hash state
+LVN_API void                    lvnHashStateUpdate(LvnHashState* state, const void* data, size_t size); // add data to a streaming hash
+LVN_API uint64_t                lvnHashStateDigest64(const LvnHashState* state);           // get the 64 bit hash of all data added so far, the state can keep being updated
+LVN_API LvnHash128              lvnHashStateDigest128(const LvnHashState* state);          // get the 128 bit hash of all data added so far
+LVN_API LvnResult               lvnHashSetImpl(LvnHashImpl impl);                          // force a specific simd implementation, fails if the cpu does not support it; not thread safe, meant for testing and benchmarks
+LVN_API LvnHashImpl             lvnHashGetImpl(void);                                      // get the implementation currently in use
+LVN_API const char*             lvnHashGetImplName(LvnHashImpl impl);                      // get the name of an implementation (eg. "avx2")
+
+LVN_API uint64_t                lvnTimeNowNs(void);                                        // get the monotonic time in nanoseconds from an unspecified starting point
+LVN_API uint64_t                lvnTimeNowTicks(void);                                     // get a raw timestamp from the cheapest source, convert differences between two timestamps with lvnTimeTicksToNs
+LVN_API uint64_t                lvnTimeTicksToNs(uint64_t ticks);                          // convert a number of ticks to nanoseconds
+LVN_API bool                    lvnTimeUsesTsc(void);                                      // check if timestamps are read from the calibrated cpu time stamp counter
+LVN_API void                    lvnTimerReset(LvnTimer* timer);                            // stop the timer and clear the elapsed time
+LVN_API void                    lvnTimerStart(LvnTimer* timer);                            // start or resume the timer
+LVN_API void                    lvnTimerStop(LvnTimer* timer);                             // pause the timer, the elapsed time is kept
+LVN_API uint64_t                lvnTimerLap(LvnTimer* timer);                              // get the elapsed time in nanoseconds and restart the timer from zero (eg. frame delta time)
+LVN_API uint64_t                lvnTimerElapsedNs(const LvnTimer* timer);                  // get the elapsed time in nanoseconds
+LVN_API double                  lvnTimerElapsedSec(const LvnTimer* timer);                 // get the elapsed time in seconds
+
+LVN_API void                    lvnProfilerBegin(const char* name);                        // begin a profiled scope on the calling thread, use LVN_PROFILE_BEGIN instead so it compiles out
+LVN_API void                    lvnProfilerEnd(void);                                      // end the last profiled scope on the calling thread
+LVN_API void                    lvnProfilerInstant(const char* name);                      // record a single point in time (eg. a frame boundary)
+LVN_API void                    lvnProfilerSetThreadName(const char* name);                // name the calling thread in the trace, the name is copied
+LVN_API void                    lvnProfilerEnable(bool enable);                            // pause or resume recording on all threads, enabled by default
+LVN_API void                    lvnProfilerClear(void);                                    // drop every event recorded so far on all threads, threads free their memory when they next record
+LVN_API LvnResult               lvnProfilerWriteTrace(const char* filepath);               // write every recorded event as chrome trace event json (loadable in perfetto or chrome://tracing), each thread keeps its latest 262144 events and marks where older ones were dropped
+
+LVN_API void                    lvnDateGetSnapshot(LvnDate* date);                         // get all calendar fields of the current local time at once, thread safe and cached per thread for the current second
 LVN_API int                     lvnDateGetYear(void);                                      // get the year number (eg. 2025)
 LVN_API int                     lvnDateGetYear02d(void);                                   // get the last two digits of the year number (eg. 25)
 LVN_API int                     lvnDateGetMonth(void);                                     // get the month number (1...12)
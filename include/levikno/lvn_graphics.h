@@ -3,6 +3,9 @@
 
 #include "lvn_config.h"
 
+#define LVN_MAX_FRAMES_IN_FLIGHT 3
+#define LVN_BINDLESS_INVALID_INDEX 0xffffffffu
+
 
 typedef enum LvnGraphicsApi
 {
@@ -18,6 +21,12 @@ typedef enum LvnPresentationModeFlagBits
 } LvnPresentationModeFlagBits;
 typedef LvnFlags LvnPresentationModeFlags;
 
+typedef enum LvnCommandBufferLevel
+{
+    Lvn_CommandBufferLevel_Primary = 0,
+    Lvn_CommandBufferLevel_Secondary,
+} LvnCommandBufferLevel;
+
 typedef enum LvnTopologyType
 {
     Lvn_TopologyType_Point,
@@ -166,6 +175,14 @@ typedef enum LvnShaderStage
     Lvn_ShaderStage_Fragment,
 } LvnShaderStage;
 
+typedef enum LvnShaderStageFlagBits
+{
+    Lvn_ShaderStageFlag_Vertex   = 0x00000001,
+    Lvn_ShaderStageFlag_Fragment = 0x00000002,
+    Lvn_ShaderStageFlag_All      = 0x00000003,
+} LvnShaderStageFlagBits;
+typedef LvnFlags LvnShaderStageFlags;
+
 typedef enum LvnColorImageFormat
 {
     Lvn_ColorImageFormat_None = 0,
@@ -190,13 +207,47 @@ typedef enum LvnDepthImageFormat
     Lvn_DepthImageFormat_Depth32Stencil8,
 } LvnDepthImageFormat;
 
+typedef enum LvnBufferUsageFlagBits
+{
+    Lvn_BufferUsageFlag_Vertex   = 0x00000001,
+    Lvn_BufferUsageFlag_Index    = 0x00000002,
+    Lvn_BufferUsageFlag_Uniform  = 0x00000004,
+    Lvn_BufferUsageFlag_Storage  = 0x00000008,
+    Lvn_BufferUsageFlag_Indirect = 0x00000010,
+} LvnBufferUsageFlagBits;
+typedef LvnFlags LvnBufferUsageFlags;
+
+typedef enum LvnMemoryAccess
+{
+    Lvn_MemoryAccess_GpuOnly = 0,     // device local, not visible to the cpu
+    Lvn_MemoryAccess_Upload,          // written by the cpu through the persistently mapped pointer and read by the gpu
+    Lvn_MemoryAccess_Readback,        // written by the gpu and read by the cpu through the persistently mapped pointer, cached where supported
+} LvnMemoryAccess;
+
+typedef enum LvnIndexType
+{
+    Lvn_IndexType_Uint16,
+    Lvn_IndexType_Uint32,
+} LvnIndexType;
+
+typedef enum LvnDescriptorType
+{
+    Lvn_DescriptorType_UniformBuffer,
+    Lvn_DescriptorType_StorageBuffer,
+    Lvn_DescriptorType_UniformBufferDynamic,           // offset is added to a dynamic offset given when the set is bound
+    Lvn_DescriptorType_StorageBufferDynamic,
+} LvnDescriptorType;
+
 
 typedef struct LvnGraphicsContext LvnGraphicsContext;
 typedef struct LvnRenderPass LvnRenderPass;
 typedef struct LvnSurface LvnSurface;
 typedef struct LvnDescriptorLayout LvnDescriptorLayout;
+typedef struct LvnDescriptorSet LvnDescriptorSet;
 typedef struct LvnShader LvnShader;
 typedef struct LvnPipeline LvnPipeline;
+typedef struct LvnCommandBuffer LvnCommandBuffer;
+typedef struct LvnBuffer LvnBuffer;
 
 struct LvnContext;
 
@@ -204,23 +255,40 @@ struct LvnContext;
 typedef struct LvnPlatformData
 {
     void* nativeDisplayHandle;
-    void* nativeWindowHandle;
+    void* nativeWindowHandle;                            // null with a null display handle uses a headless surface (vulkan: VK_EXT_headless_surface)
 } LvnPlatformData;
 
 typedef struct LvnSurfaceCreateInfo
 {
     void* nativeDisplayHandle;
-    void* nativeWindowHandle;
+    void* nativeWindowHandle;                            // null with a null display handle creates a headless surface that renders without a window
     uint32_t width;
     uint32_t height;
 } LvnSurfaceCreateInfo;
 
 typedef struct LvnShaderCreateInfo
 {
-    const uint8_t* pCode;
-    size_t codeSize;
+    const uint8_t* pCode;    // spir-v bytecode, can point directly into a mapped file view (lvnMapFile), the code is not copied
+    size_t codeSize;         // size of the code in bytes, must be a multiple of 4
 } LvnShaderCreateInfo;
 
+typedef struct LvnShaderDefine
+{
+    const char* name;
+    const char* value;       // can be null to define the name without a value
+} LvnShaderDefine;
+
+typedef struct LvnShaderSourceCreateInfo
+{
+    const char* pSource;                 // null terminated glsl source, #include is available without enabling GL_GOOGLE_include_directive
+    const char* sourcePath;              // optional path of the source file, "" includes are resolved from its directory first
+    LvnShaderStage stage;
+    const LvnShaderDefine* pDefines;     // macros defined before the source
+    uint32_t defineCount;
+    const char* const* pIncludeDirs;     // directories searched for includes after the source directory
+    uint32_t includeDirCount;
+} LvnShaderSourceCreateInfo;
+
 typedef struct LvnPipelineInputAssembly
 {
     LvnTopologyType topology;
@@ -334,6 +402,14 @@ typedef struct LvnPipelineShaderStageCreateInfo
     const char* entryPoint;
 } LvnPipelineShaderStageCreateInfo;
 
+// offsets and sizes are multiples of 4, every device has at least 128 bytes of push constants
+typedef struct LvnPushConstantRange
+{
+    LvnShaderStageFlags shaderStages;
+    uint32_t offset;
+    uint32_t size;
+} LvnPushConstantRange;
+
 typedef struct LvnPipelineCreateInfo
 {
     const LvnPipelineFixedFunctions* pipelineFixedFunctions;
@@ -343,17 +419,90 @@ typedef struct LvnPipelineCreateInfo
     uint32_t vertexAttributeCount;
     const LvnDescriptorLayout* const* pDescriptorLayouts;
     uint32_t descriptorLayoutCount;
+    const LvnPushConstantRange* pPushConstantRanges;     // pipelines with the same descriptor layouts and ranges share a layout, so bound sets stay valid when switching between them
+    uint32_t pushConstantRangeCount;
     const LvnPipelineShaderStageCreateInfo* pStages;
     uint32_t stageCount;
     const LvnRenderPass* renderPass;
 } LvnPipelineCreateInfo;
 
+typedef struct LvnDescriptorBinding
+{
+    uint32_t binding;
+    LvnDescriptorType descriptorType;
+    LvnShaderStageFlags shaderStages;
+    uint32_t descriptorCount;                            // array size of the binding, 0 is treated as 1
+} LvnDescriptorBinding;
+
+typedef struct LvnDescriptorLayoutCreateInfo
+{
+    const LvnDescriptorBinding* pDescriptorBindings;
+    uint32_t descriptorBindingCount;
+} LvnDescriptorLayoutCreateInfo;
+
+typedef struct LvnDescriptorBufferInfo
+{
+    const LvnBuffer* buffer;
+    uint64_t offset;
+    uint64_t range;                                      // bytes visible to the shader, 0 for the rest of the buffer, dynamic descriptors need the size of one element; must fit the device uniform or storage range limit
+} LvnDescriptorBufferInfo;
+
+typedef struct LvnPipelineCacheStats
+{
+    uint32_t hitCount;                                   // pipelines the driver found in the pipeline cache
+    uint32_t missCount;                                  // pipelines the driver had to compile
+    uint64_t creationTimeNs;                             // total time the driver reported for creating the pipelines above
+    bool feedbackSupported;                              // false if the driver cannot report cache hits, the counts then stay zero
+} LvnPipelineCacheStats;
+
+typedef struct LvnBufferCreateInfo
+{
+    LvnBufferUsageFlags usage;
+    LvnMemoryAccess memoryAccess;
+    uint64_t size;
+} LvnBufferCreateInfo;
+
+typedef struct LvnUniformAllocation
+{
+    LvnBuffer* buffer;                                   // per frame uniform buffer of the context, the same for every allocation
+    uint64_t offset;                                     // dynamic offset to bind the allocation with
+    void* pData;                                         // mapped memory to write the data to
+} LvnUniformAllocation;
+
+typedef struct LvnGraphicsMemoryStats
+{
+    uint32_t blockCount;                                 // large device memory blocks resources are sub-allocated from
+    uint32_t allocationCount;                            // resources placed in the blocks
+    uint32_t dedicatedAllocationCount;                   // resources too large for a block, each with its own device memory
+    uint32_t deviceMemoryCount;                          // device memory objects in use, blocks and dedicated allocations
+    uint32_t maxDeviceMemoryCount;                       // device limit for deviceMemoryCount
+    uint64_t blockBytes;
+    uint64_t allocationBytes;                            // bytes used by resources in the blocks, the rest of blockBytes is free or alignment padding
+    uint64_t dedicatedAllocationBytes;
+    uint64_t largestFreeRange;                           // largest free range in any block, a measure of fragmentation
+} LvnGraphicsMemoryStats;
+
+typedef struct LvnRenderPassBeginInfo
+{
+    LvnSurface* surface;                 // render to the surface image of the current frame
+    float clearColor[4];
+    bool secondaryCommandBuffers;        // the contents are recorded in secondary command buffers and run with lvnCmdExecuteCommands
+} LvnRenderPassBeginInfo;
+
 typedef struct LvnGraphicsContextCreateInfo
 {
     LvnGraphicsApi graphicsapi;                          // graphics api backend
     LvnPresentationModeFlags presentationModeFlags;      // type of output the graphics api will render to
     const LvnPlatformData* platformData;                 // native platform data for surface creation
     bool enableGraphicsApiDebugLogging;                  // enable logging for graphics api layer debug logs
+    bool enableParallelPipelineCreation;                 // let lvnCreatePipelines compile pipelines on the core context job system workers
+    bool enableInlineShaderCode;                         // skip shader module objects and hand spir-v to pipeline creation directly where supported (vulkan: VK_KHR_maintenance5)
+    const char* shaderCacheDirectory;                    // existing directory where spir-v compiled from glsl is cached by content, null disables the cache
+    uint32_t framesInFlight;                             // frames the cpu can record ahead of the gpu, 0 defaults to 2, at most LVN_MAX_FRAMES_IN_FLIGHT
+    uint64_t stagingBufferSize;                          // size of the upload staging ring in bytes, 0 defaults to 32 MiB
+    uint64_t uniformBufferSize;                          // bytes of per frame uniform data for each frame slot, 0 defaults to 4 MiB
+    bool enableBindless;                                 // put every storage buffer into one descriptor set indexed by shaders, see lvnGraphicsContextGetBindlessSet (vulkan: descriptor indexing, core in 1.2)
+    bool enableDynamicRendering;                         // render straight to image views without render pass and framebuffer objects, pipelines then only depend on attachment formats (vulkan: VK_KHR_dynamic_rendering)
 } LvnGraphicsContextCreateInfo;
 
 
@@ -361,17 +510,105 @@ typedef struct LvnGraphicsContextCreateInfo
 extern "C" {
 #endif
 
+// threading:
+// - lvnCreateGraphicsContext and lvnDestroyGraphicsContext must not overlap any other call on the context
+// - surfaces, shaders, pipelines, buffers and descriptor layouts are created and destroyed from any thread at the same time,
+//   identical shaders, pipelines and descriptor layouts are shared and reference counted
+// - an object must not be destroyed while another thread still uses it, this includes shaders and layouts passed to a pipeline being created
+// - pipelines keep their shaders and descriptor layouts alive, destroying either only drops the reference returned by its create call
+// - lvnBufferWrite, lvnAllocateUniformData, lvnShaderQueueReload and the stats getters are safe from any thread,
+//   writes, flushes and invalidates of overlapping buffer ranges must not race each other
+// - command buffers and descriptor sets come from pools of the calling thread, so allocating them never contends; a command buffer
+//   or descriptor set is recorded or updated by one thread at a time and may be handed to another thread for submission
+// - lvnSubmitCommandBuffers and lvnSurfaceEndFrame are safe from any thread, submissions and presents are serialized on the context queue
+// - lvnGraphicsContextBeginFrame and lvnSurfaceBeginFrame reset the pools and uniform data of the next frame slot, they must not overlap
+//   recording, allocation or submission on other threads; the calls of one surface are made by one thread at a time
+// - lvnGraphicsContextApplyReloads and the pipeline cache load and save wait for create and destroy calls in progress on other threads
+//   and block new ones until they return; called from a job run by lvnJobWait inside lvnCreatePipelines they fail instead of waiting
+//   for the call they are nested in, object calls from such a job are fine
+
 LVN_API LvnResult                   lvnCreateGraphicsContext(struct LvnContext* ctx, LvnGraphicsContext** graphicsctx, const LvnGraphicsContextCreateInfo* createInfo); // create the graphics context
 LVN_API void                        lvnDestroyGraphicsContext(LvnGraphicsContext* graphicsctx);                                                                         // destroy the graphics context
+LVN_API LvnResult                   lvnGraphicsContextLoadPipelineCache(const LvnGraphicsContext* graphicsctx, const char* filepath);                                   // merge a pipeline cache file into the context pipeline cache, files written by a different device or driver are rejected
+LVN_API LvnResult                   lvnGraphicsContextSavePipelineCache(const LvnGraphicsContext* graphicsctx, const char* filepath);                                   // atomically write the context pipeline cache to a file, entries of a valid file already at filepath are merged in first
+LVN_API LvnPipelineCacheStats       lvnGraphicsContextGetPipelineCacheStats(const LvnGraphicsContext* graphicsctx);                                                     // get the pipeline cache hits and misses of every pipeline created so far
+LVN_API LvnGraphicsMemoryStats      lvnGraphicsContextGetMemoryStats(const LvnGraphicsContext* graphicsctx);                                                            // get the device memory used by buffers and textures of the context
 
 LVN_API LvnResult                   lvnCreateSurface(const LvnGraphicsContext* graphicsctx, LvnSurface** surface, const LvnSurfaceCreateInfo* createInfo);
 LVN_API void                        lvnDestroySurface(LvnSurface* surface);
-LVN_API LvnResult                   lvnCreateShader(const LvnGraphicsContext* graphicsctx, LvnShader** shader, const LvnShaderCreateInfo* createInfo);
+LVN_API LvnResult                   lvnCreateShader(const LvnGraphicsContext* graphicsctx, LvnShader** shader, const LvnShaderCreateInfo* createInfo); // identical code returns the same reference counted shader, call lvnDestroyShader once per returned shader
+LVN_API LvnResult                   lvnCreateShaderFromSource(const LvnGraphicsContext* graphicsctx, LvnShader** shader, const LvnShaderSourceCreateInfo* createInfo); // compile glsl with glslang, or load the spir-v from the shader cache if the preprocessed source was compiled before
+LVN_API LvnResult                   lvnCreateShadersFromSource(const LvnGraphicsContext* graphicsctx, LvnShader** pShaders, const LvnShaderSourceCreateInfo* pCreateInfos, uint32_t count); // compile count shaders on the core context job system workers, either every shader is created or none are and pShaders is set to null
 LVN_API void                        lvnDestroyShader(LvnShader* shader);
-LVN_API LvnResult                   lvnCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo);
+LVN_API LvnResult                   lvnCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo); // identical create infos return the same reference counted pipeline, call lvnDestroyPipeline once per returned pipeline
+LVN_API LvnResult                   lvnCreatePipelines(const LvnGraphicsContext* graphicsctx, LvnPipeline** pPipelines, const LvnPipelineCreateInfo* pCreateInfos, uint32_t count); // create count pipelines in batched calls, either every pipeline is created or none are and pPipelines is set to null
 LVN_API void                        lvnDestroyPipeline(LvnPipeline* pipeline);
-
-LVN_API LvnRenderPass*              lvnSurfaceGetRenderPass(LvnSurface* surface);
+LVN_API LvnResult                   lvnCreateBuffer(const LvnGraphicsContext* graphicsctx, LvnBuffer** buffer, const LvnBufferCreateInfo* createInfo);
+LVN_API void                        lvnDestroyBuffer(LvnBuffer* buffer);                                               // the buffer must no longer be used by submitted command buffers
+LVN_API LvnResult                   lvnCreateDescriptorLayout(const LvnGraphicsContext* graphicsctx, LvnDescriptorLayout** descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo); // identical bindings return the same reference counted layout, call lvnDestroyDescriptorLayout once per returned layout
+LVN_API void                        lvnDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout);                 // pipelines keep the layouts they were created with alive until they are destroyed
+
+// upload and readback buffers stay mapped for their whole lifetime; writes through the pointer need lvnBufferFlush and
+// reads need lvnBufferInvalidate, both do nothing on host coherent memory; writes to gpu only buffers are copied on the gpu
+// before any command buffer submitted afterwards runs, the range written must not be in use by submitted command buffers
+LVN_API void*                       lvnBufferGetMappedData(const LvnBuffer* buffer);                                  // get the persistently mapped pointer, null for gpu only buffers
+LVN_API LvnResult                   lvnBufferWrite(LvnBuffer* buffer, const void* data, uint64_t size, uint64_t offset); // copy data into the mapped memory and flush the range, gpu only buffers are written through the context staging ring
+LVN_API LvnResult                   lvnBufferFlush(LvnBuffer* buffer, uint64_t offset, uint64_t size);                 // make cpu writes to the range visible to the gpu
+LVN_API LvnResult                   lvnBufferInvalidate(LvnBuffer* buffer, uint64_t offset, uint64_t size);            // make gpu writes to the range visible to the cpu, the gpu work must have finished
+
+LVN_API LvnResult                   lvnShaderQueueReload(LvnShader* shader, const LvnShaderCreateInfo* createInfo);   // queue new code for the shader, the code is copied and swapped in at the next lvnGraphicsContextApplyReloads; affects every holder of a shared shader
+LVN_API LvnResult                   lvnGraphicsContextApplyReloads(LvnGraphicsContext* graphicsctx);                   // call between frames; waits for the gpu to go idle, then recreates reloaded shaders and only the pipelines built from them, keeping the old objects if recreation fails
+
+LVN_API LvnResult                   lvnGraphicsContextBeginFrame(LvnGraphicsContext* graphicsctx);                     // move to the next frame slot, wait for the gpu to finish the submissions last made in it and reset its command pools in bulk
+LVN_API uint32_t                    lvnGraphicsContextGetFrameIndex(const LvnGraphicsContext* graphicsctx);            // get the current frame slot (0...framesInFlight-1)
+
+// per frame uniform data is carved linearly out of the frame slot's part of one persistently mapped buffer and freed in bulk
+// when the slot comes around again; every allocation lives in the same buffer, so one descriptor set with a dynamic uniform or
+// storage buffer binding serves every draw and only the dynamic offset changes; allocating is thread safe and the data must
+// be written before the command buffers using it are submitted
+LVN_API LvnResult                   lvnAllocateUniformData(const LvnGraphicsContext* graphicsctx, uint64_t size, LvnUniformAllocation* allocation); // allocate size bytes for the current frame slot, aligned for dynamic offsets
+LVN_API LvnBuffer*                  lvnGraphicsContextGetUniformBuffer(const LvnGraphicsContext* graphicsctx);         // get the buffer every uniform allocation comes from, null if the graphics api has none
+
+// bindless mode keeps one descriptor set of partially bound arrays that stays bound while it changes: binding 0 holds every
+// storage buffer, bindings 1 and 2 are reserved for sampled images and samplers. resources get a stable index into their array
+// when created, shaders index the arrays with values passed in push constants or uniform data. the layout and set are owned
+// by the context, include the layout in pipelines and bind the set once per command buffer
+LVN_API const LvnDescriptorLayout*  lvnGraphicsContextGetBindlessLayout(const LvnGraphicsContext* graphicsctx);        // null if bindless mode is disabled or not supported
+LVN_API LvnDescriptorSet*           lvnGraphicsContextGetBindlessSet(const LvnGraphicsContext* graphicsctx);           // null if bindless mode is disabled or not supported
+LVN_API uint32_t                    lvnBufferGetBindlessIndex(const LvnBuffer* buffer);                                // index of a storage buffer in binding 0 of the bindless set, LVN_BINDLESS_INVALID_INDEX if it has none
+
+// command buffers come from pools owned by the calling thread for the current frame slot and stay valid until lvnGraphicsContextBeginFrame
+// returns to that slot, so threads record in parallel without locking; they are never freed individually.
+// recording must not overlap lvnGraphicsContextBeginFrame or lvnGraphicsContextApplyReloads
+LVN_API LvnCommandBuffer*           lvnAllocateCommandBuffer(const LvnGraphicsContext* graphicsctx, LvnCommandBufferLevel level); // get a command buffer from the calling thread's pool, null on failure
+LVN_API LvnResult                   lvnBeginCommandBuffer(LvnCommandBuffer* commandBuffer, const LvnRenderPass* renderPass); // renderPass is required for secondary command buffers recorded inside a render pass, null otherwise
+LVN_API LvnResult                   lvnEndCommandBuffer(LvnCommandBuffer* commandBuffer);
+LVN_API LvnResult                   lvnSubmitCommandBuffers(const LvnGraphicsContext* graphicsctx, LvnCommandBuffer* const* pCommandBuffers, uint32_t count); // submit recorded primary command buffers, can be called from any thread
+
+// descriptor sets follow the same rules as command buffers: they come from the calling thread's pools for the current frame
+// slot, are valid until the slot comes around again and are never freed individually, so allocating one is a pool bump.
+// every set is written in full, one buffer info per descriptor of the layout in binding order, through an update template
+LVN_API LvnDescriptorSet*           lvnAllocateDescriptorSet(const LvnGraphicsContext* graphicsctx, const LvnDescriptorLayout* descriptorLayout); // get a descriptor set from the calling thread's pool, null on failure
+LVN_API LvnResult                   lvnUpdateDescriptorSet(LvnDescriptorSet* descriptorSet, const LvnDescriptorBufferInfo* pBufferInfos, uint32_t count); // count must equal the number of descriptors in the layout, the set must not be in use by submitted command buffers
+
+LVN_API void                        lvnCmdBeginRenderPass(LvnCommandBuffer* commandBuffer, const LvnRenderPassBeginInfo* beginInfo);
+LVN_API void                        lvnCmdEndRenderPass(LvnCommandBuffer* commandBuffer);
+LVN_API void                        lvnCmdBindPipeline(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline);
+LVN_API void                        lvnCmdSetViewport(LvnCommandBuffer* commandBuffer, const LvnPipelineViewport* viewport);
+LVN_API void                        lvnCmdSetScissor(LvnCommandBuffer* commandBuffer, const LvnPipelineScissor* scissor);
+LVN_API void                        lvnCmdBindVertexBuffers(LvnCommandBuffer* commandBuffer, uint32_t firstBinding, LvnBuffer* const* pBuffers, const uint64_t* pOffsets, uint32_t count); // pOffsets can be null to bind every buffer from its start
+LVN_API void                        lvnCmdBindDescriptorSets(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, uint32_t firstSet, LvnDescriptorSet* const* pDescriptorSets, uint32_t count, const uint32_t* pDynamicOffsets, uint32_t dynamicOffsetCount); // one dynamic offset per dynamic descriptor of the sets, in set and binding order
+LVN_API void                        lvnCmdPushConstants(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, LvnShaderStageFlags shaderStages, uint32_t offset, uint32_t size, const void* pValues); // update push constants of the ranges covering shaderStages, they stay set across compatible pipelines
+LVN_API void                        lvnCmdBindIndexBuffer(LvnCommandBuffer* commandBuffer, const LvnBuffer* buffer, uint64_t offset, LvnIndexType indexType);
+LVN_API void                        lvnCmdDraw(LvnCommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+LVN_API void                        lvnCmdDrawIndexed(LvnCommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+LVN_API void                        lvnCmdExecuteCommands(LvnCommandBuffer* commandBuffer, LvnCommandBuffer* const* pSecondaryCommandBuffers, uint32_t count); // run secondary command buffers recorded for the render pass begun on commandBuffer
+
+LVN_API LvnResult                   lvnSurfaceBeginFrame(LvnSurface* surface);                                       // begin the next frame slot (see lvnGraphicsContextBeginFrame) and acquire the surface image to render to, the swapchain is recreated if it is out of date
+LVN_API LvnResult                   lvnSurfaceEndFrame(LvnSurface* surface, LvnCommandBuffer* const* pCommandBuffers, uint32_t count); // submit the frame's primary command buffers once the image is available and present the image when they finish
+LVN_API LvnRenderPass*              lvnSurfaceGetRenderPass(LvnSurface* surface);                                    // attachments of the surface, with dynamic rendering only their formats so pipelines work with every surface of the same format
+LVN_API void                        lvnSurfaceResize(LvnSurface* surface, uint32_t width, uint32_t height);          // call when the window is resized, the swapchain is recreated at the next lvnSurfaceBeginFrame; a size reported by the window system takes precedence
+LVN_API void                        lvnSurfaceGetExtent(const LvnSurface* surface, uint32_t* width, uint32_t* height); // get the size of the current surface images
 LVN_API LvnPipelineFixedFunctions   lvnConfigPipelineFixedFunctions(void);
 
 #ifdef __cplusplus
@@ -16,6 +16,8 @@
     static const char* s_LvnVkLibName = "libvulkan.1.dylib";
 #endif
 
+#define LVN_VK_MAX_DEVICE_EXTENSIONS 10
+
 static const char* s_LvnVkValidationLayers[] =
 {
     "VK_LAYER_KHRONOS_validation",
@@ -25,8 +27,16 @@ static LvnResult                   lvn_createPlatformSurface(const LvnVulkanBack
 static LvnVkQueueFamilyIndices     lvn_findQueueFamilies(const LvnVulkanBackends* vkBackends, VkPhysicalDevice device, VkSurfaceKHR surface);
 static bool                        lvn_checkDeviceExtensionSupport(const LvnVulkanBackends* vkBackends, VkPhysicalDevice device, const char** requiredExtensions, uint32_t requiredExtensionCount);
 static VkPhysicalDevice            lvn_getBestPhysicalDevice(const LvnVulkanBackends* vkBackends, VkSurfaceKHR surface);
+static LvnResult                   lvn_createSurfaceRenderPass(const LvnVulkanBackends* vkBackends, VkFormat colorFormat, VkRenderPass* renderPass);
 static LvnResult                   lvn_createSwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData, const LvnVkSwapChainCreateInfo* createInfo);
+static void                        lvn_destroySwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData);
+static LvnResult                   lvn_createSwapChainSemaphores(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData);
+static LvnResult                   lvn_recreateSwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData);
+static LvnResult                   lvn_submitCommandBuffers(LvnVulkanBackends* vkBackends, LvnCommandBuffer* const* pCommandBuffers, uint32_t count, VkSemaphore waitSemaphore, VkSemaphore signalSemaphore);
+static VkBufferUsageFlags          lvn_getVkBufferUsageFlags(LvnBufferUsageFlags usage);
 static VkShaderStageFlagBits       lvn_getVkShaderStageEnum(LvnShaderStage stage);
+static VkShaderStageFlags          lvn_getVkShaderStageFlags(LvnShaderStageFlags stages);
+static VkDescriptorType            lvn_getVkDescriptorTypeEnum(LvnDescriptorType type);
 static VkFormat                    lvn_getVkVertexAttributeFormatEnum(LvnAttributeFormat format);
 static VkPrimitiveTopology         lvn_getVkTopologyTypeEnum(LvnTopologyType topologyType);
 static VkCullModeFlags             lvn_getVkCullModeFlagEnum(LvnCullFaceMode cullFaceMode);
@@ -39,6 +49,16 @@ static VkCompareOp                 lvn_getVkCompareOpEnum(LvnCompareOperation co
 static VkStencilOp                 lvn_getVkStencilOpEnum(LvnStencilOperation stencilOp);
 static VkFormat                    lvn_findSupportedFormat(const LvnVulkanBackends* vkBackends, VkPhysicalDevice physicalDevice, const VkFormat* candidates, uint32_t count, VkImageTiling tiling, VkFormatFeatureFlags features);
 static VkFormat                    lvn_findDepthFormat(const LvnVulkanBackends* vkBackends, VkPhysicalDevice physicalDevice);
+static LvnResult                   lvn_createPipelineBuildData(const LvnGraphicsContext* graphicsctx, LvnVkPipelineBuildData* build, VkGraphicsPipelineCreateInfo* pipelineInfo, const LvnPipelineCreateInfo* createInfo);
+static void                        lvn_buildPipelinesRange(uint32_t begin, uint32_t end, void* userData);
+static void                        lvn_compilePipelinesRange(uint32_t begin, uint32_t end, void* userData);
+static LvnVkThreadCommandPools*    lvn_getThreadCommandPools(const LvnVulkanBackends* vkBackends);
+static void                        lvn_destroyThreadCommandPools(const LvnVulkanBackends* vkBackends, LvnVkThreadCommandPools* threadPools);
+static VkDescriptorSet             lvn_allocateFrameDescriptorSet(const LvnVulkanBackends* vkBackends, LvnVkFrameDescriptorPools* descriptorPools, VkDescriptorSetLayout setLayout);
+static bool                        lvn_pipelineLayoutMatch(const void* value, const void* userData);
+static LvnVkPipelineLayoutEntry*   lvn_acquirePipelineLayout(const LvnVulkanBackends* vkBackends, const LvnVkPipelineLayoutSignature* signature);
+static void                        lvn_releasePipelineLayout(const LvnVulkanBackends* vkBackends, LvnVkPipelineLayoutEntry* entry);
+static bool                        lvn_validatePipelineCacheData(const LvnVulkanBackends* vkBackends, const uint8_t* data, size_t size);
 
 static VKAPI_ATTR VkBool32 VKAPI_CALL lvn_debugCallback(
     VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
@@ -81,7 +101,22 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL lvn_debugCallback(
 
 static LvnResult lvn_createPlatformSurface(const LvnVulkanBackends* vkBackends, VkSurfaceKHR* surface, const LvnPlatformData* platformData)
 {
-    VkResult result;
+    VkResult result = VK_ERROR_EXTENSION_NOT_PRESENT;
+
+    // no window, render offscreen through a headless surface; also used to run the frame loop on lavapipe in ci
+    if (!platformData->nativeDisplayHandle && !platformData->nativeWindowHandle)
+    {
+        if (!vkBackends->createHeadlessSurfaceEXT)
+        {
+            LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to create headless surface, VK_EXT_headless_surface is not supported");
+            return Lvn_Result_Failure;
+        }
+
+        VkHeadlessSurfaceCreateInfoEXT headlessCreateInfo = {0};
+        headlessCreateInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+        result = vkBackends->createHeadlessSurfaceEXT(vkBackends->instance, &headlessCreateInfo, NULL, surface);
+        return result == VK_SUCCESS ? Lvn_Result_Success : Lvn_Result_Failure;
+    }
 
 #if defined(LVN_INCLUDE_WAYLAND)
     VkWaylandSurfaceCreateInfoKHR surfaceCreateInfo = {0};
@@ -107,15 +142,20 @@ static LvnVkQueueFamilyIndices lvn_findQueueFamilies(const LvnVulkanBackends* vk
     queueFamilies = lvn_calloc(queueFamilyCount * sizeof(VkQueueFamilyProperties));
     vkBackends->getPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies);
 
+    // a transfer-only family is usually a dedicated dma engine, a family without graphics but with compute is the next best choice
+    uint32_t transferScore = 0;
+
     for (uint32_t i = 0; i < queueFamilyCount; i++)
     {
-        if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+        VkQueueFlags flags = queueFamilies[i].queueFlags;
+
+        if ((flags & VK_QUEUE_GRAPHICS_BIT) && !indices.hasGraphics)
         {
             indices.graphicsIndex = i;
             indices.hasGraphics = true;
         }
 
-        if (surface != NULL)
+        if (surface != NULL && !indices.hasPresent)
         {
             VkBool32 presentSupport = VK_FALSE;
             vkBackends->getPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
@@ -127,11 +167,22 @@ static LvnVkQueueFamilyIndices lvn_findQueueFamilies(const LvnVulkanBackends* vk
             }
         }
 
-        // return only graphics index if no surface is provided; present support discluded
-        if (indices.hasGraphics && (!surface || indices.hasPresent))
-            break;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT))
+        {
+            uint32_t score = (flags & VK_QUEUE_COMPUTE_BIT) ? 1 : 2;
+            if (score > transferScore)
+            {
+                indices.transferIndex = i;
+                indices.hasTransfer = true;
+                transferScore = score;
+            }
+        }
     }
 
+    // without a separate family, transfers go through the graphics queue
+    if (!indices.hasTransfer)
+        indices.transferIndex = indices.graphicsIndex;
+
     lvn_free(queueFamilies);
 
     return indices;
@@ -223,6 +274,10 @@ static VkPhysicalDevice lvn_getBestPhysicalDevice(const LvnVulkanBackends* vkBac
         VkPhysicalDeviceProperties deviceProperties;
         vkBackends->getPhysicalDeviceProperties(physicalDevice, &deviceProperties);
 
+        // descriptor update templates are core in 1.1
+        if (deviceProperties.apiVersion < VK_API_VERSION_1_1)
+            continue;
+
         size_t score = 0;
 
         if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
@@ -248,6 +303,67 @@ static VkPhysicalDevice lvn_getBestPhysicalDevice(const LvnVulkanBackends* vkBac
     return bestDevice;
 }
 
+static LvnResult lvn_createSurfaceRenderPass(const LvnVulkanBackends* vkBackends, VkFormat colorFormat, VkRenderPass* renderPass)
+{
+    // color attachment
+    VkAttachmentDescription colorAttachment = {0};
+    colorAttachment.format = colorFormat;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkAttachmentReference colorAttachmentRef = {0};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    // depth attachment
+    VkAttachmentDescription depthAttachment = {0};
+    depthAttachment.format = lvn_findDepthFormat(vkBackends, vkBackends->physicalDevice);
+    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference depthAttachmentRef = {0};
+    depthAttachmentRef.attachment = 1;
+    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass = {0};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+    // subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+    VkSubpassDependency dependency = {0};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcAccessMask = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    VkAttachmentDescription attachments[] = { colorAttachment, /* depthAttachment */ };
+    VkRenderPassCreateInfo renderPassInfo = {0};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = LVN_ARRAY_LEN(attachments);
+    renderPassInfo.pAttachments = attachments;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 1;
+    renderPassInfo.pDependencies = &dependency;
+
+    return vkBackends->createRenderPass(vkBackends->device, &renderPassInfo, NULL, renderPass) == VK_SUCCESS
+        ? Lvn_Result_Success
+        : Lvn_Result_Failure;
+}
+
 static LvnResult lvn_createSwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData, const LvnVkSwapChainCreateInfo* createInfo)
 {
     LVN_ASSERT(vkBackends && swapchainData && createInfo, "vkBackends, swapchain, and createInfo cannot be null");
@@ -389,17 +505,18 @@ static LvnResult lvn_createSwapChainData(const LvnVulkanBackends* vkBackends, Lv
         }
     }
 
-    // create swapchain framebuffers
-    swapchainFramebuffers = lvn_calloc(swapchainImageCount * sizeof(VkFramebuffer));
-    for (uint32_t i = 0; i < swapchainImageCount; i++)
+    // create swapchain framebuffers, dynamic rendering begins on the image views instead
+    if (createInfo->renderPass)
+        swapchainFramebuffers = lvn_calloc(swapchainImageCount * sizeof(VkFramebuffer));
+    for (uint32_t i = 0; swapchainFramebuffers && i < swapchainImageCount; i++)
     {
         VkFramebufferCreateInfo framebufferCreateInfo = {0};
         framebufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebufferCreateInfo.renderPass = createInfo->renderPass;
         framebufferCreateInfo.pAttachments = &swapchainImageViews[i];
         framebufferCreateInfo.attachmentCount = 1;
-        framebufferCreateInfo.width = createInfo->width;
-        framebufferCreateInfo.height = createInfo->height;
+        framebufferCreateInfo.width = extent.width;
+        framebufferCreateInfo.height = extent.height;
         framebufferCreateInfo.layers = 1;
 
         if (vkBackends->createFramebuffer(vkBackends->device, &framebufferCreateInfo, NULL, &swapchainFramebuffers[i]) != VK_SUCCESS)
@@ -416,12 +533,13 @@ static LvnResult lvn_createSwapChainData(const LvnVulkanBackends* vkBackends, Lv
     swapchainData->swapchainImageCount = swapchainImageCount;
     swapchainData->swapchainImageViews = swapchainImageViews;
     swapchainData->swapchainFramebuffers = swapchainFramebuffers;
+    swapchainData->imageIndex = 0;
 
     lvn_free(presentModes);
     return Lvn_Result_Success;
 
 fail_cleanup:
-    for (uint32_t i = 0; i < swapchainImageCount; i++)
+    for (uint32_t i = 0; swapchainFramebuffers && i < swapchainImageCount; i++)
         vkBackends->destroyFramebuffer(vkBackends->device, swapchainFramebuffers[i], NULL);
     lvn_free(swapchainFramebuffers);
     for (uint32_t i = 0; i < swapchainImageCount; i++)
@@ -433,6 +551,92 @@ fail_cleanup:
     return Lvn_Result_Failure;
 }
 
+static void lvn_destroySwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData)
+{
+    for (uint32_t i = 0; i < swapchainData->swapchainImageCount; i++)
+    {
+        if (swapchainData->swapchainFramebuffers)
+            vkBackends->destroyFramebuffer(vkBackends->device, swapchainData->swapchainFramebuffers[i], NULL);
+        vkBackends->destroyImageView(vkBackends->device, swapchainData->swapchainImageViews[i], NULL);
+        if (swapchainData->renderFinishedSemaphores)
+            vkBackends->destroySemaphore(vkBackends->device, swapchainData->renderFinishedSemaphores[i], NULL);
+    }
+
+    lvn_free(swapchainData->swapchainFramebuffers);
+    lvn_free(swapchainData->swapchainImageViews);
+    lvn_free(swapchainData->swapchainImages);
+    lvn_free(swapchainData->renderFinishedSemaphores);
+    vkBackends->destroySwapchainKHR(vkBackends->device, swapchainData->swapchain, NULL);
+
+    swapchainData->swapchainFramebuffers = NULL;
+    swapchainData->swapchainImageViews = NULL;
+    swapchainData->swapchainImages = NULL;
+    swapchainData->renderFinishedSemaphores = NULL;
+    swapchainData->swapchain = VK_NULL_HANDLE;
+    swapchainData->swapchainImageCount = 0;
+}
+
+static LvnResult lvn_createSwapChainSemaphores(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData)
+{
+    VkSemaphoreCreateInfo semaphoreInfo = {0};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    swapchainData->renderFinishedSemaphores = (VkSemaphore*) lvn_calloc(swapchainData->swapchainImageCount * sizeof(VkSemaphore));
+    if (!swapchainData->renderFinishedSemaphores)
+        return Lvn_Result_Failure;
+
+    uint32_t semaphoreCount = 0;
+    for (; semaphoreCount < swapchainData->swapchainImageCount; semaphoreCount++)
+    {
+        if (vkBackends->createSemaphore(vkBackends->device, &semaphoreInfo, NULL, &swapchainData->renderFinishedSemaphores[semaphoreCount]) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to create swapchain semaphores");
+            goto fail_cleanup;
+        }
+    }
+
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    for (uint32_t i = 0; i < semaphoreCount; i++)
+        vkBackends->destroySemaphore(vkBackends->device, swapchainData->renderFinishedSemaphores[i], NULL);
+    lvn_free(swapchainData->renderFinishedSemaphores);
+    swapchainData->renderFinishedSemaphores = NULL;
+    return Lvn_Result_Failure;
+}
+
+static LvnResult lvn_recreateSwapChainData(const LvnVulkanBackends* vkBackends, LvnVkSwapchainData* swapchainData)
+{
+    // the old images, views and semaphores may still be used by frames in flight
+    vkBackends->deviceWaitIdle(vkBackends->device);
+    lvn_destroySwapChainData(vkBackends, swapchainData);
+
+    swapchainData->createInfo.queueFamilyIndices = &swapchainData->queueFamilyIndices;
+    if (lvn_createSwapChainData(vkBackends, swapchainData, &swapchainData->createInfo) != Lvn_Result_Success ||
+        lvn_createSwapChainSemaphores(vkBackends, swapchainData) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to recreate swapchain");
+        return Lvn_Result_Failure;
+    }
+
+    swapchainData->outOfDate = false;
+    return Lvn_Result_Success;
+}
+
+static VkBufferUsageFlags lvn_getVkBufferUsageFlags(LvnBufferUsageFlags usage)
+{
+    // transfer usage is always set so any buffer can be filled or read back through a copy
+    VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    if (usage & Lvn_BufferUsageFlag_Vertex)   flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (usage & Lvn_BufferUsageFlag_Index)    flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (usage & Lvn_BufferUsageFlag_Uniform)  flags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (usage & Lvn_BufferUsageFlag_Storage)  flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (usage & Lvn_BufferUsageFlag_Indirect) flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    return flags;
+}
+
 static VkShaderStageFlagBits lvn_getVkShaderStageEnum(LvnShaderStage stage)
 {
     switch (stage)
@@ -445,6 +649,30 @@ static VkShaderStageFlagBits lvn_getVkShaderStageEnum(LvnShaderStage stage)
     return VK_SHADER_STAGE_VERTEX_BIT;
 }
 
+static VkShaderStageFlags lvn_getVkShaderStageFlags(LvnShaderStageFlags stages)
+{
+    VkShaderStageFlags flags = 0;
+
+    if (stages & Lvn_ShaderStageFlag_Vertex)   flags |= VK_SHADER_STAGE_VERTEX_BIT;
+    if (stages & Lvn_ShaderStageFlag_Fragment) flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    return flags;
+}
+
+static VkDescriptorType lvn_getVkDescriptorTypeEnum(LvnDescriptorType type)
+{
+    switch (type)
+    {
+        case Lvn_DescriptorType_UniformBuffer: { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; }
+        case Lvn_DescriptorType_StorageBuffer: { return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; }
+        case Lvn_DescriptorType_UniformBufferDynamic: { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; }
+        case Lvn_DescriptorType_StorageBufferDynamic: { return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC; }
+    }
+
+    LVN_ASSERT(false, "invalid descriptor type enum");
+    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+}
+
 static VkFormat lvn_getVkVertexAttributeFormatEnum(LvnAttributeFormat format)
 {
     switch (format)
@@ -674,8 +902,11 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
 {
     LVN_ASSERT(graphicsctx && createInfo, "graphicsctx and createInfo cannot be nullptr");
 
+    LVN_PROFILE_BEGIN("lvnImplVkInit");
+
     const char** extensionNames = NULL;
     VkExtensionProperties* extensionProps = NULL;
+    VkExtensionProperties* deviceExtensionProps = NULL;
     VkLayerProperties* availableLayers = NULL;
     VkSurfaceKHR surface = VK_NULL_HANDLE;
 
@@ -684,6 +915,7 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
 
     vkBackends->graphicsctx = graphicsctx;
     vkBackends->enableValidationLayers = createInfo->enableGraphicsApiDebugLogging;
+    vkBackends->enableParallelPipelineCreation = createInfo->enableParallelPipelineCreation;
 
     // load vulkan library
     vkBackends->handle = lvn_platformLoadModule(s_LvnVkLibName);
@@ -899,7 +1131,11 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         vkCreateInfo.pNext = NULL;
     }
 
-    if (vkBackends->createInstance(&vkCreateInfo, NULL, &vkBackends->instance) != VK_SUCCESS)
+    LVN_PROFILE_BEGIN("vkCreateInstance");
+    VkResult instanceResult = vkBackends->createInstance(&vkCreateInfo, NULL, &vkBackends->instance);
+    LVN_PROFILE_END();
+
+    if (instanceResult != VK_SUCCESS)
     {
         LVN_LOG_ERROR(graphicsctx->coreLogger,
                       "[vulkan] failed to create instance");
@@ -919,6 +1155,12 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetPhysicalDeviceProperties");
     vkBackends->getPhysicalDeviceFormatProperties = (PFN_vkGetPhysicalDeviceFormatProperties)
         vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetPhysicalDeviceFormatProperties");
+    vkBackends->getPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)
+        vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetPhysicalDeviceMemoryProperties");
+    vkBackends->getPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)
+        vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetPhysicalDeviceFeatures2"); // optional, only used to query extension features
+    vkBackends->getPhysicalDeviceProperties2 = (PFN_vkGetPhysicalDeviceProperties2)
+        vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetPhysicalDeviceProperties2"); // optional, only used to query extension limits
     vkBackends->getDeviceProcAddr = (PFN_vkGetDeviceProcAddr)
         vkBackends->getInstanceProcAddr(vkBackends->instance, "vkGetDeviceProcAddr");
     vkBackends->createDevice = (PFN_vkCreateDevice)
@@ -929,6 +1171,7 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         !vkBackends->getPhysicalDeviceQueueFamilyProperties ||
         !vkBackends->enumerateDeviceExtensionProperties ||
         !vkBackends->getPhysicalDeviceProperties ||
+        !vkBackends->getPhysicalDeviceMemoryProperties ||
         !vkBackends->getDeviceProcAddr ||
         !vkBackends->createDevice)
     {
@@ -955,13 +1198,18 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         vkBackends->createSurfaceProc = (PFN_vkVoidFunction)
             vkBackends->getInstanceProcAddr(vkBackends->instance, "vkCreateWaylandSurfaceKHR");
 #endif
+        if (vkBackends->ext.EXT_headless_surface)
+        {
+            vkBackends->createHeadlessSurfaceEXT = (PFN_vkCreateHeadlessSurfaceEXT)
+                vkBackends->getInstanceProcAddr(vkBackends->instance, "vkCreateHeadlessSurfaceEXT");
+        }
 
         if (!vkBackends->getPhysicalDeviceSurfaceSupportKHR ||
             !vkBackends->getPhysicalDeviceSurfaceCapabilitiesKHR ||
             !vkBackends->getPhysicalDeviceSurfaceFormatsKHR ||
             !vkBackends->getPhysicalDeviceSurfacePresentModesKHR ||
             !vkBackends->destroySurfaceKHR ||
-            !vkBackends->createSurfaceProc)
+            (!vkBackends->createSurfaceProc && !vkBackends->createHeadlessSurfaceEXT))
         {
             LVN_LOG_ERROR(graphicsctx->coreLogger,
                           "[vulkan] failed to load vulkan instance level surface function symbol");
@@ -1005,7 +1253,9 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
     }
 
     // get default physical device without surface support
+    LVN_PROFILE_BEGIN("lvn_getBestPhysicalDevice");
     vkBackends->physicalDevice = lvn_getBestPhysicalDevice(vkBackends, surface);
+    LVN_PROFILE_END();
 
     if (vkBackends->physicalDevice == VK_NULL_HANDLE)
     {
@@ -1022,20 +1272,49 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
                   deviceProperties.driverVersion,
                   deviceProperties.apiVersion);
 
+    vkBackends->maxPushConstantsSize = deviceProperties.limits.maxPushConstantsSize;
+    graphicsctx->uniformAlignment = deviceProperties.limits.minUniformBufferOffsetAlignment > deviceProperties.limits.minStorageBufferOffsetAlignment
+                                  ? deviceProperties.limits.minUniformBufferOffsetAlignment : deviceProperties.limits.minStorageBufferOffsetAlignment;
+    graphicsctx->maxUniformRange = deviceProperties.limits.maxUniformBufferRange;
+    graphicsctx->maxStorageRange = deviceProperties.limits.maxStorageBufferRange;
+
     // create logical device
     LvnVkQueueFamilyIndices indices = lvn_findQueueFamilies(vkBackends, vkBackends->physicalDevice, surface);
     float queuePriority = 1.0f;
 
-    VkDeviceQueueCreateInfo queueCreateInfo = {0};
-    queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueCreateInfo.queueFamilyIndex = indices.graphicsIndex;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    // one queue per distinct family of graphics, present and transfer
+    uint32_t queueFamilies[3] = { indices.graphicsIndex, indices.presentIndex, indices.transferIndex };
+    uint32_t queueFamilyCount = (graphicsctx->presentModeFlags & Lvn_PresentationModeFlag_Surface) ? 3 : 1;
+    VkDeviceQueueCreateInfo queueCreateInfos[3];
+    uint32_t queueCreateInfoCount = 0;
+
+    if (queueFamilyCount == 1 && indices.hasTransfer)
+    {
+        queueFamilies[1] = indices.transferIndex;
+        queueFamilyCount = 2;
+    }
+
+    for (uint32_t i = 0; i < queueFamilyCount; i++)
+    {
+        bool duplicate = false;
+        for (uint32_t j = 0; j < queueCreateInfoCount; j++)
+            duplicate |= queueCreateInfos[j].queueFamilyIndex == queueFamilies[i];
+
+        if (duplicate)
+            continue;
+
+        VkDeviceQueueCreateInfo queueCreateInfo = {0};
+        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfo.queueFamilyIndex = queueFamilies[i];
+        queueCreateInfo.queueCount = 1;
+        queueCreateInfo.pQueuePriorities = &queuePriority;
+        queueCreateInfos[queueCreateInfoCount++] = queueCreateInfo;
+    }
 
     VkDeviceCreateInfo deviceCreateInfo = {0};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
-    deviceCreateInfo.queueCreateInfoCount = 1;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
+    deviceCreateInfo.queueCreateInfoCount = queueCreateInfoCount;
     deviceCreateInfo.enabledExtensionCount = 0;
 
     if (vkBackends->enableValidationLayers)
@@ -1044,18 +1323,159 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         deviceCreateInfo.ppEnabledLayerNames = s_LvnVkValidationLayers;
     }
 
-    const char* requiredExtensions = NULL;
-    uint32_t requiredExtensionCount = 0;
+    // optional device extensions are enabled whenever the physical device supports them
+    uint32_t deviceExtensionPropsCount = 0;
+    vkBackends->enumerateDeviceExtensionProperties(vkBackends->physicalDevice, NULL, &deviceExtensionPropsCount, NULL);
+    deviceExtensionProps = lvn_calloc(deviceExtensionPropsCount * sizeof(VkExtensionProperties));
+    vkBackends->enumerateDeviceExtensionProperties(vkBackends->physicalDevice, NULL, &deviceExtensionPropsCount, deviceExtensionProps);
+
+    for (uint32_t i = 0; i < deviceExtensionPropsCount; i++)
+    {
+        if (strcmp(deviceExtensionProps[i].extensionName, VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME) == 0)
+            vkBackends->ext.EXT_pipeline_creation_feedback = true;
+        else if (strcmp(deviceExtensionProps[i].extensionName, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) == 0)
+            vkBackends->ext.KHR_dynamic_rendering = true;
+        else if (strcmp(deviceExtensionProps[i].extensionName, VK_KHR_MAINTENANCE_5_EXTENSION_NAME) == 0)
+            vkBackends->ext.KHR_maintenance5 = true;
+        else if (strcmp(deviceExtensionProps[i].extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+            vkBackends->ext.EXT_descriptor_indexing = true;
+        else if (strcmp(deviceExtensionProps[i].extensionName, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) == 0)
+            vkBackends->ext.KHR_depth_stencil_resolve = true;
+        else if (strcmp(deviceExtensionProps[i].extensionName, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME) == 0)
+            vkBackends->ext.KHR_create_renderpass2 = true;
+    }
+
+    // VK_KHR_dynamic_rendering depends on VK_KHR_depth_stencil_resolve, which depends on VK_KHR_create_renderpass2, both core in 1.2
+    bool renderPass2Core = deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+    if (!renderPass2Core && !(vkBackends->ext.KHR_depth_stencil_resolve && vkBackends->ext.KHR_create_renderpass2))
+        vkBackends->ext.KHR_dynamic_rendering = false;
+
+    // inline shader code needs the maintenance5 feature, the extension itself depends on VK_KHR_dynamic_rendering
+    VkPhysicalDeviceMaintenance5FeaturesKHR maintenance5Features = {0};
+    maintenance5Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_5_FEATURES_KHR;
+
+    if (createInfo->enableInlineShaderCode && vkBackends->getPhysicalDeviceFeatures2 &&
+        vkBackends->ext.KHR_maintenance5 && vkBackends->ext.KHR_dynamic_rendering)
+    {
+        VkPhysicalDeviceFeatures2 features2 = {0};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &maintenance5Features;
+        vkBackends->getPhysicalDeviceFeatures2(vkBackends->physicalDevice, &features2);
+        maintenance5Features.pNext = NULL;
+
+        vkBackends->inlineShaderCode = maintenance5Features.maintenance5;
+    }
+
+    if (vkBackends->inlineShaderCode)
+    {
+        maintenance5Features.maintenance5 = VK_TRUE;
+        deviceCreateInfo.pNext = &maintenance5Features;
+    }
+    else
+    {
+        vkBackends->ext.KHR_maintenance5 = false;
+        if (createInfo->enableInlineShaderCode)
+            LVN_LOG_TRACE(graphicsctx->coreLogger, "[vulkan] VK_KHR_maintenance5 is not supported, shaders fall back to shader modules");
+    }
+
+    // dynamic rendering is core in 1.3 but the instance targets 1.2, so the extension is used on every device
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures = {0};
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+
+    if (createInfo->enableDynamicRendering && vkBackends->getPhysicalDeviceFeatures2 && vkBackends->ext.KHR_dynamic_rendering)
+    {
+        VkPhysicalDeviceFeatures2 features2 = {0};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &dynamicRenderingFeatures;
+        vkBackends->getPhysicalDeviceFeatures2(vkBackends->physicalDevice, &features2);
+        dynamicRenderingFeatures.pNext = NULL;
+
+        vkBackends->dynamicRendering = dynamicRenderingFeatures.dynamicRendering;
+    }
+
+    if (vkBackends->dynamicRendering)
+    {
+        dynamicRenderingFeatures.pNext = (void*) deviceCreateInfo.pNext;
+        deviceCreateInfo.pNext = &dynamicRenderingFeatures;
+    }
+    else if (createInfo->enableDynamicRendering)
+    {
+        LVN_LOG_WARN(graphicsctx->coreLogger, "[vulkan] VK_KHR_dynamic_rendering is not supported by the physical device, surfaces fall back to render passes");
+    }
+
+    // the bindless set needs descriptor indexing, core in 1.2 and VK_EXT_descriptor_indexing before that
+    VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {0};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+    bool indexingCore = deviceProperties.apiVersion >= VK_API_VERSION_1_2;
+    if (createInfo->enableBindless && vkBackends->getPhysicalDeviceFeatures2 && vkBackends->getPhysicalDeviceProperties2 &&
+        (indexingCore || vkBackends->ext.EXT_descriptor_indexing))
+    {
+        VkPhysicalDeviceFeatures2 features2 = {0};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &indexingFeatures;
+        vkBackends->getPhysicalDeviceFeatures2(vkBackends->physicalDevice, &features2);
+        indexingFeatures.pNext = NULL;
+
+        vkBackends->bindless = indexingFeatures.runtimeDescriptorArray &&
+                               indexingFeatures.descriptorBindingPartiallyBound &&
+                               indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind &&
+                               indexingFeatures.descriptorBindingSampledImageUpdateAfterBind;
+    }
+
+    if (vkBackends->bindless)
+    {
+        // only enable what the set uses, non uniform indexing is left on where supported
+        VkPhysicalDeviceDescriptorIndexingFeatures enabledFeatures = {0};
+        enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+        enabledFeatures.runtimeDescriptorArray = VK_TRUE;
+        enabledFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        enabledFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        enabledFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        enabledFeatures.shaderStorageBufferArrayNonUniformIndexing = indexingFeatures.shaderStorageBufferArrayNonUniformIndexing;
+        enabledFeatures.shaderSampledImageArrayNonUniformIndexing = indexingFeatures.shaderSampledImageArrayNonUniformIndexing;
+        enabledFeatures.pNext = (void*) deviceCreateInfo.pNext;
+        indexingFeatures = enabledFeatures;
+        deviceCreateInfo.pNext = &indexingFeatures;
+
+        vkBackends->ext.EXT_descriptor_indexing = !indexingCore;
+    }
+    else
+    {
+        vkBackends->ext.EXT_descriptor_indexing = false;
+        if (createInfo->enableBindless)
+            LVN_LOG_WARN(graphicsctx->coreLogger, "[vulkan] descriptor indexing is not supported by the physical device, bindless mode is disabled");
+    }
+
+    const char* deviceExtensionNames[LVN_VK_MAX_DEVICE_EXTENSIONS];
+    uint32_t deviceExtensionCount = 0;
 
     if (graphicsctx->presentModeFlags & Lvn_PresentationModeFlag_Surface)
+        deviceExtensionNames[deviceExtensionCount++] = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    if (vkBackends->ext.EXT_pipeline_creation_feedback)
+        deviceExtensionNames[deviceExtensionCount++] = VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
+    if (vkBackends->ext.KHR_maintenance5 || vkBackends->dynamicRendering)
     {
-        requiredExtensions = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
-        requiredExtensionCount = 1;
-        deviceCreateInfo.ppEnabledExtensionNames = &requiredExtensions;
-        deviceCreateInfo.enabledExtensionCount = requiredExtensionCount;
+        deviceExtensionNames[deviceExtensionCount++] = VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME;
+        if (!renderPass2Core)
+        {
+            deviceExtensionNames[deviceExtensionCount++] = VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME;
+            deviceExtensionNames[deviceExtensionCount++] = VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME;
+        }
     }
+    if (vkBackends->ext.KHR_maintenance5)
+        deviceExtensionNames[deviceExtensionCount++] = VK_KHR_MAINTENANCE_5_EXTENSION_NAME;
+    if (vkBackends->ext.EXT_descriptor_indexing)
+        deviceExtensionNames[deviceExtensionCount++] = VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME;
 
-    if (vkBackends->createDevice(vkBackends->physicalDevice, &deviceCreateInfo, NULL, &vkBackends->device) != VK_SUCCESS)
+    deviceCreateInfo.ppEnabledExtensionNames = deviceExtensionCount ? deviceExtensionNames : NULL;
+    deviceCreateInfo.enabledExtensionCount = deviceExtensionCount;
+
+    LVN_PROFILE_BEGIN("vkCreateDevice");
+    VkResult deviceResult = vkBackends->createDevice(vkBackends->physicalDevice, &deviceCreateInfo, NULL, &vkBackends->device);
+    LVN_PROFILE_END();
+
+    if (deviceResult != VK_SUCCESS)
     {
         LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create logical device");
         goto fail_cleanup;
@@ -1090,10 +1510,112 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateGraphicsPipelines");
     vkBackends->destroyPipeline = (PFN_vkDestroyPipeline)
         vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyPipeline");
+    vkBackends->createPipelineCache = (PFN_vkCreatePipelineCache)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreatePipelineCache");
+    vkBackends->destroyPipelineCache = (PFN_vkDestroyPipelineCache)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyPipelineCache");
+    vkBackends->getPipelineCacheData = (PFN_vkGetPipelineCacheData)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkGetPipelineCacheData");
+    vkBackends->mergePipelineCaches = (PFN_vkMergePipelineCaches)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkMergePipelineCaches");
     vkBackends->createFramebuffer = (PFN_vkCreateFramebuffer)
         vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateFramebuffer");
     vkBackends->destroyFramebuffer = (PFN_vkDestroyFramebuffer)
         vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyFramebuffer");
+    vkBackends->deviceWaitIdle = (PFN_vkDeviceWaitIdle)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDeviceWaitIdle");
+    vkBackends->createCommandPool = (PFN_vkCreateCommandPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateCommandPool");
+    vkBackends->destroyCommandPool = (PFN_vkDestroyCommandPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyCommandPool");
+    vkBackends->resetCommandPool = (PFN_vkResetCommandPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkResetCommandPool");
+    vkBackends->allocateCommandBuffers = (PFN_vkAllocateCommandBuffers)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkAllocateCommandBuffers");
+    vkBackends->beginCommandBuffer = (PFN_vkBeginCommandBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkBeginCommandBuffer");
+    vkBackends->endCommandBuffer = (PFN_vkEndCommandBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkEndCommandBuffer");
+    vkBackends->queueSubmit = (PFN_vkQueueSubmit)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkQueueSubmit");
+    vkBackends->allocateMemory = (PFN_vkAllocateMemory)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkAllocateMemory");
+    vkBackends->freeMemory = (PFN_vkFreeMemory)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkFreeMemory");
+    vkBackends->mapMemory = (PFN_vkMapMemory)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkMapMemory");
+    vkBackends->flushMappedMemoryRanges = (PFN_vkFlushMappedMemoryRanges)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkFlushMappedMemoryRanges");
+    vkBackends->invalidateMappedMemoryRanges = (PFN_vkInvalidateMappedMemoryRanges)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkInvalidateMappedMemoryRanges");
+    vkBackends->createBuffer = (PFN_vkCreateBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateBuffer");
+    vkBackends->destroyBuffer = (PFN_vkDestroyBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyBuffer");
+    vkBackends->getBufferMemoryRequirements = (PFN_vkGetBufferMemoryRequirements)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkGetBufferMemoryRequirements");
+    vkBackends->bindBufferMemory = (PFN_vkBindBufferMemory)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkBindBufferMemory");
+    vkBackends->createDescriptorSetLayout = (PFN_vkCreateDescriptorSetLayout)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateDescriptorSetLayout");
+    vkBackends->destroyDescriptorSetLayout = (PFN_vkDestroyDescriptorSetLayout)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyDescriptorSetLayout");
+    vkBackends->createDescriptorPool = (PFN_vkCreateDescriptorPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateDescriptorPool");
+    vkBackends->destroyDescriptorPool = (PFN_vkDestroyDescriptorPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyDescriptorPool");
+    vkBackends->resetDescriptorPool = (PFN_vkResetDescriptorPool)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkResetDescriptorPool");
+    vkBackends->allocateDescriptorSets = (PFN_vkAllocateDescriptorSets)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkAllocateDescriptorSets");
+    vkBackends->createDescriptorUpdateTemplate = (PFN_vkCreateDescriptorUpdateTemplate)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateDescriptorUpdateTemplate");
+    vkBackends->destroyDescriptorUpdateTemplate = (PFN_vkDestroyDescriptorUpdateTemplate)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyDescriptorUpdateTemplate");
+    vkBackends->updateDescriptorSetWithTemplate = (PFN_vkUpdateDescriptorSetWithTemplate)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkUpdateDescriptorSetWithTemplate");
+    vkBackends->updateDescriptorSets = (PFN_vkUpdateDescriptorSets)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkUpdateDescriptorSets");
+    vkBackends->createSemaphore = (PFN_vkCreateSemaphore)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateSemaphore");
+    vkBackends->destroySemaphore = (PFN_vkDestroySemaphore)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroySemaphore");
+    vkBackends->createFence = (PFN_vkCreateFence)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCreateFence");
+    vkBackends->destroyFence = (PFN_vkDestroyFence)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroyFence");
+    vkBackends->waitForFences = (PFN_vkWaitForFences)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkWaitForFences");
+    vkBackends->resetFences = (PFN_vkResetFences)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkResetFences");
+    vkBackends->cmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBeginRenderPass");
+    vkBackends->cmdEndRenderPass = (PFN_vkCmdEndRenderPass)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdEndRenderPass");
+    vkBackends->cmdBindPipeline = (PFN_vkCmdBindPipeline)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBindPipeline");
+    vkBackends->cmdSetViewport = (PFN_vkCmdSetViewport)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdSetViewport");
+    vkBackends->cmdSetScissor = (PFN_vkCmdSetScissor)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdSetScissor");
+    vkBackends->cmdCopyBuffer = (PFN_vkCmdCopyBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdCopyBuffer");
+    vkBackends->cmdPipelineBarrier = (PFN_vkCmdPipelineBarrier)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdPipelineBarrier");
+    vkBackends->cmdBindVertexBuffers = (PFN_vkCmdBindVertexBuffers)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBindVertexBuffers");
+    vkBackends->cmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBindDescriptorSets");
+    vkBackends->cmdPushConstants = (PFN_vkCmdPushConstants)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdPushConstants");
+    vkBackends->cmdBindIndexBuffer = (PFN_vkCmdBindIndexBuffer)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBindIndexBuffer");
+    vkBackends->cmdDrawIndexed = (PFN_vkCmdDrawIndexed)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdDrawIndexed");
+    vkBackends->cmdDraw = (PFN_vkCmdDraw)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdDraw");
+    vkBackends->cmdExecuteCommands = (PFN_vkCmdExecuteCommands)
+        vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdExecuteCommands");
 
     if (!vkBackends->destroyDevice ||
         !vkBackends->getDeviceQueue ||
@@ -1109,13 +1631,78 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
         !vkBackends->destroyPipelineLayout ||
         !vkBackends->createGraphicsPipelines ||
         !vkBackends->destroyPipeline ||
+        !vkBackends->createPipelineCache ||
+        !vkBackends->destroyPipelineCache ||
+        !vkBackends->getPipelineCacheData ||
+        !vkBackends->mergePipelineCaches ||
         !vkBackends->createFramebuffer ||
-        !vkBackends->destroyFramebuffer)
+        !vkBackends->destroyFramebuffer ||
+        !vkBackends->deviceWaitIdle ||
+        !vkBackends->createCommandPool ||
+        !vkBackends->destroyCommandPool ||
+        !vkBackends->resetCommandPool ||
+        !vkBackends->allocateCommandBuffers ||
+        !vkBackends->beginCommandBuffer ||
+        !vkBackends->endCommandBuffer ||
+        !vkBackends->queueSubmit ||
+        !vkBackends->allocateMemory ||
+        !vkBackends->freeMemory ||
+        !vkBackends->mapMemory ||
+        !vkBackends->flushMappedMemoryRanges ||
+        !vkBackends->invalidateMappedMemoryRanges ||
+        !vkBackends->createBuffer ||
+        !vkBackends->destroyBuffer ||
+        !vkBackends->getBufferMemoryRequirements ||
+        !vkBackends->bindBufferMemory ||
+        !vkBackends->createDescriptorSetLayout ||
+        !vkBackends->destroyDescriptorSetLayout ||
+        !vkBackends->createDescriptorPool ||
+        !vkBackends->destroyDescriptorPool ||
+        !vkBackends->resetDescriptorPool ||
+        !vkBackends->allocateDescriptorSets ||
+        !vkBackends->createDescriptorUpdateTemplate ||
+        !vkBackends->destroyDescriptorUpdateTemplate ||
+        !vkBackends->updateDescriptorSetWithTemplate ||
+        !vkBackends->updateDescriptorSets ||
+        !vkBackends->createSemaphore ||
+        !vkBackends->destroySemaphore ||
+        !vkBackends->createFence ||
+        !vkBackends->destroyFence ||
+        !vkBackends->waitForFences ||
+        !vkBackends->resetFences ||
+        !vkBackends->cmdBeginRenderPass ||
+        !vkBackends->cmdEndRenderPass ||
+        !vkBackends->cmdBindPipeline ||
+        !vkBackends->cmdSetViewport ||
+        !vkBackends->cmdSetScissor ||
+        !vkBackends->cmdCopyBuffer ||
+        !vkBackends->cmdPipelineBarrier ||
+        !vkBackends->cmdBindVertexBuffers ||
+        !vkBackends->cmdBindDescriptorSets ||
+        !vkBackends->cmdPushConstants ||
+        !vkBackends->cmdBindIndexBuffer ||
+        !vkBackends->cmdDraw ||
+        !vkBackends->cmdDrawIndexed ||
+        !vkBackends->cmdExecuteCommands)
     {
         LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to load vulkan device level function symbols");
         goto fail_cleanup;
     }
 
+    if (vkBackends->dynamicRendering)
+    {
+        vkBackends->cmdBeginRenderingKHR = (PFN_vkCmdBeginRenderingKHR)
+            vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdBeginRenderingKHR");
+        vkBackends->cmdEndRenderingKHR = (PFN_vkCmdEndRenderingKHR)
+            vkBackends->getDeviceProcAddr(vkBackends->device, "vkCmdEndRenderingKHR");
+
+        if (!vkBackends->cmdBeginRenderingKHR || !vkBackends->cmdEndRenderingKHR)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to load VK_KHR_dynamic_rendering function symbols");
+            goto fail_cleanup;
+        }
+    }
+
     if (graphicsctx->presentModeFlags & Lvn_PresentationModeFlag_Surface)
     {
         vkBackends->createSwapchainKHR = (PFN_vkCreateSwapchainKHR)
@@ -1124,10 +1711,16 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
             vkBackends->getDeviceProcAddr(vkBackends->device, "vkDestroySwapchainKHR");
         vkBackends->getSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)
             vkBackends->getDeviceProcAddr(vkBackends->device, "vkGetSwapchainImagesKHR");
+        vkBackends->acquireNextImageKHR = (PFN_vkAcquireNextImageKHR)
+            vkBackends->getDeviceProcAddr(vkBackends->device, "vkAcquireNextImageKHR");
+        vkBackends->queuePresentKHR = (PFN_vkQueuePresentKHR)
+            vkBackends->getDeviceProcAddr(vkBackends->device, "vkQueuePresentKHR");
 
         if (!vkBackends->createSwapchainKHR ||
             !vkBackends->destroySwapchainKHR ||
-            !vkBackends->getSwapchainImagesKHR)
+            !vkBackends->getSwapchainImagesKHR ||
+            !vkBackends->acquireNextImageKHR ||
+            !vkBackends->queuePresentKHR)
         {
             LVN_LOG_ERROR(graphicsctx->coreLogger,
                           "[vulkan] failed to load vulkan device level surface function symbol");
@@ -1138,32 +1731,106 @@ LvnResult lvnImplVkInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContex
 
     // get graphics and present queues from device
     vkBackends->getDeviceQueue(vkBackends->device, indices.graphicsIndex, 0, &vkBackends->graphicsQueue);
+    vkBackends->graphicsQueueFamilyIndex = indices.graphicsIndex;
+    vkBackends->getDeviceQueue(vkBackends->device, indices.transferIndex, 0, &vkBackends->transferQueue);
+    vkBackends->transferQueueFamilyIndex = indices.transferIndex;
 
     if (graphicsctx->presentModeFlags & Lvn_PresentationModeFlag_Surface)
         vkBackends->getDeviceQueue(vkBackends->device, indices.presentIndex, 0, &vkBackends->presentQueue);
 
 
+    lvn_vkMemoryAllocatorInit(vkBackends);
+
+    if (lvn_vkStagingInit(vkBackends, createInfo) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create staging buffer");
+        goto fail_cleanup;
+    }
+
+    if (vkBackends->bindless)
+    {
+        if (lvn_vkBindlessInit(vkBackends) != Lvn_Result_Success)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create bindless descriptor set");
+            goto fail_cleanup;
+        }
+
+        graphicsctx->bindlessLayout = &vkBackends->bindlessSet.layout;
+        graphicsctx->bindlessSet = &vkBackends->bindlessSet.set;
+    }
+
+    // one cache shared by every pipeline, vulkan synchronizes access to it internally so the
+    // parallel path in lvnImplVkCreatePipelines can hand it to several threads at once
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {0};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    if (vkBackends->createPipelineCache(vkBackends->device, &pipelineCacheCreateInfo, NULL, &vkBackends->pipelineCache) != VK_SUCCESS)
+    {
+        LVN_LOG_WARN(graphicsctx->coreLogger, "[vulkan] failed to create pipeline cache, pipelines will be created without one");
+        vkBackends->pipelineCache = VK_NULL_HANDLE;
+    }
+
     // set vulkan implementation function pointers
     graphicsctx->implCreateSurface = lvnImplVkCreateSurface;
     graphicsctx->implDestroySurface = lvnImplVkDestroySurface;
     graphicsctx->implCreateShader = lvnImplVkCreateShader;
     graphicsctx->implDestroyShader = lvnImplVkDestroyShader;
     graphicsctx->implCreatePipeline = lvnImplVkCreatePipeline;
+    graphicsctx->implCreatePipelines = lvnImplVkCreatePipelines;
     graphicsctx->implDestroyPipeline = lvnImplVkDestroyPipeline;
+    graphicsctx->implCreateBuffer = lvnImplVkCreateBuffer;
+    graphicsctx->implDestroyBuffer = lvnImplVkDestroyBuffer;
+    graphicsctx->implCreateDescriptorLayout = lvnImplVkCreateDescriptorLayout;
+    graphicsctx->implDestroyDescriptorLayout = lvnImplVkDestroyDescriptorLayout;
+    graphicsctx->implFlushBuffer = lvnImplVkFlushBuffer;
+    graphicsctx->implInvalidateBuffer = lvnImplVkInvalidateBuffer;
+    graphicsctx->implUploadBuffer = lvnImplVkUploadBuffer;
+    graphicsctx->implWaitIdle = lvnImplVkWaitIdle;
+    graphicsctx->implLoadPipelineCache = lvnImplVkLoadPipelineCache;
+    graphicsctx->implGetPipelineCacheData = lvnImplVkGetPipelineCacheData;
+    graphicsctx->implGetPipelineCacheStats = lvnImplVkGetPipelineCacheStats;
+    graphicsctx->implGetMemoryStats = lvnImplVkGetMemoryStats;
+    graphicsctx->implBeginFrame = lvnImplVkBeginFrame;
+    graphicsctx->implSurfaceBeginFrame = lvnImplVkSurfaceBeginFrame;
+    graphicsctx->implSurfaceEndFrame = lvnImplVkSurfaceEndFrame;
+    graphicsctx->implSurfaceResize = lvnImplVkSurfaceResize;
+    graphicsctx->implSurfaceGetExtent = lvnImplVkSurfaceGetExtent;
+    graphicsctx->implAllocateCommandBuffer = lvnImplVkAllocateCommandBuffer;
+    graphicsctx->implBeginCommandBuffer = lvnImplVkBeginCommandBuffer;
+    graphicsctx->implEndCommandBuffer = lvnImplVkEndCommandBuffer;
+    graphicsctx->implSubmitCommandBuffers = lvnImplVkSubmitCommandBuffers;
+    graphicsctx->implAllocateDescriptorSet = lvnImplVkAllocateDescriptorSet;
+    graphicsctx->implUpdateDescriptorSet = lvnImplVkUpdateDescriptorSet;
+    graphicsctx->implCmdBeginRenderPass = lvnImplVkCmdBeginRenderPass;
+    graphicsctx->implCmdEndRenderPass = lvnImplVkCmdEndRenderPass;
+    graphicsctx->implCmdBindPipeline = lvnImplVkCmdBindPipeline;
+    graphicsctx->implCmdSetViewport = lvnImplVkCmdSetViewport;
+    graphicsctx->implCmdSetScissor = lvnImplVkCmdSetScissor;
+    graphicsctx->implCmdBindVertexBuffers = lvnImplVkCmdBindVertexBuffers;
+    graphicsctx->implCmdBindDescriptorSets = lvnImplVkCmdBindDescriptorSets;
+    graphicsctx->implCmdPushConstants = lvnImplVkCmdPushConstants;
+    graphicsctx->implCmdBindIndexBuffer = lvnImplVkCmdBindIndexBuffer;
+    graphicsctx->implCmdDraw = lvnImplVkCmdDraw;
+    graphicsctx->implCmdDrawIndexed = lvnImplVkCmdDrawIndexed;
+    graphicsctx->implCmdExecuteCommands = lvnImplVkCmdExecuteCommands;
 
     if (surface) vkBackends->destroySurfaceKHR(vkBackends->instance, surface, NULL);
     lvn_free(extensionProps);
+    lvn_free(deviceExtensionProps);
     lvn_free(extensionNames);
     lvn_free(availableLayers);
 
+    LVN_PROFILE_END();
     return Lvn_Result_Success;
 
 fail_cleanup:
     if (surface) vkBackends->destroySurfaceKHR(vkBackends->instance, surface, NULL);
     lvn_free(extensionProps);
+    lvn_free(deviceExtensionProps);
     lvn_free(extensionNames);
     lvn_free(availableLayers);
     lvnImplVkTerminate(graphicsctx);
+    LVN_PROFILE_END();
     return Lvn_Result_Failure;
 }
 
@@ -1173,8 +1840,46 @@ void lvnImplVkTerminate(LvnGraphicsContext* graphicsctx)
 
     LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
 
+    // command buffers may still be executing
+    if (vkBackends->device && vkBackends->deviceWaitIdle)
+        vkBackends->deviceWaitIdle(vkBackends->device);
+
+    for (uint32_t i = 0; i < vkBackends->threadCommandPoolTable.capacity; i++)
+    {
+        LvnVkThreadCommandPools* threadPools = (LvnVkThreadCommandPools*) vkBackends->threadCommandPoolTable.pEntries[i].value;
+        if (threadPools)
+            lvn_destroyThreadCommandPools(vkBackends, threadPools);
+    }
+    lvn_hashTableFree(&vkBackends->threadCommandPoolTable);
+
+    for (uint32_t i = 0; i < LVN_MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        for (uint32_t j = 0; j < vkBackends->frameSync[i].fenceCount; j++)
+            vkBackends->destroyFence(vkBackends->device, vkBackends->frameSync[i].pFences[j], NULL);
+        lvn_free(vkBackends->frameSync[i].pFences);
+    }
+
+    // layouts still in the table belong to pipelines that were never destroyed
+    for (uint32_t i = 0; i < vkBackends->pipelineLayoutTable.capacity; i++)
+    {
+        LvnVkPipelineLayoutEntry* entry = (LvnVkPipelineLayoutEntry*) vkBackends->pipelineLayoutTable.pEntries[i].value;
+        if (!entry)
+            continue;
+
+        vkBackends->destroyPipelineLayout(vkBackends->device, entry->pipelineLayout, NULL);
+        lvn_free(entry);
+    }
+    lvn_hashTableFree(&vkBackends->pipelineLayoutTable);
+
+    if (vkBackends->pipelineCache)
+        vkBackends->destroyPipelineCache(vkBackends->device, vkBackends->pipelineCache, NULL);
     if (vkBackends->device)
+    {
+        lvn_vkBindlessTerminate(vkBackends);
+        lvn_vkStagingTerminate(vkBackends);
+        lvn_vkMemoryAllocatorTerminate(vkBackends);
         vkBackends->destroyDevice(vkBackends->device, NULL);
+    }
     if (vkBackends->debugMessenger)
         vkBackends->destroyDebugUtilsMessengerEXT(vkBackends->instance, vkBackends->debugMessenger, NULL);
     if (vkBackends->instance)
@@ -1191,6 +1896,8 @@ LvnResult lvnImplVkCreateSurface(const LvnGraphicsContext* graphicsctx, LvnSurfa
 {
     LVN_ASSERT(graphicsctx && surface && createInfo, "graphicsctx, surface, and createInfo cannot be null");
 
+    LVN_PROFILE_BEGIN("lvnImplVkCreateSurface");
+
     const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
 
     VkSurfaceKHR vkSurface = VK_NULL_HANDLE;
@@ -1238,104 +1945,79 @@ LvnResult lvnImplVkCreateSurface(const LvnGraphicsContext* graphicsctx, LvnSurfa
     }
     LvnVkQueueFamilyIndices queueFamilyIndices = lvn_findQueueFamilies(vkBackends, vkBackends->physicalDevice, vkSurface);
 
-    // render pass
-    // color attachment
-    VkAttachmentDescription colorAttachment = {0};
-    colorAttachment.format = swapchainFormat.format; // use the swapchain format for color attachment
-    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // render pass, dynamic rendering needs only the attachment format
+    if (!vkBackends->dynamicRendering && lvn_createSurfaceRenderPass(vkBackends, swapchainFormat.format, &renderPass) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create render pass for surface %p", surface);
+        goto fail_cleanup;
+    }
 
-    VkAttachmentReference colorAttachmentRef = {0};
-    colorAttachmentRef.attachment = 0;
-    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    // create swapchain data
+    LvnVkSwapChainCreateInfo swapchainCreateInfo = {0};
+    swapchainCreateInfo.physicalDevice = vkBackends->physicalDevice;
+    swapchainCreateInfo.surface = vkSurface;
+    swapchainCreateInfo.surfaceFormat = swapchainFormat;
+    swapchainCreateInfo.queueFamilyIndices = &queueFamilyIndices;
+    swapchainCreateInfo.renderPass = renderPass;
+    swapchainCreateInfo.width = createInfo->width;
+    swapchainCreateInfo.height = createInfo->height;
 
-    // depth attachment
-    VkAttachmentDescription depthAttachment = {0};
-    depthAttachment.format = lvn_findDepthFormat(vkBackends, vkBackends->physicalDevice);
-    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    swapchainData = lvn_calloc(sizeof(LvnVkSwapchainData));
 
-    VkAttachmentReference depthAttachmentRef = {0};
-    depthAttachmentRef.attachment = 1;
-    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    LVN_PROFILE_BEGIN("lvn_createSwapChainData");
+    LvnResult swapchainResult = lvn_createSwapChainData(vkBackends, swapchainData, &swapchainCreateInfo);
+    LVN_PROFILE_END();
 
-    VkSubpassDescription subpass = {0};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorAttachmentRef;
-    // subpass.pDepthStencilAttachment = &depthAttachmentRef;
+    if (swapchainResult != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create swapchain data for surface %p", surface);
+        goto fail_cleanup;
+    }
 
-    VkSubpassDependency dependency = {0};
-    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependency.dstSubpass = 0;
-    dependency.srcAccessMask = 0;
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    swapchainData->queueFamilyIndices = queueFamilyIndices;
+    swapchainData->createInfo = swapchainCreateInfo;
+    swapchainData->createInfo.queueFamilyIndices = &swapchainData->queueFamilyIndices;
 
-    VkAttachmentDescription attachments[] = { colorAttachment, /* depthAttachment */ };
-    VkRenderPassCreateInfo renderPassInfo = {0};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = LVN_ARRAY_LEN(attachments);
-    renderPassInfo.pAttachments = attachments;
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies = &dependency;
+    // frame sync, see lvnImplVkSurfaceBeginFrame
+    VkSemaphoreCreateInfo semaphoreInfo = {0};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    if (vkBackends->createRenderPass(vkBackends->device, &renderPassInfo, NULL, &renderPass) != VK_SUCCESS)
+    for (uint32_t i = 0; i < graphicsctx->framesInFlight; i++)
     {
-        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create render pass for surface %p", surface);
-        goto fail_cleanup;
+        if (vkBackends->createSemaphore(vkBackends->device, &semaphoreInfo, NULL, &swapchainData->imageAvailableSemaphores[i]) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create frame semaphores for surface %p", surface);
+            goto fail_cleanup;
+        }
     }
 
-    // create swapchain data
-    LvnVkSwapChainCreateInfo swapchainCreateInfo = {0};
-    swapchainCreateInfo.physicalDevice = vkBackends->physicalDevice;
-    swapchainCreateInfo.surface = vkSurface;
-    swapchainCreateInfo.surfaceFormat = swapchainFormat;
-    swapchainCreateInfo.queueFamilyIndices = &queueFamilyIndices;
-    swapchainCreateInfo.renderPass = renderPass;
-    swapchainCreateInfo.width = createInfo->width;
-    swapchainCreateInfo.height = createInfo->height;
-
-    swapchainData = lvn_calloc(sizeof(LvnVkSwapchainData));
-    if (lvn_createSwapChainData(vkBackends, swapchainData, &swapchainCreateInfo) != Lvn_Result_Success)
+    if (lvn_createSwapChainSemaphores(vkBackends, swapchainData) != Lvn_Result_Success)
     {
-        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create swapchain data for surface %p", surface);
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create frame semaphores for surface %p", surface);
         goto fail_cleanup;
     }
 
     surface->surface = vkSurface;
     surface->swapchainData = swapchainData;
     surface->renderPass.renderPassHandle = renderPass;
+    surface->renderPass.colorFormat = swapchainFormat.format;
 
     lvn_free(swapchainFormats);
+    LVN_PROFILE_END();
     return Lvn_Result_Success;
 
 fail_cleanup:
     vkBackends->destroyRenderPass(vkBackends->device, renderPass, NULL);
-    vkBackends->destroySwapchainKHR(vkBackends->device, swapchainData->swapchain, NULL);
+    if (swapchainData)
+    {
+        for (uint32_t i = 0; i < LVN_MAX_FRAMES_IN_FLIGHT; i++)
+            vkBackends->destroySemaphore(vkBackends->device, swapchainData->imageAvailableSemaphores[i], NULL);
+        lvn_destroySwapChainData(vkBackends, swapchainData);
+    }
     vkBackends->destroySurfaceKHR(vkBackends->instance, vkSurface, NULL);
-    for (uint32_t i = 0; i < swapchainData->swapchainImageCount; i++)
-        vkBackends->destroyFramebuffer(vkBackends->device, swapchainData->swapchainFramebuffers[i], NULL);
-    lvn_free(swapchainData->swapchainFramebuffers);
-    for (uint32_t i = 0; i < swapchainData->swapchainImageCount; i++)
-        vkBackends->destroyImageView(vkBackends->device, swapchainData->swapchainImageViews[i], NULL);
-    lvn_free(swapchainData->swapchainImageViews);
-    lvn_free(swapchainData->swapchainImages);
     lvn_free(swapchainData);
     lvn_free(swapchainFormats);
+    LVN_PROFILE_END();
     return Lvn_Result_Failure;
 }
 
@@ -1347,21 +2029,14 @@ void lvnImplVkDestroySurface(LvnSurface* surface)
     LvnVkSwapchainData* swapchainData = (LvnVkSwapchainData*) surface->swapchainData;
     VkRenderPass renderPass = (VkRenderPass) surface->renderPass.renderPassHandle;
 
-    // swapchain framebuffers
-    for (uint32_t i = 0; i < swapchainData->swapchainImageCount; i++)
-        vkBackends->destroyFramebuffer(vkBackends->device, swapchainData->swapchainFramebuffers[i], NULL);
-    lvn_free(swapchainData->swapchainFramebuffers);
-
-    // swapchain image views
-    for (uint32_t i = 0; i < swapchainData->swapchainImageCount; i++)
-        vkBackends->destroyImageView(vkBackends->device, swapchainData->swapchainImageViews[i], NULL);
-    lvn_free(swapchainData->swapchainImageViews);
+    // frames in flight may still wait on the semaphores or render to the images
+    vkBackends->deviceWaitIdle(vkBackends->device);
 
-    // swapchain images
-    lvn_free(swapchainData->swapchainImages);
+    for (uint32_t i = 0; i < LVN_MAX_FRAMES_IN_FLIGHT; i++)
+        vkBackends->destroySemaphore(vkBackends->device, swapchainData->imageAvailableSemaphores[i], NULL);
 
-    // swapchain
-    vkBackends->destroySwapchainKHR(vkBackends->device, swapchainData->swapchain, NULL);
+    // swapchain, its images, views, framebuffers and present semaphores
+    lvn_destroySwapChainData(vkBackends, swapchainData);
 
     // swapchain data struct
     lvn_free(surface->swapchainData);
@@ -1380,13 +2055,49 @@ LvnResult lvnImplVkCreateShader(const LvnGraphicsContext* graphicsctx, LvnShader
 {
     const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
 
+    if (!createInfo->pCode || !createInfo->codeSize || createInfo->codeSize % sizeof(uint32_t) != 0)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create shader module, spir-v code size (%zu) must be a non zero multiple of 4", createInfo->codeSize);
+        return Lvn_Result_Failure;
+    }
+
+    // pipelines read the code at creation time, so keep an aligned copy instead of a module
+    if (vkBackends->inlineShaderCode)
+    {
+        LvnVkShaderCode* shaderCode = (LvnVkShaderCode*) lvn_malloc(sizeof(LvnVkShaderCode) + createInfo->codeSize);
+        if (!shaderCode)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for shader code");
+            return Lvn_Result_Failure;
+        }
+
+        shaderCode->codeSize = createInfo->codeSize;
+        memcpy(shaderCode->code, createInfo->pCode, createInfo->codeSize);
+        shader->shader = shaderCode;
+        return Lvn_Result_Success;
+    }
+
+    // spir-v is passed as uint32_t words; mapped files and heap buffers are already aligned
+    // so only copy when the caller hands in an unaligned pointer
+    uint32_t* alignedCode = NULL;
+    const uint32_t* pCode = (const uint32_t*) createInfo->pCode;
+    if ((uintptr_t) createInfo->pCode % sizeof(uint32_t) != 0)
+    {
+        alignedCode = lvn_malloc(createInfo->codeSize);
+        memcpy(alignedCode, createInfo->pCode, createInfo->codeSize);
+        pCode = alignedCode;
+    }
+
     VkShaderModuleCreateInfo shaderCreateInfo = {0};
     shaderCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
     shaderCreateInfo.codeSize = createInfo->codeSize;
-    shaderCreateInfo.pCode = (const uint32_t*) createInfo->pCode;
+    shaderCreateInfo.pCode = pCode;
 
     VkShaderModule shaderModule;
-    if (vkBackends->createShaderModule(vkBackends->device, &shaderCreateInfo, NULL, &shaderModule) != VK_SUCCESS)
+    VkResult result = vkBackends->createShaderModule(vkBackends->device, &shaderCreateInfo, NULL, &shaderModule);
+    lvn_free(alignedCode);
+
+    if (result != VK_SUCCESS)
     {
         LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create shader module!");
         return Lvn_Result_Failure;
@@ -1400,32 +2111,87 @@ void lvnImplVkDestroyShader(LvnShader* shader)
 {
     LVN_ASSERT(shader, "shader cannot be null");
     const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) shader->graphicsctx->implData;
+
+    if (vkBackends->inlineShaderCode)
+    {
+        lvn_free(shader->shader);
+        shader->shader = NULL;
+        return;
+    }
+
     VkShaderModule shaderModule = (VkShaderModule) shader->shader;
     vkBackends->destroyShaderModule(vkBackends->device, shaderModule, NULL);
     shader->shader = NULL;
 }
 
-LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo)
+static LvnResult lvn_createPipelineBuildData(const LvnGraphicsContext* graphicsctx, LvnVkPipelineBuildData* build, VkGraphicsPipelineCreateInfo* pipelineInfo, const LvnPipelineCreateInfo* createInfo)
 {
     const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
-    LvnVkPipelineData* pipelineData = NULL;
-    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-    VkPipeline vkPipeline = VK_NULL_HANDLE;
+    const LvnPipelineFixedFunctions* pipelineFixedFunctions = createInfo->pipelineFixedFunctions;
+
+    // if color blend attachments is 0, we automatically add a default color blend attachment
+    uint32_t colorBlendAttachmentCount = (pipelineFixedFunctions->colorBlend.colorBlendAttachmentCount == 0)
+        ? 1
+        : pipelineFixedFunctions->colorBlend.colorBlendAttachmentCount;
+
+    // every array lives in one allocation, the 8 byte aligned shader stages, module infos and stage feedbacks come first
+    size_t stagesSize = createInfo->stageCount * sizeof(VkPipelineShaderStageCreateInfo);
+    size_t stageModuleInfosSize = vkBackends->inlineShaderCode ? createInfo->stageCount * sizeof(VkShaderModuleCreateInfo) : 0;
+    size_t stageFeedbacksSize = vkBackends->ext.EXT_pipeline_creation_feedback ? createInfo->stageCount * sizeof(VkPipelineCreationFeedbackEXT) : 0;
+    size_t colorBlendSize = colorBlendAttachmentCount * sizeof(VkPipelineColorBlendAttachmentState);
+    size_t attributesSize = createInfo->vertexAttributeCount * sizeof(VkVertexInputAttributeDescription);
+    size_t bindingsSize = createInfo->vertexBindingDescriptionCount * sizeof(VkVertexInputBindingDescription);
+
+    uint8_t* arrays = (uint8_t*) lvn_malloc(stagesSize + stageModuleInfosSize + stageFeedbacksSize + colorBlendSize + attributesSize + bindingsSize);
+    if (!arrays)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for pipeline create info");
+        return Lvn_Result_Failure;
+    }
+
+    build->arrays = arrays;
+    build->shaderStages = (VkPipelineShaderStageCreateInfo*) arrays;
+    arrays += stagesSize;
+    build->stageModuleInfos = (VkShaderModuleCreateInfo*) arrays;
+    arrays += stageModuleInfosSize;
+    build->stageFeedbacks = (VkPipelineCreationFeedbackEXT*) arrays;
+    arrays += stageFeedbacksSize;
+    build->colorBlendAttachments = (VkPipelineColorBlendAttachmentState*) arrays;
+    arrays += colorBlendSize;
+    build->vertexAttributes = (VkVertexInputAttributeDescription*) arrays;
+    arrays += attributesSize;
+    build->bindingDescriptions = (VkVertexInputBindingDescription*) arrays;
 
     // shader stages
-    VkPipelineShaderStageCreateInfo shaderStages[createInfo->stageCount];
     for (uint32_t i = 0; i < createInfo->stageCount; i++)
     {
         VkPipelineShaderStageCreateInfo stageCreateInfo = {0};
         stageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         stageCreateInfo.stage = lvn_getVkShaderStageEnum(createInfo->pStages[i].stage);
-        stageCreateInfo.module = (VkShaderModule) createInfo->pStages[i].shader->shader;
         stageCreateInfo.pName = createInfo->pStages[i].entryPoint;
-        shaderStages[i] = stageCreateInfo;
+
+        if (vkBackends->inlineShaderCode)
+        {
+            const LvnVkShaderCode* shaderCode = (const LvnVkShaderCode*) createInfo->pStages[i].shader->shader;
+
+            VkShaderModuleCreateInfo* moduleInfo = &build->stageModuleInfos[i];
+            memset(moduleInfo, 0, sizeof(VkShaderModuleCreateInfo));
+            moduleInfo->sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            moduleInfo->codeSize = shaderCode->codeSize;
+            moduleInfo->pCode = shaderCode->code;
+
+            stageCreateInfo.module = VK_NULL_HANDLE;
+            stageCreateInfo.pNext = moduleInfo;
+        }
+        else
+        {
+            stageCreateInfo.module = (VkShaderModule) createInfo->pStages[i].shader->shader;
+        }
+
+        build->shaderStages[i] = stageCreateInfo;
     }
 
     // vertex binding descriptions
-    VkVertexInputBindingDescription bindingDescriptions[createInfo->vertexBindingDescriptionCount];
     for (uint32_t i = 0; i < createInfo->vertexBindingDescriptionCount; i++)
     {
         VkVertexInputBindingDescription bindingDescription = {0};
@@ -1433,11 +2199,10 @@ LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipe
         bindingDescription.stride = createInfo->pVertexBindingDescriptions[i].stride;
         bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-        bindingDescriptions[i] = bindingDescription;
+        build->bindingDescriptions[i] = bindingDescription;
     }
 
     // vertex attributes
-    VkVertexInputAttributeDescription vertexAttributes[createInfo->vertexAttributeCount];
     for (uint32_t i = 0; i < createInfo->vertexAttributeCount; i++)
     {
         VkVertexInputAttributeDescription attributeDescription = {0};
@@ -1446,31 +2211,23 @@ LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipe
         attributeDescription.format = lvn_getVkVertexAttributeFormatEnum(createInfo->pVertexAttributes[i].format);
         attributeDescription.offset = createInfo->pVertexAttributes[i].offset;
 
-        vertexAttributes[i] = attributeDescription;
+        build->vertexAttributes[i] = attributeDescription;
     }
 
     // send binding descriptions and attributes to pipeline
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {0};
-    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    VkPipelineVertexInputStateCreateInfo* vertexInputInfo = &build->vertexInputInfo;
+    vertexInputInfo->sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
     if (createInfo->pVertexBindingDescriptions && createInfo->vertexBindingDescriptionCount > 0)
     {
-        vertexInputInfo.vertexBindingDescriptionCount = createInfo->vertexBindingDescriptionCount;
-        vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions;
+        vertexInputInfo->vertexBindingDescriptionCount = createInfo->vertexBindingDescriptionCount;
+        vertexInputInfo->pVertexBindingDescriptions = build->bindingDescriptions;
     }
 
     if (createInfo->pVertexAttributes && createInfo->vertexAttributeCount > 0)
     {
-        vertexInputInfo.vertexAttributeDescriptionCount = createInfo->vertexAttributeCount;
-        vertexInputInfo.pVertexAttributeDescriptions = vertexAttributes;
-    }
-
-    // descriptor layouts
-    VkDescriptorSetLayout descriptorLayouts[createInfo->descriptorLayoutCount];
-    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
-    {
-        VkDescriptorSetLayout descriptorLayout = (VkDescriptorSetLayout) createInfo->pDescriptorLayouts[i]->descriptorLayout;
-        descriptorLayouts[i] = descriptorLayout;
+        vertexInputInfo->vertexAttributeDescriptionCount = createInfo->vertexAttributeCount;
+        vertexInputInfo->pVertexAttributeDescriptions = build->vertexAttributes;
     }
 
     // render pass
@@ -1478,64 +2235,54 @@ LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipe
 
 
     // pipeline fixed functions
-    const LvnPipelineFixedFunctions* pipelineFixedFunctions = createInfo->pipelineFixedFunctions;
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {0};
-    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAssembly.topology = lvn_getVkTopologyTypeEnum(pipelineFixedFunctions->inputAssembly.topology);
-    inputAssembly.primitiveRestartEnable = pipelineFixedFunctions->inputAssembly.primitiveRestartEnable;
+    VkPipelineInputAssemblyStateCreateInfo* inputAssembly = &build->inputAssembly;
+    inputAssembly->sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly->topology = lvn_getVkTopologyTypeEnum(pipelineFixedFunctions->inputAssembly.topology);
+    inputAssembly->primitiveRestartEnable = pipelineFixedFunctions->inputAssembly.primitiveRestartEnable;
 
-    VkDynamicState dynamicStates[5];
-    dynamicStates[0] = VK_DYNAMIC_STATE_VIEWPORT;
-    dynamicStates[1] = VK_DYNAMIC_STATE_SCISSOR;
+    build->dynamicStates[0] = VK_DYNAMIC_STATE_VIEWPORT;
+    build->dynamicStates[1] = VK_DYNAMIC_STATE_SCISSOR;
     uint32_t dynamicStatesCount = 2;
 
     if (pipelineFixedFunctions->depthstencil.enableStencil)
     {
-        dynamicStates[2] = VK_DYNAMIC_STATE_STENCIL_REFERENCE;
-        dynamicStates[3] = VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK;
-        dynamicStates[4] = VK_DYNAMIC_STATE_STENCIL_WRITE_MASK;
+        build->dynamicStates[2] = VK_DYNAMIC_STATE_STENCIL_REFERENCE;
+        build->dynamicStates[3] = VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK;
+        build->dynamicStates[4] = VK_DYNAMIC_STATE_STENCIL_WRITE_MASK;
         dynamicStatesCount = 5;
     }
 
-    VkPipelineDynamicStateCreateInfo dynamicState = {0};
-    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicState.pDynamicStates = dynamicStates;
-    dynamicState.dynamicStateCount = dynamicStatesCount;
-
-    VkPipelineViewportStateCreateInfo viewportState = {0};
-    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportState.viewportCount = 1;
-    viewportState.scissorCount = 1;
-
-    VkPipelineRasterizationStateCreateInfo rasterizer = {0};
-    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizer.depthClampEnable = pipelineFixedFunctions->rasterizer.depthClampEnable;
-    rasterizer.rasterizerDiscardEnable = pipelineFixedFunctions->rasterizer.rasterizerDiscardEnable;
-    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizer.lineWidth = pipelineFixedFunctions->rasterizer.lineWidth;
-    rasterizer.cullMode = lvn_getVkCullModeFlagEnum(pipelineFixedFunctions->rasterizer.cullMode);
-    rasterizer.frontFace = lvn_getVkCullFrontFaceEnum(pipelineFixedFunctions->rasterizer.frontFace);
-    rasterizer.depthBiasEnable = pipelineFixedFunctions->rasterizer.depthBiasEnable;
-    rasterizer.depthBiasConstantFactor = pipelineFixedFunctions->rasterizer.depthBiasConstantFactor;
-    rasterizer.depthBiasClamp = pipelineFixedFunctions->rasterizer.depthBiasClamp;
-    rasterizer.depthBiasSlopeFactor = pipelineFixedFunctions->rasterizer.depthBiasSlopeFactor;
-
-    VkPipelineMultisampleStateCreateInfo multisampling = {0};
-    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampling.sampleShadingEnable = pipelineFixedFunctions->multisampling.sampleShadingEnable;
-    multisampling.rasterizationSamples = lvn_getVkSampleCountFlagEnum(pipelineFixedFunctions->multisampling.rasterizationSamples);
-    multisampling.minSampleShading = pipelineFixedFunctions->multisampling.minSampleShading;
-    multisampling.pSampleMask = pipelineFixedFunctions->multisampling.sampleMask;
-    multisampling.alphaToCoverageEnable = pipelineFixedFunctions->multisampling.alphaToCoverageEnable;
-    multisampling.alphaToOneEnable = pipelineFixedFunctions->multisampling.alphaToOneEnable;
-
-    // if color blend attachments is 0, we automatically add a default color blend attachment
-    uint32_t colorBlendAttachmentCount = (pipelineFixedFunctions->colorBlend.colorBlendAttachmentCount == 0)
-        ? 1
-        : pipelineFixedFunctions->colorBlend.colorBlendAttachmentCount;
-
-    VkPipelineColorBlendAttachmentState colorBlendAttachments[colorBlendAttachmentCount];
+    VkPipelineDynamicStateCreateInfo* dynamicState = &build->dynamicState;
+    dynamicState->sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState->pDynamicStates = build->dynamicStates;
+    dynamicState->dynamicStateCount = dynamicStatesCount;
+
+    VkPipelineViewportStateCreateInfo* viewportState = &build->viewportState;
+    viewportState->sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState->viewportCount = 1;
+    viewportState->scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo* rasterizer = &build->rasterizer;
+    rasterizer->sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer->depthClampEnable = pipelineFixedFunctions->rasterizer.depthClampEnable;
+    rasterizer->rasterizerDiscardEnable = pipelineFixedFunctions->rasterizer.rasterizerDiscardEnable;
+    rasterizer->polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer->lineWidth = pipelineFixedFunctions->rasterizer.lineWidth;
+    rasterizer->cullMode = lvn_getVkCullModeFlagEnum(pipelineFixedFunctions->rasterizer.cullMode);
+    rasterizer->frontFace = lvn_getVkCullFrontFaceEnum(pipelineFixedFunctions->rasterizer.frontFace);
+    rasterizer->depthBiasEnable = pipelineFixedFunctions->rasterizer.depthBiasEnable;
+    rasterizer->depthBiasConstantFactor = pipelineFixedFunctions->rasterizer.depthBiasConstantFactor;
+    rasterizer->depthBiasClamp = pipelineFixedFunctions->rasterizer.depthBiasClamp;
+    rasterizer->depthBiasSlopeFactor = pipelineFixedFunctions->rasterizer.depthBiasSlopeFactor;
+
+    VkPipelineMultisampleStateCreateInfo* multisampling = &build->multisampling;
+    multisampling->sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling->sampleShadingEnable = pipelineFixedFunctions->multisampling.sampleShadingEnable;
+    multisampling->rasterizationSamples = lvn_getVkSampleCountFlagEnum(pipelineFixedFunctions->multisampling.rasterizationSamples);
+    multisampling->minSampleShading = pipelineFixedFunctions->multisampling.minSampleShading;
+    multisampling->pSampleMask = pipelineFixedFunctions->multisampling.sampleMask;
+    multisampling->alphaToCoverageEnable = pipelineFixedFunctions->multisampling.alphaToCoverageEnable;
+    multisampling->alphaToOneEnable = pipelineFixedFunctions->multisampling.alphaToOneEnable;
 
     if (pipelineFixedFunctions->colorBlend.colorBlendAttachmentCount == 0)
     {
@@ -1548,7 +2295,7 @@ LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipe
         colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
         colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
         colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
-        colorBlendAttachments[0] = colorBlendAttachment;
+        build->colorBlendAttachments[0] = colorBlendAttachment;
     }
     else
     {
@@ -1566,99 +2313,398 @@ LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipe
             colorBlendAttachment.dstAlphaBlendFactor = lvn_getVkBlendFactorEnum(attachment.dstAlphaBlendFactor);
             colorBlendAttachment.alphaBlendOp = lvn_getVkBlendOperationEnum(attachment.alphaBlendOp);
 
-            colorBlendAttachments[i] = colorBlendAttachment;
-        }
-    }
-
-    VkPipelineColorBlendStateCreateInfo colorBlending = {0};
-    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.logicOpEnable = pipelineFixedFunctions->colorBlend.logicOpEnable;
-    colorBlending.logicOp = VK_LOGIC_OP_COPY;
-    colorBlending.pAttachments = colorBlendAttachments;
-    colorBlending.attachmentCount = colorBlendAttachmentCount;
-    colorBlending.blendConstants[0] = pipelineFixedFunctions->colorBlend.blendConstants[0];
-    colorBlending.blendConstants[1] = pipelineFixedFunctions->colorBlend.blendConstants[1];
-    colorBlending.blendConstants[2] = pipelineFixedFunctions->colorBlend.blendConstants[2];
-    colorBlending.blendConstants[3] = pipelineFixedFunctions->colorBlend.blendConstants[3];
-
-    VkPipelineDepthStencilStateCreateInfo depthStencil = {0};
-    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    depthStencil.depthTestEnable = pipelineFixedFunctions->depthstencil.enableDepth;
-    depthStencil.depthWriteEnable = pipelineFixedFunctions->depthstencil.enableDepth;
-    depthStencil.depthCompareOp = lvn_getVkCompareOpEnum(pipelineFixedFunctions->depthstencil.depthOpCompare);
-    depthStencil.depthBoundsTestEnable = VK_FALSE;
-    depthStencil.minDepthBounds = 0.0f;
-    depthStencil.maxDepthBounds = 1.0f;
-    depthStencil.stencilTestEnable = pipelineFixedFunctions->depthstencil.enableStencil;
-    depthStencil.back.compareMask = pipelineFixedFunctions->depthstencil.stencil.compareMask;
-    depthStencil.back.writeMask = pipelineFixedFunctions->depthstencil.stencil.writeMask;
-    depthStencil.back.reference = pipelineFixedFunctions->depthstencil.stencil.reference;
-    depthStencil.back.compareOp = lvn_getVkCompareOpEnum(pipelineFixedFunctions->depthstencil.stencil.compareOp);
-    depthStencil.back.depthFailOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.depthFailOp);
-    depthStencil.back.failOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.failOp);
-    depthStencil.back.passOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.passOp);
-    depthStencil.front = depthStencil.back;
+            build->colorBlendAttachments[i] = colorBlendAttachment;
+        }
+    }
+
+    VkPipelineColorBlendStateCreateInfo* colorBlending = &build->colorBlending;
+    colorBlending->sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending->logicOpEnable = pipelineFixedFunctions->colorBlend.logicOpEnable;
+    colorBlending->logicOp = VK_LOGIC_OP_COPY;
+    colorBlending->pAttachments = build->colorBlendAttachments;
+    colorBlending->attachmentCount = colorBlendAttachmentCount;
+    colorBlending->blendConstants[0] = pipelineFixedFunctions->colorBlend.blendConstants[0];
+    colorBlending->blendConstants[1] = pipelineFixedFunctions->colorBlend.blendConstants[1];
+    colorBlending->blendConstants[2] = pipelineFixedFunctions->colorBlend.blendConstants[2];
+    colorBlending->blendConstants[3] = pipelineFixedFunctions->colorBlend.blendConstants[3];
+
+    VkPipelineDepthStencilStateCreateInfo* depthStencil = &build->depthStencil;
+    depthStencil->sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil->depthTestEnable = pipelineFixedFunctions->depthstencil.enableDepth;
+    depthStencil->depthWriteEnable = pipelineFixedFunctions->depthstencil.enableDepth;
+    depthStencil->depthCompareOp = lvn_getVkCompareOpEnum(pipelineFixedFunctions->depthstencil.depthOpCompare);
+    depthStencil->depthBoundsTestEnable = VK_FALSE;
+    depthStencil->minDepthBounds = 0.0f;
+    depthStencil->maxDepthBounds = 1.0f;
+    depthStencil->stencilTestEnable = pipelineFixedFunctions->depthstencil.enableStencil;
+    depthStencil->back.compareMask = pipelineFixedFunctions->depthstencil.stencil.compareMask;
+    depthStencil->back.writeMask = pipelineFixedFunctions->depthstencil.stencil.writeMask;
+    depthStencil->back.reference = pipelineFixedFunctions->depthstencil.stencil.reference;
+    depthStencil->back.compareOp = lvn_getVkCompareOpEnum(pipelineFixedFunctions->depthstencil.stencil.compareOp);
+    depthStencil->back.depthFailOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.depthFailOp);
+    depthStencil->back.failOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.failOp);
+    depthStencil->back.passOp = lvn_getVkStencilOpEnum(pipelineFixedFunctions->depthstencil.stencil.passOp);
+    depthStencil->front = depthStencil->back;
+
+    // descriptor layouts
+    VkDescriptorSetLayout descriptorLayouts[createInfo->descriptorLayoutCount ? createInfo->descriptorLayoutCount : 1];
+    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
+    {
+        VkDescriptorSetLayout descriptorLayout = (VkDescriptorSetLayout) createInfo->pDescriptorLayouts[i]->descriptorLayout;
+        descriptorLayouts[i] = descriptorLayout;
+    }
+
+    // push constant ranges
+    VkPushConstantRange pushConstantRanges[createInfo->pushConstantRangeCount ? createInfo->pushConstantRangeCount : 1];
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        const LvnPushConstantRange* range = &createInfo->pPushConstantRanges[i];
+        if (range->offset + range->size > vkBackends->maxPushConstantsSize)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] push constant range (offset: %u, size: %u) exceeds the device limit of %u bytes",
+                          range->offset, range->size, vkBackends->maxPushConstantsSize);
+            lvn_free(build->arrays);
+            build->arrays = NULL;
+            return Lvn_Result_Failure;
+        }
+
+        pushConstantRanges[i].stageFlags = lvn_getVkShaderStageFlags(range->shaderStages);
+        pushConstantRanges[i].offset = range->offset;
+        pushConstantRanges[i].size = range->size;
+    }
 
     // pipeline layout
+    LvnVkPipelineLayoutSignature layoutSignature = {0};
+    layoutSignature.pSetLayouts = descriptorLayouts;
+    layoutSignature.setLayoutCount = createInfo->descriptorLayoutCount;
+    layoutSignature.pPushConstantRanges = pushConstantRanges;
+    layoutSignature.pushConstantRangeCount = createInfo->pushConstantRangeCount;
+
+    build->layoutEntry = lvn_acquirePipelineLayout(vkBackends, &layoutSignature);
+    if (!build->layoutEntry)
+    {
+        lvn_free(build->arrays);
+        build->arrays = NULL;
+        return Lvn_Result_Failure;
+    }
+
+    memset(pipelineInfo, 0, sizeof(VkGraphicsPipelineCreateInfo));
+    pipelineInfo->sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo->renderPass = renderPass;
+    pipelineInfo->stageCount = createInfo->stageCount;
+    pipelineInfo->pStages = build->shaderStages;
+    pipelineInfo->pVertexInputState = vertexInputInfo;
+    pipelineInfo->pInputAssemblyState = inputAssembly;
+    pipelineInfo->pViewportState = viewportState;
+    pipelineInfo->pRasterizationState = rasterizer;
+    pipelineInfo->pMultisampleState = multisampling;
+    pipelineInfo->pDepthStencilState = depthStencil;
+    pipelineInfo->pColorBlendState = colorBlending;
+    pipelineInfo->pDynamicState = dynamicState;
+    pipelineInfo->layout = build->layoutEntry->pipelineLayout;
+    pipelineInfo->subpass = 0;
+    pipelineInfo->basePipelineHandle = VK_NULL_HANDLE;
+    pipelineInfo->basePipelineIndex = -1;
+
+    if (vkBackends->ext.EXT_pipeline_creation_feedback)
+    {
+        build->feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+        build->feedbackInfo.pPipelineCreationFeedback = &build->feedback;
+        build->feedbackInfo.pipelineStageCreationFeedbackCount = createInfo->stageCount;
+        build->feedbackInfo.pPipelineStageCreationFeedbacks = build->stageFeedbacks;
+        pipelineInfo->pNext = &build->feedbackInfo;
+    }
+
+    // without a render pass object the pipeline only needs the formats it renders to
+    if (!renderPass)
+    {
+        build->colorAttachmentFormat = (VkFormat) createInfo->renderPass->colorFormat;
+
+        memset(&build->renderingInfo, 0, sizeof(VkPipelineRenderingCreateInfoKHR));
+        build->renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        build->renderingInfo.pNext = pipelineInfo->pNext;
+        build->renderingInfo.colorAttachmentCount = 1;
+        build->renderingInfo.pColorAttachmentFormats = &build->colorAttachmentFormat;
+        pipelineInfo->pNext = &build->renderingInfo;
+    }
+
+    return Lvn_Result_Success;
+}
+
+static bool lvn_pipelineLayoutMatch(const void* value, const void* userData)
+{
+    const LvnVkPipelineLayoutEntry* entry = (const LvnVkPipelineLayoutEntry*) value;
+    const LvnVkPipelineLayoutSignature* signature = (const LvnVkPipelineLayoutSignature*) userData;
+
+    return entry->setLayoutCount == signature->setLayoutCount &&
+           entry->pushConstantRangeCount == signature->pushConstantRangeCount &&
+           memcmp(entry->setLayouts, signature->pSetLayouts, signature->setLayoutCount * sizeof(VkDescriptorSetLayout)) == 0 &&
+           memcmp(entry->pPushConstantRanges, signature->pPushConstantRanges, signature->pushConstantRangeCount * sizeof(VkPushConstantRange)) == 0;
+}
+
+static LvnVkPipelineLayoutEntry* lvn_acquirePipelineLayout(const LvnVulkanBackends* vkBackends, const LvnVkPipelineLayoutSignature* signature)
+{
+    LvnVulkanBackends* mutBackends = (LvnVulkanBackends*) vkBackends;
+    uint64_t hash = lvnHash64(signature->pSetLayouts, signature->setLayoutCount * sizeof(VkDescriptorSetLayout), 0);
+    hash = lvnHash64(signature->pPushConstantRanges, signature->pushConstantRangeCount * sizeof(VkPushConstantRange), hash);
+
+    lvn_spinLock(&mutBackends->pipelineLayoutLock);
+    LvnVkPipelineLayoutEntry* entry = (LvnVkPipelineLayoutEntry*) lvn_hashTableFind(&vkBackends->pipelineLayoutTable, hash, lvn_pipelineLayoutMatch, signature);
+    if (entry)
+        entry->refCount++;
+    lvn_spinUnlock(&mutBackends->pipelineLayoutLock);
+
+    if (entry)
+        return entry;
+
+    // the layout is created outside the lock so workers building other pipelines are not held up by the driver
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = {0};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
-    pipelineLayoutInfo.pPushConstantRanges = NULL;
+    pipelineLayoutInfo.setLayoutCount = signature->setLayoutCount;
+    pipelineLayoutInfo.pSetLayouts = signature->setLayoutCount ? signature->pSetLayouts : NULL;
+    pipelineLayoutInfo.pushConstantRangeCount = signature->pushConstantRangeCount;
+    pipelineLayoutInfo.pPushConstantRanges = signature->pushConstantRangeCount ? signature->pPushConstantRanges : NULL;
 
-    if (createInfo->descriptorLayoutCount != 0)
+    VkPipelineLayout pipelineLayout;
+    if (vkBackends->createPipelineLayout(vkBackends->device, &pipelineLayoutInfo, NULL, &pipelineLayout) != VK_SUCCESS)
     {
-        pipelineLayoutInfo.setLayoutCount = createInfo->descriptorLayoutCount;
-        pipelineLayoutInfo.pSetLayouts = descriptorLayouts;
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to create pipeline layout");
+        return NULL;
     }
-    else
+
+    entry = (LvnVkPipelineLayoutEntry*) lvn_malloc(sizeof(LvnVkPipelineLayoutEntry) + signature->setLayoutCount * sizeof(VkDescriptorSetLayout) +
+                                                   signature->pushConstantRangeCount * sizeof(VkPushConstantRange));
+    if (!entry)
     {
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = NULL;
+        vkBackends->destroyPipelineLayout(vkBackends->device, pipelineLayout, NULL);
+        return NULL;
     }
 
-    if (vkBackends->createPipelineLayout(vkBackends->device, &pipelineLayoutInfo, NULL, &pipelineLayout) != VK_SUCCESS)
+    entry->pipelineLayout = pipelineLayout;
+    entry->hash = hash;
+    entry->refCount = 1;
+    entry->setLayoutCount = signature->setLayoutCount;
+    memcpy(entry->setLayouts, signature->pSetLayouts, signature->setLayoutCount * sizeof(VkDescriptorSetLayout));
+    entry->pushConstantRangeCount = signature->pushConstantRangeCount;
+    entry->pPushConstantRanges = (VkPushConstantRange*) (entry->setLayouts + signature->setLayoutCount);
+    memcpy(entry->pPushConstantRanges, signature->pPushConstantRanges, signature->pushConstantRangeCount * sizeof(VkPushConstantRange));
+
+    // another thread may have created the same layout meanwhile, keep theirs
+    lvn_spinLock(&mutBackends->pipelineLayoutLock);
+    LvnVkPipelineLayoutEntry* existing = (LvnVkPipelineLayoutEntry*) lvn_hashTableFind(&vkBackends->pipelineLayoutTable, hash, lvn_pipelineLayoutMatch, signature);
+    if (existing)
+        existing->refCount++;
+    else if (!lvn_hashTableInsert(&mutBackends->pipelineLayoutTable, hash, entry))
+        entry->hash = 0;
+    lvn_spinUnlock(&mutBackends->pipelineLayoutLock);
+
+    if (existing)
     {
-        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create pipeline layout for pipeline %p", pipeline);
-        goto fail_cleanup;
+        vkBackends->destroyPipelineLayout(vkBackends->device, pipelineLayout, NULL);
+        lvn_free(entry);
+        return existing;
     }
 
-    VkGraphicsPipelineCreateInfo pipelineInfo = {0};
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.renderPass = renderPass;
-    pipelineInfo.stageCount = createInfo->stageCount;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInputInfo;
-    pipelineInfo.pInputAssemblyState = &inputAssembly;
-    pipelineInfo.pViewportState = &viewportState;
-    pipelineInfo.pRasterizationState = &rasterizer;
-    pipelineInfo.pMultisampleState = &multisampling;
-    pipelineInfo.pDepthStencilState = &depthStencil;
-    pipelineInfo.pColorBlendState = &colorBlending;
-    pipelineInfo.pDynamicState = &dynamicState;
-    pipelineInfo.layout = pipelineLayout;
-    pipelineInfo.subpass = 0;
-    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-    pipelineInfo.basePipelineIndex = -1;
-
-    if (vkBackends->createGraphicsPipelines(vkBackends->device, VK_NULL_HANDLE, 1, &pipelineInfo, NULL, &vkPipeline) != VK_SUCCESS)
-    {
-        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create graphics pipeline for pipeline %p", pipeline);
-        goto fail_cleanup;
+    if (!entry->hash)
+    {
+        vkBackends->destroyPipelineLayout(vkBackends->device, pipelineLayout, NULL);
+        lvn_free(entry);
+        return NULL;
     }
 
-    pipelineData = lvn_calloc(sizeof(LvnVkPipelineData));
-    pipelineData->pipelineLayout = pipelineLayout;
-    pipelineData->pipeline = vkPipeline;
+    return entry;
+}
 
-    pipeline->pipeline = pipelineData;
+static void lvn_releasePipelineLayout(const LvnVulkanBackends* vkBackends, LvnVkPipelineLayoutEntry* entry)
+{
+    LvnVulkanBackends* mutBackends = (LvnVulkanBackends*) vkBackends;
 
-    return Lvn_Result_Success;
+    lvn_spinLock(&mutBackends->pipelineLayoutLock);
+    bool lastReference = --entry->refCount == 0;
+    if (lastReference)
+        lvn_hashTableRemove(&mutBackends->pipelineLayoutTable, entry->hash, entry);
+    lvn_spinUnlock(&mutBackends->pipelineLayoutLock);
 
-fail_cleanup:
-    vkBackends->destroyPipeline(vkBackends->device, vkPipeline, NULL);
-    vkBackends->destroyPipelineLayout(vkBackends->device, pipelineLayout, NULL);
-    lvn_free(pipelineData);
-    return Lvn_Result_Failure;
+    if (!lastReference)
+        return;
+
+    vkBackends->destroyPipelineLayout(vkBackends->device, entry->pipelineLayout, NULL);
+    lvn_free(entry);
+}
+
+static void lvn_buildPipelinesRange(uint32_t begin, uint32_t end, void* userData)
+{
+    LvnVkPipelineBatch* batch = (LvnVkPipelineBatch*) userData;
+
+    LVN_PROFILE_BEGIN("lvn_buildPipelinesRange");
+    for (uint32_t i = begin; i < end; i++)
+        batch->pResults[i] = lvn_createPipelineBuildData(batch->graphicsctx, &batch->pBuilds[i], &batch->pPipelineInfos[i], &batch->pCreateInfos[i]);
+    LVN_PROFILE_END();
+}
+
+static void lvn_compilePipelinesRange(uint32_t begin, uint32_t end, void* userData)
+{
+    LvnVkPipelineBatch* batch = (LvnVkPipelineBatch*) userData;
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) batch->graphicsctx->implData;
+
+    uint32_t hitCount = 0, missCount = 0;
+    uint64_t durationNs = 0;
+
+    // a range may contain pipelines whose translation failed, only hand the valid runs to the driver
+    LVN_PROFILE_BEGIN("vkCreateGraphicsPipelines");
+    uint32_t first = begin;
+    while (first < end)
+    {
+        if (batch->pResults[first] != Lvn_Result_Success)
+        {
+            first++;
+            continue;
+        }
+
+        uint32_t last = first;
+        while (last < end && batch->pResults[last] == Lvn_Result_Success)
+            last++;
+
+        VkResult result = vkBackends->createGraphicsPipelines(vkBackends->device, vkBackends->pipelineCache, last - first, &batch->pPipelineInfos[first], NULL, &batch->pVkPipelines[first]);
+        if (result != VK_SUCCESS)
+        {
+            // pipelines that failed are set to VK_NULL_HANDLE, the others were still created
+            for (uint32_t i = first; i < last; i++)
+            {
+                if (batch->pVkPipelines[i] == VK_NULL_HANDLE)
+                {
+                    LVN_LOG_ERROR(batch->graphicsctx->coreLogger, "[vulkan] failed to create graphics pipeline for pipeline %p", batch->pPipelines[i]);
+                    batch->pResults[i] = Lvn_Result_Failure;
+                }
+            }
+        }
+
+        if (vkBackends->ext.EXT_pipeline_creation_feedback)
+        {
+            for (uint32_t i = first; i < last; i++)
+            {
+                const VkPipelineCreationFeedbackEXT* feedback = &batch->pBuilds[i].feedback;
+                if (batch->pVkPipelines[i] == VK_NULL_HANDLE || !(feedback->flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT))
+                    continue;
+
+                if (feedback->flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT)
+                    hitCount++;
+                else
+                    missCount++;
+                durationNs += feedback->duration;
+            }
+        }
+
+        first = last;
+    }
+
+    LvnVulkanBackends* mutBackends = (LvnVulkanBackends*) vkBackends;
+    lvn_atomicFetchAdd32(&mutBackends->pipelineCacheHitCount, hitCount);
+    lvn_atomicFetchAdd32(&mutBackends->pipelineCacheMissCount, missCount);
+    lvn_atomicFetchAdd32(&batch->hitCount, hitCount);
+    lvn_atomicFetchAdd32(&batch->missCount, missCount);
+    lvn_atomicFetchAdd64(&mutBackends->pipelineCreationTimeNs, (int64_t) durationNs);
+    LVN_PROFILE_END();
+}
+
+LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo)
+{
+    return lvnImplVkCreatePipelines(graphicsctx, &pipeline, createInfo, 1);
+}
+
+LvnResult lvnImplVkCreatePipelines(const LvnGraphicsContext* graphicsctx, LvnPipeline** pPipelines, const LvnPipelineCreateInfo* pCreateInfos, uint32_t count)
+{
+    LVN_PROFILE_BEGIN("lvnImplVkCreatePipelines");
+
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+    LvnResult result = Lvn_Result_Success;
+
+    LvnVkPipelineBatch batch = {0};
+    batch.graphicsctx = graphicsctx;
+    batch.pPipelines = pPipelines;
+    batch.pCreateInfos = pCreateInfos;
+    batch.pBuilds = (LvnVkPipelineBuildData*) lvn_calloc(count * sizeof(LvnVkPipelineBuildData));
+    batch.pPipelineInfos = (VkGraphicsPipelineCreateInfo*) lvn_calloc(count * sizeof(VkGraphicsPipelineCreateInfo));
+    batch.pVkPipelines = (VkPipeline*) lvn_calloc(count * sizeof(VkPipeline));
+    batch.pResults = (LvnResult*) lvn_calloc(count * sizeof(LvnResult));
+
+    if (!batch.pBuilds || !batch.pPipelineInfos || !batch.pVkPipelines || !batch.pResults)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for %u pipelines", count);
+        result = Lvn_Result_Failure;
+        goto cleanup;
+    }
+
+    // translating is cheap next to compiling, but layouts are created here too so it is split up the same way.
+    // drivers compile the pipelines of one vkCreateGraphicsPipelines call in order on the calling thread,
+    // spreading the ranges over the job workers is what lets several pipelines compile at the same time
+    if (vkBackends->enableParallelPipelineCreation && count > 1)
+    {
+        LvnContext* ctx = (LvnContext*) graphicsctx->ctx;
+        lvnJobParallelFor(ctx, count, 0, lvn_buildPipelinesRange, &batch);
+        lvnJobParallelFor(ctx, count, 0, lvn_compilePipelinesRange, &batch);
+    }
+    else
+    {
+        lvn_buildPipelinesRange(0, count, &batch);
+        lvn_compilePipelinesRange(0, count, &batch);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (batch.pResults[i] != Lvn_Result_Success)
+        {
+            result = Lvn_Result_Failure;
+            break;
+        }
+    }
+
+    if (vkBackends->ext.EXT_pipeline_creation_feedback)
+        LVN_LOG_TRACE(graphicsctx->coreLogger, "[vulkan] created %u pipelines, pipeline cache hits: %u, misses: %u", count, batch.hitCount, batch.missCount);
+
+    if (result == Lvn_Result_Success)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            LvnVkPipelineData* pipelineData = (LvnVkPipelineData*) lvn_calloc(sizeof(LvnVkPipelineData));
+            if (!pipelineData)
+            {
+                result = Lvn_Result_Failure;
+                break;
+            }
+
+            pipelineData->pipelineLayout = batch.pBuilds[i].layoutEntry->pipelineLayout;
+            pipelineData->layoutEntry = batch.pBuilds[i].layoutEntry;
+            pipelineData->pipeline = batch.pVkPipelines[i];
+            pPipelines[i]->pipeline = pipelineData;
+        }
+    }
+
+    // the batch is all or nothing, a partly created set would leave the caller with holes to track
+    if (result != Lvn_Result_Success)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            lvn_free(pPipelines[i]->pipeline);
+            pPipelines[i]->pipeline = NULL;
+            vkBackends->destroyPipeline(vkBackends->device, batch.pVkPipelines[i], NULL);
+            if (batch.pBuilds[i].layoutEntry)
+                lvn_releasePipelineLayout(vkBackends, batch.pBuilds[i].layoutEntry);
+        }
+    }
+
+cleanup:
+    if (batch.pBuilds)
+    {
+        for (uint32_t i = 0; i < count; i++)
+            lvn_free(batch.pBuilds[i].arrays);
+    }
+    lvn_free(batch.pBuilds);
+    lvn_free(batch.pPipelineInfos);
+    lvn_free(batch.pVkPipelines);
+    lvn_free(batch.pResults);
+    LVN_PROFILE_END();
+    return result;
 }
 
 void lvnImplVkDestroyPipeline(LvnPipeline* pipeline)
@@ -1669,6 +2715,1161 @@ void lvnImplVkDestroyPipeline(LvnPipeline* pipeline)
     LvnVkPipelineData* pipelineData = (LvnVkPipelineData*) pipeline->pipeline;
 
     vkBackends->destroyPipeline(vkBackends->device, pipelineData->pipeline, NULL);
-    vkBackends->destroyPipelineLayout(vkBackends->device, pipelineData->pipelineLayout, NULL);
+    lvn_releasePipelineLayout(vkBackends, pipelineData->layoutEntry);
     lvn_free(pipelineData);
 }
+
+LvnResult lvnImplVkCreateBuffer(const LvnGraphicsContext* graphicsctx, LvnBuffer* buffer, const LvnBufferCreateInfo* createInfo)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+
+    VkBuffer vkBuffer = VK_NULL_HANDLE;
+    LvnVkAllocation* allocation = (LvnVkAllocation*) lvn_calloc(sizeof(LvnVkAllocation));
+    if (!allocation)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for buffer %p", buffer);
+        return Lvn_Result_Failure;
+    }
+
+    VkBufferCreateInfo bufferInfo = {0};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = createInfo->size;
+    bufferInfo.usage = lvn_getVkBufferUsageFlags(createInfo->usage);
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    // gpu only buffers are written by staging copies on the transfer queue, sharing them with the graphics family avoids
+    // ownership transfers, which would leave the bytes a partial write does not cover undefined
+    uint32_t queueFamilyIndices[] = { vkBackends->graphicsQueueFamilyIndex, vkBackends->transferQueueFamilyIndex };
+    if (createInfo->memoryAccess == Lvn_MemoryAccess_GpuOnly && queueFamilyIndices[0] != queueFamilyIndices[1])
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = LVN_ARRAY_LEN(queueFamilyIndices);
+        bufferInfo.pQueueFamilyIndices = queueFamilyIndices;
+    }
+
+    if (vkBackends->createBuffer(vkBackends->device, &bufferInfo, NULL, &vkBuffer) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create buffer %p", buffer);
+        goto fail_cleanup;
+    }
+
+    LvnVkAllocationCreateInfo allocInfo = {0};
+    vkBackends->getBufferMemoryRequirements(vkBackends->device, vkBuffer, &allocInfo.requirements);
+    allocInfo.type = LvnVk_AllocationType_Linear;
+
+    switch (createInfo->memoryAccess)
+    {
+        case Lvn_MemoryAccess_GpuOnly:
+        {
+            allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        }
+        case Lvn_MemoryAccess_Upload:
+        {
+            allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            break;
+        }
+        case Lvn_MemoryAccess_Readback:
+        {
+            // cached memory makes cpu reads fast, it is usually not coherent so reads need lvnBufferInvalidate
+            allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            break;
+        }
+    }
+
+    if (lvn_vkAllocateMemory(vkBackends, &allocInfo, allocation) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for buffer %p", buffer);
+        goto fail_cleanup;
+    }
+
+    if (vkBackends->bindBufferMemory(vkBackends->device, vkBuffer, allocation->memory, allocation->offset) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to bind memory to buffer %p", buffer);
+        goto fail_cleanup;
+    }
+
+    // storage buffers get a slot in the bindless set for their whole lifetime
+    if (vkBackends->bindless && (createInfo->usage & Lvn_BufferUsageFlag_Storage))
+    {
+        buffer->bindlessIndex = lvn_vkBindlessAddBuffer(vkBackends, vkBuffer);
+        if (buffer->bindlessIndex == LVN_BINDLESS_INVALID_INDEX)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create buffer %p, the bindless storage buffer array is full", buffer);
+            goto fail_cleanup;
+        }
+    }
+
+    buffer->buffer = vkBuffer;
+    buffer->bufferMemory = allocation;
+    buffer->pMapped = createInfo->memoryAccess != Lvn_MemoryAccess_GpuOnly ? allocation->pMapped : NULL;
+
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    lvn_vkFreeMemory(vkBackends, allocation);
+    lvn_free(allocation);
+    if (vkBuffer)
+        vkBackends->destroyBuffer(vkBackends->device, vkBuffer, NULL);
+    return Lvn_Result_Failure;
+}
+
+void lvnImplVkDestroyBuffer(LvnBuffer* buffer)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) buffer->graphicsctx->implData;
+    LvnVkAllocation* allocation = (LvnVkAllocation*) buffer->bufferMemory;
+
+    if (buffer->bindlessIndex != LVN_BINDLESS_INVALID_INDEX)
+        lvn_vkBindlessRemove(vkBackends, LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS, buffer->bindlessIndex);
+
+    vkBackends->destroyBuffer(vkBackends->device, (VkBuffer) buffer->buffer, NULL);
+    lvn_vkFreeMemory(vkBackends, allocation);
+    lvn_free(allocation);
+}
+
+LvnResult lvnImplVkFlushBuffer(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) buffer->graphicsctx->implData;
+    return lvn_vkFlushMemory(vkBackends, (const LvnVkAllocation*) buffer->bufferMemory, offset, size);
+}
+
+LvnResult lvnImplVkInvalidateBuffer(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) buffer->graphicsctx->implData;
+    return lvn_vkInvalidateMemory(vkBackends, (const LvnVkAllocation*) buffer->bufferMemory, offset, size);
+}
+
+LvnResult lvnImplVkUploadBuffer(LvnBuffer* buffer, const void* data, uint64_t size, uint64_t offset)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) buffer->graphicsctx->implData;
+    return lvn_vkStagingWriteBuffer(vkBackends, (VkBuffer) buffer->buffer, data, size, offset);
+}
+
+LvnResult lvnImplVkCreateDescriptorLayout(const LvnGraphicsContext* graphicsctx, LvnDescriptorLayout* descriptorLayout)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+    uint32_t bindingCount = descriptorLayout->bindingCount;
+
+    VkDescriptorSetLayoutBinding layoutBindings[bindingCount ? bindingCount : 1];
+    VkDescriptorUpdateTemplateEntry templateEntries[bindingCount ? bindingCount : 1];
+    uint32_t descriptorIndex = 0;
+
+    // the template reads one VkDescriptorBufferInfo per descriptor, packed in binding order like the infos given to lvnUpdateDescriptorSet
+    for (uint32_t i = 0; i < bindingCount; i++)
+    {
+        const LvnDescriptorBinding* binding = &descriptorLayout->pBindings[i];
+
+        layoutBindings[i] = (VkDescriptorSetLayoutBinding) {0};
+        layoutBindings[i].binding = binding->binding;
+        layoutBindings[i].descriptorType = lvn_getVkDescriptorTypeEnum(binding->descriptorType);
+        layoutBindings[i].descriptorCount = binding->descriptorCount;
+        layoutBindings[i].stageFlags = lvn_getVkShaderStageFlags(binding->shaderStages);
+
+        templateEntries[i] = (VkDescriptorUpdateTemplateEntry) {0};
+        templateEntries[i].dstBinding = binding->binding;
+        templateEntries[i].dstArrayElement = 0;
+        templateEntries[i].descriptorCount = binding->descriptorCount;
+        templateEntries[i].descriptorType = layoutBindings[i].descriptorType;
+        templateEntries[i].offset = descriptorIndex * sizeof(VkDescriptorBufferInfo);
+        templateEntries[i].stride = sizeof(VkDescriptorBufferInfo);
+
+        descriptorIndex += binding->descriptorCount;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {0};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = bindingCount;
+    layoutInfo.pBindings = bindingCount ? layoutBindings : NULL;
+
+    VkDescriptorSetLayout setLayout;
+    if (vkBackends->createDescriptorSetLayout(vkBackends->device, &layoutInfo, NULL, &setLayout) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create descriptor set layout");
+        return Lvn_Result_Failure;
+    }
+
+    VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+    if (bindingCount)
+    {
+        VkDescriptorUpdateTemplateCreateInfo templateInfo = {0};
+        templateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        templateInfo.descriptorUpdateEntryCount = bindingCount;
+        templateInfo.pDescriptorUpdateEntries = templateEntries;
+        templateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        templateInfo.descriptorSetLayout = setLayout;
+
+        if (vkBackends->createDescriptorUpdateTemplate(vkBackends->device, &templateInfo, NULL, &updateTemplate) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create descriptor update template");
+            vkBackends->destroyDescriptorSetLayout(vkBackends->device, setLayout, NULL);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    descriptorLayout->descriptorLayout = setLayout;
+    descriptorLayout->updateTemplate = updateTemplate;
+    return Lvn_Result_Success;
+}
+
+void lvnImplVkDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) descriptorLayout->graphicsctx->implData;
+
+    if (descriptorLayout->updateTemplate)
+        vkBackends->destroyDescriptorUpdateTemplate(vkBackends->device, (VkDescriptorUpdateTemplate) descriptorLayout->updateTemplate, NULL);
+    vkBackends->destroyDescriptorSetLayout(vkBackends->device, (VkDescriptorSetLayout) descriptorLayout->descriptorLayout, NULL);
+}
+
+void lvnImplVkWaitIdle(const LvnGraphicsContext* graphicsctx)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+    vkBackends->deviceWaitIdle(vkBackends->device);
+}
+
+static bool lvn_validatePipelineCacheData(const LvnVulkanBackends* vkBackends, const uint8_t* data, size_t size)
+{
+    LvnLogger* logger = vkBackends->graphicsctx->coreLogger;
+
+    LvnVkPipelineCacheFileHeader header;
+    if (size < sizeof(header))
+    {
+        LVN_LOG_WARN(logger, "[vulkan] pipeline cache data is too small (%zu bytes) to contain a header", size);
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != LVN_VK_PIPELINE_CACHE_MAGIC || header.version != LVN_VK_PIPELINE_CACHE_VERSION)
+    {
+        LVN_LOG_WARN(logger, "[vulkan] pipeline cache data has an unknown format or version (%u)", header.version);
+        return false;
+    }
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkBackends->getPhysicalDeviceProperties(vkBackends->physicalDevice, &deviceProperties);
+
+    // the driver would reject a foreign blob too, but only after parsing it and without saying why
+    if (header.vendorID != deviceProperties.vendorID ||
+        header.deviceID != deviceProperties.deviceID ||
+        header.driverVersion != deviceProperties.driverVersion ||
+        memcmp(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        LVN_LOG_WARN(logger, "[vulkan] pipeline cache data was written by a different device or driver (vendor: %u, device: %u, driverVersion: %u)",
+                     header.vendorID, header.deviceID, header.driverVersion);
+        return false;
+    }
+
+    const uint8_t* blob = data + sizeof(header);
+    size_t blobSize = size - sizeof(header);
+
+    if (header.dataSize != blobSize || lvnHash64(blob, blobSize, 0) != header.dataHash)
+    {
+        LVN_LOG_WARN(logger, "[vulkan] pipeline cache data is truncated or corrupted");
+        return false;
+    }
+
+    VkPipelineCacheHeaderVersionOne blobHeader;
+    if (blobSize < sizeof(blobHeader))
+        return false;
+
+    memcpy(&blobHeader, blob, sizeof(blobHeader));
+    return blobHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           blobHeader.vendorID == deviceProperties.vendorID &&
+           blobHeader.deviceID == deviceProperties.deviceID &&
+           memcmp(blobHeader.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+LvnResult lvnImplVkLoadPipelineCache(const LvnGraphicsContext* graphicsctx, const uint8_t* data, size_t size)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+
+    if (!vkBackends->pipelineCache || !lvn_validatePipelineCacheData(vkBackends, data, size))
+        return Lvn_Result_Failure;
+
+    // the loaded entries are merged instead of replacing the cache so pipelines created before the load stay cached
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {0};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = size - sizeof(LvnVkPipelineCacheFileHeader);
+    pipelineCacheCreateInfo.pInitialData = data + sizeof(LvnVkPipelineCacheFileHeader);
+
+    VkPipelineCache loadedCache;
+    if (vkBackends->createPipelineCache(vkBackends->device, &pipelineCacheCreateInfo, NULL, &loadedCache) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create pipeline cache from loaded data");
+        return Lvn_Result_Failure;
+    }
+
+    VkResult result = vkBackends->mergePipelineCaches(vkBackends->device, vkBackends->pipelineCache, 1, &loadedCache);
+    vkBackends->destroyPipelineCache(vkBackends->device, loadedCache, NULL);
+
+    if (result != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to merge loaded pipeline cache");
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnImplVkGetPipelineCacheData(const LvnGraphicsContext* graphicsctx, uint8_t** data, size_t* size)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+
+    if (!vkBackends->pipelineCache)
+        return Lvn_Result_Failure;
+
+    // pipelines created on other threads can grow the cache between the two calls, retry with the new size
+    uint8_t* buffer = NULL;
+    size_t blobSize = 0;
+    VkResult result;
+    do
+    {
+        if (vkBackends->getPipelineCacheData(vkBackends->device, vkBackends->pipelineCache, &blobSize, NULL) != VK_SUCCESS)
+            goto fail_cleanup;
+
+        uint8_t* newBuffer = (uint8_t*) lvn_realloc(buffer, sizeof(LvnVkPipelineCacheFileHeader) + blobSize);
+        if (!newBuffer)
+            goto fail_cleanup;
+
+        buffer = newBuffer;
+        result = vkBackends->getPipelineCacheData(vkBackends->device, vkBackends->pipelineCache, &blobSize, buffer + sizeof(LvnVkPipelineCacheFileHeader));
+    } while (result == VK_INCOMPLETE);
+
+    if (result != VK_SUCCESS)
+        goto fail_cleanup;
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkBackends->getPhysicalDeviceProperties(vkBackends->physicalDevice, &deviceProperties);
+
+    LvnVkPipelineCacheFileHeader header = {0};
+    header.magic = LVN_VK_PIPELINE_CACHE_MAGIC;
+    header.version = LVN_VK_PIPELINE_CACHE_VERSION;
+    header.vendorID = deviceProperties.vendorID;
+    header.deviceID = deviceProperties.deviceID;
+    header.driverVersion = deviceProperties.driverVersion;
+    memcpy(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = blobSize;
+    header.dataHash = lvnHash64(buffer + sizeof(header), blobSize, 0);
+    memcpy(buffer, &header, sizeof(header));
+
+    *data = buffer;
+    *size = sizeof(header) + blobSize;
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to get pipeline cache data");
+    lvn_free(buffer);
+    return Lvn_Result_Failure;
+}
+
+LvnPipelineCacheStats lvnImplVkGetPipelineCacheStats(const LvnGraphicsContext* graphicsctx)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+
+    LvnPipelineCacheStats stats = {0};
+    stats.feedbackSupported = vkBackends->ext.EXT_pipeline_creation_feedback;
+    stats.hitCount = lvn_atomicLoad32(&vkBackends->pipelineCacheHitCount);
+    stats.missCount = lvn_atomicLoad32(&vkBackends->pipelineCacheMissCount);
+    stats.creationTimeNs = (uint64_t) lvn_atomicLoad64(&vkBackends->pipelineCreationTimeNs);
+    return stats;
+}
+
+static LvnVkThreadCommandPools* lvn_getThreadCommandPools(const LvnVulkanBackends* vkBackends)
+{
+    LvnVulkanBackends* mutBackends = (LvnVulkanBackends*) vkBackends;
+    uint64_t threadId = lvn_platformGetThreadId();
+
+    lvn_spinLock(&mutBackends->threadCommandPoolLock);
+    LvnVkThreadCommandPools* threadPools = (LvnVkThreadCommandPools*) lvn_hashTableFind(&vkBackends->threadCommandPoolTable, threadId, NULL, NULL);
+    lvn_spinUnlock(&mutBackends->threadCommandPoolLock);
+
+    if (threadPools)
+        return threadPools;
+
+    threadPools = (LvnVkThreadCommandPools*) lvn_calloc(sizeof(LvnVkThreadCommandPools));
+    if (!threadPools)
+        return NULL;
+
+    threadPools->threadId = threadId;
+
+    // buffers are never reset one by one, the whole pool is reset when its frame slot comes around again
+    VkCommandPoolCreateInfo poolInfo = {0};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = vkBackends->graphicsQueueFamilyIndex;
+
+    for (uint32_t i = 0; i < vkBackends->graphicsctx->framesInFlight; i++)
+    {
+        if (vkBackends->createCommandPool(vkBackends->device, &poolInfo, NULL, &threadPools->frames[i].commandPool) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to create command pool for thread %llu", (unsigned long long) threadId);
+            lvn_destroyThreadCommandPools(vkBackends, threadPools);
+            return NULL;
+        }
+    }
+
+    lvn_spinLock(&mutBackends->threadCommandPoolLock);
+    bool inserted = lvn_hashTableInsert(&mutBackends->threadCommandPoolTable, threadId, threadPools);
+    lvn_spinUnlock(&mutBackends->threadCommandPoolLock);
+
+    if (!inserted)
+    {
+        lvn_destroyThreadCommandPools(vkBackends, threadPools);
+        return NULL;
+    }
+
+    return threadPools;
+}
+
+static void lvn_destroyThreadCommandPools(const LvnVulkanBackends* vkBackends, LvnVkThreadCommandPools* threadPools)
+{
+    for (uint32_t i = 0; i < LVN_MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        LvnVkFrameCommandPool* framePool = &threadPools->frames[i];
+
+        // destroying the pool frees its command buffers
+        if (framePool->commandPool)
+            vkBackends->destroyCommandPool(vkBackends->device, framePool->commandPool, NULL);
+
+        for (uint32_t level = 0; level < 2; level++)
+        {
+            for (uint32_t j = 0; j < framePool->commandBufferCounts[level]; j++)
+                lvn_free(framePool->pCommandBuffers[level][j]);
+            lvn_free(framePool->pCommandBuffers[level]);
+        }
+
+        // destroying the pools frees their descriptor sets
+        LvnVkFrameDescriptorPools* descriptorPools = &threadPools->descriptorFrames[i];
+        for (uint32_t j = 0; j < descriptorPools->poolCount; j++)
+            vkBackends->destroyDescriptorPool(vkBackends->device, descriptorPools->pPools[j], NULL);
+        for (uint32_t j = 0; j < descriptorPools->descriptorSetCount; j++)
+            lvn_free(descriptorPools->pDescriptorSets[j]);
+        lvn_free(descriptorPools->pPools);
+        lvn_free(descriptorPools->pDescriptorSets);
+    }
+
+    lvn_free(threadPools);
+}
+
+LvnResult lvnImplVkBeginFrame(LvnGraphicsContext* graphicsctx)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+    LvnVkFrameSync* frameSync = &vkBackends->frameSync[graphicsctx->frameIndex];
+
+    LVN_PROFILE_BEGIN("lvnImplVkBeginFrame");
+
+    lvn_spinLock(&vkBackends->queueLock);
+    uint32_t usedFenceCount = frameSync->usedFenceCount;
+    frameSync->usedFenceCount = 0;
+    lvn_spinUnlock(&vkBackends->queueLock);
+
+    if (usedFenceCount)
+    {
+        if (vkBackends->waitForFences(vkBackends->device, usedFenceCount, frameSync->pFences, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to wait for the submissions of frame slot %u", graphicsctx->frameIndex);
+            LVN_PROFILE_END();
+            return Lvn_Result_Failure;
+        }
+        vkBackends->resetFences(vkBackends->device, usedFenceCount, frameSync->pFences);
+    }
+
+    // every command buffer and descriptor set of the slot goes back to its pool in one call per pool
+    lvn_spinLock(&vkBackends->threadCommandPoolLock);
+    for (uint32_t i = 0; i < vkBackends->threadCommandPoolTable.capacity; i++)
+    {
+        LvnVkThreadCommandPools* threadPools = (LvnVkThreadCommandPools*) vkBackends->threadCommandPoolTable.pEntries[i].value;
+        if (!threadPools)
+            continue;
+
+        LvnVkFrameCommandPool* framePool = &threadPools->frames[graphicsctx->frameIndex];
+        if (framePool->usedCounts[0] || framePool->usedCounts[1])
+        {
+            vkBackends->resetCommandPool(vkBackends->device, framePool->commandPool, 0);
+            framePool->usedCounts[0] = 0;
+            framePool->usedCounts[1] = 0;
+        }
+
+        LvnVkFrameDescriptorPools* descriptorPools = &threadPools->descriptorFrames[graphicsctx->frameIndex];
+        for (uint32_t j = 0; j < descriptorPools->poolCount && j <= descriptorPools->poolIndex; j++)
+            vkBackends->resetDescriptorPool(vkBackends->device, descriptorPools->pPools[j], 0);
+        descriptorPools->poolIndex = 0;
+        descriptorPools->poolSetCount = 0;
+        descriptorPools->usedCount = 0;
+    }
+    lvn_spinUnlock(&vkBackends->threadCommandPoolLock);
+
+    LVN_PROFILE_END();
+    return Lvn_Result_Success;
+}
+
+LvnCommandBuffer* lvnImplVkAllocateCommandBuffer(const LvnGraphicsContext* graphicsctx, LvnCommandBufferLevel level)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+
+    // only the calling thread touches its pools, no locking past the lookup
+    LvnVkThreadCommandPools* threadPools = lvn_getThreadCommandPools(vkBackends);
+    if (!threadPools)
+        return NULL;
+
+    LvnVkFrameCommandPool* framePool = &threadPools->frames[graphicsctx->frameIndex];
+    if (framePool->usedCounts[level] < framePool->commandBufferCounts[level])
+        return framePool->pCommandBuffers[level][framePool->usedCounts[level]++];
+
+    LvnCommandBuffer* commandBuffer = (LvnCommandBuffer*) lvn_calloc(sizeof(LvnCommandBuffer));
+    LvnCommandBuffer** pCommandBuffers = (LvnCommandBuffer**) lvn_realloc(framePool->pCommandBuffers[level], (framePool->commandBufferCounts[level] + 1) * sizeof(LvnCommandBuffer*));
+    if (!commandBuffer || !pCommandBuffers)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for command buffer");
+        lvn_free(commandBuffer);
+        if (pCommandBuffers)
+            framePool->pCommandBuffers[level] = pCommandBuffers;
+        return NULL;
+    }
+    framePool->pCommandBuffers[level] = pCommandBuffers;
+
+    VkCommandBufferAllocateInfo allocInfo = {0};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = framePool->commandPool;
+    allocInfo.level = level == Lvn_CommandBufferLevel_Secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer vkCommandBuffer;
+    if (vkBackends->allocateCommandBuffers(vkBackends->device, &allocInfo, &vkCommandBuffer) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate command buffer");
+        lvn_free(commandBuffer);
+        return NULL;
+    }
+
+    commandBuffer->graphicsctx = graphicsctx;
+    commandBuffer->commandBuffer = vkCommandBuffer;
+    commandBuffer->level = level;
+
+    framePool->pCommandBuffers[level][framePool->commandBufferCounts[level]++] = commandBuffer;
+    framePool->usedCounts[level]++;
+    return commandBuffer;
+}
+
+LvnResult lvnImplVkBeginCommandBuffer(LvnCommandBuffer* commandBuffer, const LvnRenderPass* renderPass)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {0};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo = {0};
+    inheritanceRenderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+
+    VkCommandBufferBeginInfo beginInfo = {0};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (commandBuffer->level == Lvn_CommandBufferLevel_Secondary)
+    {
+        // the framebuffer is left unknown so secondaries can be recorded before the frame's image is acquired
+        if (renderPass)
+        {
+            inheritanceInfo.renderPass = (VkRenderPass) renderPass->renderPassHandle;
+            inheritanceInfo.subpass = 0;
+            beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+
+            // dynamic rendering inherits the attachment formats instead of a render pass
+            if (!renderPass->renderPassHandle)
+            {
+                colorFormat = (VkFormat) renderPass->colorFormat;
+                inheritanceRenderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR;
+                inheritanceRenderingInfo.colorAttachmentCount = 1;
+                inheritanceRenderingInfo.pColorAttachmentFormats = &colorFormat;
+                inheritanceRenderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+                inheritanceInfo.pNext = &inheritanceRenderingInfo;
+            }
+        }
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+    }
+
+    if (vkBackends->beginCommandBuffer((VkCommandBuffer) commandBuffer->commandBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(commandBuffer->graphicsctx->coreLogger, "[vulkan] failed to begin recording command buffer %p", commandBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnImplVkEndCommandBuffer(LvnCommandBuffer* commandBuffer)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    if (vkBackends->endCommandBuffer((VkCommandBuffer) commandBuffer->commandBuffer) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(commandBuffer->graphicsctx->coreLogger, "[vulkan] failed to record command buffer %p", commandBuffer);
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnImplVkSubmitCommandBuffers(const LvnGraphicsContext* graphicsctx, LvnCommandBuffer* const* pCommandBuffers, uint32_t count)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+    return lvn_submitCommandBuffers(vkBackends, pCommandBuffers, count, VK_NULL_HANDLE, VK_NULL_HANDLE);
+}
+
+static VkDescriptorSet lvn_allocateFrameDescriptorSet(const LvnVulkanBackends* vkBackends, LvnVkFrameDescriptorPools* descriptorPools, VkDescriptorSetLayout setLayout)
+{
+    // every pool can hold any layout made of buffer descriptors, a full pool moves allocation on to the next one
+    static const VkDescriptorPoolSize poolSizes[] =
+    {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, LVN_VK_DESCRIPTOR_POOL_SET_COUNT * 2 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, LVN_VK_DESCRIPTOR_POOL_SET_COUNT * 2 },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, LVN_VK_DESCRIPTOR_POOL_SET_COUNT },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, LVN_VK_DESCRIPTOR_POOL_SET_COUNT },
+    };
+
+    VkDescriptorSetAllocateInfo allocInfo = {0};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout;
+
+    for (;;)
+    {
+        if (descriptorPools->poolIndex == descriptorPools->poolCount)
+        {
+            VkDescriptorPool* pPools = (VkDescriptorPool*) lvn_realloc(descriptorPools->pPools, (descriptorPools->poolCount + 1) * sizeof(VkDescriptorPool));
+            if (!pPools)
+                return VK_NULL_HANDLE;
+            descriptorPools->pPools = pPools;
+
+            VkDescriptorPoolCreateInfo poolInfo = {0};
+            poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.maxSets = LVN_VK_DESCRIPTOR_POOL_SET_COUNT;
+            poolInfo.poolSizeCount = LVN_ARRAY_LEN(poolSizes);
+            poolInfo.pPoolSizes = poolSizes;
+
+            if (vkBackends->createDescriptorPool(vkBackends->device, &poolInfo, NULL, &pPools[descriptorPools->poolCount]) != VK_SUCCESS)
+            {
+                LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to create descriptor pool");
+                return VK_NULL_HANDLE;
+            }
+            descriptorPools->poolCount++;
+        }
+
+        VkDescriptorSet descriptorSet;
+        allocInfo.descriptorPool = descriptorPools->pPools[descriptorPools->poolIndex];
+        VkResult result = vkBackends->allocateDescriptorSets(vkBackends->device, &allocInfo, &descriptorSet);
+
+        if (result == VK_SUCCESS)
+        {
+            descriptorPools->poolSetCount++;
+            return descriptorSet;
+        }
+
+        // a layout that does not fit into an empty pool never will
+        if ((result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) || !descriptorPools->poolSetCount)
+        {
+            LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to allocate descriptor set");
+            return VK_NULL_HANDLE;
+        }
+
+        descriptorPools->poolIndex++;
+        descriptorPools->poolSetCount = 0;
+    }
+}
+
+LvnDescriptorSet* lvnImplVkAllocateDescriptorSet(const LvnGraphicsContext* graphicsctx, const LvnDescriptorLayout* descriptorLayout)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+
+    // only the calling thread touches its pools, no locking past the lookup
+    LvnVkThreadCommandPools* threadPools = lvn_getThreadCommandPools(vkBackends);
+    if (!threadPools)
+        return NULL;
+
+    LvnVkFrameDescriptorPools* descriptorPools = &threadPools->descriptorFrames[graphicsctx->frameIndex];
+
+    VkDescriptorSet vkDescriptorSet = lvn_allocateFrameDescriptorSet(vkBackends, descriptorPools, (VkDescriptorSetLayout) descriptorLayout->descriptorLayout);
+    if (vkDescriptorSet == VK_NULL_HANDLE)
+        return NULL;
+
+    LvnDescriptorSet* descriptorSet = NULL;
+    if (descriptorPools->usedCount < descriptorPools->descriptorSetCount)
+    {
+        descriptorSet = descriptorPools->pDescriptorSets[descriptorPools->usedCount];
+    }
+    else
+    {
+        descriptorSet = (LvnDescriptorSet*) lvn_calloc(sizeof(LvnDescriptorSet));
+        LvnDescriptorSet** pDescriptorSets = (LvnDescriptorSet**) lvn_realloc(descriptorPools->pDescriptorSets, (descriptorPools->descriptorSetCount + 1) * sizeof(LvnDescriptorSet*));
+        if (pDescriptorSets)
+            descriptorPools->pDescriptorSets = pDescriptorSets;
+
+        // the vulkan set goes back to its pool with the next reset
+        if (!descriptorSet || !pDescriptorSets)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to allocate memory for descriptor set");
+            lvn_free(descriptorSet);
+            return NULL;
+        }
+
+        descriptorPools->pDescriptorSets[descriptorPools->descriptorSetCount++] = descriptorSet;
+    }
+
+    descriptorPools->usedCount++;
+    descriptorSet->graphicsctx = graphicsctx;
+    descriptorSet->descriptorLayout = descriptorLayout;
+    descriptorSet->descriptorSet = vkDescriptorSet;
+    return descriptorSet;
+}
+
+void lvnImplVkUpdateDescriptorSet(LvnDescriptorSet* descriptorSet, const LvnDescriptorBufferInfo* pBufferInfos)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) descriptorSet->graphicsctx->implData;
+    const LvnDescriptorLayout* descriptorLayout = descriptorSet->descriptorLayout;
+    uint32_t count = descriptorLayout->descriptorCount;
+
+    VkDescriptorBufferInfo stackInfos[64];
+    VkDescriptorBufferInfo* bufferInfos = count <= LVN_ARRAY_LEN(stackInfos) ? stackInfos : (VkDescriptorBufferInfo*) lvn_malloc(count * sizeof(VkDescriptorBufferInfo));
+    if (!bufferInfos)
+    {
+        LVN_LOG_ERROR(descriptorSet->graphicsctx->coreLogger, "[vulkan] failed to allocate memory for descriptor set update");
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        bufferInfos[i].buffer = (VkBuffer) pBufferInfos[i].buffer->buffer;
+        bufferInfos[i].offset = pBufferInfos[i].offset;
+        bufferInfos[i].range = pBufferInfos[i].range ? pBufferInfos[i].range : pBufferInfos[i].buffer->size - pBufferInfos[i].offset;
+    }
+
+    vkBackends->updateDescriptorSetWithTemplate(vkBackends->device, (VkDescriptorSet) descriptorSet->descriptorSet,
+                                                (VkDescriptorUpdateTemplate) descriptorLayout->updateTemplate, bufferInfos);
+
+    if (bufferInfos != stackInfos)
+        lvn_free(bufferInfos);
+}
+
+static LvnResult lvn_submitCommandBuffers(LvnVulkanBackends* vkBackends, LvnCommandBuffer* const* pCommandBuffers, uint32_t count, VkSemaphore waitSemaphore, VkSemaphore signalSemaphore)
+{
+    const LvnGraphicsContext* graphicsctx = vkBackends->graphicsctx;
+
+    // uploads recorded so far are submitted first, their barriers order them before the command buffers below
+    if (lvn_vkStagingFlush(vkBackends) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    VkCommandBuffer stackCommandBuffers[16];
+    VkCommandBuffer* vkCommandBuffers = count <= LVN_ARRAY_LEN(stackCommandBuffers)
+        ? stackCommandBuffers
+        : (VkCommandBuffer*) lvn_malloc(count * sizeof(VkCommandBuffer));
+
+    if (!vkCommandBuffers)
+        return Lvn_Result_Failure;
+
+    for (uint32_t i = 0; i < count; i++)
+        vkCommandBuffers[i] = (VkCommandBuffer) pCommandBuffers[i]->commandBuffer;
+
+    VkSubmitInfo submitInfo = {0};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = count;
+    submitInfo.pCommandBuffers = vkCommandBuffers;
+
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    if (waitSemaphore)
+    {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &waitSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+    }
+    if (signalSemaphore)
+    {
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphore;
+    }
+
+    LvnResult result = Lvn_Result_Failure;
+    LvnVkFrameSync* frameSync = &vkBackends->frameSync[graphicsctx->frameIndex];
+
+    // each submission signals its own fence so lvnImplVkBeginFrame can wait for all of them at once
+    lvn_spinLock(&vkBackends->queueLock);
+
+    if (frameSync->usedFenceCount == frameSync->fenceCount)
+    {
+        VkFence* pFences = (VkFence*) lvn_realloc(frameSync->pFences, (frameSync->fenceCount + 1) * sizeof(VkFence));
+        if (!pFences)
+            goto fail_cleanup;
+        frameSync->pFences = pFences;
+
+        VkFenceCreateInfo fenceInfo = {0};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        if (vkBackends->createFence(vkBackends->device, &fenceInfo, NULL, &frameSync->pFences[frameSync->fenceCount]) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to create submission fence");
+            goto fail_cleanup;
+        }
+        frameSync->fenceCount++;
+    }
+
+    if (vkBackends->queueSubmit(vkBackends->graphicsQueue, 1, &submitInfo, frameSync->pFences[frameSync->usedFenceCount]) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to submit %u command buffers", count);
+        goto fail_cleanup;
+    }
+
+    frameSync->usedFenceCount++;
+    result = Lvn_Result_Success;
+
+fail_cleanup:
+    lvn_spinUnlock(&vkBackends->queueLock);
+
+    if (vkCommandBuffers != stackCommandBuffers)
+        lvn_free(vkCommandBuffers);
+
+    return result;
+}
+
+void lvnImplVkCmdBeginRenderPass(LvnCommandBuffer* commandBuffer, const LvnRenderPassBeginInfo* beginInfo)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    const LvnSurface* surface = beginInfo->surface;
+    const LvnVkSwapchainData* swapchainData = (const LvnVkSwapchainData*) surface->swapchainData;
+
+    VkClearValue clearValue = {0};
+    memcpy(clearValue.color.float32, beginInfo->clearColor, sizeof(clearValue.color.float32));
+
+    if (vkBackends->dynamicRendering)
+    {
+        VkImage image = swapchainData->swapchainImages[swapchainData->imageIndex];
+        commandBuffer->renderingImage = image;
+
+        // the previous contents are cleared, the wait on the acquire semaphore happens in the same stage
+        VkImageMemoryBarrier barrier = {0};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+
+        vkBackends->cmdPipelineBarrier((VkCommandBuffer) commandBuffer->commandBuffer,
+                                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                       0, 0, NULL, 0, NULL, 1, &barrier);
+
+        VkRenderingAttachmentInfoKHR colorAttachment = {0};
+        colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        colorAttachment.imageView = swapchainData->swapchainImageViews[swapchainData->imageIndex];
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue = clearValue;
+
+        VkRenderingInfoKHR renderingInfo = {0};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.flags = beginInfo->secondaryCommandBuffers ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+        renderingInfo.renderArea.extent = swapchainData->swapchainExtent;
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments = &colorAttachment;
+
+        vkBackends->cmdBeginRenderingKHR((VkCommandBuffer) commandBuffer->commandBuffer, &renderingInfo);
+        return;
+    }
+
+    VkRenderPassBeginInfo renderPassInfo = {0};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = (VkRenderPass) surface->renderPass.renderPassHandle;
+    renderPassInfo.framebuffer = swapchainData->swapchainFramebuffers[swapchainData->imageIndex];
+    renderPassInfo.renderArea.extent = swapchainData->swapchainExtent;
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearValue;
+
+    VkSubpassContents contents = beginInfo->secondaryCommandBuffers
+        ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+        : VK_SUBPASS_CONTENTS_INLINE;
+
+    vkBackends->cmdBeginRenderPass((VkCommandBuffer) commandBuffer->commandBuffer, &renderPassInfo, contents);
+}
+
+void lvnImplVkCmdEndRenderPass(LvnCommandBuffer* commandBuffer)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    if (!vkBackends->dynamicRendering)
+    {
+        vkBackends->cmdEndRenderPass((VkCommandBuffer) commandBuffer->commandBuffer);
+        return;
+    }
+
+    vkBackends->cmdEndRenderingKHR((VkCommandBuffer) commandBuffer->commandBuffer);
+
+    // the render pass did this transition in its final layout, the semaphore signaled by the submission makes it visible to the present
+    VkImageMemoryBarrier barrier = {0};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = (VkImage) commandBuffer->renderingImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkBackends->cmdPipelineBarrier((VkCommandBuffer) commandBuffer->commandBuffer,
+                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                   0, 0, NULL, 0, NULL, 1, &barrier);
+
+    commandBuffer->renderingImage = NULL;
+}
+
+void lvnImplVkCmdBindPipeline(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    const LvnVkPipelineData* pipelineData = (const LvnVkPipelineData*) pipeline->pipeline;
+    vkBackends->cmdBindPipeline((VkCommandBuffer) commandBuffer->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineData->pipeline);
+}
+
+void lvnImplVkCmdSetViewport(LvnCommandBuffer* commandBuffer, const LvnPipelineViewport* viewport)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    VkViewport vkViewport = {0};
+    vkViewport.x = viewport->x;
+    vkViewport.y = viewport->y;
+    vkViewport.width = viewport->width;
+    vkViewport.height = viewport->height;
+    vkViewport.minDepth = viewport->minDepth;
+    vkViewport.maxDepth = viewport->maxDepth;
+
+    vkBackends->cmdSetViewport((VkCommandBuffer) commandBuffer->commandBuffer, 0, 1, &vkViewport);
+}
+
+void lvnImplVkCmdSetScissor(LvnCommandBuffer* commandBuffer, const LvnPipelineScissor* scissor)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    VkRect2D vkScissor = {0};
+    vkScissor.offset.x = (int32_t) scissor->offset.x;
+    vkScissor.offset.y = (int32_t) scissor->offset.y;
+    vkScissor.extent.width = scissor->extent.width;
+    vkScissor.extent.height = scissor->extent.height;
+
+    vkBackends->cmdSetScissor((VkCommandBuffer) commandBuffer->commandBuffer, 0, 1, &vkScissor);
+}
+
+void lvnImplVkCmdDraw(LvnCommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    vkBackends->cmdDraw((VkCommandBuffer) commandBuffer->commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void lvnImplVkCmdBindVertexBuffers(LvnCommandBuffer* commandBuffer, uint32_t firstBinding, LvnBuffer* const* pBuffers, const uint64_t* pOffsets, uint32_t count)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    VkBuffer stackBuffers[16];
+    VkDeviceSize stackOffsets[16];
+    VkBuffer* vkBuffers = stackBuffers;
+    VkDeviceSize* vkOffsets = stackOffsets;
+
+    if (count > LVN_ARRAY_LEN(stackBuffers))
+    {
+        vkBuffers = (VkBuffer*) lvn_malloc(count * sizeof(VkBuffer));
+        vkOffsets = (VkDeviceSize*) lvn_malloc(count * sizeof(VkDeviceSize));
+        if (!vkBuffers || !vkOffsets)
+        {
+            LVN_LOG_ERROR(commandBuffer->graphicsctx->coreLogger, "[vulkan] failed to allocate memory to bind %u vertex buffers", count);
+            lvn_free(vkBuffers);
+            lvn_free(vkOffsets);
+            return;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        vkBuffers[i] = (VkBuffer) pBuffers[i]->buffer;
+        vkOffsets[i] = pOffsets ? pOffsets[i] : 0;
+    }
+
+    vkBackends->cmdBindVertexBuffers((VkCommandBuffer) commandBuffer->commandBuffer, firstBinding, count, vkBuffers, vkOffsets);
+
+    if (vkBuffers != stackBuffers)
+    {
+        lvn_free(vkBuffers);
+        lvn_free(vkOffsets);
+    }
+}
+
+void lvnImplVkCmdBindDescriptorSets(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, uint32_t firstSet, LvnDescriptorSet* const* pDescriptorSets, uint32_t count, const uint32_t* pDynamicOffsets, uint32_t dynamicOffsetCount)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    const LvnVkPipelineData* pipelineData = (const LvnVkPipelineData*) pipeline->pipeline;
+
+    VkDescriptorSet descriptorSets[count];
+    for (uint32_t i = 0; i < count; i++)
+        descriptorSets[i] = (VkDescriptorSet) pDescriptorSets[i]->descriptorSet;
+
+    vkBackends->cmdBindDescriptorSets((VkCommandBuffer) commandBuffer->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineData->pipelineLayout,
+                                      firstSet, count, descriptorSets, dynamicOffsetCount, pDynamicOffsets);
+}
+
+void lvnImplVkCmdPushConstants(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, LvnShaderStageFlags shaderStages, uint32_t offset, uint32_t size, const void* pValues)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    const LvnVkPipelineData* pipelineData = (const LvnVkPipelineData*) pipeline->pipeline;
+
+    vkBackends->cmdPushConstants((VkCommandBuffer) commandBuffer->commandBuffer, pipelineData->pipelineLayout,
+                                 lvn_getVkShaderStageFlags(shaderStages), offset, size, pValues);
+}
+
+void lvnImplVkCmdBindIndexBuffer(LvnCommandBuffer* commandBuffer, const LvnBuffer* buffer, uint64_t offset, LvnIndexType indexType)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    VkIndexType vkIndexType = indexType == Lvn_IndexType_Uint16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    vkBackends->cmdBindIndexBuffer((VkCommandBuffer) commandBuffer->commandBuffer, (VkBuffer) buffer->buffer, offset, vkIndexType);
+}
+
+void lvnImplVkCmdDrawIndexed(LvnCommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+    vkBackends->cmdDrawIndexed((VkCommandBuffer) commandBuffer->commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void lvnImplVkCmdExecuteCommands(LvnCommandBuffer* commandBuffer, LvnCommandBuffer* const* pSecondaryCommandBuffers, uint32_t count)
+{
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) commandBuffer->graphicsctx->implData;
+
+    VkCommandBuffer stackCommandBuffers[16];
+    VkCommandBuffer* vkCommandBuffers = count <= LVN_ARRAY_LEN(stackCommandBuffers)
+        ? stackCommandBuffers
+        : (VkCommandBuffer*) lvn_malloc(count * sizeof(VkCommandBuffer));
+
+    if (!vkCommandBuffers)
+        return;
+
+    for (uint32_t i = 0; i < count; i++)
+        vkCommandBuffers[i] = (VkCommandBuffer) pSecondaryCommandBuffers[i]->commandBuffer;
+
+    vkBackends->cmdExecuteCommands((VkCommandBuffer) commandBuffer->commandBuffer, count, vkCommandBuffers);
+
+    if (vkCommandBuffers != stackCommandBuffers)
+        lvn_free(vkCommandBuffers);
+}
+
+LvnResult lvnImplVkSurfaceBeginFrame(LvnSurface* surface)
+{
+    const LvnGraphicsContext* graphicsctx = surface->graphicsctx;
+    const LvnVulkanBackends* vkBackends = (const LvnVulkanBackends*) graphicsctx->implData;
+    LvnVkSwapchainData* swapchainData = (LvnVkSwapchainData*) surface->swapchainData;
+
+    LVN_PROFILE_BEGIN("lvnImplVkSurfaceBeginFrame");
+
+    if (swapchainData->outOfDate && lvn_recreateSwapChainData(vkBackends, swapchainData) != Lvn_Result_Success)
+    {
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
+
+    // the semaphore of this slot was last waited on by the slot's previous submission, which lvnImplVkBeginFrame already waited for
+    VkSemaphore imageAvailable = swapchainData->imageAvailableSemaphores[graphicsctx->frameIndex];
+    VkResult result = vkBackends->acquireNextImageKHR(vkBackends->device, swapchainData->swapchain, UINT64_MAX, imageAvailable, VK_NULL_HANDLE, &swapchainData->imageIndex);
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        if (lvn_recreateSwapChainData(vkBackends, swapchainData) != Lvn_Result_Success)
+        {
+            LVN_PROFILE_END();
+            return Lvn_Result_Failure;
+        }
+
+        result = vkBackends->acquireNextImageKHR(vkBackends->device, swapchainData->swapchain, UINT64_MAX, imageAvailable, VK_NULL_HANDLE, &swapchainData->imageIndex);
+    }
+
+    // suboptimal still acquires an image, the swapchain is recreated after it is presented
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to acquire swapchain image of surface %p", surface);
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
+
+    LVN_PROFILE_END();
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnImplVkSurfaceEndFrame(LvnSurface* surface, LvnCommandBuffer* const* pCommandBuffers, uint32_t count)
+{
+    const LvnGraphicsContext* graphicsctx = surface->graphicsctx;
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+    LvnVkSwapchainData* swapchainData = (LvnVkSwapchainData*) surface->swapchainData;
+
+    LVN_PROFILE_BEGIN("lvnImplVkSurfaceEndFrame");
+
+    VkSemaphore imageAvailable = swapchainData->imageAvailableSemaphores[graphicsctx->frameIndex];
+    VkSemaphore renderFinished = swapchainData->renderFinishedSemaphores[swapchainData->imageIndex];
+
+    // also submitted without command buffers so the acquire semaphore is always consumed and the slot gets a fence
+    if (lvn_submitCommandBuffers(vkBackends, pCommandBuffers, count, imageAvailable, renderFinished) != Lvn_Result_Success)
+    {
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
+
+    VkPresentInfoKHR presentInfo = {0};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &renderFinished;
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = &swapchainData->swapchain;
+    presentInfo.pImageIndices = &swapchainData->imageIndex;
+
+    lvn_spinLock(&vkBackends->queueLock);
+    VkResult result = vkBackends->queuePresentKHR(vkBackends->presentQueue, &presentInfo);
+    lvn_spinUnlock(&vkBackends->queueLock);
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+        LvnResult recreateResult = lvn_recreateSwapChainData(vkBackends, swapchainData);
+        LVN_PROFILE_END();
+        return recreateResult;
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "[vulkan] failed to present swapchain image of surface %p", surface);
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
+
+    LVN_PROFILE_END();
+    return Lvn_Result_Success;
+}
+
+void lvnImplVkSurfaceResize(LvnSurface* surface, uint32_t width, uint32_t height)
+{
+    LvnVkSwapchainData* swapchainData = (LvnVkSwapchainData*) surface->swapchainData;
+
+    // the images may still be rendered to by the current frame, so only remember the size until the next acquire
+    swapchainData->createInfo.width = width;
+    swapchainData->createInfo.height = height;
+    swapchainData->outOfDate = true;
+}
+
+void lvnImplVkSurfaceGetExtent(const LvnSurface* surface, uint32_t* width, uint32_t* height)
+{
+    const LvnVkSwapchainData* swapchainData = (const LvnVkSwapchainData*) surface->swapchainData;
+
+    *width = swapchainData->swapchainExtent.width;
+    *height = swapchainData->swapchainExtent.height;
+}
@@ -12,6 +12,42 @@ void      lvnImplVkDestroySurface(LvnSurface* surface);
 LvnResult lvnImplVkCreateShader(const LvnGraphicsContext* graphicsctx, LvnShader* shader, const LvnShaderCreateInfo* createInfo);
 void      lvnImplVkDestroyShader(LvnShader* shader);
 LvnResult lvnImplVkCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline* pipeline, const LvnPipelineCreateInfo* createInfo);
+LvnResult lvnImplVkCreatePipelines(const LvnGraphicsContext* graphicsctx, LvnPipeline** pPipelines, const LvnPipelineCreateInfo* pCreateInfos, uint32_t count);
 void      lvnImplVkDestroyPipeline(LvnPipeline* pipeline);
+LvnResult lvnImplVkCreateBuffer(const LvnGraphicsContext* graphicsctx, LvnBuffer* buffer, const LvnBufferCreateInfo* createInfo);
+void      lvnImplVkDestroyBuffer(LvnBuffer* buffer);
+LvnResult lvnImplVkFlushBuffer(LvnBuffer* buffer, uint64_t offset, uint64_t size);
+LvnResult lvnImplVkInvalidateBuffer(LvnBuffer* buffer, uint64_t offset, uint64_t size);
+LvnResult lvnImplVkUploadBuffer(LvnBuffer* buffer, const void* data, uint64_t size, uint64_t offset);
+LvnResult lvnImplVkCreateDescriptorLayout(const LvnGraphicsContext* graphicsctx, LvnDescriptorLayout* descriptorLayout);
+void      lvnImplVkDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout);
+void      lvnImplVkWaitIdle(const LvnGraphicsContext* graphicsctx);
+LvnResult lvnImplVkLoadPipelineCache(const LvnGraphicsContext* graphicsctx, const uint8_t* data, size_t size);
+LvnResult lvnImplVkGetPipelineCacheData(const LvnGraphicsContext* graphicsctx, uint8_t** data, size_t* size);
+LvnPipelineCacheStats lvnImplVkGetPipelineCacheStats(const LvnGraphicsContext* graphicsctx);
+LvnGraphicsMemoryStats lvnImplVkGetMemoryStats(const LvnGraphicsContext* graphicsctx);
+LvnResult lvnImplVkBeginFrame(LvnGraphicsContext* graphicsctx);
+LvnResult lvnImplVkSurfaceBeginFrame(LvnSurface* surface);
+LvnResult lvnImplVkSurfaceEndFrame(LvnSurface* surface, LvnCommandBuffer* const* pCommandBuffers, uint32_t count);
+void lvnImplVkSurfaceResize(LvnSurface* surface, uint32_t width, uint32_t height);
+void lvnImplVkSurfaceGetExtent(const LvnSurface* surface, uint32_t* width, uint32_t* height);
+LvnCommandBuffer* lvnImplVkAllocateCommandBuffer(const LvnGraphicsContext* graphicsctx, LvnCommandBufferLevel level);
+LvnResult lvnImplVkBeginCommandBuffer(LvnCommandBuffer* commandBuffer, const LvnRenderPass* renderPass);
+LvnResult lvnImplVkEndCommandBuffer(LvnCommandBuffer* commandBuffer);
+LvnResult lvnImplVkSubmitCommandBuffers(const LvnGraphicsContext* graphicsctx, LvnCommandBuffer* const* pCommandBuffers, uint32_t count);
+LvnDescriptorSet* lvnImplVkAllocateDescriptorSet(const LvnGraphicsContext* graphicsctx, const LvnDescriptorLayout* descriptorLayout);
+void      lvnImplVkUpdateDescriptorSet(LvnDescriptorSet* descriptorSet, const LvnDescriptorBufferInfo* pBufferInfos);
+void      lvnImplVkCmdBeginRenderPass(LvnCommandBuffer* commandBuffer, const LvnRenderPassBeginInfo* beginInfo);
+void      lvnImplVkCmdEndRenderPass(LvnCommandBuffer* commandBuffer);
+void      lvnImplVkCmdBindPipeline(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline);
+void      lvnImplVkCmdSetViewport(LvnCommandBuffer* commandBuffer, const LvnPipelineViewport* viewport);
+void      lvnImplVkCmdSetScissor(LvnCommandBuffer* commandBuffer, const LvnPipelineScissor* scissor);
+void      lvnImplVkCmdBindVertexBuffers(LvnCommandBuffer* commandBuffer, uint32_t firstBinding, LvnBuffer* const* pBuffers, const uint64_t* pOffsets, uint32_t count);
+void      lvnImplVkCmdBindDescriptorSets(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, uint32_t firstSet, LvnDescriptorSet* const* pDescriptorSets, uint32_t count, const uint32_t* pDynamicOffsets, uint32_t dynamicOffsetCount);
+void      lvnImplVkCmdPushConstants(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, LvnShaderStageFlags shaderStages, uint32_t offset, uint32_t size, const void* pValues);
+void      lvnImplVkCmdBindIndexBuffer(LvnCommandBuffer* commandBuffer, const LvnBuffer* buffer, uint64_t offset, LvnIndexType indexType);
+void      lvnImplVkCmdDraw(LvnCommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+void      lvnImplVkCmdDrawIndexed(LvnCommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+void      lvnImplVkCmdExecuteCommands(LvnCommandBuffer* commandBuffer, LvnCommandBuffer* const* pSecondaryCommandBuffers, uint32_t count);
 
 #endif // !HG_LVN_IMPL_VK_H
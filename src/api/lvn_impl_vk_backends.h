@@ -11,8 +11,10 @@ typedef struct LvnVkQueueFamilyIndices
 {
     uint32_t graphicsIndex;
     uint32_t presentIndex;
+    uint32_t transferIndex;                            // graphics family if the device has no separate transfer family
     bool hasGraphics;
     bool hasPresent;
+    bool hasTransfer;                                  // a family with transfer but without graphics support
 } LvnVkQueueFamilyIndices;
 
 typedef struct LvnVkSwapChainCreateInfo
@@ -21,13 +23,15 @@ typedef struct LvnVkSwapChainCreateInfo
     VkSurfaceKHR surface;
     VkSurfaceFormatKHR surfaceFormat;
     const LvnVkQueueFamilyIndices* queueFamilyIndices;
-    VkRenderPass renderPass;
+    VkRenderPass renderPass;                           // no framebuffers are created if null
     uint32_t width;
     uint32_t height;
 } LvnVkSwapChainCreateInfo;
 
 typedef struct LvnVkSwapchainData
 {
+    LvnVkSwapChainCreateInfo createInfo;               // kept to recreate the swapchain when it goes out of date
+    LvnVkQueueFamilyIndices queueFamilyIndices;
     VkSwapchainKHR swapchain;
     VkExtent2D swapchainExtent;
     VkFormat swapchainFormat;
@@ -35,14 +39,289 @@ typedef struct LvnVkSwapchainData
     VkImage* swapchainImages;
     VkImageView* swapchainImageViews;
     VkFramebuffer* swapchainFramebuffers;
+    uint32_t imageIndex;                               // swapchain image rendered to in the current frame
+    VkSemaphore imageAvailableSemaphores[LVN_MAX_FRAMES_IN_FLIGHT]; // per frame slot, signaled by the acquire and waited on by the frame's submission
+    VkSemaphore* renderFinishedSemaphores;             // per swapchain image, a present holds its semaphore until the image is acquired again
+    bool outOfDate;                                    // set by lvnImplVkSurfaceResize, the swapchain is recreated before the next acquire
 } LvnVkSwapchainData;
 
+// command buffers recorded by one thread in one frame slot, reset together with vkResetCommandPool
+typedef struct LvnVkFrameCommandPool
+{
+    VkCommandPool commandPool;
+    LvnCommandBuffer** pCommandBuffers[2];             // per LvnCommandBufferLevel, allocated once and reused after every reset
+    uint32_t commandBufferCounts[2];
+    uint32_t usedCounts[2];                            // handed out since the last reset
+} LvnVkFrameCommandPool;
+
+// descriptor pools of one frame slot, sets are never freed one by one and every pool is reset with the command pool
+#define LVN_VK_DESCRIPTOR_POOL_SET_COUNT 256
+
+typedef struct LvnVkFrameDescriptorPools
+{
+    VkDescriptorPool* pPools;                          // grows when every pool is full, pools are kept across resets
+    uint32_t poolCount;
+    uint32_t poolIndex;                                // pool sets are allocated from, the pools before it are full
+    uint32_t poolSetCount;                             // sets allocated from the current pool
+    LvnDescriptorSet** pDescriptorSets;                // allocated once and reused after every reset
+    uint32_t descriptorSetCount;
+    uint32_t usedCount;                                // handed out since the last reset
+} LvnVkFrameDescriptorPools;
+
+// pools of one recording thread, created the first time the thread allocates a command buffer or descriptor set
+typedef struct LvnVkThreadCommandPools
+{
+    uint64_t threadId;
+    LvnVkFrameCommandPool frames[LVN_MAX_FRAMES_IN_FLIGHT];
+    LvnVkFrameDescriptorPools descriptorFrames[LVN_MAX_FRAMES_IN_FLIGHT];
+} LvnVkThreadCommandPools;
+
+// fences of the submissions made in one frame slot, waited on before the slot's pools are reset
+typedef struct LvnVkFrameSync
+{
+    VkFence* pFences;
+    uint32_t fenceCount;
+    uint32_t usedFenceCount;                           // fences submitted since the slot was last begun
+} LvnVkFrameSync;
+
+// device memory sub-allocator, see lvn_impl_vk_memory.c
+#define LVN_VK_TLSF_SL_LOG2   5
+#define LVN_VK_TLSF_SL_COUNT  (1 << LVN_VK_TLSF_SL_LOG2)
+#define LVN_VK_TLSF_FL_COUNT  32
+
+// kept apart on the same bufferImageGranularity page
+typedef enum LvnVkAllocationType
+{
+    LvnVk_AllocationType_Free = 0,
+    LvnVk_AllocationType_Linear,                       // buffers and linear tiling images
+    LvnVk_AllocationType_Optimal,                      // optimal tiling images
+} LvnVkAllocationType;
+
+// free or used range of a memory block, ranges are linked in address order and free ranges also in their size class list
+typedef struct LvnVkMemoryRange
+{
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    struct LvnVkMemoryRange* prevPhysical;
+    struct LvnVkMemoryRange* nextPhysical;
+    struct LvnVkMemoryRange* prevFree;
+    struct LvnVkMemoryRange* nextFree;
+    uint32_t type;                                     // LvnVkAllocationType
+} LvnVkMemoryRange;
+
+typedef struct LvnVkMemoryBlock
+{
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    VkDeviceSize allocatedSize;
+    uint32_t allocationCount;
+    void* pMapped;                                     // whole block mapped if the memory type is host visible
+    LvnVkMemoryRange* pFirstRange;
+    uint32_t flBitmap;                                 // first levels with a free range
+    uint32_t slBitmaps[LVN_VK_TLSF_FL_COUNT];          // second level classes with a free range
+    LvnVkMemoryRange* freeLists[LVN_VK_TLSF_FL_COUNT][LVN_VK_TLSF_SL_COUNT];
+} LvnVkMemoryBlock;
+
+typedef struct LvnVkMemoryTypePool
+{
+    LvnVkMemoryBlock** pBlocks;
+    uint32_t blockCount;
+    VkDeviceSize blockSize;
+    VkDeviceMemory* pDedicated;                        // dedicated allocations still alive, freed by lvn_vkFreeMemory or at terminate
+    uint32_t dedicatedCount;
+    uint32_t dedicatedCapacity;
+    VkDeviceSize dedicatedSize;
+    uint32_t lock;                                     // spin lock guarding the blocks and counters of the pool
+} LvnVkMemoryTypePool;
+
+typedef struct LvnVkMemoryAllocator
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    VkDeviceSize bufferImageGranularity;
+    VkDeviceSize nonCoherentAtomSize;
+    uint32_t maxDeviceMemoryCount;                     // maxMemoryAllocationCount of the device
+    uint32_t deviceMemoryCount;                        // VkDeviceMemory objects allocated, blocks and dedicated allocations
+    LvnVkMemoryTypePool pools[VK_MAX_MEMORY_TYPES];
+} LvnVkMemoryAllocator;
+
+typedef struct LvnVkAllocationCreateInfo
+{
+    VkMemoryRequirements requirements;
+    VkMemoryPropertyFlags requiredFlags;
+    VkMemoryPropertyFlags preferredFlags;              // memory types missing fewer of these are picked first
+    LvnVkAllocationType type;
+    bool dedicated;                                    // give the resource its own VkDeviceMemory
+} LvnVkAllocationCreateInfo;
+
+typedef struct LvnVkAllocation
+{
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void* pMapped;                                     // host pointer to offset, null if the memory is not host visible
+    uint32_t memoryTypeIndex;
+    LvnVkMemoryBlock* block;                           // null for dedicated allocations
+    LvnVkMemoryRange* range;
+} LvnVkAllocation;
+
+// uploads to gpu only resources, see lvn_impl_vk_staging.c
+#define LVN_VK_STAGING_BATCH_COUNT        4
+#define LVN_VK_STAGING_DEFAULT_SIZE       (32ull * 1024 * 1024)
+
+typedef enum LvnVkStagingBatchState
+{
+    LvnVk_StagingBatchState_Idle = 0,
+    LvnVk_StagingBatchState_Recording,
+    LvnVk_StagingBatchState_Pending,                   // submitted, its part of the ring is freed once its fences signal
+} LvnVkStagingBatchState;
+
+// copies recorded between two flushes of the staging ring
+typedef struct LvnVkStagingBatch
+{
+    VkCommandPool transferCommandPool;
+    VkCommandBuffer transferCommandBuffer;             // copies into the destination buffers
+    VkCommandPool waitCommandPool;                     // graphics family, only with a separate transfer family
+    VkCommandBuffer waitCommandBuffer;                 // barrier ordering later graphics work after the copies
+    VkSemaphore semaphore;                             // signaled by the transfer submission and waited on by the wait submission
+    VkFence fences[2];                                 // transfer and wait submission
+    VkDeviceSize ringEnd;                              // ring head when the batch was submitted
+    LvnVkStagingBatchState state;
+    bool reclaiming;                                   // a thread is waiting on the fences without holding the ring lock
+} LvnVkStagingBatch;
+
+// one persistently mapped buffer, upload regions are carved out at the head and freed at the tail in submission order
+typedef struct LvnVkStagingRing
+{
+    VkBuffer buffer;
+    LvnVkAllocation allocation;
+    VkDeviceSize size;
+    VkDeviceSize head;
+    VkDeviceSize tail;
+    LvnVkStagingBatch batches[LVN_VK_STAGING_BATCH_COUNT];
+    uint32_t batchIndex;                               // batch copies are recorded into, batches are submitted in index order
+    uint32_t lock;                                     // spin lock guarding the ring and the batches
+    bool separateTransferQueue;
+} LvnVkStagingRing;
+
+// bindless resources, see lvn_impl_vk_bindless.c
+#define LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS   0
+#define LVN_VK_BINDLESS_BINDING_SAMPLED_IMAGES    1
+#define LVN_VK_BINDLESS_BINDING_SAMPLERS          2
+#define LVN_VK_BINDLESS_BINDING_COUNT             3
+
+// indices of one descriptor array, freed indices are handed out again before new ones
+typedef struct LvnVkBindlessArray
+{
+    uint32_t capacity;
+    uint32_t nextIndex;                                // indices below were handed out at least once
+    uint32_t* pFreeIndices;
+    uint32_t freeCount;
+} LvnVkBindlessArray;
+
+// one update after bind set of partially bound arrays, bound once and indexed by shaders
+typedef struct LvnVkBindlessSet
+{
+    VkDescriptorSetLayout setLayout;
+    VkDescriptorPool descriptorPool;
+    VkDescriptorSet descriptorSet;
+    LvnVkBindlessArray arrays[LVN_VK_BINDLESS_BINDING_COUNT];
+    uint32_t lock;                                     // spin lock guarding the arrays and descriptor writes to the set
+    LvnDescriptorLayout layout;                        // handed out by lvnGraphicsContextGetBindlessLayout
+    LvnDescriptorSet set;                              // handed out by lvnGraphicsContextGetBindlessSet
+} LvnVkBindlessSet;
+
+// shader data when VK_KHR_maintenance5 lets pipelines take spir-v directly, replaces the VkShaderModule handle in LvnShader
+typedef struct LvnVkShaderCode
+{
+    size_t codeSize;
+    uint32_t code[];
+} LvnVkShaderCode;
+
+// everything a VkPipelineLayout is created from, pipelines with equal signatures share one layout
+typedef struct LvnVkPipelineLayoutSignature
+{
+    const VkDescriptorSetLayout* pSetLayouts;
+    uint32_t setLayoutCount;
+    const VkPushConstantRange* pPushConstantRanges;
+    uint32_t pushConstantRangeCount;
+} LvnVkPipelineLayoutSignature;
+
+typedef struct LvnVkPipelineLayoutEntry
+{
+    VkPipelineLayout pipelineLayout;
+    uint64_t hash;
+    uint32_t refCount;                                 // guarded by LvnVulkanBackends::pipelineLayoutLock
+    uint32_t setLayoutCount;
+    uint32_t pushConstantRangeCount;
+    VkPushConstantRange* pPushConstantRanges;          // points past setLayouts in the same allocation
+    VkDescriptorSetLayout setLayouts[];
+} LvnVkPipelineLayoutEntry;
+
 typedef struct LvnVkPipelineData
 {
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
+    LvnVkPipelineLayoutEntry* layoutEntry;
 } LvnVkPipelineData;
 
+#define LVN_VK_PIPELINE_CACHE_MAGIC   0x4350564c      // "LVPC"
+#define LVN_VK_PIPELINE_CACHE_VERSION 1
+
+// written in front of the vkGetPipelineCacheData blob in pipeline cache files, the vulkan header
+// of the blob has no driver version and nothing to detect a truncated or corrupted file
+typedef struct LvnVkPipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint32_t reserved;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t dataHash;                                 // lvnHash64 of the blob
+} LvnVkPipelineCacheFileHeader;
+
+// translated state of one pipeline, the VkGraphicsPipelineCreateInfo built alongside it points into this struct
+typedef struct LvnVkPipelineBuildData
+{
+    void* arrays;                                      // single allocation holding the arrays below
+    VkPipelineShaderStageCreateInfo* shaderStages;
+    VkShaderModuleCreateInfo* stageModuleInfos;        // chained to the shader stages when shader code is inline
+    VkPipelineCreationFeedbackEXT* stageFeedbacks;
+    VkPipelineColorBlendAttachmentState* colorBlendAttachments;
+    VkVertexInputAttributeDescription* vertexAttributes;
+    VkVertexInputBindingDescription* bindingDescriptions;
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo;
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly;
+    VkDynamicState dynamicStates[5];
+    VkPipelineDynamicStateCreateInfo dynamicState;
+    VkPipelineViewportStateCreateInfo viewportState;
+    VkPipelineRasterizationStateCreateInfo rasterizer;
+    VkPipelineMultisampleStateCreateInfo multisampling;
+    VkPipelineColorBlendStateCreateInfo colorBlending;
+    VkPipelineDepthStencilStateCreateInfo depthStencil;
+    VkPipelineCreationFeedbackCreateInfoEXT feedbackInfo;  // chained only when VK_EXT_pipeline_creation_feedback is enabled
+    VkPipelineCreationFeedbackEXT feedback;
+    VkPipelineRenderingCreateInfoKHR renderingInfo;    // chained instead of a render pass with dynamic rendering
+    VkFormat colorAttachmentFormat;
+    LvnVkPipelineLayoutEntry* layoutEntry;
+} LvnVkPipelineBuildData;
+
+// shared by the job ranges of one lvnImplVkCreatePipelines call, every array has one entry per pipeline
+typedef struct LvnVkPipelineBatch
+{
+    const LvnGraphicsContext* graphicsctx;
+    LvnPipeline** pPipelines;
+    const LvnPipelineCreateInfo* pCreateInfos;
+    LvnVkPipelineBuildData* pBuilds;
+    VkGraphicsPipelineCreateInfo* pPipelineInfos;
+    VkPipeline* pVkPipelines;
+    LvnResult* pResults;
+    uint32_t hitCount;                                 // pipeline cache hits and misses reported by creation feedback
+    uint32_t missCount;
+} LvnVkPipelineBatch;
+
 typedef struct LvnVulkanBackends
 {
     void*                                         handle;
@@ -56,13 +335,17 @@ typedef struct LvnVulkanBackends
     PFN_vkEnumeratePhysicalDevices                enumeratePhysicalDevices;
     PFN_vkEnumerateDeviceExtensionProperties      enumerateDeviceExtensionProperties;
     PFN_vkGetPhysicalDeviceProperties             getPhysicalDeviceProperties;
+    PFN_vkGetPhysicalDeviceFeatures2              getPhysicalDeviceFeatures2;
+    PFN_vkGetPhysicalDeviceProperties2            getPhysicalDeviceProperties2;
     PFN_vkGetPhysicalDeviceFormatProperties       getPhysicalDeviceFormatProperties;
+    PFN_vkGetPhysicalDeviceMemoryProperties       getPhysicalDeviceMemoryProperties;
     PFN_vkGetPhysicalDeviceQueueFamilyProperties  getPhysicalDeviceQueueFamilyProperties;
     PFN_vkGetPhysicalDeviceSurfaceSupportKHR      getPhysicalDeviceSurfaceSupportKHR;
     PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR getPhysicalDeviceSurfaceCapabilitiesKHR;
     PFN_vkGetPhysicalDeviceSurfaceFormatsKHR      getPhysicalDeviceSurfaceFormatsKHR;
     PFN_vkGetPhysicalDeviceSurfacePresentModesKHR getPhysicalDeviceSurfacePresentModesKHR;
     PFN_vkVoidFunction                            createSurfaceProc;
+    PFN_vkCreateHeadlessSurfaceEXT                createHeadlessSurfaceEXT;
     PFN_vkDestroySurfaceKHR                       destroySurfaceKHR;
     PFN_vkGetDeviceProcAddr                       getDeviceProcAddr;
     PFN_vkCreateDevice                            createDevice;
@@ -71,6 +354,20 @@ typedef struct LvnVulkanBackends
     PFN_vkCreateSwapchainKHR                      createSwapchainKHR;
     PFN_vkDestroySwapchainKHR                     destroySwapchainKHR;
     PFN_vkGetSwapchainImagesKHR                   getSwapchainImagesKHR;
+    PFN_vkAcquireNextImageKHR                     acquireNextImageKHR;
+    PFN_vkQueuePresentKHR                         queuePresentKHR;
+    PFN_vkCreateDescriptorSetLayout               createDescriptorSetLayout;
+    PFN_vkDestroyDescriptorSetLayout              destroyDescriptorSetLayout;
+    PFN_vkCreateDescriptorPool                    createDescriptorPool;
+    PFN_vkDestroyDescriptorPool                   destroyDescriptorPool;
+    PFN_vkResetDescriptorPool                     resetDescriptorPool;
+    PFN_vkAllocateDescriptorSets                  allocateDescriptorSets;
+    PFN_vkCreateDescriptorUpdateTemplate          createDescriptorUpdateTemplate;
+    PFN_vkDestroyDescriptorUpdateTemplate         destroyDescriptorUpdateTemplate;
+    PFN_vkUpdateDescriptorSetWithTemplate         updateDescriptorSetWithTemplate;
+    PFN_vkUpdateDescriptorSets                    updateDescriptorSets;
+    PFN_vkCreateSemaphore                         createSemaphore;
+    PFN_vkDestroySemaphore                        destroySemaphore;
     PFN_vkCreateImage                             createImage;
     PFN_vkDestroyImage                            destroyImage;
     PFN_vkCreateImageView                         createImageView;
@@ -83,17 +380,79 @@ typedef struct LvnVulkanBackends
     PFN_vkDestroyPipelineLayout                   destroyPipelineLayout;
     PFN_vkCreateGraphicsPipelines                 createGraphicsPipelines;
     PFN_vkDestroyPipeline                         destroyPipeline;
+    PFN_vkCreatePipelineCache                     createPipelineCache;
+    PFN_vkDestroyPipelineCache                    destroyPipelineCache;
+    PFN_vkGetPipelineCacheData                    getPipelineCacheData;
+    PFN_vkMergePipelineCaches                     mergePipelineCaches;
     PFN_vkCreateFramebuffer                       createFramebuffer;
     PFN_vkDestroyFramebuffer                      destroyFramebuffer;
+    PFN_vkDeviceWaitIdle                          deviceWaitIdle;
+    PFN_vkAllocateMemory                          allocateMemory;
+    PFN_vkFreeMemory                              freeMemory;
+    PFN_vkMapMemory                               mapMemory;
+    PFN_vkFlushMappedMemoryRanges                 flushMappedMemoryRanges;
+    PFN_vkInvalidateMappedMemoryRanges            invalidateMappedMemoryRanges;
+    PFN_vkCreateBuffer                            createBuffer;
+    PFN_vkDestroyBuffer                           destroyBuffer;
+    PFN_vkGetBufferMemoryRequirements             getBufferMemoryRequirements;
+    PFN_vkBindBufferMemory                        bindBufferMemory;
+    PFN_vkCreateCommandPool                       createCommandPool;
+    PFN_vkDestroyCommandPool                      destroyCommandPool;
+    PFN_vkResetCommandPool                        resetCommandPool;
+    PFN_vkAllocateCommandBuffers                  allocateCommandBuffers;
+    PFN_vkBeginCommandBuffer                      beginCommandBuffer;
+    PFN_vkEndCommandBuffer                        endCommandBuffer;
+    PFN_vkQueueSubmit                             queueSubmit;
+    PFN_vkCreateFence                             createFence;
+    PFN_vkDestroyFence                            destroyFence;
+    PFN_vkWaitForFences                           waitForFences;
+    PFN_vkResetFences                             resetFences;
+    PFN_vkCmdBeginRenderPass                      cmdBeginRenderPass;
+    PFN_vkCmdEndRenderPass                        cmdEndRenderPass;
+    PFN_vkCmdBeginRenderingKHR                    cmdBeginRenderingKHR; // only loaded with dynamic rendering
+    PFN_vkCmdEndRenderingKHR                      cmdEndRenderingKHR;
+    PFN_vkCmdBindPipeline                         cmdBindPipeline;
+    PFN_vkCmdSetViewport                          cmdSetViewport;
+    PFN_vkCmdSetScissor                           cmdSetScissor;
+    PFN_vkCmdCopyBuffer                           cmdCopyBuffer;
+    PFN_vkCmdPipelineBarrier                      cmdPipelineBarrier;
+    PFN_vkCmdBindVertexBuffers                    cmdBindVertexBuffers;
+    PFN_vkCmdBindDescriptorSets                   cmdBindDescriptorSets;
+    PFN_vkCmdPushConstants                        cmdPushConstants;
+    PFN_vkCmdBindIndexBuffer                      cmdBindIndexBuffer;
+    PFN_vkCmdDraw                                 cmdDraw;
+    PFN_vkCmdDrawIndexed                          cmdDrawIndexed;
+    PFN_vkCmdExecuteCommands                      cmdExecuteCommands;
 
     const LvnGraphicsContext*                     graphicsctx;
     bool                                          enableValidationLayers;
+    bool                                          enableParallelPipelineCreation;
+    bool                                          inlineShaderCode;     // shaders hold LvnVkShaderCode instead of a VkShaderModule
+    bool                                          dynamicRendering;     // surfaces have no render pass or framebuffers, rendering begins on the image views
     VkInstance                                    instance;
     VkDebugUtilsMessengerEXT                      debugMessenger;
     VkPhysicalDevice                              physicalDevice;
     VkDevice                                      device;
     VkQueue                                       graphicsQueue;
     VkQueue                                       presentQueue;
+    VkQueue                                       transferQueue;        // graphicsQueue if there is no separate transfer family
+    uint32_t                                      graphicsQueueFamilyIndex;
+    uint32_t                                      transferQueueFamilyIndex;
+    uint32_t                                      queueLock;            // spin lock guarding queue submission and frameSync
+    LvnVkFrameSync                                frameSync[LVN_MAX_FRAMES_IN_FLIGHT];
+    LvnHashTable                                  threadCommandPoolTable; // LvnVkThreadCommandPools by thread id
+    uint32_t                                      threadCommandPoolLock;
+    VkPipelineCache                               pipelineCache;
+    LvnHashTable                                  pipelineLayoutTable;  // LvnVkPipelineLayoutEntry by signature hash
+    uint32_t                                      pipelineLayoutLock;
+    uint32_t                                      maxPushConstantsSize; // offset + size limit of push constant ranges
+    uint32_t                                      pipelineCacheHitCount;
+    uint32_t                                      pipelineCacheMissCount;
+    int64_t                                       pipelineCreationTimeNs;
+    LvnVkMemoryAllocator                          memoryAllocator;
+    LvnVkStagingRing                              stagingRing;
+    bool                                          bindless;             // descriptor indexing features were enabled for the bindless set
+    LvnVkBindlessSet                              bindlessSet;
 
     struct
     {
@@ -105,8 +464,35 @@ typedef struct LvnVulkanBackends
         bool                                      KHR_xcb_surface;
         bool                                      KHR_wayland_surface;
         bool                                      EXT_headless_surface;
+        bool                                      EXT_pipeline_creation_feedback;
+        bool                                      EXT_descriptor_indexing;
+        bool                                      KHR_dynamic_rendering;
+        bool                                      KHR_depth_stencil_resolve;
+        bool                                      KHR_create_renderpass2;
+        bool                                      KHR_maintenance5;
     } ext;
 
 } LvnVulkanBackends;
 
+
+// device memory, allocations are thread safe
+void      lvn_vkMemoryAllocatorInit(LvnVulkanBackends* vkBackends);
+void      lvn_vkMemoryAllocatorTerminate(LvnVulkanBackends* vkBackends);
+LvnResult lvn_vkAllocateMemory(LvnVulkanBackends* vkBackends, const LvnVkAllocationCreateInfo* createInfo, LvnVkAllocation* allocation);
+void      lvn_vkFreeMemory(LvnVulkanBackends* vkBackends, LvnVkAllocation* allocation);
+LvnResult lvn_vkFlushMemory(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size);      // offset is relative to the allocation, no-op on host coherent memory
+LvnResult lvn_vkInvalidateMemory(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size);
+
+// staging ring, writes are thread safe
+LvnResult lvn_vkStagingInit(LvnVulkanBackends* vkBackends, const LvnGraphicsContextCreateInfo* createInfo);
+void      lvn_vkStagingTerminate(LvnVulkanBackends* vkBackends);                                                         // the device must be idle
+LvnResult lvn_vkStagingWriteBuffer(LvnVulkanBackends* vkBackends, VkBuffer buffer, const void* data, VkDeviceSize size, VkDeviceSize offset);
+LvnResult lvn_vkStagingFlush(LvnVulkanBackends* vkBackends);                                                             // submit the copies recorded so far
+
+// bindless set, adding and removing resources is thread safe
+LvnResult lvn_vkBindlessInit(LvnVulkanBackends* vkBackends);
+void      lvn_vkBindlessTerminate(LvnVulkanBackends* vkBackends);
+uint32_t  lvn_vkBindlessAddBuffer(LvnVulkanBackends* vkBackends, VkBuffer buffer);                                      // LVN_BINDLESS_INVALID_INDEX if the array is full
+void      lvn_vkBindlessRemove(LvnVulkanBackends* vkBackends, uint32_t binding, uint32_t index);
+
 #endif // !HG_LVN_VK_BACKENDS_H
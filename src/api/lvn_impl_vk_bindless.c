@@ -0,0 +1,219 @@
+#include "lvn_impl_vk.h"
+#include "lvn_impl_vk_backends.h"
+
+#include <string.h>
+
+
+// bindless set
+// - one descriptor set with a partially bound array per resource type, created from an update after bind pool
+// - descriptors are written when resources are created and may change while the set is bound in pending command buffers,
+//   slots of destroyed resources keep their stale descriptor until reused, shaders must not index them
+// - indices are stable for the lifetime of a resource, freed indices are reused first
+
+#define LVN_VK_BINDLESS_STORAGE_BUFFER_COUNT  16384
+#define LVN_VK_BINDLESS_SAMPLED_IMAGE_COUNT   16384
+#define LVN_VK_BINDLESS_SAMPLER_COUNT         1024
+
+
+static uint32_t                    lvn_bindlessClamp(uint32_t count, uint32_t perStageLimit, uint32_t setLimit);
+static uint32_t                    lvn_bindlessAcquireIndex(LvnVkBindlessArray* array);
+
+
+static uint32_t lvn_bindlessClamp(uint32_t count, uint32_t perStageLimit, uint32_t setLimit)
+{
+    if (count > perStageLimit)
+        count = perStageLimit;
+    if (count > setLimit)
+        count = setLimit;
+    return count;
+}
+
+static uint32_t lvn_bindlessAcquireIndex(LvnVkBindlessArray* array)
+{
+    if (array->freeCount)
+        return array->pFreeIndices[--array->freeCount];
+
+    if (array->nextIndex < array->capacity)
+        return array->nextIndex++;
+
+    return LVN_BINDLESS_INVALID_INDEX;
+}
+
+LvnResult lvn_vkBindlessInit(LvnVulkanBackends* vkBackends)
+{
+    LvnVkBindlessSet* bindlessSet = &vkBackends->bindlessSet;
+    LvnLogger* logger = vkBackends->graphicsctx->coreLogger;
+
+    memset(bindlessSet, 0, sizeof(LvnVkBindlessSet));
+
+    // update after bind limits can be lower than the regular ones
+    VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {0};
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 properties2 = {0};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &indexingProperties;
+    vkBackends->getPhysicalDeviceProperties2(vkBackends->physicalDevice, &properties2);
+
+    uint32_t counts[LVN_VK_BINDLESS_BINDING_COUNT];
+    counts[LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS] = lvn_bindlessClamp(LVN_VK_BINDLESS_STORAGE_BUFFER_COUNT,
+        indexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers);
+    counts[LVN_VK_BINDLESS_BINDING_SAMPLED_IMAGES] = lvn_bindlessClamp(LVN_VK_BINDLESS_SAMPLED_IMAGE_COUNT,
+        indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+    counts[LVN_VK_BINDLESS_BINDING_SAMPLERS] = lvn_bindlessClamp(LVN_VK_BINDLESS_SAMPLER_COUNT,
+        indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers);
+
+    const VkDescriptorType types[LVN_VK_BINDLESS_BINDING_COUNT] =
+    {
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+        VK_DESCRIPTOR_TYPE_SAMPLER,
+    };
+
+    VkDescriptorSetLayoutBinding layoutBindings[LVN_VK_BINDLESS_BINDING_COUNT];
+    VkDescriptorBindingFlags bindingFlags[LVN_VK_BINDLESS_BINDING_COUNT];
+    VkDescriptorPoolSize poolSizes[LVN_VK_BINDLESS_BINDING_COUNT];
+
+    for (uint32_t i = 0; i < LVN_VK_BINDLESS_BINDING_COUNT; i++)
+    {
+        if (!counts[i])
+        {
+            LVN_LOG_ERROR(logger, "[vulkan] failed to create bindless set, the device has no update after bind descriptors of type %d", types[i]);
+            return Lvn_Result_Failure;
+        }
+
+        layoutBindings[i] = (VkDescriptorSetLayoutBinding) {0};
+        layoutBindings[i].binding = i;
+        layoutBindings[i].descriptorType = types[i];
+        layoutBindings[i].descriptorCount = counts[i];
+        layoutBindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+
+        bindingFlags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+        poolSizes[i].type = types[i];
+        poolSizes[i].descriptorCount = counts[i];
+
+        bindlessSet->arrays[i].capacity = counts[i];
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {0};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = LVN_VK_BINDLESS_BINDING_COUNT;
+    bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {0};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = LVN_VK_BINDLESS_BINDING_COUNT;
+    layoutInfo.pBindings = layoutBindings;
+
+    if (vkBackends->createDescriptorSetLayout(vkBackends->device, &layoutInfo, NULL, &bindlessSet->setLayout) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(logger, "[vulkan] failed to create bindless descriptor set layout");
+        return Lvn_Result_Failure;
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo = {0};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = LVN_VK_BINDLESS_BINDING_COUNT;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkBackends->createDescriptorPool(vkBackends->device, &poolInfo, NULL, &bindlessSet->descriptorPool) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(logger, "[vulkan] failed to create bindless descriptor pool");
+        return Lvn_Result_Failure;
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {0};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = bindlessSet->descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &bindlessSet->setLayout;
+
+    if (vkBackends->allocateDescriptorSets(vkBackends->device, &allocInfo, &bindlessSet->descriptorSet) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(logger, "[vulkan] failed to allocate bindless descriptor set");
+        return Lvn_Result_Failure;
+    }
+
+    for (uint32_t i = 0; i < LVN_VK_BINDLESS_BINDING_COUNT; i++)
+    {
+        bindlessSet->arrays[i].pFreeIndices = (uint32_t*) lvn_malloc(counts[i] * sizeof(uint32_t));
+        if (!bindlessSet->arrays[i].pFreeIndices)
+            return Lvn_Result_Failure;
+    }
+
+    // the layout has no bindings lvnUpdateDescriptorSet could write, resources fill it as they are created
+    bindlessSet->layout.graphicsctx = vkBackends->graphicsctx;
+    bindlessSet->layout.descriptorLayout = bindlessSet->setLayout;
+    bindlessSet->layout.refCount = 1;
+
+    bindlessSet->set.graphicsctx = vkBackends->graphicsctx;
+    bindlessSet->set.descriptorLayout = &bindlessSet->layout;
+    bindlessSet->set.descriptorSet = bindlessSet->descriptorSet;
+
+    LVN_LOG_TRACE(logger, "[vulkan] bindless set created, storage buffers: %u, sampled images: %u, samplers: %u",
+                  counts[LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS], counts[LVN_VK_BINDLESS_BINDING_SAMPLED_IMAGES], counts[LVN_VK_BINDLESS_BINDING_SAMPLERS]);
+
+    return Lvn_Result_Success;
+}
+
+void lvn_vkBindlessTerminate(LvnVulkanBackends* vkBackends)
+{
+    LvnVkBindlessSet* bindlessSet = &vkBackends->bindlessSet;
+
+    // destroying the pool frees the set
+    if (bindlessSet->descriptorPool)
+        vkBackends->destroyDescriptorPool(vkBackends->device, bindlessSet->descriptorPool, NULL);
+    if (bindlessSet->setLayout)
+        vkBackends->destroyDescriptorSetLayout(vkBackends->device, bindlessSet->setLayout, NULL);
+
+    for (uint32_t i = 0; i < LVN_VK_BINDLESS_BINDING_COUNT; i++)
+        lvn_free(bindlessSet->arrays[i].pFreeIndices);
+
+    memset(bindlessSet, 0, sizeof(LvnVkBindlessSet));
+}
+
+uint32_t lvn_vkBindlessAddBuffer(LvnVulkanBackends* vkBackends, VkBuffer buffer)
+{
+    LvnVkBindlessSet* bindlessSet = &vkBackends->bindlessSet;
+
+    VkDescriptorBufferInfo bufferInfo = {0};
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet write = {0};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = bindlessSet->descriptorSet;
+    write.dstBinding = LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &bufferInfo;
+
+    // writes to one set from several threads must not overlap, even to different descriptors
+    lvn_spinLock(&bindlessSet->lock);
+
+    uint32_t index = lvn_bindlessAcquireIndex(&bindlessSet->arrays[LVN_VK_BINDLESS_BINDING_STORAGE_BUFFERS]);
+    if (index != LVN_BINDLESS_INVALID_INDEX)
+    {
+        write.dstArrayElement = index;
+        vkBackends->updateDescriptorSets(vkBackends->device, 1, &write, 0, NULL);
+    }
+
+    lvn_spinUnlock(&bindlessSet->lock);
+
+    return index;
+}
+
+void lvn_vkBindlessRemove(LvnVulkanBackends* vkBackends, uint32_t binding, uint32_t index)
+{
+    LvnVkBindlessArray* array = &vkBackends->bindlessSet.arrays[binding];
+
+    lvn_spinLock(&vkBackends->bindlessSet.lock);
+    array->pFreeIndices[array->freeCount++] = index;
+    lvn_spinUnlock(&vkBackends->bindlessSet.lock);
+}
@@ -0,0 +1,742 @@
+#include "lvn_impl_vk.h"
+#include "lvn_impl_vk_backends.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+// device memory sub-allocator
+// - every memory type gets a list of large blocks, resources are placed in them with a two level segregated fit (tlsf) allocator
+// - a free range is found in O(1) through the first and second level bitmaps, freed ranges are merged with their free neighbours
+// - linear and optimal resources on the same bufferImageGranularity page are kept apart
+// - resources larger than half a block, or that ask for it, get a dedicated VkDeviceMemory that is freed when the resource is destroyed
+
+// heaps up to this size use an eighth of the heap as block size, larger heaps use LVN_VK_MEMORY_LARGE_HEAP_BLOCK_SIZE
+#define LVN_VK_MEMORY_SMALL_HEAP_MAX_SIZE     (1024ull * 1024 * 1024)
+#define LVN_VK_MEMORY_LARGE_HEAP_BLOCK_SIZE   (256ull * 1024 * 1024)
+#define LVN_VK_MEMORY_BLOCK_SIZE_FALLBACKS    3 // halve the block size this many times when the full size cannot be allocated
+
+
+static uint32_t                    lvn_bitScanForward32(uint32_t value);
+static uint32_t                    lvn_bitScanReverse64(uint64_t value);
+static uint32_t                    lvn_bitCount32(uint32_t value);
+static VkDeviceSize                lvn_alignUp(VkDeviceSize value, VkDeviceSize alignment);
+static void                        lvn_tlsfMapping(VkDeviceSize size, uint32_t* fl, uint32_t* sl);
+static void                        lvn_tlsfInsertFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range);
+static void                        lvn_tlsfRemoveFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range);
+static LvnVkMemoryRange*           lvn_tlsfFindFree(const LvnVkMemoryBlock* block, VkDeviceSize size);
+static bool                        lvn_allocationTypesConflict(const LvnVkMemoryRange* range, LvnVkAllocationType type, VkDeviceSize a, VkDeviceSize b, VkDeviceSize granularity);
+static LvnVkMemoryRange*           lvn_blockAllocate(const LvnVkMemoryAllocator* allocator, LvnVkMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, LvnVkAllocationType type, VkDeviceSize* offset);
+static void                        lvn_blockFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range);
+static VkDeviceSize                lvn_blockLargestFreeRange(const LvnVkMemoryBlock* block);
+static LvnResult                   lvn_allocateDeviceMemory(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory* memory, void** pMapped);
+static void                        lvn_freeDeviceMemory(LvnVulkanBackends* vkBackends, VkDeviceMemory memory);
+static LvnVkMemoryBlock*           lvn_createMemoryBlock(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size);
+static void                        lvn_destroyMemoryBlock(LvnVulkanBackends* vkBackends, LvnVkMemoryBlock* block);
+static int32_t                     lvn_findMemoryType(const LvnVkMemoryAllocator* allocator, uint32_t memoryTypeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags preferredFlags);
+static LvnResult                   lvn_allocateDedicated(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size, LvnVkAllocation* allocation);
+static LvnResult                   lvn_allocateFromMemoryType(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, const LvnVkAllocationCreateInfo* createInfo, LvnVkAllocation* allocation);
+static bool                        lvn_getMappedMemoryRange(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size, VkMappedMemoryRange* range);
+
+
+static uint32_t lvn_bitScanForward32(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (uint32_t) index;
+#else
+    return (uint32_t) __builtin_ctz(value);
+#endif
+}
+
+static uint32_t lvn_bitScanReverse64(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (uint32_t) index;
+#else
+    return 63 - (uint32_t) __builtin_clzll(value);
+#endif
+}
+
+static uint32_t lvn_bitCount32(uint32_t value)
+{
+    uint32_t count = 0;
+    for (; value; count++)
+        value &= value - 1;
+    return count;
+}
+
+static VkDeviceSize lvn_alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static void lvn_tlsfMapping(VkDeviceSize size, uint32_t* fl, uint32_t* sl)
+{
+    // sizes below the second level count share the first list linearly, above it every power of two is split into LVN_VK_TLSF_SL_COUNT classes
+    if (size < LVN_VK_TLSF_SL_COUNT)
+    {
+        *fl = 0;
+        *sl = (uint32_t) size;
+        return;
+    }
+
+    uint32_t log2 = lvn_bitScanReverse64(size);
+    *fl = log2 - LVN_VK_TLSF_SL_LOG2 + 1;
+    *sl = (uint32_t) (size >> (log2 - LVN_VK_TLSF_SL_LOG2)) ^ LVN_VK_TLSF_SL_COUNT;
+}
+
+static void lvn_tlsfInsertFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range)
+{
+    uint32_t fl, sl;
+    lvn_tlsfMapping(range->size, &fl, &sl);
+
+    range->prevFree = NULL;
+    range->nextFree = block->freeLists[fl][sl];
+    if (range->nextFree)
+        range->nextFree->prevFree = range;
+
+    block->freeLists[fl][sl] = range;
+    block->flBitmap |= 1u << fl;
+    block->slBitmaps[fl] |= 1u << sl;
+}
+
+static void lvn_tlsfRemoveFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range)
+{
+    uint32_t fl, sl;
+    lvn_tlsfMapping(range->size, &fl, &sl);
+
+    if (range->nextFree)
+        range->nextFree->prevFree = range->prevFree;
+
+    if (range->prevFree)
+    {
+        range->prevFree->nextFree = range->nextFree;
+    }
+    else
+    {
+        block->freeLists[fl][sl] = range->nextFree;
+        if (!range->nextFree)
+        {
+            block->slBitmaps[fl] &= ~(1u << sl);
+            if (!block->slBitmaps[fl])
+                block->flBitmap &= ~(1u << fl);
+        }
+    }
+
+    range->prevFree = range->nextFree = NULL;
+}
+
+static LvnVkMemoryRange* lvn_tlsfFindFree(const LvnVkMemoryBlock* block, VkDeviceSize size)
+{
+    uint32_t fl, sl;
+    lvn_tlsfMapping(size, &fl, &sl);
+    if (fl >= LVN_VK_TLSF_FL_COUNT)
+        return NULL;
+
+    // round the size up to the next class so every range in the list found fits without walking it
+    LvnVkMemoryRange* exactRange = block->freeLists[fl][sl];
+    if (size >= LVN_VK_TLSF_SL_COUNT)
+        lvn_tlsfMapping(size + ((VkDeviceSize) 1 << (lvn_bitScanReverse64(size) - LVN_VK_TLSF_SL_LOG2)) - 1, &fl, &sl);
+
+    uint32_t slMap = fl < LVN_VK_TLSF_FL_COUNT ? block->slBitmaps[fl] & (~0u << sl) : 0;
+    if (!slMap)
+    {
+        uint32_t flMap = fl + 1 < LVN_VK_TLSF_FL_COUNT ? block->flBitmap & (~0u << (fl + 1)) : 0;
+        if (!flMap)
+        {
+            // last resort, the head of the unrounded class may still be large enough
+            return exactRange && exactRange->size >= size ? exactRange : NULL;
+        }
+
+        fl = lvn_bitScanForward32(flMap);
+        slMap = block->slBitmaps[fl];
+    }
+
+    return block->freeLists[fl][lvn_bitScanForward32(slMap)];
+}
+
+static bool lvn_allocationTypesConflict(const LvnVkMemoryRange* range, LvnVkAllocationType type, VkDeviceSize a, VkDeviceSize b, VkDeviceSize granularity)
+{
+    // a and b are the closest bytes of the two resources, they only conflict on the same page
+    if (!range || range->type == LvnVk_AllocationType_Free || range->type == (uint32_t) type)
+        return false;
+
+    return (a & ~(granularity - 1)) == (b & ~(granularity - 1));
+}
+
+static LvnVkMemoryRange* lvn_blockAllocate(const LvnVkMemoryAllocator* allocator, LvnVkMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, LvnVkAllocationType type, VkDeviceSize* offset)
+{
+    VkDeviceSize granularity = allocator->bufferImageGranularity;
+
+    // worst case padding, so placement below never runs past the end of the range found
+    VkDeviceSize searchSize = size + alignment - 1;
+    if (granularity > 1)
+        searchSize = size + (granularity > alignment ? granularity : alignment) - 1 + granularity - 1;
+
+    LvnVkMemoryRange* range = lvn_tlsfFindFree(block, searchSize);
+    if (!range)
+        return NULL;
+
+    VkDeviceSize rangeEnd = range->offset + range->size;
+    VkDeviceSize start = lvn_alignUp(range->offset, alignment);
+
+    LvnVkMemoryRange* prev = range->prevPhysical;
+    if (granularity > 1 && prev && lvn_allocationTypesConflict(prev, type, prev->offset + prev->size - 1, start, granularity))
+        start = lvn_alignUp(start, granularity);
+
+    VkDeviceSize end = start + size;
+
+    LvnVkMemoryRange* next = range->nextPhysical;
+    if (granularity > 1 && next && lvn_allocationTypesConflict(next, type, end - 1, next->offset, granularity))
+        end = lvn_alignUp(end, granularity);
+
+    LVN_ASSERT(end <= rangeEnd, "tlsf search size does not cover the allocation padding");
+
+    lvn_tlsfRemoveFree(block, range);
+
+    // split the padding in front and the rest behind into free ranges, if that fails they stay part of the allocation
+    if (start > range->offset)
+    {
+        LvnVkMemoryRange* front = (LvnVkMemoryRange*) lvn_calloc(sizeof(LvnVkMemoryRange));
+        if (front)
+        {
+            front->offset = range->offset;
+            front->size = start - range->offset;
+            front->type = LvnVk_AllocationType_Free;
+            front->prevPhysical = prev;
+            front->nextPhysical = range;
+            if (prev)
+                prev->nextPhysical = front;
+            else
+                block->pFirstRange = front;
+            range->prevPhysical = front;
+            range->offset = start;
+            range->size -= front->size;
+            lvn_tlsfInsertFree(block, front);
+        }
+    }
+
+    if (end < rangeEnd)
+    {
+        LvnVkMemoryRange* back = (LvnVkMemoryRange*) lvn_calloc(sizeof(LvnVkMemoryRange));
+        if (back)
+        {
+            back->offset = end;
+            back->size = rangeEnd - end;
+            back->type = LvnVk_AllocationType_Free;
+            back->prevPhysical = range;
+            back->nextPhysical = next;
+            if (next)
+                next->prevPhysical = back;
+            range->nextPhysical = back;
+            range->size -= back->size;
+            lvn_tlsfInsertFree(block, back);
+        }
+    }
+
+    range->type = type;
+    *offset = start;
+    return range;
+}
+
+static void lvn_blockFree(LvnVkMemoryBlock* block, LvnVkMemoryRange* range)
+{
+    range->type = LvnVk_AllocationType_Free;
+
+    LvnVkMemoryRange* prev = range->prevPhysical;
+    if (prev && prev->type == LvnVk_AllocationType_Free)
+    {
+        lvn_tlsfRemoveFree(block, prev);
+        prev->size += range->size;
+        prev->nextPhysical = range->nextPhysical;
+        if (range->nextPhysical)
+            range->nextPhysical->prevPhysical = prev;
+        lvn_free(range);
+        range = prev;
+    }
+
+    LvnVkMemoryRange* next = range->nextPhysical;
+    if (next && next->type == LvnVk_AllocationType_Free)
+    {
+        lvn_tlsfRemoveFree(block, next);
+        range->size += next->size;
+        range->nextPhysical = next->nextPhysical;
+        if (next->nextPhysical)
+            next->nextPhysical->prevPhysical = range;
+        lvn_free(next);
+    }
+
+    lvn_tlsfInsertFree(block, range);
+}
+
+static VkDeviceSize lvn_blockLargestFreeRange(const LvnVkMemoryBlock* block)
+{
+    if (!block->flBitmap)
+        return 0;
+
+    // the largest range is in the highest class in use, ranges inside one class differ in size
+    uint32_t fl = lvn_bitScanReverse64(block->flBitmap);
+    uint32_t sl = lvn_bitScanReverse64(block->slBitmaps[fl]);
+
+    VkDeviceSize largest = 0;
+    for (const LvnVkMemoryRange* range = block->freeLists[fl][sl]; range; range = range->nextFree)
+        largest = range->size > largest ? range->size : largest;
+
+    return largest;
+}
+
+static LvnResult lvn_allocateDeviceMemory(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory* memory, void** pMapped)
+{
+    LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+
+    if (lvn_atomicFetchAdd32(&allocator->deviceMemoryCount, 1) >= allocator->maxDeviceMemoryCount)
+    {
+        lvn_atomicFetchAdd32(&allocator->deviceMemoryCount, (uint32_t) -1);
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to allocate device memory, maxMemoryAllocationCount (%u) reached", allocator->maxDeviceMemoryCount);
+        return Lvn_Result_Failure;
+    }
+
+    VkMemoryAllocateInfo allocInfo = {0};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+    // not logged, callers retry with a smaller block or another memory type
+    if (vkBackends->allocateMemory(vkBackends->device, &allocInfo, NULL, memory) != VK_SUCCESS)
+    {
+        lvn_atomicFetchAdd32(&allocator->deviceMemoryCount, (uint32_t) -1);
+        return Lvn_Result_Failure;
+    }
+
+    // host visible memory stays mapped for its whole lifetime
+    *pMapped = NULL;
+    if (allocator->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        if (vkBackends->mapMemory(vkBackends->device, *memory, 0, VK_WHOLE_SIZE, 0, pMapped) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to map host visible device memory");
+            lvn_freeDeviceMemory(vkBackends, *memory);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    return Lvn_Result_Success;
+}
+
+static void lvn_freeDeviceMemory(LvnVulkanBackends* vkBackends, VkDeviceMemory memory)
+{
+    // freeing also unmaps the memory
+    vkBackends->freeMemory(vkBackends->device, memory, NULL);
+    lvn_atomicFetchAdd32(&vkBackends->memoryAllocator.deviceMemoryCount, (uint32_t) -1);
+}
+
+static LvnVkMemoryBlock* lvn_createMemoryBlock(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size)
+{
+    LvnVkMemoryBlock* block = (LvnVkMemoryBlock*) lvn_calloc(sizeof(LvnVkMemoryBlock));
+    LvnVkMemoryRange* range = (LvnVkMemoryRange*) lvn_calloc(sizeof(LvnVkMemoryRange));
+
+    if (!block || !range || lvn_allocateDeviceMemory(vkBackends, memoryTypeIndex, size, &block->memory, &block->pMapped) != Lvn_Result_Success)
+    {
+        lvn_free(block);
+        lvn_free(range);
+        return NULL;
+    }
+
+    block->size = size;
+    block->pFirstRange = range;
+
+    range->offset = 0;
+    range->size = size;
+    range->type = LvnVk_AllocationType_Free;
+    lvn_tlsfInsertFree(block, range);
+
+    return block;
+}
+
+static void lvn_destroyMemoryBlock(LvnVulkanBackends* vkBackends, LvnVkMemoryBlock* block)
+{
+    LvnVkMemoryRange* range = block->pFirstRange;
+    while (range)
+    {
+        LvnVkMemoryRange* next = range->nextPhysical;
+        lvn_free(range);
+        range = next;
+    }
+
+    lvn_freeDeviceMemory(vkBackends, block->memory);
+    lvn_free(block);
+}
+
+static int32_t lvn_findMemoryType(const LvnVkMemoryAllocator* allocator, uint32_t memoryTypeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags preferredFlags)
+{
+    int32_t bestIndex = -1;
+    uint32_t bestCost = UINT32_MAX;
+
+    // the cost is the number of preferred flags a type is missing, types without the required flags are never used
+    for (uint32_t i = 0; i < allocator->memoryProperties.memoryTypeCount; i++)
+    {
+        if (!(memoryTypeBits & (1u << i)))
+            continue;
+
+        VkMemoryPropertyFlags flags = allocator->memoryProperties.memoryTypes[i].propertyFlags;
+        if ((flags & requiredFlags) != requiredFlags)
+            continue;
+
+        uint32_t cost = lvn_bitCount32(preferredFlags & ~flags);
+        if (cost < bestCost)
+        {
+            bestIndex = (int32_t) i;
+            bestCost = cost;
+        }
+    }
+
+    return bestIndex;
+}
+
+static LvnResult lvn_allocateDedicated(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, VkDeviceSize size, LvnVkAllocation* allocation)
+{
+    LvnVkMemoryTypePool* pool = &vkBackends->memoryAllocator.pools[memoryTypeIndex];
+
+    VkDeviceMemory memory;
+    void* pMapped;
+    if (lvn_allocateDeviceMemory(vkBackends, memoryTypeIndex, size, &memory, &pMapped) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    lvn_spinLock(&pool->lock);
+
+    if (pool->dedicatedCount == pool->dedicatedCapacity)
+    {
+        uint32_t capacity = pool->dedicatedCapacity ? pool->dedicatedCapacity * 2 : 16;
+        VkDeviceMemory* pDedicated = (VkDeviceMemory*) lvn_realloc(pool->pDedicated, capacity * sizeof(VkDeviceMemory));
+        if (!pDedicated)
+        {
+            lvn_spinUnlock(&pool->lock);
+            lvn_freeDeviceMemory(vkBackends, memory);
+            return Lvn_Result_Failure;
+        }
+        pool->pDedicated = pDedicated;
+        pool->dedicatedCapacity = capacity;
+    }
+
+    pool->pDedicated[pool->dedicatedCount++] = memory;
+    pool->dedicatedSize += size;
+
+    lvn_spinUnlock(&pool->lock);
+
+    allocation->memory = memory;
+    allocation->offset = 0;
+    allocation->size = size;
+    allocation->pMapped = pMapped;
+    allocation->memoryTypeIndex = memoryTypeIndex;
+    allocation->block = NULL;
+    allocation->range = NULL;
+
+    return Lvn_Result_Success;
+}
+
+static LvnResult lvn_allocateFromMemoryType(LvnVulkanBackends* vkBackends, uint32_t memoryTypeIndex, const LvnVkAllocationCreateInfo* createInfo, LvnVkAllocation* allocation)
+{
+    const LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+    LvnVkMemoryTypePool* pool = &vkBackends->memoryAllocator.pools[memoryTypeIndex];
+
+    VkDeviceSize size = createInfo->requirements.size;
+    VkDeviceSize alignment = createInfo->requirements.alignment ? createInfo->requirements.alignment : 1;
+
+    // flush and invalidate work on whole atoms, keep neighbours in non coherent memory on separate atoms so invalidating one never drops the other's writes
+    VkMemoryPropertyFlags flags = allocator->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+    if ((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) && allocator->nonCoherentAtomSize > alignment)
+        alignment = allocator->nonCoherentAtomSize;
+
+    if (createInfo->dedicated || size > pool->blockSize / 2)
+        return lvn_allocateDedicated(vkBackends, memoryTypeIndex, size, allocation);
+
+    lvn_spinLock(&pool->lock);
+
+    LvnVkMemoryBlock* block = NULL;
+    LvnVkMemoryRange* range = NULL;
+    VkDeviceSize offset = 0;
+
+    for (uint32_t i = 0; i < pool->blockCount && !range; i++)
+    {
+        block = pool->pBlocks[i];
+        range = lvn_blockAllocate(allocator, block, size, alignment, createInfo->type, &offset);
+    }
+
+    if (!range)
+    {
+        LvnVkMemoryBlock** pBlocks = (LvnVkMemoryBlock**) lvn_realloc(pool->pBlocks, (pool->blockCount + 1) * sizeof(LvnVkMemoryBlock*));
+        if (!pBlocks)
+        {
+            lvn_spinUnlock(&pool->lock);
+            return Lvn_Result_Failure;
+        }
+        pool->pBlocks = pBlocks;
+
+        // a heap close to full may still fit a smaller block
+        block = NULL;
+        VkDeviceSize blockSize = pool->blockSize;
+        for (uint32_t i = 0; i <= LVN_VK_MEMORY_BLOCK_SIZE_FALLBACKS && !block && blockSize >= size * 2; i++, blockSize /= 2)
+            block = lvn_createMemoryBlock(vkBackends, memoryTypeIndex, blockSize);
+
+        if (!block)
+        {
+            lvn_spinUnlock(&pool->lock);
+            return lvn_allocateDedicated(vkBackends, memoryTypeIndex, size, allocation);
+        }
+
+        pool->pBlocks[pool->blockCount++] = block;
+        range = lvn_blockAllocate(allocator, block, size, alignment, createInfo->type, &offset);
+        LVN_ASSERT(range, "allocation does not fit into a new memory block");
+    }
+
+    block->allocationCount++;
+    block->allocatedSize += size;
+
+    lvn_spinUnlock(&pool->lock);
+
+    allocation->memory = block->memory;
+    allocation->offset = offset;
+    allocation->size = size;
+    allocation->pMapped = block->pMapped ? (uint8_t*) block->pMapped + offset : NULL;
+    allocation->memoryTypeIndex = memoryTypeIndex;
+    allocation->block = block;
+    allocation->range = range;
+
+    return Lvn_Result_Success;
+}
+
+void lvn_vkMemoryAllocatorInit(LvnVulkanBackends* vkBackends)
+{
+    LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+
+    vkBackends->getPhysicalDeviceMemoryProperties(vkBackends->physicalDevice, &allocator->memoryProperties);
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkBackends->getPhysicalDeviceProperties(vkBackends->physicalDevice, &deviceProperties);
+
+    allocator->bufferImageGranularity = deviceProperties.limits.bufferImageGranularity ? deviceProperties.limits.bufferImageGranularity : 1;
+    allocator->nonCoherentAtomSize = deviceProperties.limits.nonCoherentAtomSize ? deviceProperties.limits.nonCoherentAtomSize : 1;
+    allocator->maxDeviceMemoryCount = deviceProperties.limits.maxMemoryAllocationCount;
+    allocator->deviceMemoryCount = 0;
+
+    for (uint32_t i = 0; i < allocator->memoryProperties.memoryTypeCount; i++)
+    {
+        VkDeviceSize heapSize = allocator->memoryProperties.memoryHeaps[allocator->memoryProperties.memoryTypes[i].heapIndex].size;
+        allocator->pools[i].blockSize = heapSize <= LVN_VK_MEMORY_SMALL_HEAP_MAX_SIZE
+            ? lvn_alignUp(heapSize / 8, 32)
+            : LVN_VK_MEMORY_LARGE_HEAP_BLOCK_SIZE;
+    }
+}
+
+void lvn_vkMemoryAllocatorTerminate(LvnVulkanBackends* vkBackends)
+{
+    LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+
+    uint32_t leakedCount = 0;
+    for (uint32_t i = 0; i < allocator->memoryProperties.memoryTypeCount; i++)
+    {
+        LvnVkMemoryTypePool* pool = &allocator->pools[i];
+
+        for (uint32_t j = 0; j < pool->blockCount; j++)
+        {
+            leakedCount += pool->pBlocks[j]->allocationCount;
+            lvn_destroyMemoryBlock(vkBackends, pool->pBlocks[j]);
+        }
+
+        // destroying a resource frees its dedicated memory, whatever is left here was leaked and vkDestroyDevice does not free it
+        for (uint32_t j = 0; j < pool->dedicatedCount; j++)
+            lvn_freeDeviceMemory(vkBackends, pool->pDedicated[j]);
+        leakedCount += pool->dedicatedCount;
+
+        lvn_free(pool->pBlocks);
+        lvn_free(pool->pDedicated);
+        memset(pool, 0, sizeof(LvnVkMemoryTypePool));
+    }
+
+    if (leakedCount)
+        LVN_LOG_WARN(vkBackends->graphicsctx->coreLogger, "[vulkan] %u device memory allocations were not freed before the graphics context was destroyed", leakedCount);
+}
+
+LvnResult lvn_vkAllocateMemory(LvnVulkanBackends* vkBackends, const LvnVkAllocationCreateInfo* createInfo, LvnVkAllocation* allocation)
+{
+    LVN_ASSERT(vkBackends && createInfo && allocation, "vkBackends, createInfo, and allocation cannot be null");
+
+    memset(allocation, 0, sizeof(LvnVkAllocation));
+
+    // when the best memory type is out of memory, fall back to the next best type that still has the required flags
+    uint32_t memoryTypeBits = createInfo->requirements.memoryTypeBits;
+    int32_t memoryTypeIndex;
+    while ((memoryTypeIndex = lvn_findMemoryType(&vkBackends->memoryAllocator, memoryTypeBits, createInfo->requiredFlags, createInfo->preferredFlags)) >= 0)
+    {
+        if (lvn_allocateFromMemoryType(vkBackends, (uint32_t) memoryTypeIndex, createInfo, allocation) == Lvn_Result_Success)
+            return Lvn_Result_Success;
+
+        memoryTypeBits &= ~(1u << memoryTypeIndex);
+    }
+
+    LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to allocate %llu bytes of device memory", (unsigned long long) createInfo->requirements.size);
+    return Lvn_Result_Failure;
+}
+
+void lvn_vkFreeMemory(LvnVulkanBackends* vkBackends, LvnVkAllocation* allocation)
+{
+    if (!allocation->memory)
+        return;
+
+    LvnVkMemoryTypePool* pool = &vkBackends->memoryAllocator.pools[allocation->memoryTypeIndex];
+
+    if (!allocation->block)
+    {
+        lvn_spinLock(&pool->lock);
+        for (uint32_t i = 0; i < pool->dedicatedCount; i++)
+        {
+            if (pool->pDedicated[i] == allocation->memory)
+            {
+                pool->pDedicated[i] = pool->pDedicated[--pool->dedicatedCount];
+                break;
+            }
+        }
+        pool->dedicatedSize -= allocation->size;
+        lvn_spinUnlock(&pool->lock);
+
+        lvn_freeDeviceMemory(vkBackends, allocation->memory);
+
+        memset(allocation, 0, sizeof(LvnVkAllocation));
+        return;
+    }
+
+    LvnVkMemoryBlock* block = allocation->block;
+    LvnVkMemoryBlock* emptyBlock = NULL;
+
+    lvn_spinLock(&pool->lock);
+
+    lvn_blockFree(block, allocation->range);
+    block->allocationCount--;
+    block->allocatedSize -= allocation->size;
+
+    // keep one empty block per memory type so allocating and freeing around a block boundary does not hit vkAllocateMemory every time
+    if (block->allocationCount == 0)
+    {
+        uint32_t blockIndex = 0;
+        bool otherEmptyBlock = false;
+        for (uint32_t i = 0; i < pool->blockCount; i++)
+        {
+            if (pool->pBlocks[i] == block)
+                blockIndex = i;
+            else if (pool->pBlocks[i]->allocationCount == 0)
+                otherEmptyBlock = true;
+        }
+
+        if (otherEmptyBlock)
+        {
+            pool->pBlocks[blockIndex] = pool->pBlocks[--pool->blockCount];
+            emptyBlock = block;
+        }
+    }
+
+    lvn_spinUnlock(&pool->lock);
+
+    if (emptyBlock)
+        lvn_destroyMemoryBlock(vkBackends, emptyBlock);
+
+    memset(allocation, 0, sizeof(LvnVkAllocation));
+}
+
+static bool lvn_getMappedMemoryRange(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size, VkMappedMemoryRange* range)
+{
+    const LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+
+    VkMemoryPropertyFlags flags = allocator->memoryProperties.memoryTypes[allocation->memoryTypeIndex].propertyFlags;
+    if (!(flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) || (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        return false;
+
+    // the range is widened to whole atoms, the end of the memory object is allowed as is
+    VkDeviceSize atom = allocator->nonCoherentAtomSize;
+    VkDeviceSize memorySize = allocation->block ? allocation->block->size : allocation->size;
+    VkDeviceSize start = (allocation->offset + offset) & ~(atom - 1);
+    VkDeviceSize end = lvn_alignUp(allocation->offset + offset + size, atom);
+    if (end > memorySize)
+        end = memorySize;
+
+    memset(range, 0, sizeof(VkMappedMemoryRange));
+    range->sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range->memory = allocation->memory;
+    range->offset = start;
+    range->size = end - start;
+    return true;
+}
+
+LvnResult lvn_vkFlushMemory(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size)
+{
+    VkMappedMemoryRange range;
+    if (!lvn_getMappedMemoryRange(vkBackends, allocation, offset, size, &range))
+        return Lvn_Result_Success;
+
+    if (vkBackends->flushMappedMemoryRanges(vkBackends->device, 1, &range) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to flush mapped memory range");
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnResult lvn_vkInvalidateMemory(const LvnVulkanBackends* vkBackends, const LvnVkAllocation* allocation, VkDeviceSize offset, VkDeviceSize size)
+{
+    VkMappedMemoryRange range;
+    if (!lvn_getMappedMemoryRange(vkBackends, allocation, offset, size, &range))
+        return Lvn_Result_Success;
+
+    if (vkBackends->invalidateMappedMemoryRanges(vkBackends->device, 1, &range) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to invalidate mapped memory range");
+        return Lvn_Result_Failure;
+    }
+
+    return Lvn_Result_Success;
+}
+
+LvnGraphicsMemoryStats lvnImplVkGetMemoryStats(const LvnGraphicsContext* graphicsctx)
+{
+    LvnVulkanBackends* vkBackends = (LvnVulkanBackends*) graphicsctx->implData;
+    LvnVkMemoryAllocator* allocator = &vkBackends->memoryAllocator;
+
+    LvnGraphicsMemoryStats stats = {0};
+
+    for (uint32_t i = 0; i < allocator->memoryProperties.memoryTypeCount; i++)
+    {
+        LvnVkMemoryTypePool* pool = &allocator->pools[i];
+
+        lvn_spinLock(&pool->lock);
+
+        for (uint32_t j = 0; j < pool->blockCount; j++)
+        {
+            const LvnVkMemoryBlock* block = pool->pBlocks[j];
+            VkDeviceSize largestFree = lvn_blockLargestFreeRange(block);
+
+            stats.blockCount++;
+            stats.blockBytes += block->size;
+            stats.allocationCount += block->allocationCount;
+            stats.allocationBytes += block->allocatedSize;
+            if (largestFree > stats.largestFreeRange)
+                stats.largestFreeRange = largestFree;
+        }
+
+        stats.dedicatedAllocationCount += pool->dedicatedCount;
+        stats.dedicatedAllocationBytes += pool->dedicatedSize;
+
+        lvn_spinUnlock(&pool->lock);
+    }
+
+    stats.deviceMemoryCount = lvn_atomicLoad32(&allocator->deviceMemoryCount);
+    stats.maxDeviceMemoryCount = allocator->maxDeviceMemoryCount;
+
+    return stats;
+}
@@ -0,0 +1,416 @@
+#include "lvn_impl_vk.h"
+#include "lvn_impl_vk_backends.h"
+
+#include <string.h>
+
+
+// staging ring
+// - writes to gpu only buffers are copied into one persistently mapped buffer and recorded as copy commands into the current batch
+// - a batch is submitted before the next command buffer submission, or earlier when the ring runs out of space
+// - with a separate transfer family the copies run on the transfer queue into buffers shared by both families, a graphics queue
+//   submission waits on the batch semaphore and its barrier orders later graphics submissions after the copies
+// - without one, the copies run on the graphics queue followed by a barrier for every later command
+
+#define LVN_VK_STAGING_COPY_ALIGNMENT 16
+
+
+static LvnResult                   lvn_stagingBeginBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch);
+static LvnResult                   lvn_stagingSubmitBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch);
+static LvnResult                   lvn_stagingReclaimBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch);
+static LvnResult                   lvn_stagingMakeSpace(LvnVulkanBackends* vkBackends);
+static bool                        lvn_stagingReserve(LvnVkStagingRing* ring, VkDeviceSize size, VkDeviceSize* offset);
+
+
+static LvnResult lvn_stagingBeginBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch)
+{
+    if (batch->state == LvnVk_StagingBatchState_Recording)
+        return Lvn_Result_Success;
+
+    // retiring drops the ring lock, the caller looks at the ring again before recording
+    if (batch->state == LvnVk_StagingBatchState_Pending)
+        return lvn_stagingReclaimBatch(vkBackends, batch);
+
+    vkBackends->resetCommandPool(vkBackends->device, batch->transferCommandPool, 0);
+    if (batch->waitCommandPool)
+        vkBackends->resetCommandPool(vkBackends->device, batch->waitCommandPool, 0);
+
+    VkCommandBufferBeginInfo beginInfo = {0};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBackends->beginCommandBuffer(batch->transferCommandBuffer, &beginInfo) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to begin staging command buffer");
+        return Lvn_Result_Failure;
+    }
+
+    batch->state = LvnVk_StagingBatchState_Recording;
+    return Lvn_Result_Success;
+}
+
+static LvnResult lvn_stagingSubmitBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+    LvnLogger* logger = vkBackends->graphicsctx->coreLogger;
+
+    // the semaphore signal already covers the copies on a separate transfer queue
+    if (!ring->separateTransferQueue)
+    {
+        VkMemoryBarrier barrier = {0};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        vkBackends->cmdPipelineBarrier(batch->transferCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                       0, 1, &barrier, 0, NULL, 0, NULL);
+    }
+
+    if (vkBackends->endCommandBuffer(batch->transferCommandBuffer) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(logger, "[vulkan] failed to record staging command buffer");
+        return Lvn_Result_Failure;
+    }
+
+    if (ring->separateTransferQueue)
+    {
+        VkCommandBufferBeginInfo beginInfo = {0};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        // the semaphore wait only orders the commands of its own submission, the barrier carries that to every later one
+        VkMemoryBarrier barrier = {0};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        if (vkBackends->beginCommandBuffer(batch->waitCommandBuffer, &beginInfo) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(logger, "[vulkan] failed to begin staging wait command buffer");
+            return Lvn_Result_Failure;
+        }
+
+        vkBackends->cmdPipelineBarrier(batch->waitCommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                       0, 1, &barrier, 0, NULL, 0, NULL);
+
+        if (vkBackends->endCommandBuffer(batch->waitCommandBuffer) != VK_SUCCESS)
+        {
+            LVN_LOG_ERROR(logger, "[vulkan] failed to record staging wait command buffer");
+            return Lvn_Result_Failure;
+        }
+    }
+
+    VkSubmitInfo transferSubmit = {0};
+    transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    transferSubmit.commandBufferCount = 1;
+    transferSubmit.pCommandBuffers = &batch->transferCommandBuffer;
+
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo waitSubmit = {0};
+    waitSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    waitSubmit.waitSemaphoreCount = 1;
+    waitSubmit.pWaitSemaphores = &batch->semaphore;
+    waitSubmit.pWaitDstStageMask = &waitStage;
+    waitSubmit.commandBufferCount = 1;
+    waitSubmit.pCommandBuffers = &batch->waitCommandBuffer;
+
+    if (ring->separateTransferQueue)
+    {
+        transferSubmit.signalSemaphoreCount = 1;
+        transferSubmit.pSignalSemaphores = &batch->semaphore;
+    }
+
+    LvnResult result = Lvn_Result_Success;
+
+    lvn_spinLock(&vkBackends->queueLock);
+
+    if (vkBackends->queueSubmit(vkBackends->transferQueue, 1, &transferSubmit, batch->fences[0]) != VK_SUCCESS)
+        result = Lvn_Result_Failure;
+    else if (ring->separateTransferQueue && vkBackends->queueSubmit(vkBackends->graphicsQueue, 1, &waitSubmit, batch->fences[1]) != VK_SUCCESS)
+        result = Lvn_Result_Failure;
+
+    lvn_spinUnlock(&vkBackends->queueLock);
+
+    if (result != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(logger, "[vulkan] failed to submit staging copies");
+        return Lvn_Result_Failure;
+    }
+
+    batch->ringEnd = ring->head;
+    batch->state = LvnVk_StagingBatchState_Pending;
+    ring->batchIndex = (ring->batchIndex + 1) % LVN_VK_STAGING_BATCH_COUNT;
+
+    return Lvn_Result_Success;
+}
+
+// called and returns with the ring lock held, the lock is dropped while waiting so other threads keep recording meanwhile.
+// the ring may have changed once this returns, callers look at it again
+static LvnResult lvn_stagingReclaimBatch(LvnVulkanBackends* vkBackends, LvnVkStagingBatch* batch)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+    uint32_t fenceCount = ring->separateTransferQueue ? 2 : 1;
+
+    // one thread waits for a batch and resets its fences, the others back off until it is retired
+    if (batch->reclaiming)
+    {
+        lvn_spinUnlock(&ring->lock);
+        lvn_platformYieldThread();
+        lvn_spinLock(&ring->lock);
+        return Lvn_Result_Success;
+    }
+
+    VkFence fences[LVN_ARRAY_LEN(batch->fences)];
+    memcpy(fences, batch->fences, sizeof(fences));
+    batch->reclaiming = true;
+
+    lvn_spinUnlock(&ring->lock);
+    VkResult waitResult = vkBackends->waitForFences(vkBackends->device, fenceCount, fences, VK_TRUE, UINT64_MAX);
+    lvn_spinLock(&ring->lock);
+
+    batch->reclaiming = false;
+
+    if (waitResult != VK_SUCCESS || vkBackends->resetFences(vkBackends->device, fenceCount, fences) != VK_SUCCESS)
+    {
+        LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to wait for staging copies");
+        return Lvn_Result_Failure;
+    }
+
+    ring->tail = batch->ringEnd;
+    batch->state = LvnVk_StagingBatchState_Idle;
+
+    // start over at the front once nothing is left in the ring, so the next uploads do not have to wrap.
+    // the batch being recorded holds nothing either then, its regions would lie between the tail and the head
+    if (ring->tail == ring->head)
+        ring->head = ring->tail = 0;
+
+    return Lvn_Result_Success;
+}
+
+static LvnResult lvn_stagingMakeSpace(LvnVulkanBackends* vkBackends)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+
+    // batches are submitted in index order, so the oldest one is found first starting at the current index
+    for (uint32_t i = 0; i < LVN_VK_STAGING_BATCH_COUNT; i++)
+    {
+        LvnVkStagingBatch* batch = &ring->batches[(ring->batchIndex + i) % LVN_VK_STAGING_BATCH_COUNT];
+        if (batch->state == LvnVk_StagingBatchState_Pending)
+            return lvn_stagingReclaimBatch(vkBackends, batch);
+    }
+
+    // nothing in flight, the batch being recorded fills the ring on its own
+    LvnVkStagingBatch* batch = &ring->batches[ring->batchIndex];
+    if (batch->state == LvnVk_StagingBatchState_Recording)
+    {
+        if (lvn_stagingSubmitBatch(vkBackends, batch) != Lvn_Result_Success)
+            return Lvn_Result_Failure;
+
+        return lvn_stagingReclaimBatch(vkBackends, batch);
+    }
+
+    return Lvn_Result_Failure;
+}
+
+static bool lvn_stagingReserve(LvnVkStagingRing* ring, VkDeviceSize size, VkDeviceSize* offset)
+{
+    VkDeviceSize start = (ring->head + LVN_VK_STAGING_COPY_ALIGNMENT - 1) & ~((VkDeviceSize) LVN_VK_STAGING_COPY_ALIGNMENT - 1);
+
+    // the head never catches up with the tail, head == tail always means the ring is empty
+    if (ring->head >= ring->tail)
+    {
+        if (start + size > ring->size)
+        {
+            if (size >= ring->tail)
+                return false;
+            start = 0;
+        }
+    }
+    else if (start + size >= ring->tail)
+    {
+        return false;
+    }
+
+    ring->head = start + size;
+    *offset = start;
+    return true;
+}
+
+LvnResult lvn_vkStagingInit(LvnVulkanBackends* vkBackends, const LvnGraphicsContextCreateInfo* createInfo)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+
+    memset(ring, 0, sizeof(LvnVkStagingRing));
+    ring->size = createInfo->stagingBufferSize ? createInfo->stagingBufferSize : LVN_VK_STAGING_DEFAULT_SIZE;
+    ring->separateTransferQueue = vkBackends->transferQueueFamilyIndex != vkBackends->graphicsQueueFamilyIndex;
+
+    VkBufferCreateInfo bufferInfo = {0};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = ring->size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkBackends->createBuffer(vkBackends->device, &bufferInfo, NULL, &ring->buffer) != VK_SUCCESS)
+        return Lvn_Result_Failure;
+
+    LvnVkAllocationCreateInfo allocInfo = {0};
+    vkBackends->getBufferMemoryRequirements(vkBackends->device, ring->buffer, &allocInfo.requirements);
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    allocInfo.type = LvnVk_AllocationType_Linear;
+    allocInfo.dedicated = true;
+
+    if (lvn_vkAllocateMemory(vkBackends, &allocInfo, &ring->allocation) != Lvn_Result_Success ||
+        vkBackends->bindBufferMemory(vkBackends->device, ring->buffer, ring->allocation.memory, ring->allocation.offset) != VK_SUCCESS)
+        return Lvn_Result_Failure;
+
+    VkCommandPoolCreateInfo poolInfo = {0};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+    VkCommandBufferAllocateInfo commandBufferInfo = {0};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferInfo.commandBufferCount = 1;
+
+    VkFenceCreateInfo fenceInfo = {0};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {0};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (uint32_t i = 0; i < LVN_VK_STAGING_BATCH_COUNT; i++)
+    {
+        LvnVkStagingBatch* batch = &ring->batches[i];
+
+        poolInfo.queueFamilyIndex = vkBackends->transferQueueFamilyIndex;
+        if (vkBackends->createCommandPool(vkBackends->device, &poolInfo, NULL, &batch->transferCommandPool) != VK_SUCCESS)
+            return Lvn_Result_Failure;
+
+        commandBufferInfo.commandPool = batch->transferCommandPool;
+        if (vkBackends->allocateCommandBuffers(vkBackends->device, &commandBufferInfo, &batch->transferCommandBuffer) != VK_SUCCESS ||
+            vkBackends->createFence(vkBackends->device, &fenceInfo, NULL, &batch->fences[0]) != VK_SUCCESS)
+            return Lvn_Result_Failure;
+
+        if (!ring->separateTransferQueue)
+            continue;
+
+        poolInfo.queueFamilyIndex = vkBackends->graphicsQueueFamilyIndex;
+        if (vkBackends->createCommandPool(vkBackends->device, &poolInfo, NULL, &batch->waitCommandPool) != VK_SUCCESS)
+            return Lvn_Result_Failure;
+
+        commandBufferInfo.commandPool = batch->waitCommandPool;
+        if (vkBackends->allocateCommandBuffers(vkBackends->device, &commandBufferInfo, &batch->waitCommandBuffer) != VK_SUCCESS ||
+            vkBackends->createFence(vkBackends->device, &fenceInfo, NULL, &batch->fences[1]) != VK_SUCCESS ||
+            vkBackends->createSemaphore(vkBackends->device, &semaphoreInfo, NULL, &batch->semaphore) != VK_SUCCESS)
+            return Lvn_Result_Failure;
+    }
+
+    LVN_LOG_TRACE(vkBackends->graphicsctx->coreLogger, "[vulkan] staging ring of %llu bytes, %s",
+                  (unsigned long long) ring->size,
+                  ring->separateTransferQueue ? "copies on a separate transfer queue" : "copies on the graphics queue");
+
+    return Lvn_Result_Success;
+}
+
+void lvn_vkStagingTerminate(LvnVulkanBackends* vkBackends)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+
+    // also called after a partial init, only objects that were created are destroyed
+    for (uint32_t i = 0; i < LVN_VK_STAGING_BATCH_COUNT; i++)
+    {
+        LvnVkStagingBatch* batch = &ring->batches[i];
+
+        if (batch->transferCommandPool)
+            vkBackends->destroyCommandPool(vkBackends->device, batch->transferCommandPool, NULL);
+        if (batch->waitCommandPool)
+            vkBackends->destroyCommandPool(vkBackends->device, batch->waitCommandPool, NULL);
+        if (batch->semaphore)
+            vkBackends->destroySemaphore(vkBackends->device, batch->semaphore, NULL);
+        for (uint32_t j = 0; j < LVN_ARRAY_LEN(batch->fences); j++)
+        {
+            if (batch->fences[j])
+                vkBackends->destroyFence(vkBackends->device, batch->fences[j], NULL);
+        }
+    }
+
+    if (ring->buffer)
+        vkBackends->destroyBuffer(vkBackends->device, ring->buffer, NULL);
+    lvn_vkFreeMemory(vkBackends, &ring->allocation);
+
+    memset(ring, 0, sizeof(LvnVkStagingRing));
+}
+
+LvnResult lvn_vkStagingWriteBuffer(LvnVulkanBackends* vkBackends, VkBuffer buffer, const void* data, VkDeviceSize size, VkDeviceSize offset)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+    const uint8_t* src = (const uint8_t*) data;
+
+    LVN_PROFILE_BEGIN("lvn_vkStagingWriteBuffer");
+
+    lvn_spinLock(&ring->lock);
+
+    // writes larger than half the ring are split, so one chunk always fits once the ring drains
+    while (size)
+    {
+        VkDeviceSize chunkSize = size < ring->size / 2 ? size : ring->size / 2;
+        VkDeviceSize stagingOffset;
+
+        // beginning a batch and making space can drop the lock to wait for the gpu, so the ring is looked at again after
+        // either of them; a region is reserved and recorded without dropping the lock, so no other thread submits it half written
+        LvnVkStagingBatch* batch = &ring->batches[ring->batchIndex];
+        if (batch->state != LvnVk_StagingBatchState_Recording)
+        {
+            if (lvn_stagingBeginBatch(vkBackends, batch) != Lvn_Result_Success)
+                goto fail_cleanup;
+            continue;
+        }
+
+        if (!lvn_stagingReserve(ring, chunkSize, &stagingOffset))
+        {
+            if (lvn_stagingMakeSpace(vkBackends) != Lvn_Result_Success)
+                goto fail_cleanup;
+            continue;
+        }
+
+        memcpy((uint8_t*) ring->allocation.pMapped + stagingOffset, src, chunkSize);
+        if (lvn_vkFlushMemory(vkBackends, &ring->allocation, stagingOffset, chunkSize) != Lvn_Result_Success)
+            goto fail_cleanup;
+
+        VkBufferCopy region = {0};
+        region.srcOffset = stagingOffset;
+        region.dstOffset = offset;
+        region.size = chunkSize;
+        vkBackends->cmdCopyBuffer(batch->transferCommandBuffer, ring->buffer, buffer, 1, &region);
+
+        src += chunkSize;
+        offset += chunkSize;
+        size -= chunkSize;
+    }
+
+    lvn_spinUnlock(&ring->lock);
+    LVN_PROFILE_END();
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    lvn_spinUnlock(&ring->lock);
+    LVN_LOG_ERROR(vkBackends->graphicsctx->coreLogger, "[vulkan] failed to stage %llu bytes for buffer upload", (unsigned long long) size);
+    LVN_PROFILE_END();
+    return Lvn_Result_Failure;
+}
+
+LvnResult lvn_vkStagingFlush(LvnVulkanBackends* vkBackends)
+{
+    LvnVkStagingRing* ring = &vkBackends->stagingRing;
+    LvnResult result = Lvn_Result_Success;
+
+    lvn_spinLock(&ring->lock);
+
+    LvnVkStagingBatch* batch = &ring->batches[ring->batchIndex];
+    if (batch->state == LvnVk_StagingBatchState_Recording)
+        result = lvn_stagingSubmitBatch(vkBackends, batch);
+
+    lvn_spinUnlock(&ring->lock);
+
+    return result;
+}
@@ -5,12 +5,24 @@
 #include <string.h>
 #include <time.h>
 #include <stdarg.h>
+#include <errno.h>
 
 // ansi color terminal logging support on windows
 #ifdef LVN_PLATFORM_WINDOWS
 #include <windows.h>
 #endif
 
+// time stamp counter
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LVN_TIME_HAS_TSC
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+        #include <cpuid.h>
+    #endif
+#endif
+
 #define LVN_DEFAULT_LOG_PATTERN "[%Y-%m-%d] [%T] [%#%l%^] %n: %v%$"
 #define LVN_DEFAULT_APP_NAME "levikno"
 
@@ -23,6 +35,21 @@ static LvnMemFreeFn s_LvnMemFreeFnCallback = freeWrapper;
 static LvnMemReallocFn s_LvnMemReallocFnCallback = reallocWrapper;
 static void* s_LvnMemUserData = NULL;
 
+// time
+#define LVN_TIME_TSC_CALIBRATION_NS 10000000ull  // 10 ms
+
+typedef struct LvnTimeTsc
+{
+    bool enabled;
+    uint64_t baseTicks;      // tsc value at the end of calibration
+    uint64_t baseNs;         // monotonic time at the end of calibration
+    uint64_t nsPerTick;      // 32.32 fixed point
+} LvnTimeTsc;
+
+static LvnTimeTsc s_LvnTimeTsc;
+
+static void lvn_timeCalibrateTsc(LvnContext* ctx);
+
 // logging
 static void    printWrapper(const char* msg) { printf("%s", msg); }
 
@@ -53,6 +80,7 @@ static char*          lvn_logPatternStrDateHour12(const LvnLogMessage* msg);
 static char*          lvn_logPatternStrDateMinute(const LvnLogMessage* msg);
 static char*          lvn_logPatternStrDateSecond(const LvnLogMessage* msg);
 static LvnLogPattern* lvn_logParseFormat(const LvnContext* ctx, const char* fmt, uint32_t* logPatternCount);
+static const LvnDate* lvn_dateGetCached(void);
 
 
 #ifdef LVN_PLATFORM_WINDOWS
@@ -116,9 +144,8 @@ static char* lvn_logPatternStrDateTimeMeridiemLower(const LvnLogMessage* msg) {
 static char* lvn_logPatternStrDateTimeHHMMSS(const LvnLogMessage* msg)
 {
     char buff[9];
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    snprintf(buff, 9, "%02d:%02d:%02d", tm.tm_hour, tm.tm_min, tm.tm_sec);
+    const LvnDate* date = lvn_dateGetCached();
+    snprintf(buff, 9, "%02d:%02d:%02d", date->hour, date->minute, date->second);
     return lvn_strdup(buff);
 }
 
@@ -126,9 +153,8 @@ static char* lvn_logPatternStrDateTimeHHMMSS12(const LvnLogMessage* msg)
 {
     // make buff size larger to supress gcc truncate warning
     char buff[16];
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    snprintf(buff, 16, "%02d:%02d:%02d", ((tm.tm_hour + 11) % 12) + 1, tm.tm_min, tm.tm_sec);
+    const LvnDate* date = lvn_dateGetCached();
+    snprintf(buff, 16, "%02d:%02d:%02d", date->hour12, date->minute, date->second);
     return lvn_strdup(buff);
 }
 
@@ -222,100 +248,1081 @@ static LvnLogPattern* lvn_logParseFormat(const LvnContext* ctx, const char* fmt,
     LvnLogPattern* patterns = NULL;
     uint32_t patternCount = 0;
 
-    for (uint32_t i = 0; i < strlen(fmt) - 1; i++)
+    for (uint32_t i = 0; i < strlen(fmt) - 1; i++)
+    {
+        if (fmt[i] != '%') // other characters in format
+        {
+            LvnLogPattern pattern = { .symbol = fmt[i], .func = NULL };
+            patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
+            memcpy(&patterns[patternCount - 1], &pattern, sizeof(LvnLogPattern));
+            continue;
+        }
+
+        // find pattern with matching symbol
+        bool skip = false;
+        for (uint32_t j = 0; j < LVN_ARRAY_LEN(s_LvnLogPatterns); j++)
+        {
+            if (fmt[i + 1] == s_LvnLogPatterns[j].symbol)
+            {
+                patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
+                memcpy(&patterns[patternCount - 1], &s_LvnLogPatterns[j], sizeof(LvnLogPattern));
+                skip = true;
+                break;
+            }
+        }
+
+        if (skip)
+        {
+            i++;
+            continue;
+        }
+
+        // find and add user defined patterns
+        for (uint32_t j = 0; j < ctx->userLogPatternCount; j++)
+        {
+            if (fmt[i + 1] == ctx->pUserLogPatterns[j].symbol)
+            {
+                patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
+                memcpy(&patterns[patternCount - 1], &ctx->pUserLogPatterns[j], sizeof(LvnLogPattern));
+                break;
+            }
+        }
+
+        i++; // incramant past symbol on next character in format
+    }
+
+    *logPatternCount = patternCount;
+
+    return patterns;
+}
+
+LvnFile lvnLoadFileSrc(const char* filepath)
+{
+    return lvnLoadFile(filepath, Lvn_FileType_Src);
+}
+
+LvnFile lvnLoadFileBin(const char* filepath)
+{
+    return lvnLoadFile(filepath, Lvn_FileType_Bin);
+}
+
+LvnFile lvnLoadFile(const char* filepath, LvnFileType type)
+{
+    LvnFile file = {0};
+
+    const char* mode = "r";
+    if (type == Lvn_FileType_Src)
+        mode = "r";
+    else if (type == Lvn_FileType_Bin)
+        mode = "rb";
+
+    FILE* fileptr = fopen(filepath, mode);
+
+    if (!fileptr)
+        return file;
+
+    fseek(fileptr, 0, SEEK_END);
+    long filesize = ftell(fileptr);
+    fseek(fileptr, 0, SEEK_SET);
+
+    if (filesize <= 0)
+    {
+        fclose(fileptr);
+        return file;
+    }
+
+    // every byte is overwritten by fread, no need to zero the buffer first
+    file.data = lvn_malloc(filesize * sizeof(uint8_t));
+
+    if (!file.data)
+    {
+        fclose(fileptr);
+        return file;
+    }
+
+    // text mode may read fewer bytes than the file size due to newline conversion
+    size_t readsize = fread(file.data, sizeof(uint8_t), filesize, fileptr);
+
+    if (ferror(fileptr))
+    {
+        lvn_free(file.data);
+        file.data = NULL;
+        fclose(fileptr);
+        return file;
+    }
+
+    file.size = readsize;
+    fclose(fileptr);
+
+    return file;
+}
+
+void lvnUnloadFile(LvnFile* file)
+{
+    if (!file) return;
+    lvn_free(file->data);
+    file->data = NULL;
+    file->size = 0;
+}
+
+LvnFileView lvnMapFile(const char* filepath)
+{
+    LVN_ASSERT(filepath, "filepath cannot be null");
+
+    LvnFileView view = {0};
+    size_t size = 0;
+    void* data = lvn_platformMapFile(filepath, &size);
+
+    if (!data)
+        return view;
+
+    view.data = (const uint8_t*) data;
+    view.size = size;
+    return view;
+}
+
+void lvnUnmapFile(LvnFileView* view)
+{
+    if (!view || !view->data) return;
+    lvn_platformUnmapFile((void*) view->data, view->size);
+    view->data = NULL;
+    view->size = 0;
+}
+
+#define LVN_FILE_LOADER_DEFAULT_QUEUE_DEPTH    64
+#define LVN_FILE_LOADER_DEFAULT_THREAD_COUNT   2
+#define LVN_FILE_LOADER_MAX_READ_SIZE          (1u << 30)
+
+static void lvn_fileReadOpQueuePush(LvnFileReadOpQueue* queue, LvnFileReadOp* op)
+{
+    op->next = NULL;
+    if (queue->tail)
+        queue->tail->next = op;
+    else
+        queue->head = op;
+    queue->tail = op;
+}
+
+static LvnFileReadOp* lvn_fileReadOpQueuePop(LvnFileReadOpQueue* queue)
+{
+    LvnFileReadOp* op = queue->head;
+    if (!op) return NULL;
+
+    queue->head = op->next;
+    if (!queue->head)
+        queue->tail = NULL;
+
+    op->next = NULL;
+    return op;
+}
+
+// open the file and make sure there is a buffer large enough to hold it
+static bool lvn_fileReadOpOpen(LvnFileReadOp* op, const char* filepath)
+{
+    if (!lvn_platformFileOpen(filepath, &op->handle, &op->fileSize))
+        return false;
+
+    op->fileOpen = true;
+
+    if (op->dst)
+        return op->fileSize <= op->dstSize;
+
+    if (op->fileSize == 0)
+        return true;
+
+    op->dst = (uint8_t*) lvn_malloc(op->fileSize);
+    op->ownsDst = op->dst != NULL;
+    return op->ownsDst;
+}
+
+static void lvn_fileReadOpFinish(LvnFileReadOp* op, LvnResult result)
+{
+    if (op->fileOpen)
+    {
+        lvn_platformFileClose(op->handle);
+        op->fileOpen = false;
+    }
+
+    op->result = result;
+
+    if (result != Lvn_Result_Success && op->ownsDst)
+    {
+        lvn_free(op->dst);
+        op->dst = NULL;
+        op->ownsDst = false;
+    }
+}
+
+static void lvn_fileReadOpFree(LvnFileReadOp* op)
+{
+    if (op->fileOpen)
+        lvn_platformFileClose(op->handle);
+    if (op->ownsDst)
+        lvn_free(op->dst);
+    lvn_free(op->filepath);
+    lvn_free(op);
+}
+
+static size_t lvn_fileReadOpNextReadSize(const LvnFileReadOp* op)
+{
+    size_t remaining = op->fileSize - op->bytesRead;
+    return remaining < LVN_FILE_LOADER_MAX_READ_SIZE ? remaining : LVN_FILE_LOADER_MAX_READ_SIZE;
+}
+
+static void lvn_fileReadOpRunBlocking(LvnFileReadOp* op)
+{
+    if (!lvn_fileReadOpOpen(op, op->filepath))
+    {
+        lvn_fileReadOpFinish(op, Lvn_Result_Failure);
+        return;
+    }
+
+    while (op->bytesRead < op->fileSize)
+    {
+        int64_t result = lvn_platformFileRead(op->handle, op->dst + op->bytesRead, lvn_fileReadOpNextReadSize(op), op->bytesRead);
+
+        if (result < 0)
+        {
+            lvn_fileReadOpFinish(op, Lvn_Result_Failure);
+            return;
+        }
+
+        if (result == 0) // file was truncated after it was opened
+            break;
+
+        op->bytesRead += (size_t) result;
+    }
+
+    lvn_fileReadOpFinish(op, Lvn_Result_Success);
+}
+
+static void lvn_fileLoaderWorker(void* arg)
+{
+    LvnFileLoader* loader = (LvnFileLoader*) arg;
+
+    lvn_platformLockMutex(loader->mutex);
+
+    for (;;)
+    {
+        while (!loader->work.head && !loader->shutdown)
+            lvn_platformWaitCondVar(loader->workCondVar, loader->mutex);
+
+        if (loader->shutdown)
+            break;
+
+        LvnFileReadOp* op = lvn_fileReadOpQueuePop(&loader->work);
+
+        lvn_platformUnlockMutex(loader->mutex);
+        lvn_fileReadOpRunBlocking(op);
+        lvn_platformLockMutex(loader->mutex);
+
+        lvn_fileReadOpQueuePush(&loader->completed, op);
+        lvn_platformSignalCondVar(loader->doneCondVar);
+    }
+
+    lvn_platformUnlockMutex(loader->mutex);
+}
+
+// push as many backlogged reads into the submission queue as the queue depth allows
+static void lvn_fileLoaderIoRingFill(LvnFileLoader* loader)
+{
+    while (loader->backlog.head && loader->inflightCount < loader->queueDepth)
+    {
+        LvnFileReadOp* op = loader->backlog.head;
+        uint32_t readSize = (uint32_t) lvn_fileReadOpNextReadSize(op);
+
+        if (!lvn_platformIoRingPushRead(loader->ioRing, op->handle, op->dst + op->bytesRead, readSize, op->bytesRead, (uint64_t) (uintptr_t) op))
+            break;
+
+        lvn_fileReadOpQueuePop(&loader->backlog);
+        loader->inflightCount++;
+    }
+}
+
+static void lvn_fileLoaderIoRingReap(LvnFileLoader* loader)
+{
+    uint64_t userData;
+    int32_t result;
+
+    while (lvn_platformIoRingPopCompletion(loader->ioRing, &userData, &result))
+    {
+        LvnFileReadOp* op = (LvnFileReadOp*) (uintptr_t) userData;
+        loader->inflightCount--;
+
+        if (result == -EAGAIN || result == -EINTR)
+        {
+            lvn_fileReadOpQueuePush(&loader->backlog, op);
+            continue;
+        }
+
+        if (result < 0)
+        {
+            lvn_fileReadOpFinish(op, Lvn_Result_Failure);
+            lvn_fileReadOpQueuePush(&loader->completed, op);
+            continue;
+        }
+
+        op->bytesRead += (size_t) result;
+
+        // short reads are resubmitted for the remaining range, a zero read means the file was truncated
+        if (result > 0 && op->bytesRead < op->fileSize)
+        {
+            lvn_fileReadOpQueuePush(&loader->backlog, op);
+            continue;
+        }
+
+        lvn_fileReadOpFinish(op, Lvn_Result_Success);
+        lvn_fileReadOpQueuePush(&loader->completed, op);
+    }
+}
+
+static bool lvn_fileLoaderIoRingUpdate(LvnFileLoader* loader, bool wait)
+{
+    lvn_fileLoaderIoRingReap(loader);
+    lvn_fileLoaderIoRingFill(loader);
+
+    uint32_t waitCount = (wait && !loader->completed.head && loader->inflightCount) ? 1 : 0;
+    if (!lvn_platformIoRingSubmit(loader->ioRing, waitCount))
+    {
+        LVN_LOG_ERROR(&loader->ctx->coreLogger, "file loader (%p) failed to submit reads to io_uring", loader);
+        return false;
+    }
+
+    lvn_fileLoaderIoRingReap(loader);
+    lvn_fileLoaderIoRingFill(loader);
+    return true;
+}
+
+static uint32_t lvn_fileLoaderCollect(LvnFileLoader* loader, LvnFileReadCompletion* pCompletions, uint32_t maxCompletions)
+{
+    uint32_t count = 0;
+
+    while (count < maxCompletions)
+    {
+        LvnFileReadOp* op = lvn_fileReadOpQueuePop(&loader->completed);
+        if (!op) break;
+
+        LvnFileReadCompletion* completion = &pCompletions[count++];
+        completion->result = op->result;
+        completion->userData = op->userData;
+        completion->file.data = op->result == Lvn_Result_Success ? op->dst : NULL;
+        completion->file.size = op->result == Lvn_Result_Success ? op->bytesRead : 0;
+
+        // ownership of loader allocated buffers moves to the caller
+        op->ownsDst = false;
+        lvn_fileReadOpFree(op);
+    }
+
+    loader->pendingCount -= count;
+    return count;
+}
+
+LvnResult lvnCreateFileLoader(const LvnContext* ctx, LvnFileLoader** loader, const LvnFileLoaderCreateInfo* createInfo)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+    LVN_ASSERT(loader, "loader cannot be null");
+
+    LvnFileLoaderCreateInfo defaultCreateInfo = {0};
+    if (!createInfo)
+        createInfo = &defaultCreateInfo;
+
+    *loader = (LvnFileLoader*) lvn_calloc(sizeof(LvnFileLoader));
+    if (!*loader)
+        return Lvn_Result_Failure;
+
+    LvnFileLoader* loaderPtr = *loader;
+    loaderPtr->ctx = ctx;
+    loaderPtr->queueDepth = createInfo->queueDepth ? createInfo->queueDepth : LVN_FILE_LOADER_DEFAULT_QUEUE_DEPTH;
+
+    if (!createInfo->disableIoRing)
+        loaderPtr->ioRing = lvn_platformIoRingCreate(loaderPtr->queueDepth);
+
+    if (loaderPtr->ioRing)
+    {
+        LVN_LOG_TRACE(&ctx->coreLogger, "file loader created: (%p), using io_uring, queue depth: %u", loaderPtr, loaderPtr->queueDepth);
+        return Lvn_Result_Success;
+    }
+
+    loaderPtr->threadCount = createInfo->threadCount ? createInfo->threadCount : LVN_FILE_LOADER_DEFAULT_THREAD_COUNT;
+    loaderPtr->mutex = lvn_platformCreateMutex();
+    loaderPtr->workCondVar = lvn_platformCreateCondVar();
+    loaderPtr->doneCondVar = lvn_platformCreateCondVar();
+    loaderPtr->pThreads = (void**) lvn_calloc(loaderPtr->threadCount * sizeof(void*));
+
+    for (uint32_t i = 0; i < loaderPtr->threadCount; i++)
+    {
+        loaderPtr->pThreads[i] = lvn_platformCreateThread(lvn_fileLoaderWorker, loaderPtr);
+
+        if (!loaderPtr->pThreads[i])
+        {
+            LVN_LOG_ERROR(&ctx->coreLogger, "failed to create file loader, could not create worker thread %u", i);
+            loaderPtr->threadCount = i;
+            lvnDestroyFileLoader(loaderPtr);
+            *loader = NULL;
+            return Lvn_Result_Failure;
+        }
+    }
+
+    LVN_LOG_TRACE(&ctx->coreLogger, "file loader created: (%p), using worker threads, thread count: %u", loaderPtr, loaderPtr->threadCount);
+    return Lvn_Result_Success;
+}
+
+void lvnDestroyFileLoader(LvnFileLoader* loader)
+{
+    if (!loader) return;
+
+    LvnFileReadOp* op;
+
+    if (loader->ioRing)
+    {
+        // the kernel may still write into the buffers, wait for every read in flight before freeing them
+        while (loader->inflightCount)
+        {
+            if (!lvn_platformIoRingSubmit(loader->ioRing, 1))
+                break;
+            lvn_fileLoaderIoRingReap(loader);
+        }
+
+        while ((op = lvn_fileReadOpQueuePop(&loader->backlog)))
+            lvn_fileReadOpFree(op);
+
+        lvn_platformIoRingDestroy(loader->ioRing);
+    }
+    else
+    {
+        lvn_platformLockMutex(loader->mutex);
+        loader->shutdown = true;
+        while ((op = lvn_fileReadOpQueuePop(&loader->work)))
+            lvn_fileReadOpFree(op);
+        lvn_platformBroadcastCondVar(loader->workCondVar);
+        lvn_platformUnlockMutex(loader->mutex);
+
+        for (uint32_t i = 0; i < loader->threadCount; i++)
+            lvn_platformJoinThread(loader->pThreads[i]);
+
+        lvn_free(loader->pThreads);
+        lvn_platformDestroyCondVar(loader->doneCondVar);
+        lvn_platformDestroyCondVar(loader->workCondVar);
+        lvn_platformDestroyMutex(loader->mutex);
+    }
+
+    while ((op = lvn_fileReadOpQueuePop(&loader->completed)))
+        lvn_fileReadOpFree(op);
+
+    lvn_free(loader);
+}
+
+uint32_t lvnFileLoaderSubmit(LvnFileLoader* loader, const LvnFileReadRequest* pRequests, uint32_t requestCount)
+{
+    LVN_ASSERT(loader, "loader cannot be null");
+    LVN_ASSERT((pRequests || requestCount == 0), "pRequests cannot be null when requestCount is not zero");
+
+    LvnFileReadOpQueue ops = {0};
+    uint32_t submitCount = 0;
+
+    for (uint32_t i = 0; i < requestCount; i++)
+    {
+        const LvnFileReadRequest* request = &pRequests[i];
+        LVN_ASSERT(request->filepath, "filepath cannot be null");
+
+        LvnFileReadOp* op = (LvnFileReadOp*) lvn_calloc(sizeof(LvnFileReadOp));
+        if (!op) break;
+
+        op->dst = (uint8_t*) request->pDst;
+        op->dstSize = request->dstSize;
+        op->userData = request->userData;
+
+        if (loader->ioRing)
+        {
+            // opening is cheap compared to the read, failures are reported through the completion queue
+            if (!lvn_fileReadOpOpen(op, request->filepath))
+                lvn_fileReadOpFinish(op, Lvn_Result_Failure);
+            else if (op->fileSize == 0)
+                lvn_fileReadOpFinish(op, Lvn_Result_Success);
+
+            lvn_fileReadOpQueuePush(op->fileOpen ? &loader->backlog : &loader->completed, op);
+        }
+        else
+        {
+            op->filepath = lvn_strdup(request->filepath);
+            lvn_fileReadOpQueuePush(&ops, op);
+        }
+
+        submitCount++;
+    }
+
+    loader->pendingCount += submitCount;
+
+    if (loader->ioRing)
+    {
+        lvn_fileLoaderIoRingUpdate(loader, false);
+    }
+    else if (ops.head)
+    {
+        lvn_platformLockMutex(loader->mutex);
+        if (loader->work.tail)
+            loader->work.tail->next = ops.head;
+        else
+            loader->work.head = ops.head;
+        loader->work.tail = ops.tail;
+        lvn_platformBroadcastCondVar(loader->workCondVar);
+        lvn_platformUnlockMutex(loader->mutex);
+    }
+
+    return submitCount;
+}
+
+uint32_t lvnFileLoaderPoll(LvnFileLoader* loader, LvnFileReadCompletion* pCompletions, uint32_t maxCompletions)
+{
+    LVN_ASSERT(loader, "loader cannot be null");
+    LVN_ASSERT((pCompletions || maxCompletions == 0), "pCompletions cannot be null when maxCompletions is not zero");
+
+    if (loader->ioRing)
+    {
+        lvn_fileLoaderIoRingUpdate(loader, false);
+        return lvn_fileLoaderCollect(loader, pCompletions, maxCompletions);
+    }
+
+    lvn_platformLockMutex(loader->mutex);
+    uint32_t count = lvn_fileLoaderCollect(loader, pCompletions, maxCompletions);
+    lvn_platformUnlockMutex(loader->mutex);
+    return count;
+}
+
+uint32_t lvnFileLoaderWait(LvnFileLoader* loader, LvnFileReadCompletion* pCompletions, uint32_t maxCompletions)
+{
+    LVN_ASSERT(loader, "loader cannot be null");
+    LVN_ASSERT((pCompletions && maxCompletions > 0), "pCompletions cannot be null and maxCompletions must be greater than zero");
+
+    if (loader->ioRing)
+    {
+        while (!loader->completed.head && loader->pendingCount)
+        {
+            if (!lvn_fileLoaderIoRingUpdate(loader, true))
+                break;
+        }
+
+        return lvn_fileLoaderCollect(loader, pCompletions, maxCompletions);
+    }
+
+    lvn_platformLockMutex(loader->mutex);
+    while (!loader->completed.head && loader->pendingCount)
+        lvn_platformWaitCondVar(loader->doneCondVar, loader->mutex);
+
+    uint32_t count = lvn_fileLoaderCollect(loader, pCompletions, maxCompletions);
+    lvn_platformUnlockMutex(loader->mutex);
+    return count;
+}
+
+uint32_t lvnFileLoaderGetPendingCount(const LvnFileLoader* loader)
+{
+    LVN_ASSERT(loader, "loader cannot be null");
+    return loader->pendingCount;
+}
+
+bool lvnFileLoaderUsesIoRing(const LvnFileLoader* loader)
+{
+    LVN_ASSERT(loader, "loader cannot be null");
+    return loader->ioRing != NULL;
+}
+
+static const char* lvn_pathFileName(const char* filepath)
+{
+    const char* filename = filepath;
+    for (const char* c = filepath; *c; c++)
+    {
+        if (*c == '/' || *c == '\\')
+            filename = c + 1;
+    }
+    return filename;
+}
+
+static int32_t lvn_fileWatcherFindFile(const LvnFileWatcher* watcher, const char* filepath)
+{
+    for (uint32_t i = 0; i < watcher->fileCount; i++)
+    {
+        if (!strcmp(watcher->pFiles[i].filepath, filepath))
+            return (int32_t) i;
+    }
+    return -1;
+}
+
+static void lvn_fileWatcherMarkDirChanged(LvnFileWatcher* watcher, int32_t watchId, const char* filename)
+{
+    for (uint32_t i = 0; i < watcher->fileCount; i++)
+    {
+        LvnWatchedFile* file = &watcher->pFiles[i];
+
+        // a watch id of -1 means the event queue overflowed, report everything as changed
+        if (watchId == -1 || (watcher->pDirs[file->dirIndex].watchId == watchId && !strcmp(file->filename, filename)))
+            file->changed = true;
+    }
+}
+
+LvnResult lvnCreateFileWatcher(const LvnContext* ctx, LvnFileWatcher** watcher)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+    LVN_ASSERT(watcher, "watcher cannot be null");
+
+    *watcher = (LvnFileWatcher*) lvn_calloc(sizeof(LvnFileWatcher));
+    if (!*watcher)
+        return Lvn_Result_Failure;
+
+    LvnFileWatcher* watcherPtr = *watcher;
+    watcherPtr->ctx = ctx;
+    watcherPtr->dirWatcher = lvn_platformDirWatcherCreate();
+
+    LVN_LOG_TRACE(&ctx->coreLogger, "file watcher created: (%p), using %s", watcherPtr, watcherPtr->dirWatcher ? "native notifications" : "modification time polling");
+    return Lvn_Result_Success;
+}
+
+void lvnDestroyFileWatcher(LvnFileWatcher* watcher)
+{
+    if (!watcher) return;
+
+    for (uint32_t i = 0; i < watcher->fileCount; i++)
+        lvn_free(watcher->pFiles[i].filepath);
+
+    for (uint32_t i = 0; i < watcher->dirCount; i++)
+        lvn_free(watcher->pDirs[i].dirpath);
+
+    if (watcher->dirWatcher)
+        lvn_platformDirWatcherDestroy(watcher->dirWatcher);
+
+    lvn_free(watcher->pFiles);
+    lvn_free(watcher->pDirs);
+    lvn_free(watcher);
+}
+
+LvnResult lvnFileWatcherAddFile(LvnFileWatcher* watcher, const char* filepath, uint64_t userData)
+{
+    LVN_ASSERT(watcher, "watcher cannot be null");
+    LVN_ASSERT(filepath, "filepath cannot be null");
+
+    int32_t existing = lvn_fileWatcherFindFile(watcher, filepath);
+    if (existing >= 0)
+    {
+        watcher->pFiles[existing].userData = userData;
+        return Lvn_Result_Success;
+    }
+
+    const char* filename = lvn_pathFileName(filepath);
+    size_t dirLength = (size_t) (filename - filepath);
+    char* dirpath = dirLength ? lvn_calloc(dirLength + 1) : lvn_strdup(".");
+    if (dirLength)
+        memcpy(dirpath, filepath, dirLength);
+
+    // files in the same directory share one directory watch
+    uint32_t dirIndex = watcher->dirCount;
+    for (uint32_t i = 0; i < watcher->dirCount; i++)
+    {
+        if (!strcmp(watcher->pDirs[i].dirpath, dirpath))
+        {
+            dirIndex = i;
+            break;
+        }
+    }
+
+    int32_t watchId = -1;
+    if (dirIndex == watcher->dirCount && watcher->dirWatcher)
+    {
+        if ((watchId = lvn_platformDirWatcherAdd(watcher->dirWatcher, dirpath)) < 0)
+        {
+            LVN_LOG_ERROR(&watcher->ctx->coreLogger, "file watcher (%p) failed to watch directory: %s", watcher, dirpath);
+            lvn_free(dirpath);
+            return Lvn_Result_Failure;
+        }
+
+        // different spellings of one directory ("shaders/", "./shaders/") get the same watch id back,
+        // they must share an entry or removing the last file of one would drop the watch of the other
+        for (uint32_t i = 0; i < watcher->dirCount; i++)
+        {
+            if (watcher->pDirs[i].watchId == watchId)
+            {
+                dirIndex = i;
+                break;
+            }
+        }
+    }
+
+    if (dirIndex == watcher->dirCount)
+    {
+        if (watcher->dirCount == watcher->dirCapacity)
+        {
+            watcher->dirCapacity = watcher->dirCapacity ? watcher->dirCapacity * 2 : 8;
+            watcher->pDirs = (LvnWatchedDir*) lvn_realloc(watcher->pDirs, watcher->dirCapacity * sizeof(LvnWatchedDir));
+        }
+
+        LvnWatchedDir* dir = &watcher->pDirs[watcher->dirCount++];
+        dir->dirpath = dirpath;
+        dir->watchId = watchId;
+        dir->fileCount = 0;
+    }
+    else
+    {
+        lvn_free(dirpath);
+    }
+
+    if (watcher->fileCount == watcher->fileCapacity)
+    {
+        watcher->fileCapacity = watcher->fileCapacity ? watcher->fileCapacity * 2 : 16;
+        watcher->pFiles = (LvnWatchedFile*) lvn_realloc(watcher->pFiles, watcher->fileCapacity * sizeof(LvnWatchedFile));
+    }
+
+    LvnWatchedFile* file = &watcher->pFiles[watcher->fileCount++];
+    file->filepath = lvn_strdup(filepath);
+    file->filename = lvn_pathFileName(file->filepath);
+    file->dirIndex = dirIndex;
+    file->userData = userData;
+    file->modifiedTime = watcher->dirWatcher ? 0 : lvn_platformGetFileModifiedTime(filepath);
+    file->changed = false;
+
+    watcher->pDirs[dirIndex].fileCount++;
+    return Lvn_Result_Success;
+}
+
+void lvnFileWatcherRemoveFile(LvnFileWatcher* watcher, const char* filepath)
+{
+    LVN_ASSERT(watcher, "watcher cannot be null");
+    LVN_ASSERT(filepath, "filepath cannot be null");
+
+    int32_t index = lvn_fileWatcherFindFile(watcher, filepath);
+    if (index < 0)
+        return;
+
+    uint32_t dirIndex = watcher->pFiles[index].dirIndex;
+    lvn_free(watcher->pFiles[index].filepath);
+    watcher->pFiles[index] = watcher->pFiles[--watcher->fileCount];
+
+    LvnWatchedDir* dir = &watcher->pDirs[dirIndex];
+    if (--dir->fileCount > 0)
+        return;
+
+    // last file in the directory, drop the directory watch and move the last directory into its slot
+    if (watcher->dirWatcher)
+        lvn_platformDirWatcherRemove(watcher->dirWatcher, dir->watchId);
+    lvn_free(dir->dirpath);
+
+    uint32_t lastDir = --watcher->dirCount;
+    if (dirIndex != lastDir)
+    {
+        watcher->pDirs[dirIndex] = watcher->pDirs[lastDir];
+        for (uint32_t i = 0; i < watcher->fileCount; i++)
+        {
+            if (watcher->pFiles[i].dirIndex == lastDir)
+                watcher->pFiles[i].dirIndex = dirIndex;
+        }
+    }
+}
+
+uint32_t lvnFileWatcherPoll(LvnFileWatcher* watcher, LvnFileWatchEvent* pEvents, uint32_t maxEvents)
+{
+    LVN_ASSERT(watcher, "watcher cannot be null");
+    LVN_ASSERT((pEvents || maxEvents == 0), "pEvents cannot be null when maxEvents is not zero");
+
+    if (watcher->dirWatcher)
+    {
+        int32_t watchId;
+        const char* filename;
+        while (lvn_platformDirWatcherRead(watcher->dirWatcher, &watchId, &filename))
+            lvn_fileWatcherMarkDirChanged(watcher, watchId, filename);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < watcher->fileCount; i++)
+        {
+            LvnWatchedFile* file = &watcher->pFiles[i];
+            uint64_t modifiedTime = lvn_platformGetFileModifiedTime(file->filepath);
+
+            // a missing file is not reported until it shows up again
+            if (modifiedTime && modifiedTime != file->modifiedTime)
+                file->changed = true;
+            file->modifiedTime = modifiedTime;
+        }
+    }
+
+    // many writes to the same file between polls collapse into a single event,
+    // files that do not fit into pEvents stay marked and are reported by the next poll
+    uint32_t eventCount = 0;
+    for (uint32_t i = 0; i < watcher->fileCount && eventCount < maxEvents; i++)
+    {
+        LvnWatchedFile* file = &watcher->pFiles[i];
+        if (!file->changed)
+            continue;
+
+        file->changed = false;
+        pEvents[eventCount].filepath = file->filepath;
+        pEvents[eventCount].userData = file->userData;
+        eventCount++;
+    }
+
+    return eventCount;
+}
+
+bool lvn_lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstSize;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) return false;
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+
+        if (literalLength > (size_t) (iend - ip) || literalLength > (size_t) (oend - op))
+            return false;
+
+        memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // the last sequence only has literals
+        if (ip == iend)
+            break;
+
+        if (iend - ip < 2)
+            return false;
+
+        size_t offset = (size_t) ip[0] | ((size_t) ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > (size_t) (op - dst))
+            return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend) return false;
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += 4;
+
+        if (matchLength > (size_t) (oend - op))
+            return false;
+
+        // matches may overlap the bytes being written, copy forward one byte at a time
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            for (size_t i = 0; i < matchLength; i++)
+                *op++ = *match++;
+        }
+    }
+
+    return op == oend;
+}
+
+static const LvnPackEntry* lvn_packFindEntry(const LvnPack* pack, uint64_t pathHash)
+{
+    if (pathHash == 0)
+        return NULL;
+
+    uint32_t mask = pack->header->indexCapacity - 1;
+    uint32_t slot = (uint32_t) pathHash & mask;
+
+    for (uint32_t i = 0; i < pack->header->indexCapacity; i++)
+    {
+        const LvnPackEntry* entry = &pack->pEntries[slot];
+
+        if (entry->pathHash == pathHash)
+            return entry;
+        if (entry->pathHash == 0)
+            return NULL;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+LvnResult lvnCreatePack(const LvnContext* ctx, LvnPack** pack, const char* filepath)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+    LVN_ASSERT(pack, "pack cannot be null");
+    LVN_ASSERT(filepath, "filepath cannot be null");
+
+    LvnFileView view = lvnMapFile(filepath);
+
+    if (!view.data)
+    {
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, could not map file: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    const LvnPackHeader* header = (const LvnPackHeader*) view.data;
+
+    if (view.size < sizeof(LvnPackHeader) || header->magic != LVN_PACK_MAGIC)
+    {
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, file is not a levikno pack: %s", filepath);
+        goto fail_cleanup;
+    }
+
+    if (header->version != LVN_PACK_VERSION)
     {
-        if (fmt[i] != '%') // other characters in format
-        {
-            LvnLogPattern pattern = { .symbol = fmt[i], .func = NULL };
-            patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
-            memcpy(&patterns[patternCount - 1], &pattern, sizeof(LvnLogPattern));
-            continue;
-        }
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, unsupported pack version %u (expected %u): %s", header->version, LVN_PACK_VERSION, filepath);
+        goto fail_cleanup;
+    }
 
-        // find pattern with matching symbol
-        bool skip = false;
-        for (uint32_t j = 0; j < LVN_ARRAY_LEN(s_LvnLogPatterns); j++)
-        {
-            if (fmt[i + 1] == s_LvnLogPatterns[j].symbol)
-            {
-                patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
-                memcpy(&patterns[patternCount - 1], &s_LvnLogPatterns[j], sizeof(LvnLogPattern));
-                skip = true;
-                break;
-            }
-        }
+    // validate every offset once here so lookups do not have to
+    uint32_t indexCapacity = header->indexCapacity;
+    if (header->fileSize != view.size ||
+        indexCapacity == 0 || (indexCapacity & (indexCapacity - 1)) != 0 || header->entryCount > indexCapacity ||
+        header->indexOffset % sizeof(uint64_t) != 0 ||
+        header->indexOffset > view.size || (view.size - header->indexOffset) / sizeof(LvnPackEntry) < indexCapacity)
+    {
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, header is corrupt or the file is truncated: %s", filepath);
+        goto fail_cleanup;
+    }
 
-        if (skip)
-        {
-            i++;
+    const LvnPackEntry* pEntries = (const LvnPackEntry*) (view.data + header->indexOffset);
+    uint32_t entryCount = 0;
+
+    for (uint32_t i = 0; i < indexCapacity; i++)
+    {
+        const LvnPackEntry* entry = &pEntries[i];
+        if (entry->pathHash == 0)
             continue;
-        }
 
-        // find and add user defined patterns
-        for (uint32_t j = 0; j < ctx->userLogPatternCount; j++)
+        bool compressed = entry->flags & Lvn_PackEntryFlag_Lz4;
+        if (entry->offset > view.size || entry->size > view.size - entry->offset ||
+            (!compressed && entry->size != entry->uncompressedSize))
         {
-            if (fmt[i + 1] == ctx->pUserLogPatterns[j].symbol)
-            {
-                patterns = lvn_realloc(patterns, ++patternCount * sizeof(LvnLogPattern));
-                memcpy(&patterns[patternCount - 1], &ctx->pUserLogPatterns[j], sizeof(LvnLogPattern));
-                break;
-            }
+            LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, entry %u is out of bounds: %s", i, filepath);
+            goto fail_cleanup;
         }
 
-        i++; // incramant past symbol on next character in format
+        entryCount++;
     }
 
-    *logPatternCount = patternCount;
+    if (entryCount != header->entryCount)
+    {
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to create pack, index has %u entries but the header expects %u: %s", entryCount, header->entryCount, filepath);
+        goto fail_cleanup;
+    }
 
-    return patterns;
+    *pack = (LvnPack*) lvn_calloc(sizeof(LvnPack));
+    if (!*pack)
+        goto fail_cleanup;
+
+    LvnPack* packPtr = *pack;
+    packPtr->ctx = ctx;
+    packPtr->view = view;
+    packPtr->header = header;
+    packPtr->pEntries = pEntries;
+
+    LVN_LOG_TRACE(&ctx->coreLogger, "pack created: (%p), %u entries, %zu bytes: %s", packPtr, entryCount, view.size, filepath);
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    lvnUnmapFile(&view);
+    return Lvn_Result_Failure;
 }
 
-LvnFile lvnLoadFileSrc(const char* filepath)
+void lvnDestroyPack(LvnPack* pack)
 {
-    return lvnLoadFile(filepath, Lvn_FileType_Src);
+    if (!pack) return;
+    lvnUnmapFile(&pack->view);
+    lvn_free(pack);
 }
 
-LvnFile lvnLoadFileBin(const char* filepath)
+uint64_t lvnPackHashPath(const char* path)
 {
-    return lvnLoadFile(filepath, Lvn_FileType_Bin);
+    LVN_ASSERT(path, "path cannot be null");
+
+    // 64 bit FNV-1a, this value is stored in pack files so it must never change
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char* c = path; *c; c++)
+    {
+        hash ^= (uint8_t) (*c == '\\' ? '/' : *c);
+        hash *= 0x100000001b3ull;
+    }
+
+    // zero marks an empty slot in the index
+    return hash ? hash : 1;
 }
 
-LvnFile lvnLoadFile(const char* filepath, LvnFileType type)
+uint32_t lvnPackGetEntryCount(const LvnPack* pack)
 {
-    LvnFile file = {0};
+    LVN_ASSERT(pack, "pack cannot be null");
+    return pack->header->entryCount;
+}
 
-    const char* mode = "r";
-    if (type == Lvn_FileType_Src)
-        mode = "r";
-    else if (type == Lvn_FileType_Bin)
-        mode = "rb";
+bool lvnPackContains(const LvnPack* pack, uint64_t pathHash)
+{
+    LVN_ASSERT(pack, "pack cannot be null");
+    return lvn_packFindEntry(pack, pathHash) != NULL;
+}
 
-    FILE* fileptr = fopen(filepath, mode);
+LvnFileView lvnPackGetView(const LvnPack* pack, uint64_t pathHash)
+{
+    LVN_ASSERT(pack, "pack cannot be null");
 
-    if (!fileptr)
+    LvnFileView view = {0};
+    const LvnPackEntry* entry = lvn_packFindEntry(pack, pathHash);
+
+    if (!entry || (entry->flags & Lvn_PackEntryFlag_Lz4))
+        return view;
+
+    view.data = pack->view.data + entry->offset;
+    view.size = entry->size;
+    return view;
+}
+
+LvnFile lvnPackLoadFile(const LvnPack* pack, uint64_t pathHash)
+{
+    LVN_ASSERT(pack, "pack cannot be null");
+
+    LvnFile file = {0};
+    const LvnPackEntry* entry = lvn_packFindEntry(pack, pathHash);
+
+    if (!entry || entry->uncompressedSize == 0)
         return file;
 
-    fseek(fileptr, 0, SEEK_END);
-    size_t filesize = ftell(fileptr);
-    fseek(fileptr, 0, SEEK_SET);
+    file.data = (uint8_t*) lvn_malloc(entry->uncompressedSize);
+    if (!file.data)
+        return file;
 
-    file.data = lvn_calloc(filesize * sizeof(uint8_t));
-    file.size = filesize;
+    const uint8_t* blob = pack->view.data + entry->offset;
 
-    fread(file.data, sizeof(uint8_t), filesize, fileptr);
-    fclose(fileptr);
+    if (!(entry->flags & Lvn_PackEntryFlag_Lz4))
+    {
+        memcpy(file.data, blob, entry->size);
+    }
+    else if (!lvn_lz4DecompressBlock(blob, entry->size, file.data, entry->uncompressedSize))
+    {
+        LVN_LOG_ERROR(&pack->ctx->coreLogger, "pack (%p) entry %016llx failed to decompress, the pack may be corrupt", pack, (unsigned long long) pathHash);
+        lvn_free(file.data);
+        file.data = NULL;
+        return file;
+    }
 
+    file.size = entry->uncompressedSize;
     return file;
 }
 
-void lvnUnloadFile(LvnFile* file)
-{
-    if (!file) return;
-    lvn_free(file->data);
-    file->data = NULL;
-    file->size = 0;
-}
-
 LvnResult lvnCreateContext(LvnContext** ctx, const LvnContextCreateInfo* createInfo)
 {
     if (!ctx)
@@ -374,6 +1381,19 @@ LvnResult lvnCreateContext(LvnContext** ctx, const LvnContextCreateInfo* createI
     ctxPtr->coreLogger.pLogPatterns = lvn_logParseFormat(ctxPtr, LVN_DEFAULT_LOG_PATTERN, &ctxPtr->coreLogger.logPatternCount);
     ctxPtr->coreLogger.logging = true;
 
+    // time
+    if (createInfo && createInfo->time.enableTsc)
+        lvn_timeCalibrateTsc(ctxPtr);
+
+    // jobs
+    if (lvn_jobSystemCreate(ctxPtr, createInfo) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(&ctxPtr->coreLogger, "failed to create job system for context: (%p)", *ctx);
+        lvnDestroyContext(ctxPtr);
+        *ctx = NULL;
+        return Lvn_Result_Failure;
+    }
+
     LVN_LOG_TRACE(&ctxPtr->coreLogger, "levikno context created: (%p)", *ctx);
     return Lvn_Result_Success;
 }
@@ -385,6 +1405,8 @@ void lvnDestroyContext(LvnContext* ctx)
 
     LVN_LOG_TRACE(&ctx->coreLogger, "terminating levikno context: (%p)", ctx);
 
+    lvn_jobSystemDestroy(ctx);
+
     if (ctx->appName)
         lvn_free(ctx->appName);
     if (ctx->coreLogger.loggerName)
@@ -414,60 +1436,251 @@ LvnResult lvnSetMemAllocCallbacks(LvnMemAllocFn allocFn, LvnMemFreeFn freeFn, Lv
     return Lvn_Result_Success;
 }
 
-int lvnDateGetYear(void)
+static uint64_t lvn_timeReadTsc(void)
+{
+#ifdef LVN_TIME_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static bool lvn_timeHasInvariantTsc(void)
+{
+#if defined(LVN_TIME_HAS_TSC) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if ((unsigned int) info[0] < 0x80000007)
+        return false;
+
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#elif defined(LVN_TIME_HAS_TSC)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+        return false;
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1 << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+// measures the tsc frequency against the monotonic clock, only invariant counters are used since
+// others change rate with the cpu frequency and stop in deep sleep states
+static void lvn_timeCalibrateTsc(LvnContext* ctx)
+{
+    if (s_LvnTimeTsc.enabled)
+        return;
+
+    if (!lvn_timeHasInvariantTsc())
+    {
+        LVN_LOG_WARN(&ctx->coreLogger, "cpu does not have an invariant time stamp counter, falling back to the monotonic clock");
+        return;
+    }
+
+    uint64_t startNs = lvn_platformGetMonotonicTimeNs();
+    uint64_t startTicks = lvn_timeReadTsc();
+    uint64_t endNs, endTicks;
+    do
+    {
+        endNs = lvn_platformGetMonotonicTimeNs();
+        endTicks = lvn_timeReadTsc();
+    } while (endNs - startNs < LVN_TIME_TSC_CALIBRATION_NS);
+
+    if (endTicks <= startTicks)
+    {
+        LVN_LOG_WARN(&ctx->coreLogger, "time stamp counter calibration failed, falling back to the monotonic clock");
+        return;
+    }
+
+    s_LvnTimeTsc.nsPerTick = ((endNs - startNs) << 32) / (endTicks - startTicks);
+    s_LvnTimeTsc.baseTicks = endTicks;
+    s_LvnTimeTsc.baseNs = endNs;
+    s_LvnTimeTsc.enabled = true;
+
+    LVN_LOG_TRACE(&ctx->coreLogger, "time stamp counter calibrated: %.3f GHz", (double) (endTicks - startTicks) / (double) (endNs - startNs));
+}
+
+uint64_t lvnTimeNowNs(void)
+{
+    if (s_LvnTimeTsc.enabled)
+        return s_LvnTimeTsc.baseNs + lvnTimeTicksToNs(lvn_timeReadTsc() - s_LvnTimeTsc.baseTicks);
+
+    return lvn_platformGetMonotonicTimeNs();
+}
+
+uint64_t lvnTimeNowTicks(void)
+{
+    if (s_LvnTimeTsc.enabled)
+        return lvn_timeReadTsc();
+
+    return lvn_platformGetMonotonicTimeNs();
+}
+
+uint64_t lvnTimeTicksToNs(uint64_t ticks)
+{
+    if (!s_LvnTimeTsc.enabled)
+        return ticks;
+
+    // split the multiply so the 32.32 product does not overflow for large tick counts
+    return (ticks >> 32) * s_LvnTimeTsc.nsPerTick + (((ticks & 0xffffffff) * s_LvnTimeTsc.nsPerTick) >> 32);
+}
+
+bool lvnTimeUsesTsc(void)
+{
+    return s_LvnTimeTsc.enabled;
+}
+
+void lvnTimerReset(LvnTimer* timer)
+{
+    LVN_ASSERT(timer, "timer cannot be null");
+    memset(timer, 0, sizeof(LvnTimer));
+}
+
+void lvnTimerStart(LvnTimer* timer)
+{
+    LVN_ASSERT(timer, "timer cannot be null");
+
+    if (timer->running)
+        return;
+
+    timer->startNs = lvnTimeNowNs();
+    timer->running = true;
+}
+
+void lvnTimerStop(LvnTimer* timer)
+{
+    LVN_ASSERT(timer, "timer cannot be null");
+
+    if (!timer->running)
+        return;
+
+    timer->elapsedNs += lvnTimeNowNs() - timer->startNs;
+    timer->running = false;
+}
+
+uint64_t lvnTimerLap(LvnTimer* timer)
+{
+    LVN_ASSERT(timer, "timer cannot be null");
+
+    uint64_t now = lvnTimeNowNs();
+    uint64_t elapsed = timer->elapsedNs;
+    if (timer->running)
+        elapsed += now - timer->startNs;
+
+    timer->startNs = now;
+    timer->elapsedNs = 0;
+    timer->running = true;
+    return elapsed;
+}
+
+uint64_t lvnTimerElapsedNs(const LvnTimer* timer)
+{
+    LVN_ASSERT(timer, "timer cannot be null");
+
+    if (timer->running)
+        return timer->elapsedNs + (lvnTimeNowNs() - timer->startNs);
+
+    return timer->elapsedNs;
+}
+
+double lvnTimerElapsedSec(const LvnTimer* timer)
+{
+    return (double) lvnTimerElapsedNs(timer) / 1e9;
+}
+
+static const char* const s_LvnMonthName[12] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
+static const char* const s_LvnMonthNameShort[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+static const char* const s_LvnWeekDayName[7] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+static const char* const s_LvnWeekDayNameShort[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+
+// the local time conversion only runs once per second per thread, every getter reads from the same snapshot
+static LVN_THREAD_LOCAL LvnDate s_LvnDateCache;
+static LVN_THREAD_LOCAL time_t s_LvnDateCacheTime = (time_t) -1;
+
+static const LvnDate* lvn_dateGetCached(void)
 {
     time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_year + 1900;
+    if (t == s_LvnDateCacheTime)
+        return &s_LvnDateCache;
+
+    struct tm tm;
+#ifdef LVN_PLATFORM_WINDOWS
+    if (localtime_s(&tm, &t) != 0)
+        memset(&tm, 0, sizeof(struct tm));
+#else
+    if (!localtime_r(&t, &tm))
+        memset(&tm, 0, sizeof(struct tm));
+#endif
+
+    LvnDate* date = &s_LvnDateCache;
+    date->year = tm.tm_year + 1900;
+    date->year02d = (tm.tm_year + 1900) % 100;
+    date->month = tm.tm_mon + 1;
+    date->day = tm.tm_mday;
+    date->weekDay = tm.tm_wday;
+    date->hour = tm.tm_hour;
+    date->hour12 = ((tm.tm_hour + 11) % 12) + 1;
+    date->minute = tm.tm_min;
+    date->second = tm.tm_sec;
+    date->secondsSinceEpoch = (size_t) t;
+    date->monthName = s_LvnMonthName[tm.tm_mon];
+    date->monthNameShort = s_LvnMonthNameShort[tm.tm_mon];
+    date->dayName = s_LvnWeekDayName[tm.tm_wday];
+    date->dayNameShort = s_LvnWeekDayNameShort[tm.tm_wday];
+    date->timeMeridiem = tm.tm_hour < 12 ? "AM" : "PM";
+    date->timeMeridiemLower = tm.tm_hour < 12 ? "am" : "pm";
+
+    s_LvnDateCacheTime = t;
+    return date;
+}
+
+void lvnDateGetSnapshot(LvnDate* date)
+{
+    LVN_ASSERT(date, "date cannot be null");
+    *date = *lvn_dateGetCached();
+}
+
+int lvnDateGetYear(void)
+{
+    return lvn_dateGetCached()->year;
 }
 
 int lvnDateGetYear02d(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return (tm.tm_year + 1900) % 100;
+    return lvn_dateGetCached()->year02d;
 }
 
 int lvnDateGetMonth(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_mon + 1;
+    return lvn_dateGetCached()->month;
 }
 
 int lvnDateGetDay(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_mday;
+    return lvn_dateGetCached()->day;
 }
 
 int lvnDateGetHour(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_hour;
+    return lvn_dateGetCached()->hour;
 }
 
 int lvnDateGetHour12(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return ((tm.tm_hour + 11) % 12) + 1;
+    return lvn_dateGetCached()->hour12;
 }
 
 int lvnDateGetMinute(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_min;
+    return lvn_dateGetCached()->minute;
 }
 
 int lvnDateGetSecond(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return tm.tm_sec;
+    return lvn_dateGetCached()->second;
 }
 
 size_t lvnDateGetSecondsSinceEpoch(void)
@@ -475,57 +1688,34 @@ size_t lvnDateGetSecondsSinceEpoch(void)
     return time(NULL);
 }
 
-static const char* const s_LvnMonthName[12] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
-static const char* const s_LvnMonthNameShort[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
-static const char* const s_LvnWeekDayName[7] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
-static const char* const s_LvnWeekDayNameShort[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
-
 const char* lvnDateGetMonthName(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_LvnMonthName[tm.tm_mon];
+    return lvn_dateGetCached()->monthName;
 }
 
 const char* lvnDateGetMonthNameShort(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_LvnMonthNameShort[tm.tm_mon];
+    return lvn_dateGetCached()->monthNameShort;
 }
 
 const char* lvnDateGetDayName(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_LvnWeekDayName[tm.tm_wday];
+    return lvn_dateGetCached()->dayName;
 }
 
 const char* lvnDateGetDayNameShort(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    return s_LvnWeekDayNameShort[tm.tm_wday];
+    return lvn_dateGetCached()->dayNameShort;
 }
 
 const char* lvnDateGetTimeMeridiem(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    if (tm.tm_hour < 12)
-        return "AM";
-    else
-        return "PM";
+    return lvn_dateGetCached()->timeMeridiem;
 }
 
 const char* lvnDateGetTimeMeridiemLower(void)
 {
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    if (tm.tm_hour < 12)
-        return "am";
-    else
-        return "pm";
+    return lvn_dateGetCached()->timeMeridiemLower;
 }
 
 LvnLogger* lvnCtxGetCoreLogger(LvnContext* ctx)
@@ -906,6 +2096,11 @@ void lvnDestroyLogger(LvnLogger* logger)
     lvn_free(logger);
 }
 
+void* lvn_malloc(size_t size)
+{
+    return s_LvnMemAllocFnCallback(size, s_LvnMemUserData);
+}
+
 void* lvn_calloc(size_t size)
 {
     void* result = s_LvnMemAllocFnCallback(size, s_LvnMemUserData);
@@ -932,3 +2127,123 @@ char* lvn_strdup(const char* str)
     memcpy(result, str, length);
     return result;
 }
+
+static bool lvn_hashTableGrow(LvnHashTable* table)
+{
+    uint32_t capacity = table->capacity ? table->capacity * 2 : 16;
+    LvnHashTableEntry* pEntries = (LvnHashTableEntry*) lvn_calloc(capacity * sizeof(LvnHashTableEntry));
+    if (!pEntries)
+        return false;
+
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        if (!table->pEntries[i].key)
+            continue;
+
+        uint32_t slot = (uint32_t) table->pEntries[i].key & (capacity - 1);
+        while (pEntries[slot].key)
+            slot = (slot + 1) & (capacity - 1);
+
+        pEntries[slot] = table->pEntries[i];
+    }
+
+    lvn_free(table->pEntries);
+    table->pEntries = pEntries;
+    table->capacity = capacity;
+    return true;
+}
+
+bool lvn_hashTableInsert(LvnHashTable* table, uint64_t key, void* value)
+{
+    key = key ? key : 1;
+
+    // keep the load factor at or below one half so probe sequences stay short
+    if ((table->count + 1) * 2 > table->capacity && !lvn_hashTableGrow(table))
+        return false;
+
+    uint32_t mask = table->capacity - 1;
+    uint32_t slot = (uint32_t) key & mask;
+    while (table->pEntries[slot].key)
+        slot = (slot + 1) & mask;
+
+    table->pEntries[slot].key = key;
+    table->pEntries[slot].value = value;
+    table->count++;
+    return true;
+}
+
+bool lvn_hashTableRemove(LvnHashTable* table, uint64_t key, const void* value)
+{
+    if (!table->count)
+        return false;
+
+    key = key ? key : 1;
+    uint32_t mask = table->capacity - 1;
+    uint32_t slot = (uint32_t) key & mask;
+
+    while (table->pEntries[slot].key && !(table->pEntries[slot].key == key && table->pEntries[slot].value == value))
+        slot = (slot + 1) & mask;
+
+    if (!table->pEntries[slot].key)
+        return false;
+
+    // shift later entries of the probe sequence back instead of leaving a tombstone
+    uint32_t hole = slot;
+    for (uint32_t next = (hole + 1) & mask; table->pEntries[next].key; next = (next + 1) & mask)
+    {
+        uint32_t home = (uint32_t) table->pEntries[next].key & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            table->pEntries[hole] = table->pEntries[next];
+            hole = next;
+        }
+    }
+
+    table->pEntries[hole].key = 0;
+    table->pEntries[hole].value = NULL;
+    table->count--;
+    return true;
+}
+
+void* lvn_hashTableFind(const LvnHashTable* table, uint64_t key, LvnHashTableMatchFn match, const void* userData)
+{
+    if (!table->count)
+        return NULL;
+
+    key = key ? key : 1;
+    uint32_t mask = table->capacity - 1;
+
+    for (uint32_t slot = (uint32_t) key & mask; table->pEntries[slot].key; slot = (slot + 1) & mask)
+    {
+        if (table->pEntries[slot].key == key && (!match || match(table->pEntries[slot].value, userData)))
+            return table->pEntries[slot].value;
+    }
+
+    return NULL;
+}
+
+void lvn_hashTableFree(LvnHashTable* table)
+{
+    lvn_free(table->pEntries);
+    table->pEntries = NULL;
+    table->capacity = 0;
+    table->count = 0;
+}
+
+void lvn_spinLock(volatile uint32_t* lock)
+{
+    uint32_t spinCount = 0;
+    while (!lvn_atomicCas32(lock, 0, 1))
+    {
+        if (++spinCount >= 64)
+        {
+            lvn_platformYieldThread();
+            spinCount = 0;
+        }
+    }
+}
+
+void lvn_spinUnlock(volatile uint32_t* lock)
+{
+    lvn_atomicStore32(lock, 0);
+}
@@ -3,6 +3,15 @@
 
 #include "levikno.h"
 
+#if defined(_MSC_VER)
+    #define LVN_THREAD_LOCAL __declspec(thread)
+#else
+    #define LVN_THREAD_LOCAL __thread
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
 
 struct LvnLogger
 {
@@ -17,6 +26,8 @@ struct LvnLogger
     bool logging;
 };
 
+typedef struct LvnJobSystem LvnJobSystem;
+
 struct LvnContext
 {
     char*              appName;
@@ -24,19 +35,241 @@ struct LvnContext
     LvnLogPattern*     pUserLogPatterns;               // array of log patterns for the core logger
     uint32_t           userLogPatternCount;            // number of log patterns in the array
     bool               enableLogging;                  // enable/disable logging for all loggers created from the context
+    LvnJobSystem*      jobSystem;                      // worker threads shared by every parallel feature of the context
+};
+
+// pack file format, all values are little endian
+//
+// [LvnPackHeader][LvnPackEntry * indexCapacity][blob][blob]...
+//
+// the index is an open addressing hash table keyed by lvnPackHashPath with linear probing,
+// indexCapacity is a power of two and a pathHash of zero marks an empty slot.
+// every blob starts at a multiple of LVN_PACK_BLOB_ALIGNMENT from the start of the file.
+
+#define LVN_PACK_MAGIC                  0x504e564c    // "LVNP"
+#define LVN_PACK_VERSION                1
+#define LVN_PACK_BLOB_ALIGNMENT         64
+
+typedef enum LvnPackEntryFlagBits
+{
+    Lvn_PackEntryFlag_Lz4 = 0x00000001,               // blob is a single lz4 block
+} LvnPackEntryFlagBits;
+
+typedef struct LvnPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t indexCapacity;
+    uint64_t indexOffset;
+    uint64_t fileSize;
+} LvnPackHeader;
+
+typedef struct LvnPackEntry
+{
+    uint64_t pathHash;
+    uint64_t offset;                                   // offset of the blob from the start of the file
+    uint64_t size;                                     // stored size of the blob
+    uint64_t uncompressedSize;
+    uint32_t flags;                                    // LvnPackEntryFlagBits
+    uint32_t reserved;
+} LvnPackEntry;
+
+struct LvnPack
+{
+    const LvnContext*    ctx;
+    LvnFileView          view;                         // the whole pack file mapped once
+    const LvnPackHeader* header;
+    const LvnPackEntry*  pEntries;                     // index table, indexCapacity slots
 };
 
 typedef void* (*LvnProc)(void);
+typedef void  (*LvnThreadFn)(void*);
+typedef struct LvnIoRing LvnIoRing;
+typedef struct LvnDirWatcher LvnDirWatcher;
+
+typedef struct LvnFileReadOp
+{
+    struct LvnFileReadOp* next;
+    char* filepath;                                    // only kept for the worker thread path, io_uring opens the file at submit
+    intptr_t handle;
+    uint8_t* dst;
+    size_t dstSize;
+    size_t fileSize;
+    size_t bytesRead;
+    uint64_t userData;
+    LvnResult result;
+    bool ownsDst;                                      // dst was allocated by the loader
+    bool fileOpen;
+} LvnFileReadOp;
+
+typedef struct LvnFileReadOpQueue
+{
+    LvnFileReadOp* head;
+    LvnFileReadOp* tail;
+} LvnFileReadOpQueue;
+
+struct LvnFileLoader
+{
+    const LvnContext*  ctx;
+    uint32_t           queueDepth;
+    uint32_t           pendingCount;                   // submitted ops not yet returned through poll/wait
+    LvnIoRing*         ioRing;                         // null when using the worker thread fallback
+
+    // io_uring path, only touched by the thread that owns the loader
+    LvnFileReadOpQueue backlog;                        // ops waiting for a free submission slot
+    uint32_t           inflightCount;
+
+    // worker thread path, guarded by mutex
+    void*              mutex;
+    void*              workCondVar;
+    void*              doneCondVar;
+    void**             pThreads;
+    uint32_t           threadCount;
+    LvnFileReadOpQueue work;
+    bool               shutdown;
+
+    LvnFileReadOpQueue completed;                      // guarded by mutex when using worker threads
+};
+
+typedef struct LvnWatchedDir
+{
+    char* dirpath;
+    int32_t watchId;
+    uint32_t fileCount;                                // number of watched files in this directory
+} LvnWatchedDir;
+
+typedef struct LvnWatchedFile
+{
+    char* filepath;
+    const char* filename;                              // points into filepath after the last separator
+    uint32_t dirIndex;
+    uint64_t userData;
+    uint64_t modifiedTime;                             // only used when polling modification times
+    bool changed;
+} LvnWatchedFile;
+
+struct LvnFileWatcher
+{
+    const LvnContext*  ctx;
+    LvnDirWatcher*     dirWatcher;                     // null when falling back to polling modification times
+    LvnWatchedFile*    pFiles;
+    uint32_t           fileCount;
+    uint32_t           fileCapacity;
+    LvnWatchedDir*     pDirs;
+    uint32_t           dirCount;
+    uint32_t           dirCapacity;
+};
+
+
+// open addressing hash table with linear probing mapping a 64 bit key to a pointer, zero initialize before use.
+// keys are usually hashes of a larger object, several values can share a key and the match callback of
+// lvn_hashTableFind tells them apart. not thread safe, callers guard the table with their own lock
+typedef struct LvnHashTableEntry
+{
+    uint64_t key;                                      // zero marks an empty slot, a key of zero is stored as one
+    void*    value;
+} LvnHashTableEntry;
+
+typedef struct LvnHashTable
+{
+    LvnHashTableEntry* pEntries;
+    uint32_t           capacity;                       // power of two
+    uint32_t           count;
+} LvnHashTable;
+
+typedef bool (*LvnHashTableMatchFn)(const void* value, const void* userData);
 
 
+void*     lvn_malloc(size_t size);
 void*     lvn_calloc(size_t size);
 void      lvn_free(void* ptr);
 void*     lvn_realloc(void* ptr, size_t size);
 
 char*     lvn_strdup(const char* str);
 
+// atomics, loads acquire, stores release and read-modify-write operations are sequentially consistent
+#if defined(_MSC_VER)
+static inline uint32_t lvn_atomicLoad32(volatile uint32_t* ptr)                 { return (uint32_t) _InterlockedOr((volatile long*) ptr, 0); }
+static inline void     lvn_atomicStore32(volatile uint32_t* ptr, uint32_t value) { _InterlockedExchange((volatile long*) ptr, (long) value); }
+static inline uint32_t lvn_atomicFetchAdd32(volatile uint32_t* ptr, uint32_t value) { return (uint32_t) _InterlockedExchangeAdd((volatile long*) ptr, (long) value); }
+static inline void*    lvn_atomicLoadPtr(void* volatile* ptr)                   { return _InterlockedCompareExchangePointer(ptr, NULL, NULL); }
+static inline void     lvn_atomicStorePtr(void* volatile* ptr, void* value)     { _InterlockedExchangePointer(ptr, value); }
+static inline bool     lvn_atomicCasPtr(void* volatile* ptr, void* expected, void* desired) { return _InterlockedCompareExchangePointer(ptr, desired, expected) == expected; }
+static inline void*    lvn_atomicExchangePtr(void* volatile* ptr, void* value)  { return _InterlockedExchangePointer(ptr, value); }
+static inline bool     lvn_atomicCas32(volatile uint32_t* ptr, uint32_t expected, uint32_t desired) { return (uint32_t) _InterlockedCompareExchange((volatile long*) ptr, (long) desired, (long) expected) == expected; }
+static inline int64_t  lvn_atomicLoad64(volatile int64_t* ptr)                  { return _InterlockedOr64((volatile long long*) ptr, 0); }
+static inline void     lvn_atomicStore64(volatile int64_t* ptr, int64_t value)  { _InterlockedExchange64((volatile long long*) ptr, value); }
+static inline bool     lvn_atomicCas64(volatile int64_t* ptr, int64_t expected, int64_t desired) { return _InterlockedCompareExchange64((volatile long long*) ptr, desired, expected) == expected; }
+static inline int64_t  lvn_atomicFetchAdd64(volatile int64_t* ptr, int64_t value) { return _InterlockedExchangeAdd64((volatile long long*) ptr, value); }
+static inline void     lvn_atomicFence(void)                                    { MemoryBarrier(); }
+#else
+static inline uint32_t lvn_atomicLoad32(volatile uint32_t* ptr)                 { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static inline void     lvn_atomicStore32(volatile uint32_t* ptr, uint32_t value) { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static inline uint32_t lvn_atomicFetchAdd32(volatile uint32_t* ptr, uint32_t value) { return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST); }
+static inline void*    lvn_atomicLoadPtr(void* volatile* ptr)                   { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static inline void     lvn_atomicStorePtr(void* volatile* ptr, void* value)     { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static inline bool     lvn_atomicCasPtr(void* volatile* ptr, void* expected, void* desired) { return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE); }
+static inline void*    lvn_atomicExchangePtr(void* volatile* ptr, void* value)  { return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST); }
+static inline bool     lvn_atomicCas32(volatile uint32_t* ptr, uint32_t expected, uint32_t desired) { return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE); }
+static inline int64_t  lvn_atomicLoad64(volatile int64_t* ptr)                  { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static inline void     lvn_atomicStore64(volatile int64_t* ptr, int64_t value)  { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static inline bool     lvn_atomicCas64(volatile int64_t* ptr, int64_t expected, int64_t desired) { return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE); }
+static inline int64_t  lvn_atomicFetchAdd64(volatile int64_t* ptr, int64_t value) { return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST); }
+static inline void     lvn_atomicFence(void)                                    { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+#endif
+
+bool      lvn_hashTableInsert(LvnHashTable* table, uint64_t key, void* value);                                   // returns false if the table could not grow
+bool      lvn_hashTableRemove(LvnHashTable* table, uint64_t key, const void* value);                             // remove the entry holding exactly this key and value, returns false if not found
+void*     lvn_hashTableFind(const LvnHashTable* table, uint64_t key, LvnHashTableMatchFn match, const void* userData); // first value stored with key that match accepts, match can be null to accept any
+void      lvn_hashTableFree(LvnHashTable* table);
+
+void      lvn_spinLock(volatile uint32_t* lock);                                                                   // for short critical sections, yields to the os after spinning for a while
+void      lvn_spinUnlock(volatile uint32_t* lock);
+
+LvnResult lvn_jobSystemCreate(LvnContext* ctx, const LvnContextCreateInfo* createInfo);                            // createInfo can be null to use the defaults
+void      lvn_jobSystemDestroy(LvnContext* ctx);                                                                   // runs every queued job before the workers exit
+
+bool      lvn_lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize); // returns false if the block is malformed or does not decode to exactly dstSize bytes
+
 void*     lvn_platformLoadModule(const char* path);
 void      lvn_platformFreeModule(void* handle);
 LvnProc   lvn_platformGetModuleSymbol(void* handle, const char* name);
+void*     lvn_platformMapFile(const char* filepath, size_t* size);
+void      lvn_platformUnmapFile(void* data, size_t size);
+bool      lvn_platformFileOpen(const char* filepath, intptr_t* handle, size_t* size);
+int64_t   lvn_platformFileRead(intptr_t handle, void* dst, size_t size, uint64_t offset);
+void      lvn_platformFileClose(intptr_t handle);
+bool      lvn_platformWriteFileAtomic(const char* filepath, const void* data, size_t size);                      // write to a temporary file next to filepath, flush it and rename it over filepath
+
+void*     lvn_platformCreateThread(LvnThreadFn func, void* arg);
+void      lvn_platformJoinThread(void* thread);
+void*     lvn_platformCreateMutex(void);
+void      lvn_platformDestroyMutex(void* mutex);
+void      lvn_platformLockMutex(void* mutex);
+void      lvn_platformUnlockMutex(void* mutex);
+void*     lvn_platformCreateCondVar(void);
+void      lvn_platformDestroyCondVar(void* condVar);
+void      lvn_platformWaitCondVar(void* condVar, void* mutex);
+void      lvn_platformSignalCondVar(void* condVar);
+void      lvn_platformBroadcastCondVar(void* condVar);
+uint32_t  lvn_platformGetCpuCount(void);
+uint64_t  lvn_platformGetMonotonicTimeNs(void);
+uint64_t  lvn_platformGetThreadId(void);
+void      lvn_platformYieldThread(void);
+bool      lvn_platformSetThreadAffinity(uint32_t cpu);                                                            // pin the calling thread to a single cpu, returns false if unsupported
+
+LvnIoRing* lvn_platformIoRingCreate(uint32_t entries);                                                              // returns null if io_uring or the read opcode is unsupported
+void       lvn_platformIoRingDestroy(LvnIoRing* ring);
+bool       lvn_platformIoRingPushRead(LvnIoRing* ring, intptr_t handle, void* dst, uint32_t size, uint64_t offset, uint64_t userData); // returns false if the submission queue is full
+bool       lvn_platformIoRingSubmit(LvnIoRing* ring, uint32_t waitCount);                                          // submit pushed reads and optionally block until waitCount reads complete
+bool       lvn_platformIoRingPopCompletion(LvnIoRing* ring, uint64_t* userData, int32_t* result);
+
+uint64_t       lvn_platformGetFileModifiedTime(const char* filepath);                                          // returns 0 if the file does not exist
+LvnDirWatcher* lvn_platformDirWatcherCreate(void);                                                             // returns null if native directory notifications are unsupported
+void           lvn_platformDirWatcherDestroy(LvnDirWatcher* watcher);
+int32_t        lvn_platformDirWatcherAdd(LvnDirWatcher* watcher, const char* dirpath);                         // returns the watch id, or -1 on failure, a directory already watched returns its existing id
+void           lvn_platformDirWatcherRemove(LvnDirWatcher* watcher, int32_t watchId);
+bool           lvn_platformDirWatcherRead(LvnDirWatcher* watcher, int32_t* watchId, const char** filename);    // pop the next changed file without blocking, watchId is -1 if events were dropped
 
 #endif // !HG_LVN_INTERNAL_H
@@ -1,10 +1,35 @@
 #include "lvn_graphics_internal.h"
 
+#include <string.h>
+
 #ifdef LVN_INCLUDE_VULKAN
 #include "lvn_impl_vk.h"
 #endif
 
 static const char* lvn_getGraphicsApiEnumName(LvnGraphicsApi api);
+static void*       lvn_memdup(const void* src, size_t size);
+static LvnPipelineCreateInfo* lvn_copyPipelineCreateInfo(const LvnPipelineCreateInfo* createInfo);
+static void        lvn_freePipelineCreateInfo(LvnPipelineCreateInfo* createInfo);
+static void        lvn_keyWrite(LvnPipelineKey* key, const void* data, size_t size);
+static void        lvn_keyWriteU32(LvnPipelineKey* key, uint32_t value);
+static bool        lvn_createPipelineKey(LvnPipelineKey* key, const LvnPipelineCreateInfo* createInfo);
+static bool        lvn_pipelineKeyMatch(const void* value, const void* userData);
+static void        lvn_releasePipeline(LvnPipeline* pipeline);
+static bool        lvn_shaderCodeMatch(const void* value, const void* userData);
+static void        lvn_compileShaderSourcesRange(uint32_t begin, uint32_t end, void* userData);
+static void        lvn_releaseShader(LvnShader* shader);
+static volatile uint32_t* lvn_gateThreadSlot(const LvnGraphicsContext* graphicsctx);
+static void        lvn_gateEnterShared(const LvnGraphicsContext* graphicsctx);
+static void        lvn_gateLeaveShared(const LvnGraphicsContext* graphicsctx);
+static bool        lvn_gateEnterExclusive(LvnGraphicsContext* graphicsctx);
+static void        lvn_gateLeaveExclusive(LvnGraphicsContext* graphicsctx);
+static bool        lvn_descriptorLayoutMatch(const void* value, const void* userData);
+static void        lvn_releaseDescriptorLayout(LvnDescriptorLayout* descriptorLayout);
+static LvnResult   lvn_createUniformBuffer(LvnGraphicsContext* graphicsctx, const LvnGraphicsContextCreateInfo* createInfo);
+static LvnResult   lvn_flushUniformData(const LvnGraphicsContext* graphicsctx);
+
+#define LVN_UNIFORM_DEFAULT_SLOT_SIZE (4u * 1024 * 1024)
+#define LVN_UNIFORM_MAX_SLOT_SIZE (1u << 30)
 
 
 static const char* lvn_getGraphicsApiEnumName(LvnGraphicsApi api)
@@ -20,6 +45,455 @@ static const char* lvn_getGraphicsApiEnumName(LvnGraphicsApi api)
     return NULL;
 }
 
+static void* lvn_memdup(const void* src, size_t size)
+{
+    if (!src || !size)
+        return NULL;
+
+    void* dst = lvn_malloc(size);
+    if (dst)
+        memcpy(dst, src, size);
+    return dst;
+}
+
+// returns null if any part could not be allocated, nothing is leaked then
+static LvnPipelineCreateInfo* lvn_copyPipelineCreateInfo(const LvnPipelineCreateInfo* createInfo)
+{
+    LvnPipelineCreateInfo* copy = (LvnPipelineCreateInfo*) lvn_malloc(sizeof(LvnPipelineCreateInfo));
+    if (!copy)
+        return NULL;
+
+    *copy = *createInfo;
+    copy->pipelineFixedFunctions = NULL;
+    copy->pStages = NULL;
+
+    if (createInfo->pipelineFixedFunctions)
+    {
+        const LvnPipelineFixedFunctions* src = createInfo->pipelineFixedFunctions;
+        LvnPipelineFixedFunctions* fixedFunctions = (LvnPipelineFixedFunctions*) lvn_memdup(src, sizeof(LvnPipelineFixedFunctions));
+        if (!fixedFunctions)
+            goto fail_cleanup;
+
+        fixedFunctions->colorBlend.pColorBlendAttachments = (LvnPipelineColorBlendAttachment*) lvn_memdup(
+            src->colorBlend.pColorBlendAttachments, src->colorBlend.colorBlendAttachmentCount * sizeof(LvnPipelineColorBlendAttachment));
+
+        // the sample mask has one bit per rasterization sample
+        uint32_t sampleMaskWordCount = ((uint32_t) src->multisampling.rasterizationSamples + 31) / 32;
+        fixedFunctions->multisampling.sampleMask = (uint32_t*) lvn_memdup(src->multisampling.sampleMask, sampleMaskWordCount * sizeof(uint32_t));
+
+        copy->pipelineFixedFunctions = fixedFunctions;
+
+        if ((src->colorBlend.pColorBlendAttachments && src->colorBlend.colorBlendAttachmentCount && !fixedFunctions->colorBlend.pColorBlendAttachments) ||
+            (src->multisampling.sampleMask && !fixedFunctions->multisampling.sampleMask))
+            goto fail_cleanup;
+    }
+
+    copy->pVertexBindingDescriptions = (const LvnVertexBindingDescription*) lvn_memdup(
+        createInfo->pVertexBindingDescriptions, createInfo->vertexBindingDescriptionCount * sizeof(LvnVertexBindingDescription));
+    copy->pVertexAttributes = (const LvnVertexAttribute*) lvn_memdup(
+        createInfo->pVertexAttributes, createInfo->vertexAttributeCount * sizeof(LvnVertexAttribute));
+    copy->pDescriptorLayouts = (const LvnDescriptorLayout* const*) lvn_memdup(
+        createInfo->pDescriptorLayouts, createInfo->descriptorLayoutCount * sizeof(const LvnDescriptorLayout*));
+    copy->pPushConstantRanges = (const LvnPushConstantRange*) lvn_memdup(
+        createInfo->pPushConstantRanges, createInfo->pushConstantRangeCount * sizeof(LvnPushConstantRange));
+
+    if ((createInfo->pVertexBindingDescriptions && createInfo->vertexBindingDescriptionCount && !copy->pVertexBindingDescriptions) ||
+        (createInfo->pVertexAttributes && createInfo->vertexAttributeCount && !copy->pVertexAttributes) ||
+        (createInfo->pDescriptorLayouts && createInfo->descriptorLayoutCount && !copy->pDescriptorLayouts) ||
+        (createInfo->pPushConstantRanges && createInfo->pushConstantRangeCount && !copy->pPushConstantRanges))
+        goto fail_cleanup;
+
+    LvnPipelineShaderStageCreateInfo* pStages = (LvnPipelineShaderStageCreateInfo*) lvn_memdup(
+        createInfo->pStages, createInfo->stageCount * sizeof(LvnPipelineShaderStageCreateInfo));
+    if (createInfo->stageCount && !pStages)
+        goto fail_cleanup;
+
+    // entry points are cleared first so a failed duplicate never leaves a borrowed string to free
+    for (uint32_t i = 0; i < createInfo->stageCount; i++)
+        pStages[i].entryPoint = NULL;
+    copy->pStages = pStages;
+
+    for (uint32_t i = 0; i < createInfo->stageCount; i++)
+    {
+        pStages[i].entryPoint = lvn_strdup(createInfo->pStages[i].entryPoint);
+        if (!pStages[i].entryPoint)
+            goto fail_cleanup;
+    }
+
+    return copy;
+
+fail_cleanup:
+    lvn_freePipelineCreateInfo(copy);
+    return NULL;
+}
+
+static void lvn_freePipelineCreateInfo(LvnPipelineCreateInfo* createInfo)
+{
+    if (!createInfo) return;
+
+    if (createInfo->pipelineFixedFunctions)
+    {
+        LvnPipelineFixedFunctions* fixedFunctions = (LvnPipelineFixedFunctions*) createInfo->pipelineFixedFunctions;
+        lvn_free(fixedFunctions->colorBlend.pColorBlendAttachments);
+        lvn_free(fixedFunctions->multisampling.sampleMask);
+        lvn_free(fixedFunctions);
+    }
+
+    for (uint32_t i = 0; createInfo->pStages && i < createInfo->stageCount; i++)
+        lvn_free((char*) createInfo->pStages[i].entryPoint);
+
+    lvn_free((void*) createInfo->pVertexBindingDescriptions);
+    lvn_free((void*) createInfo->pVertexAttributes);
+    lvn_free((void*) createInfo->pDescriptorLayouts);
+    lvn_free((void*) createInfo->pPushConstantRanges);
+    lvn_free((void*) createInfo->pStages);
+    lvn_free(createInfo);
+}
+
+static void lvn_keyWrite(LvnPipelineKey* key, const void* data, size_t size)
+{
+    if (!key->data)
+        return;
+
+    if (key->size + size > key->capacity)
+    {
+        size_t capacity = key->capacity * 2 > key->size + size ? key->capacity * 2 : key->size + size;
+        uint8_t* newData = (uint8_t*) lvn_realloc(key->data, capacity);
+        if (!newData)
+        {
+            lvn_free(key->data);
+            key->data = NULL;
+            return;
+        }
+
+        key->data = newData;
+        key->capacity = capacity;
+    }
+
+    memcpy(key->data + key->size, data, size);
+    key->size += size;
+}
+
+static void lvn_keyWriteU32(LvnPipelineKey* key, uint32_t value)
+{
+    lvn_keyWrite(key, &value, sizeof(uint32_t));
+}
+
+// writes every field that affects the built pipeline one by one, struct padding and pointers to
+// arrays never end up in the key. shaders, descriptor layouts and render pass objects are keyed by identity,
+// pipelines hold references on their shaders and layouts so those addresses are not reused while a pipeline keyed on them lives.
+// viewport and scissor are left out since they are dynamic state
+static bool lvn_createPipelineKey(LvnPipelineKey* key, const LvnPipelineCreateInfo* createInfo)
+{
+    key->capacity = 256;
+    key->data = (uint8_t*) lvn_malloc(key->capacity);
+    key->size = 0;
+
+    const LvnPipelineFixedFunctions* fixedFunctions = createInfo->pipelineFixedFunctions;
+
+    lvn_keyWriteU32(key, fixedFunctions->inputAssembly.topology);
+    lvn_keyWriteU32(key, fixedFunctions->inputAssembly.primitiveRestartEnable);
+
+    lvn_keyWriteU32(key, fixedFunctions->rasterizer.cullMode);
+    lvn_keyWriteU32(key, fixedFunctions->rasterizer.frontFace);
+    lvn_keyWrite(key, &fixedFunctions->rasterizer.lineWidth, sizeof(float));
+    lvn_keyWrite(key, &fixedFunctions->rasterizer.depthBiasConstantFactor, sizeof(float));
+    lvn_keyWrite(key, &fixedFunctions->rasterizer.depthBiasClamp, sizeof(float));
+    lvn_keyWrite(key, &fixedFunctions->rasterizer.depthBiasSlopeFactor, sizeof(float));
+    lvn_keyWriteU32(key, fixedFunctions->rasterizer.depthClampEnable);
+    lvn_keyWriteU32(key, fixedFunctions->rasterizer.rasterizerDiscardEnable);
+    lvn_keyWriteU32(key, fixedFunctions->rasterizer.depthBiasEnable);
+
+    lvn_keyWriteU32(key, fixedFunctions->multisampling.rasterizationSamples);
+    lvn_keyWrite(key, &fixedFunctions->multisampling.minSampleShading, sizeof(float));
+    lvn_keyWriteU32(key, fixedFunctions->multisampling.sampleShadingEnable);
+    lvn_keyWriteU32(key, fixedFunctions->multisampling.alphaToCoverageEnable);
+    lvn_keyWriteU32(key, fixedFunctions->multisampling.alphaToOneEnable);
+    lvn_keyWriteU32(key, fixedFunctions->multisampling.sampleMask != NULL);
+    if (fixedFunctions->multisampling.sampleMask)
+    {
+        uint32_t sampleMaskWordCount = ((uint32_t) fixedFunctions->multisampling.rasterizationSamples + 31) / 32;
+        lvn_keyWrite(key, fixedFunctions->multisampling.sampleMask, sampleMaskWordCount * sizeof(uint32_t));
+    }
+
+    lvn_keyWriteU32(key, fixedFunctions->colorBlend.colorBlendAttachmentCount);
+    for (uint32_t i = 0; i < fixedFunctions->colorBlend.colorBlendAttachmentCount; i++)
+    {
+        const LvnPipelineColorBlendAttachment* attachment = &fixedFunctions->colorBlend.pColorBlendAttachments[i];
+        lvn_keyWriteU32(key, attachment->colorWriteMask);
+        lvn_keyWriteU32(key, attachment->srcColorBlendFactor);
+        lvn_keyWriteU32(key, attachment->dstColorBlendFactor);
+        lvn_keyWriteU32(key, attachment->colorBlendOp);
+        lvn_keyWriteU32(key, attachment->srcAlphaBlendFactor);
+        lvn_keyWriteU32(key, attachment->dstAlphaBlendFactor);
+        lvn_keyWriteU32(key, attachment->alphaBlendOp);
+        lvn_keyWriteU32(key, attachment->blendEnable);
+    }
+    lvn_keyWrite(key, fixedFunctions->colorBlend.blendConstants, sizeof(fixedFunctions->colorBlend.blendConstants));
+    lvn_keyWriteU32(key, fixedFunctions->colorBlend.logicOpEnable);
+
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.depthOpCompare);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.failOp);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.passOp);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.depthFailOp);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.compareOp);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.compareMask);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.writeMask);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.stencil.reference);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.enableDepth);
+    lvn_keyWriteU32(key, fixedFunctions->depthstencil.enableStencil);
+
+    lvn_keyWriteU32(key, createInfo->vertexBindingDescriptionCount);
+    for (uint32_t i = 0; i < createInfo->vertexBindingDescriptionCount; i++)
+    {
+        lvn_keyWriteU32(key, createInfo->pVertexBindingDescriptions[i].binding);
+        lvn_keyWriteU32(key, createInfo->pVertexBindingDescriptions[i].stride);
+    }
+
+    lvn_keyWriteU32(key, createInfo->vertexAttributeCount);
+    for (uint32_t i = 0; i < createInfo->vertexAttributeCount; i++)
+    {
+        lvn_keyWriteU32(key, createInfo->pVertexAttributes[i].binding);
+        lvn_keyWriteU32(key, createInfo->pVertexAttributes[i].layout);
+        lvn_keyWriteU32(key, createInfo->pVertexAttributes[i].format);
+        lvn_keyWrite(key, &createInfo->pVertexAttributes[i].offset, sizeof(uint64_t));
+    }
+
+    lvn_keyWriteU32(key, createInfo->descriptorLayoutCount);
+    for (uint32_t i = 0; i < createInfo->descriptorLayoutCount; i++)
+        lvn_keyWrite(key, &createInfo->pDescriptorLayouts[i], sizeof(const LvnDescriptorLayout*));
+
+    lvn_keyWriteU32(key, createInfo->pushConstantRangeCount);
+    for (uint32_t i = 0; i < createInfo->pushConstantRangeCount; i++)
+    {
+        lvn_keyWriteU32(key, createInfo->pPushConstantRanges[i].shaderStages);
+        lvn_keyWriteU32(key, createInfo->pPushConstantRanges[i].offset);
+        lvn_keyWriteU32(key, createInfo->pPushConstantRanges[i].size);
+    }
+
+    lvn_keyWriteU32(key, createInfo->stageCount);
+    for (uint32_t i = 0; i < createInfo->stageCount; i++)
+    {
+        // the entry point is written with its terminator so "ab" + "c" and "a" + "bc" differ
+        lvn_keyWriteU32(key, createInfo->pStages[i].stage);
+        lvn_keyWrite(key, &createInfo->pStages[i].shader, sizeof(const LvnShader*));
+        lvn_keyWrite(key, createInfo->pStages[i].entryPoint, strlen(createInfo->pStages[i].entryPoint) + 1);
+    }
+
+    // with dynamic rendering there is no render pass object and pipelines are keyed by the attachment format alone
+    lvn_keyWrite(key, &createInfo->renderPass->renderPassHandle, sizeof(void*));
+    lvn_keyWriteU32(key, createInfo->renderPass->colorFormat);
+
+    if (!key->data)
+        return false;
+
+    key->hash = lvnHash64(key->data, key->size, 0);
+    return true;
+}
+
+static bool lvn_pipelineKeyMatch(const void* value, const void* userData)
+{
+    const LvnPipelineKey* pipelineKey = &((const LvnPipeline*) value)->key;
+    const LvnPipelineKey* key = (const LvnPipelineKey*) userData;
+
+    return pipelineKey->hash == key->hash &&
+           pipelineKey->size == key->size &&
+           memcmp(pipelineKey->data, key->data, key->size) == 0;
+}
+
+// drops one reference, the last one destroys the pipeline; the caller is inside the gate
+static void lvn_releasePipeline(LvnPipeline* pipeline)
+{
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) pipeline->graphicsctx;
+
+    lvn_spinLock(&graphicsctx->pipelineTableLock);
+    if (--pipeline->refCount > 0)
+    {
+        lvn_spinUnlock(&graphicsctx->pipelineTableLock);
+        return;
+    }
+
+    if (pipeline->inTable)
+        lvn_hashTableRemove(&graphicsctx->pipelineTable, pipeline->key.hash, pipeline);
+    pipeline->inTable = false;
+
+    if (pipeline->pPrevPipeline)
+        pipeline->pPrevPipeline->pNextPipeline = pipeline->pNextPipeline;
+    else
+        graphicsctx->pPipelines = pipeline->pNextPipeline;
+    if (pipeline->pNextPipeline)
+        pipeline->pNextPipeline->pPrevPipeline = pipeline->pPrevPipeline;
+    lvn_spinUnlock(&graphicsctx->pipelineTableLock);
+
+    graphicsctx->implDestroyPipeline(pipeline);
+
+    // every pipeline that reached the backend has its create info copy and the references it holds
+    for (uint32_t i = 0; i < pipeline->createInfo->stageCount; i++)
+        lvn_releaseShader((LvnShader*) pipeline->createInfo->pStages[i].shader);
+    for (uint32_t i = 0; i < pipeline->createInfo->descriptorLayoutCount; i++)
+        lvn_releaseDescriptorLayout((LvnDescriptorLayout*) pipeline->createInfo->pDescriptorLayouts[i]);
+    lvn_freePipelineCreateInfo(pipeline->createInfo);
+
+    lvn_free(pipeline->key.data);
+    lvn_free(pipeline);
+}
+
+// the code itself is not kept, see LvnShaderCreateInfo::pCode, so both halves of the 128 bit hash stand in for it
+static bool lvn_shaderCodeMatch(const void* value, const void* userData)
+{
+    const LvnShader* shader = (const LvnShader*) value;
+    const LvnShader* key = (const LvnShader*) userData;
+
+    return shader->codeHash.low == key->codeHash.low &&
+           shader->codeHash.high == key->codeHash.high &&
+           shader->codeSize == key->codeSize;
+}
+
+// drops one reference, the last one destroys the shader; the caller is inside the gate
+static void lvn_releaseShader(LvnShader* shader)
+{
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) shader->graphicsctx;
+
+    lvn_spinLock(&graphicsctx->shaderTableLock);
+    bool lastReference = --shader->refCount == 0;
+    if (lastReference && shader->inTable)
+        lvn_hashTableRemove(&graphicsctx->shaderTable, shader->codeHash.low, shader);
+    lvn_spinUnlock(&graphicsctx->shaderTableLock);
+
+    if (!lastReference)
+        return;
+
+    // a queued reload holds a reference, so none is left here
+    graphicsctx->implDestroyShader(shader);
+    lvn_free(shader);
+}
+
+static volatile uint32_t* lvn_gateThreadSlot(const LvnGraphicsContext* graphicsctx)
+{
+    static uint32_t s_LvnGateNextSlot = 0;
+    static LVN_THREAD_LOCAL uint32_t s_LvnGateSlot = UINT32_MAX;
+
+    // threads are spread over the slots in the order they first enter a gate, slots may be shared once there are more threads
+    if (s_LvnGateSlot == UINT32_MAX)
+        s_LvnGateSlot = lvn_atomicFetchAdd32(&s_LvnGateNextSlot, 1) % LVN_GRAPHICS_GATE_SLOT_COUNT;
+
+    return (volatile uint32_t*) &graphicsctx->gateSlots[s_LvnGateSlot].count;
+}
+
+// shared gate depth of the calling thread, lvnJobWait inside lvnCreatePipelines runs queued jobs that may enter the gate again
+static LVN_THREAD_LOCAL const LvnGraphicsContext* s_LvnGateHeldContext = NULL;
+static LVN_THREAD_LOCAL uint32_t s_LvnGateHeldDepth = 0;
+
+// object calls only touch their own object and the short locked sections above, so any number of them run at once.
+// lvnGraphicsContextApplyReloads swaps native handles that pipeline creation reads, so it waits for them to finish.
+// shared callers only write the slot of their own thread, the exclusive caller pays for reading every slot instead
+static void lvn_gateEnterShared(const LvnGraphicsContext* graphicsctx)
+{
+    volatile uint32_t* slot = lvn_gateThreadSlot(graphicsctx);
+    volatile uint32_t* exclusive = (volatile uint32_t*) &graphicsctx->gateExclusive;
+
+    // a nested call must not back off, a waiting exclusive caller cannot drain this thread's slot until the outer call returns
+    if (s_LvnGateHeldDepth && s_LvnGateHeldContext == graphicsctx)
+    {
+        lvn_atomicFetchAdd32(slot, 1);
+        s_LvnGateHeldDepth++;
+        return;
+    }
+
+    for (;;)
+    {
+        // the fence orders the increment before the flag load, the exclusive caller does the opposite,
+        // so at least one of the two sees the other
+        lvn_atomicFetchAdd32(slot, 1);
+        lvn_atomicFence();
+        if (!lvn_atomicLoad32(exclusive))
+            break;
+
+        lvn_atomicFetchAdd32(slot, (uint32_t) -1);
+        while (lvn_atomicLoad32(exclusive))
+            lvn_platformYieldThread();
+    }
+
+    // only the outermost context is tracked, nesting a call of another context takes the regular path
+    if (!s_LvnGateHeldDepth)
+        s_LvnGateHeldContext = graphicsctx;
+    if (s_LvnGateHeldContext == graphicsctx)
+        s_LvnGateHeldDepth++;
+}
+
+static void lvn_gateLeaveShared(const LvnGraphicsContext* graphicsctx)
+{
+    if (s_LvnGateHeldDepth && s_LvnGateHeldContext == graphicsctx)
+        s_LvnGateHeldDepth--;
+
+    lvn_atomicFetchAdd32(lvn_gateThreadSlot(graphicsctx), (uint32_t) -1);
+}
+
+// fails when the calling thread is inside a shared call of the same context, waiting for its own slot would never return
+static bool lvn_gateEnterExclusive(LvnGraphicsContext* graphicsctx)
+{
+    if (s_LvnGateHeldDepth && s_LvnGateHeldContext == graphicsctx)
+        return false;
+
+    // the flag is taken by one exclusive caller at a time and stops new shared calls while the ones in progress drain
+    while (!lvn_atomicCas32(&graphicsctx->gateExclusive, 0, 1))
+        lvn_platformYieldThread();
+
+    lvn_atomicFence();
+    for (uint32_t i = 0; i < LVN_GRAPHICS_GATE_SLOT_COUNT; i++)
+    {
+        while (lvn_atomicLoad32(&graphicsctx->gateSlots[i].count))
+            lvn_platformYieldThread();
+    }
+
+    return true;
+}
+
+static void lvn_gateLeaveExclusive(LvnGraphicsContext* graphicsctx)
+{
+    lvn_atomicStore32(&graphicsctx->gateExclusive, 0);
+}
+
+static LvnResult lvn_createUniformBuffer(LvnGraphicsContext* graphicsctx, const LvnGraphicsContextCreateInfo* createInfo)
+{
+    uint64_t slotSize = createInfo->uniformBufferSize ? createInfo->uniformBufferSize : LVN_UNIFORM_DEFAULT_SLOT_SIZE;
+    uint64_t alignment = graphicsctx->uniformAlignment ? graphicsctx->uniformAlignment : 256;
+
+    if (slotSize > LVN_UNIFORM_MAX_SLOT_SIZE)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to create uniform buffer, createInfo->uniformBufferSize (%llu) is larger than %u bytes",
+                      (unsigned long long) slotSize, LVN_UNIFORM_MAX_SLOT_SIZE);
+        return Lvn_Result_Failure;
+    }
+
+    // every slot starts aligned, so offsets aligned within a slot are aligned in the buffer
+    graphicsctx->uniformAlignment = alignment;
+    graphicsctx->uniformSlotSize = (uint32_t) ((slotSize + alignment - 1) & ~(alignment - 1));
+    graphicsctx->uniformHead = 0;
+
+    LvnBufferCreateInfo bufferCreateInfo = {0};
+    bufferCreateInfo.usage = Lvn_BufferUsageFlag_Uniform | Lvn_BufferUsageFlag_Storage;
+    bufferCreateInfo.memoryAccess = Lvn_MemoryAccess_Upload;
+    bufferCreateInfo.size = (uint64_t) graphicsctx->uniformSlotSize * graphicsctx->framesInFlight;
+
+    return lvnCreateBuffer(graphicsctx, &graphicsctx->uniformBuffer, &bufferCreateInfo);
+}
+
+static LvnResult lvn_flushUniformData(const LvnGraphicsContext* graphicsctx)
+{
+    if (!graphicsctx->uniformBuffer)
+        return Lvn_Result_Success;
+
+    // everything allocated in the slot so far, data written after an earlier flush is covered by the submission using it
+    uint32_t head = lvn_atomicLoad32((volatile uint32_t*) &graphicsctx->uniformHead);
+
+    if (!head)
+        return Lvn_Result_Success;
+
+    uint64_t slotOffset = (uint64_t) graphicsctx->uniformSlotSize * graphicsctx->frameIndex;
+    return graphicsctx->implFlushBuffer(graphicsctx->uniformBuffer, slotOffset, head);
+}
+
 LvnResult lvnCreateGraphicsContext(struct LvnContext* ctx, LvnGraphicsContext** graphicsctx, const LvnGraphicsContextCreateInfo* createInfo)
 {
     LVN_ASSERT(ctx && graphicsctx && createInfo, "ctx, graphicsctx, and createInfo cannot be null");
@@ -30,11 +504,16 @@ LvnResult lvnCreateGraphicsContext(struct LvnContext* ctx, LvnGraphicsContext**
         return Lvn_Result_Failure;
     }
 
+    LVN_PROFILE_BEGIN("lvnCreateGraphicsContext");
+
     // create and init graphics context
     *graphicsctx = (LvnGraphicsContext*) lvn_calloc(sizeof(LvnGraphicsContext));
 
     if (!*graphicsctx)
+    {
+        LVN_PROFILE_END();
         return Lvn_Result_Failure;
+    }
 
     LvnGraphicsContext* gctxPtr = *graphicsctx;
     gctxPtr->graphicsapi = createInfo->graphicsapi;
@@ -42,6 +521,18 @@ LvnResult lvnCreateGraphicsContext(struct LvnContext* ctx, LvnGraphicsContext**
     gctxPtr->coreLogger = &ctx->coreLogger;
     gctxPtr->presentModeFlags = createInfo->presentationModeFlags;
     gctxPtr->enableGraphicsApiDebugLogging = createInfo->enableGraphicsApiDebugLogging;
+    gctxPtr->framesInFlight = createInfo->framesInFlight ? createInfo->framesInFlight : 2;
+    if (gctxPtr->framesInFlight > LVN_MAX_FRAMES_IN_FLIGHT)
+        gctxPtr->framesInFlight = LVN_MAX_FRAMES_IN_FLIGHT;
+    gctxPtr->frameIndex = 0;
+
+    if (lvn_shaderCompilerInit(gctxPtr, createInfo) != Lvn_Result_Success)
+    {
+        lvn_free(gctxPtr);
+        *graphicsctx = NULL;
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
 
     // setup graphics api
     LvnResult result = Lvn_Result_Success;
@@ -63,13 +554,25 @@ LvnResult lvnCreateGraphicsContext(struct LvnContext* ctx, LvnGraphicsContext**
     {
         LVN_LOG_ERROR(gctxPtr->coreLogger, "failed to create graphics context, graphics api: %s",
                       lvn_getGraphicsApiEnumName(createInfo->graphicsapi));
+        lvn_shaderCompilerTerminate(gctxPtr);
+        LVN_PROFILE_END();
         return result;
     }
 
+    if (gctxPtr->implCreateBuffer && lvn_createUniformBuffer(gctxPtr, createInfo) != Lvn_Result_Success)
+    {
+        LVN_LOG_ERROR(gctxPtr->coreLogger, "failed to create graphics context, could not create the per frame uniform buffer");
+        lvnDestroyGraphicsContext(gctxPtr);
+        *graphicsctx = NULL;
+        LVN_PROFILE_END();
+        return Lvn_Result_Failure;
+    }
+
     LVN_LOG_TRACE(gctxPtr->coreLogger, "graphics context created: (%p), graphics api set: %s",
                   *graphicsctx,
                   lvn_getGraphicsApiEnumName(createInfo->graphicsapi));
 
+    LVN_PROFILE_END();
     return Lvn_Result_Success;
 }
 
@@ -77,6 +580,23 @@ void lvnDestroyGraphicsContext(LvnGraphicsContext* graphicsctx)
 {
     LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
 
+    // reloads that were never applied still hold a reference on their shaders
+    while (graphicsctx->pPendingShaderReloads)
+    {
+        LvnShader* shader = graphicsctx->pPendingShaderReloads;
+        graphicsctx->pPendingShaderReloads = shader->pNextPendingReload;
+        lvn_free(shader->pReloadCode);
+        shader->pReloadCode = NULL;
+        lvn_releaseShader(shader);
+    }
+
+    if (graphicsctx->uniformBuffer)
+    {
+        if (graphicsctx->implWaitIdle)
+            graphicsctx->implWaitIdle(graphicsctx);
+        lvnDestroyBuffer(graphicsctx->uniformBuffer);
+    }
+
     switch (graphicsctx->graphicsapi)
     {
         case Lvn_GraphicsApi_None:
@@ -93,9 +613,115 @@ void lvnDestroyGraphicsContext(LvnGraphicsContext* graphicsctx)
 
     LVN_LOG_TRACE(graphicsctx->coreLogger, "graphics context terminated: (%p)", graphicsctx);
 
+    lvn_shaderCompilerTerminate(graphicsctx);
+    lvn_hashTableFree(&graphicsctx->pipelineTable);
+    lvn_hashTableFree(&graphicsctx->shaderTable);
+    lvn_hashTableFree(&graphicsctx->descriptorLayoutTable);
     lvn_free(graphicsctx);
 }
 
+LvnResult lvnGraphicsContextLoadPipelineCache(const LvnGraphicsContext* graphicsctx, const char* filepath)
+{
+    LVN_ASSERT(graphicsctx && filepath, "graphicsctx and filepath cannot be null");
+
+    if (!graphicsctx->implLoadPipelineCache)
+        return Lvn_Result_Failure;
+
+    // saves replace the file with a rename, so a mapping stays valid even if another process saves meanwhile
+    LvnFileView file = lvnMapFile(filepath);
+    if (!file.data)
+    {
+        LVN_LOG_TRACE(graphicsctx->coreLogger, "no pipeline cache loaded, could not open file: %s", filepath);
+        return Lvn_Result_Failure;
+    }
+
+    // merging into the cache must not overlap with any other use of it
+    if (!lvn_gateEnterExclusive((LvnGraphicsContext*) graphicsctx))
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to load pipeline cache, called from a job run inside another graphics call of the same context");
+        lvnUnmapFile(&file);
+        return Lvn_Result_Failure;
+    }
+    LvnResult result = graphicsctx->implLoadPipelineCache(graphicsctx, file.data, file.size);
+    lvn_gateLeaveExclusive((LvnGraphicsContext*) graphicsctx);
+
+    lvnUnmapFile(&file);
+
+    if (result == Lvn_Result_Success)
+        LVN_LOG_TRACE(graphicsctx->coreLogger, "pipeline cache loaded from file: %s", filepath);
+
+    return result;
+}
+
+LvnResult lvnGraphicsContextSavePipelineCache(const LvnGraphicsContext* graphicsctx, const char* filepath)
+{
+    LVN_ASSERT(graphicsctx && filepath, "graphicsctx and filepath cannot be null");
+
+    if (!graphicsctx->implGetPipelineCacheData)
+        return Lvn_Result_Failure;
+
+    uint8_t* data = NULL;
+    size_t size = 0;
+
+    // pick up entries another process saved since this one loaded the file, a stale or foreign file is simply replaced
+    LvnFileView file = lvnMapFile(filepath);
+
+    if (!lvn_gateEnterExclusive((LvnGraphicsContext*) graphicsctx))
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to save pipeline cache, called from a job run inside another graphics call of the same context");
+        lvnUnmapFile(&file);
+        return Lvn_Result_Failure;
+    }
+    if (file.data)
+        graphicsctx->implLoadPipelineCache(graphicsctx, file.data, file.size);
+    LvnResult result = graphicsctx->implGetPipelineCacheData(graphicsctx, &data, &size);
+    lvn_gateLeaveExclusive((LvnGraphicsContext*) graphicsctx);
+
+    lvnUnmapFile(&file);
+
+    if (result != Lvn_Result_Success)
+        return result;
+
+    if (!lvn_platformWriteFileAtomic(filepath, data, size))
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to write pipeline cache to file: %s", filepath);
+        result = Lvn_Result_Failure;
+    }
+    else
+    {
+        LVN_LOG_TRACE(graphicsctx->coreLogger, "pipeline cache saved to file: %s, size: %zu bytes", filepath, size);
+    }
+
+    lvn_free(data);
+    return result;
+}
+
+LvnPipelineCacheStats lvnGraphicsContextGetPipelineCacheStats(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+
+    if (!graphicsctx->implGetPipelineCacheStats)
+    {
+        LvnPipelineCacheStats stats = {0};
+        return stats;
+    }
+
+    return graphicsctx->implGetPipelineCacheStats(graphicsctx);
+}
+
+LvnGraphicsMemoryStats lvnGraphicsContextGetMemoryStats(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+
+    if (!graphicsctx->implGetMemoryStats)
+    {
+        LvnGraphicsMemoryStats stats = {0};
+        return stats;
+    }
+
+    return graphicsctx->implGetMemoryStats(graphicsctx);
+}
+
 LvnResult lvnCreateSurface(const LvnGraphicsContext* graphicsctx, LvnSurface** surface, const LvnSurfaceCreateInfo* createInfo)
 {
     LVN_ASSERT(graphicsctx && surface && createInfo, "graphicsctx, surface, and createInfo cannot be null");
@@ -111,14 +737,22 @@ LvnResult lvnCreateSurface(const LvnGraphicsContext* graphicsctx, LvnSurface** s
     LvnSurface* surfacePtr = *surface;
     surfacePtr->graphicsctx = graphicsctx;
 
-    return graphicsctx->implCreateSurface(graphicsctx, *surface, createInfo);
+    lvn_gateEnterShared(graphicsctx);
+    LvnResult result = graphicsctx->implCreateSurface(graphicsctx, *surface, createInfo);
+    lvn_gateLeaveShared(graphicsctx);
+
+    return result;
 }
 
 void lvnDestroySurface(LvnSurface* surface)
 {
     LVN_ASSERT(surface, "surface cannot be null");
     const LvnGraphicsContext* graphicsctx = (const LvnGraphicsContext*) surface->graphicsctx;
+
+    lvn_gateEnterShared(graphicsctx);
     graphicsctx->implDestroySurface(surface);
+    lvn_gateLeaveShared(graphicsctx);
+
     lvn_free(surface);
 }
 
@@ -126,52 +760,1086 @@ LvnResult lvnCreateShader(const LvnGraphicsContext* graphicsctx, LvnShader** sha
 {
     LVN_ASSERT(graphicsctx && shader && createInfo, "graphicsctx, shader, and createInfo cannot be null");
 
-    *shader = (LvnShader*) lvn_calloc(sizeof(LvnShader));
+    LvnGraphicsContext* mutGraphicsctx = (LvnGraphicsContext*) graphicsctx;
+    *shader = NULL;
+
+    LvnShader key = {0};
+    if (createInfo->pCode)
+        key.codeHash = lvnHash128(createInfo->pCode, createInfo->codeSize, 0);
+    key.codeSize = createInfo->codeSize;
+
+    lvn_gateEnterShared(graphicsctx);
+
+    // materials tend to create the same shader many times, hand out the existing one
+    lvn_spinLock(&mutGraphicsctx->shaderTableLock);
+    LvnShader* existing = (LvnShader*) lvn_hashTableFind(&graphicsctx->shaderTable, key.codeHash.low, lvn_shaderCodeMatch, &key);
+    if (existing)
+        existing->refCount++;
+    lvn_spinUnlock(&mutGraphicsctx->shaderTableLock);
+
+    if (existing)
+    {
+        lvn_gateLeaveShared(graphicsctx);
+        *shader = existing;
+        return Lvn_Result_Success;
+    }
 
-    if (!*shader)
+    LvnShader* shaderPtr = (LvnShader*) lvn_calloc(sizeof(LvnShader));
+    if (!shaderPtr)
     {
+        lvn_gateLeaveShared(graphicsctx);
         LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for shader at %p", shader);
         return Lvn_Result_Failure;
     }
 
-    LvnShader* shaderPtr = *shader;
     shaderPtr->graphicsctx = graphicsctx;
+    shaderPtr->codeHash = key.codeHash;
+    shaderPtr->codeSize = key.codeSize;
+    shaderPtr->refCount = 1;
+
+    if (graphicsctx->implCreateShader(graphicsctx, shaderPtr, createInfo) != Lvn_Result_Success)
+    {
+        lvn_gateLeaveShared(graphicsctx);
+        lvn_free(shaderPtr);
+        return Lvn_Result_Failure;
+    }
+
+    // another thread may have created the same shader meanwhile, keep theirs
+    lvn_spinLock(&mutGraphicsctx->shaderTableLock);
+    existing = (LvnShader*) lvn_hashTableFind(&graphicsctx->shaderTable, key.codeHash.low, lvn_shaderCodeMatch, &key);
+    if (existing)
+        existing->refCount++;
+    else
+        shaderPtr->inTable = lvn_hashTableInsert(&mutGraphicsctx->shaderTable, key.codeHash.low, shaderPtr);
+    lvn_spinUnlock(&mutGraphicsctx->shaderTableLock);
+
+    if (existing)
+    {
+        graphicsctx->implDestroyShader(shaderPtr);
+        lvn_free(shaderPtr);
+        shaderPtr = existing;
+    }
 
-    return graphicsctx->implCreateShader(graphicsctx, *shader, createInfo);
+    lvn_gateLeaveShared(graphicsctx);
+
+    *shader = shaderPtr;
+    return Lvn_Result_Success;
 }
 
-void lvnDestroyShader(LvnShader* shader)
+static void lvn_compileShaderSourcesRange(uint32_t begin, uint32_t end, void* userData)
 {
-    LVN_ASSERT(shader, "shader cannot be null");
-    const LvnGraphicsContext* graphicsctx = (const LvnGraphicsContext*) shader->graphicsctx;
-    graphicsctx->implDestroyShader(shader);
-    lvn_free(shader);
+    LvnShaderSourceBatch* batch = (LvnShaderSourceBatch*) userData;
+
+    for (uint32_t i = begin; i < end; i++)
+        batch->pResults[i] = lvn_compileShaderSource(batch->graphicsctx, &batch->pCreateInfos[i], &batch->ppCodes[i], &batch->pCodeSizes[i]);
 }
 
-LvnResult lvnCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo)
+LvnResult lvnCreateShaderFromSource(const LvnGraphicsContext* graphicsctx, LvnShader** shader, const LvnShaderSourceCreateInfo* createInfo)
 {
-    LVN_ASSERT(graphicsctx && pipeline && createInfo, "graphicsctx, pipeline, and createInfo cannot be null");
+    return lvnCreateShadersFromSource(graphicsctx, shader, createInfo, 1);
+}
+
+LvnResult lvnCreateShadersFromSource(const LvnGraphicsContext* graphicsctx, LvnShader** pShaders, const LvnShaderSourceCreateInfo* pCreateInfos, uint32_t count)
+{
+    LVN_ASSERT(graphicsctx && pShaders && pCreateInfos, "graphicsctx, pShaders, and pCreateInfos cannot be null");
 
-    *pipeline = (LvnPipeline*) lvn_calloc(sizeof(LvnPipeline));
+    for (uint32_t i = 0; i < count; i++)
+        pShaders[i] = NULL;
 
-    if (!*pipeline)
+    if (!count)
+        return Lvn_Result_Success;
+
+    LvnResult result = Lvn_Result_Success;
+    LvnShaderSourceBatch batch = {0};
+    batch.graphicsctx = graphicsctx;
+    batch.pCreateInfos = pCreateInfos;
+    batch.ppCodes = (uint8_t**) lvn_calloc(count * (sizeof(uint8_t*) + sizeof(size_t) + sizeof(LvnResult)));
+
+    if (!batch.ppCodes)
     {
-        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for pipeline at %p", pipeline);
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for %u shader compiles", count);
         return Lvn_Result_Failure;
     }
 
-    LvnPipeline* pipelinePtr = *pipeline;
-    pipelinePtr->graphicsctx = graphicsctx;
+    batch.pCodeSizes = (size_t*) (batch.ppCodes + count);
+    batch.pResults = (LvnResult*) (batch.pCodeSizes + count);
 
-    return graphicsctx->implCreatePipeline(graphicsctx, *pipeline, createInfo);
-}
+    // compiling is pure cpu work with no shared state, one shader per job
+    lvnJobParallelFor((LvnContext*) graphicsctx->ctx, count, 1, lvn_compileShaderSourcesRange, &batch);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (batch.pResults[i] != Lvn_Result_Success)
+        {
+            result = Lvn_Result_Failure;
+            goto fail_cleanup;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LvnShaderCreateInfo shaderCreateInfo = {0};
+        shaderCreateInfo.pCode = batch.ppCodes[i];
+        shaderCreateInfo.codeSize = batch.pCodeSizes[i];
+
+        if (lvnCreateShader(graphicsctx, &pShaders[i], &shaderCreateInfo) != Lvn_Result_Success)
+        {
+            result = Lvn_Result_Failure;
+            goto fail_cleanup;
+        }
+    }
+
+fail_cleanup:
+    if (result != Lvn_Result_Success)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (pShaders[i])
+                lvnDestroyShader(pShaders[i]);
+            pShaders[i] = NULL;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+        lvn_free(batch.ppCodes[i]);
+    lvn_free(batch.ppCodes);
+
+    return result;
+}
+
+void lvnDestroyShader(LvnShader* shader)
+{
+    LVN_ASSERT(shader, "shader cannot be null");
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) shader->graphicsctx;
+
+    // pipelines hold their own references, so their shaders outlive them and stay valid for reloads
+    lvn_gateEnterShared(graphicsctx);
+    lvn_releaseShader(shader);
+    lvn_gateLeaveShared(graphicsctx);
+}
+
+LvnResult lvnCreatePipeline(const LvnGraphicsContext* graphicsctx, LvnPipeline** pipeline, const LvnPipelineCreateInfo* createInfo)
+{
+    LVN_ASSERT(graphicsctx && pipeline && createInfo, "graphicsctx, pipeline, and createInfo cannot be null");
+    return lvnCreatePipelines(graphicsctx, pipeline, createInfo, 1);
+}
+
+LvnResult lvnCreatePipelines(const LvnGraphicsContext* graphicsctx, LvnPipeline** pPipelines, const LvnPipelineCreateInfo* pCreateInfos, uint32_t count)
+{
+    LVN_ASSERT(graphicsctx && pPipelines && pCreateInfos, "graphicsctx, pPipelines, and pCreateInfos cannot be null");
+
+    if (!count)
+        return Lvn_Result_Success;
+
+    LvnGraphicsContext* mutGraphicsctx = (LvnGraphicsContext*) graphicsctx;
+    LvnResult result = Lvn_Result_Success;
+    uint32_t newCount = 0, existingCount = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!pCreateInfos[i].pipelineFixedFunctions || !pCreateInfos[i].renderPass)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to create pipelines, pCreateInfos[%u].pipelineFixedFunctions and pCreateInfos[%u].renderPass cannot be null", i, i);
+            memset(pPipelines, 0, count * sizeof(LvnPipeline*));
+            return Lvn_Result_Failure;
+        }
+    }
+
+    // pipelines that still have to be built, and references taken on pipelines that already exist
+    LvnPipeline** pNewPipelines = (LvnPipeline**) lvn_malloc(count * 2 * sizeof(LvnPipeline*));
+    LvnPipelineCreateInfo* pNewCreateInfos = (LvnPipelineCreateInfo*) lvn_malloc(count * sizeof(LvnPipelineCreateInfo));
+    if (!pNewPipelines || !pNewCreateInfos)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for %u pipelines", count);
+        lvn_free(pNewPipelines);
+        lvn_free(pNewCreateInfos);
+        return Lvn_Result_Failure;
+    }
+
+    LvnPipeline** pExistingPipelines = pNewPipelines + count;
+    memset(pPipelines, 0, count * sizeof(LvnPipeline*));
+
+    lvn_gateEnterShared(graphicsctx);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LvnPipelineKey key = {0};
+        if (!lvn_createPipelineKey(&key, &pCreateInfos[i]))
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for pipeline key at %p", &pPipelines[i]);
+            goto fail_cleanup;
+        }
+
+        lvn_spinLock(&mutGraphicsctx->pipelineTableLock);
+        LvnPipeline* existing = (LvnPipeline*) lvn_hashTableFind(&graphicsctx->pipelineTable, key.hash, lvn_pipelineKeyMatch, &key);
+        if (existing)
+            existing->refCount++;
+        lvn_spinUnlock(&mutGraphicsctx->pipelineTableLock);
+
+        if (existing)
+        {
+            pExistingPipelines[existingCount++] = existing;
+        }
+        else
+        {
+            // identical create infos in the same batch share the first pipeline built for them
+            for (uint32_t j = 0; j < newCount && !existing; j++)
+            {
+                if (lvn_pipelineKeyMatch(pNewPipelines[j], &key))
+                {
+                    existing = pNewPipelines[j];
+                    existing->refCount++;
+                }
+            }
+        }
+
+        if (existing)
+        {
+            lvn_free(key.data);
+            pPipelines[i] = existing;
+            continue;
+        }
+
+        LvnPipeline* pipeline = (LvnPipeline*) lvn_calloc(sizeof(LvnPipeline));
+        if (!pipeline)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for pipeline at %p", &pPipelines[i]);
+            lvn_free(key.data);
+            goto fail_cleanup;
+        }
+
+        pipeline->graphicsctx = graphicsctx;
+        pipeline->key = key;
+        pipeline->refCount = 1;
+
+        // kept so the pipeline can be rebuilt when one of its shaders is reloaded, copied before building so a failure has nothing to undo
+        pipeline->createInfo = lvn_copyPipelineCreateInfo(&pCreateInfos[i]);
+        if (!pipeline->createInfo)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for pipeline create info copy at %p", &pPipelines[i]);
+            lvn_free(key.data);
+            lvn_free(pipeline);
+            goto fail_cleanup;
+        }
+
+        pPipelines[i] = pipeline;
+        pNewPipelines[newCount] = pipeline;
+        pNewCreateInfos[newCount] = pCreateInfos[i];
+        newCount++;
+    }
+
+    if (newCount && graphicsctx->implCreatePipelines)
+    {
+        result = graphicsctx->implCreatePipelines(graphicsctx, pNewPipelines, pNewCreateInfos, newCount);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < newCount && result == Lvn_Result_Success; i++)
+        {
+            result = graphicsctx->implCreatePipeline(graphicsctx, pNewPipelines[i], &pNewCreateInfos[i]);
+            if (result != Lvn_Result_Success)
+            {
+                for (uint32_t j = 0; j < i; j++)
+                    graphicsctx->implDestroyPipeline(pNewPipelines[j]);
+            }
+        }
+    }
+
+    if (result != Lvn_Result_Success)
+        goto fail_cleanup;
+
+    // the create info copies hold a reference on their shaders and layouts
+    lvn_spinLock(&mutGraphicsctx->shaderTableLock);
+    for (uint32_t i = 0; i < newCount; i++)
+    {
+        for (uint32_t j = 0; j < pNewCreateInfos[i].stageCount; j++)
+            ((LvnShader*) pNewCreateInfos[i].pStages[j].shader)->refCount++;
+    }
+    lvn_spinUnlock(&mutGraphicsctx->shaderTableLock);
+
+    lvn_spinLock(&mutGraphicsctx->descriptorLayoutTableLock);
+    for (uint32_t i = 0; i < newCount; i++)
+    {
+        for (uint32_t j = 0; j < pNewCreateInfos[i].descriptorLayoutCount; j++)
+            ((LvnDescriptorLayout*) pNewCreateInfos[i].pDescriptorLayouts[j])->refCount++;
+    }
+    lvn_spinUnlock(&mutGraphicsctx->descriptorLayoutTableLock);
+
+    for (uint32_t i = 0; i < newCount; i++)
+    {
+        LvnPipeline* pipeline = pNewPipelines[i];
+
+        // another thread may have inserted an identical pipeline meanwhile, both stay valid and later lookups find one of them.
+        // the list holds the pipeline either way so reloads rebuild it even if the insert failed
+        lvn_spinLock(&mutGraphicsctx->pipelineTableLock);
+        pipeline->inTable = lvn_hashTableInsert(&mutGraphicsctx->pipelineTable, pipeline->key.hash, pipeline);
+        pipeline->pNextPipeline = mutGraphicsctx->pPipelines;
+        if (mutGraphicsctx->pPipelines)
+            mutGraphicsctx->pPipelines->pPrevPipeline = pipeline;
+        mutGraphicsctx->pPipelines = pipeline;
+        lvn_spinUnlock(&mutGraphicsctx->pipelineTableLock);
+    }
+
+    lvn_gateLeaveShared(graphicsctx);
+    lvn_free(pNewPipelines);
+    lvn_free(pNewCreateInfos);
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    // new pipelines never reached the backend, existing ones only lose the reference taken above
+    for (uint32_t i = 0; i < newCount; i++)
+    {
+        lvn_freePipelineCreateInfo(pNewPipelines[i]->createInfo);
+        lvn_free(pNewPipelines[i]->key.data);
+        lvn_free(pNewPipelines[i]);
+    }
+    for (uint32_t i = 0; i < existingCount; i++)
+        lvn_releasePipeline(pExistingPipelines[i]);
+
+    lvn_gateLeaveShared(graphicsctx);
+
+    memset(pPipelines, 0, count * sizeof(LvnPipeline*));
+    lvn_free(pNewPipelines);
+    lvn_free(pNewCreateInfos);
+    return Lvn_Result_Failure;
+}
 
 void lvnDestroyPipeline(LvnPipeline* pipeline)
 {
     LVN_ASSERT(pipeline, "pipeline cannot be null");
     const LvnGraphicsContext* graphicsctx = (const LvnGraphicsContext*) pipeline->graphicsctx;
-    graphicsctx->implDestroyPipeline(pipeline);
-    lvn_free(pipeline);
+
+    lvn_gateEnterShared(graphicsctx);
+    lvn_releasePipeline(pipeline);
+    lvn_gateLeaveShared(graphicsctx);
+}
+
+LvnResult lvnCreateBuffer(const LvnGraphicsContext* graphicsctx, LvnBuffer** buffer, const LvnBufferCreateInfo* createInfo)
+{
+    LVN_ASSERT(graphicsctx && buffer && createInfo, "graphicsctx, buffer, and createInfo cannot be null");
+
+    *buffer = NULL;
+
+    if (!createInfo->size)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to create buffer, size cannot be zero");
+        return Lvn_Result_Failure;
+    }
+
+    LvnBuffer* bufferPtr = (LvnBuffer*) lvn_calloc(sizeof(LvnBuffer));
+
+    if (!bufferPtr)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for buffer at %p", buffer);
+        return Lvn_Result_Failure;
+    }
+
+    bufferPtr->graphicsctx = graphicsctx;
+    bufferPtr->size = createInfo->size;
+    bufferPtr->usage = createInfo->usage;
+    bufferPtr->memoryAccess = createInfo->memoryAccess;
+    bufferPtr->bindlessIndex = LVN_BINDLESS_INVALID_INDEX;
+
+    lvn_gateEnterShared(graphicsctx);
+    LvnResult result = graphicsctx->implCreateBuffer(graphicsctx, bufferPtr, createInfo);
+    lvn_gateLeaveShared(graphicsctx);
+
+    if (result != Lvn_Result_Success)
+    {
+        lvn_free(bufferPtr);
+        return result;
+    }
+
+    *buffer = bufferPtr;
+    return Lvn_Result_Success;
+}
+
+void lvnDestroyBuffer(LvnBuffer* buffer)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+    const LvnGraphicsContext* graphicsctx = buffer->graphicsctx;
+
+    lvn_gateEnterShared(graphicsctx);
+    graphicsctx->implDestroyBuffer(buffer);
+    lvn_gateLeaveShared(graphicsctx);
+
+    lvn_free(buffer);
+}
+
+void* lvnBufferGetMappedData(const LvnBuffer* buffer)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+    return buffer->pMapped;
+}
+
+uint32_t lvnBufferGetBindlessIndex(const LvnBuffer* buffer)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+    return buffer->bindlessIndex;
+}
+
+LvnResult lvnBufferWrite(LvnBuffer* buffer, const void* data, uint64_t size, uint64_t offset)
+{
+    LVN_ASSERT(buffer && data, "buffer and data cannot be null");
+
+    if (offset + size > buffer->size || offset + size < offset)
+    {
+        LVN_LOG_ERROR(buffer->graphicsctx->coreLogger, "failed to write %llu bytes at offset %llu to buffer %p, the range is out of bounds",
+                      (unsigned long long) size, (unsigned long long) offset, buffer);
+        return Lvn_Result_Failure;
+    }
+
+    if (!buffer->pMapped)
+        return buffer->graphicsctx->implUploadBuffer(buffer, data, size, offset);
+
+    memcpy((uint8_t*) buffer->pMapped + offset, data, size);
+    return buffer->graphicsctx->implFlushBuffer(buffer, offset, size);
+}
+
+LvnResult lvnBufferFlush(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+
+    if (!buffer->pMapped || offset + size > buffer->size || offset + size < offset)
+    {
+        LVN_LOG_ERROR(buffer->graphicsctx->coreLogger, "failed to flush buffer %p, the buffer is not mapped or the range is out of bounds", buffer);
+        return Lvn_Result_Failure;
+    }
+
+    return buffer->graphicsctx->implFlushBuffer(buffer, offset, size);
+}
+
+LvnResult lvnBufferInvalidate(LvnBuffer* buffer, uint64_t offset, uint64_t size)
+{
+    LVN_ASSERT(buffer, "buffer cannot be null");
+
+    if (!buffer->pMapped || offset + size > buffer->size || offset + size < offset)
+    {
+        LVN_LOG_ERROR(buffer->graphicsctx->coreLogger, "failed to invalidate buffer %p, the buffer is not mapped or the range is out of bounds", buffer);
+        return Lvn_Result_Failure;
+    }
+
+    return buffer->graphicsctx->implInvalidateBuffer(buffer, offset, size);
+}
+
+static bool lvn_descriptorLayoutMatch(const void* value, const void* userData)
+{
+    const LvnDescriptorLayout* layout = (const LvnDescriptorLayout*) value;
+    const LvnDescriptorLayout* key = (const LvnDescriptorLayout*) userData;
+
+    return layout->bindingCount == key->bindingCount &&
+           memcmp(layout->pBindings, key->pBindings, key->bindingCount * sizeof(LvnDescriptorBinding)) == 0;
+}
+
+LvnResult lvnCreateDescriptorLayout(const LvnGraphicsContext* graphicsctx, LvnDescriptorLayout** descriptorLayout, const LvnDescriptorLayoutCreateInfo* createInfo)
+{
+    LVN_ASSERT(graphicsctx && descriptorLayout && createInfo, "graphicsctx, descriptorLayout, and createInfo cannot be null");
+    LVN_ASSERT((createInfo->pDescriptorBindings || !createInfo->descriptorBindingCount), "createInfo->pDescriptorBindings cannot be null");
+
+    LvnGraphicsContext* mutGraphicsctx = (LvnGraphicsContext*) graphicsctx;
+    *descriptorLayout = NULL;
+
+    if (!graphicsctx->implCreateDescriptorLayout)
+        return Lvn_Result_Failure;
+
+    LvnDescriptorLayout* layoutPtr = (LvnDescriptorLayout*) lvn_calloc(sizeof(LvnDescriptorLayout));
+    LvnDescriptorBinding* pBindings = (LvnDescriptorBinding*) lvn_calloc((createInfo->descriptorBindingCount ? createInfo->descriptorBindingCount : 1) * sizeof(LvnDescriptorBinding));
+    if (!layoutPtr || !pBindings)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate memory for descriptor layout at %p", descriptorLayout);
+        lvn_free(layoutPtr);
+        lvn_free(pBindings);
+        return Lvn_Result_Failure;
+    }
+
+    layoutPtr->graphicsctx = graphicsctx;
+    layoutPtr->pBindings = pBindings;
+    layoutPtr->bindingCount = createInfo->descriptorBindingCount;
+    layoutPtr->refCount = 1;
+
+    // sorted by binding so the same bindings in any order share a layout and buffer infos follow one order
+    for (uint32_t i = 0; i < createInfo->descriptorBindingCount; i++)
+    {
+        LvnDescriptorBinding binding = createInfo->pDescriptorBindings[i];
+        if (!binding.descriptorCount)
+            binding.descriptorCount = 1;
+
+        uint32_t j = i;
+        for (; j > 0 && pBindings[j - 1].binding > binding.binding; j--)
+            pBindings[j] = pBindings[j - 1];
+        pBindings[j] = binding;
+
+        layoutPtr->descriptorCount += binding.descriptorCount;
+    }
+
+    for (uint32_t i = 1; i < layoutPtr->bindingCount; i++)
+    {
+        if (pBindings[i].binding == pBindings[i - 1].binding)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to create descriptor layout, binding %u is used more than once", pBindings[i].binding);
+            lvn_free(pBindings);
+            lvn_free(layoutPtr);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    layoutPtr->hash = lvnHash64(pBindings, layoutPtr->bindingCount * sizeof(LvnDescriptorBinding), 0);
+
+    lvn_gateEnterShared(graphicsctx);
+
+    lvn_spinLock(&mutGraphicsctx->descriptorLayoutTableLock);
+    LvnDescriptorLayout* existing = (LvnDescriptorLayout*) lvn_hashTableFind(&graphicsctx->descriptorLayoutTable, layoutPtr->hash, lvn_descriptorLayoutMatch, layoutPtr);
+    if (existing)
+        existing->refCount++;
+    lvn_spinUnlock(&mutGraphicsctx->descriptorLayoutTableLock);
+
+    if (!existing && graphicsctx->implCreateDescriptorLayout(graphicsctx, layoutPtr) != Lvn_Result_Success)
+    {
+        lvn_gateLeaveShared(graphicsctx);
+        lvn_free(pBindings);
+        lvn_free(layoutPtr);
+        return Lvn_Result_Failure;
+    }
+
+    // another thread may have created the same layout meanwhile, keep theirs
+    if (!existing)
+    {
+        lvn_spinLock(&mutGraphicsctx->descriptorLayoutTableLock);
+        existing = (LvnDescriptorLayout*) lvn_hashTableFind(&graphicsctx->descriptorLayoutTable, layoutPtr->hash, lvn_descriptorLayoutMatch, layoutPtr);
+        if (existing)
+            existing->refCount++;
+        else
+            layoutPtr->inTable = lvn_hashTableInsert(&mutGraphicsctx->descriptorLayoutTable, layoutPtr->hash, layoutPtr);
+        lvn_spinUnlock(&mutGraphicsctx->descriptorLayoutTableLock);
+
+        if (existing)
+            graphicsctx->implDestroyDescriptorLayout(layoutPtr);
+    }
+
+    lvn_gateLeaveShared(graphicsctx);
+
+    if (existing)
+    {
+        lvn_free(pBindings);
+        lvn_free(layoutPtr);
+        layoutPtr = existing;
+    }
+
+    *descriptorLayout = layoutPtr;
+    return Lvn_Result_Success;
+}
+
+// drops one reference, the last one destroys the layout; the caller is inside the gate
+static void lvn_releaseDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
+{
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) descriptorLayout->graphicsctx;
+
+    lvn_spinLock(&graphicsctx->descriptorLayoutTableLock);
+    bool lastReference = --descriptorLayout->refCount == 0;
+    if (lastReference && descriptorLayout->inTable)
+        lvn_hashTableRemove(&graphicsctx->descriptorLayoutTable, descriptorLayout->hash, descriptorLayout);
+    lvn_spinUnlock(&graphicsctx->descriptorLayoutTableLock);
+
+    if (!lastReference)
+        return;
+
+    graphicsctx->implDestroyDescriptorLayout(descriptorLayout);
+    lvn_free(descriptorLayout->pBindings);
+    lvn_free(descriptorLayout);
+}
+
+void lvnDestroyDescriptorLayout(LvnDescriptorLayout* descriptorLayout)
+{
+    LVN_ASSERT(descriptorLayout, "descriptorLayout cannot be null");
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) descriptorLayout->graphicsctx;
+
+    // pipelines hold their own references, so a layout they were built with stays alive until the last of them is destroyed
+    lvn_gateEnterShared(graphicsctx);
+    lvn_releaseDescriptorLayout(descriptorLayout);
+    lvn_gateLeaveShared(graphicsctx);
+}
+
+LvnResult lvnShaderQueueReload(LvnShader* shader, const LvnShaderCreateInfo* createInfo)
+{
+    LVN_ASSERT(shader && createInfo, "shader and createInfo cannot be null");
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) shader->graphicsctx;
+
+    if (!createInfo->pCode || !createInfo->codeSize)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to queue reload for shader %p, createInfo has no code", shader);
+        return Lvn_Result_Failure;
+    }
+
+    // the caller's buffer is usually a file that is about to be unloaded, so keep a copy until the reload is applied
+    LvnShaderReloadCode* reload = (LvnShaderReloadCode*) lvn_malloc(sizeof(LvnShaderReloadCode) + createInfo->codeSize);
+    if (!reload)
+        return Lvn_Result_Failure;
+
+    reload->codeSize = createInfo->codeSize;
+    memcpy(reload->code, createInfo->pCode, createInfo->codeSize);
+
+    lvn_gateEnterShared(graphicsctx);
+
+    // a newer reload replaces one that has not been applied yet, the shader is already on the pending stack then
+    LvnShaderReloadCode* previous = (LvnShaderReloadCode*) lvn_atomicExchangePtr((void* volatile*) &shader->pReloadCode, reload);
+    if (previous)
+    {
+        lvn_free(previous);
+    }
+    else
+    {
+        // the pending stack keeps the shader alive until the reload is applied, even if it is destroyed meanwhile
+        lvn_spinLock(&graphicsctx->shaderTableLock);
+        shader->refCount++;
+        lvn_spinUnlock(&graphicsctx->shaderTableLock);
+
+        // only lvnGraphicsContextApplyReloads pops, and never while a push is in progress, so the stack has no aba problem
+        LvnShader* head;
+        do
+        {
+            head = (LvnShader*) lvn_atomicLoadPtr((void* volatile*) &graphicsctx->pPendingShaderReloads);
+            shader->pNextPendingReload = head;
+        } while (!lvn_atomicCasPtr((void* volatile*) &graphicsctx->pPendingShaderReloads, head, shader));
+    }
+
+    lvn_gateLeaveShared(graphicsctx);
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnGraphicsContextApplyReloads(LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+
+    if (!lvn_atomicLoadPtr((void* volatile*) &graphicsctx->pPendingShaderReloads))
+        return Lvn_Result_Success;
+
+    // no object calls run while handles are swapped, so the pending stack and the tables need no locking below
+    if (!lvn_gateEnterExclusive(graphicsctx))
+    {
+        LVN_LOG_WARN(graphicsctx->coreLogger, "shader reloads not applied, called from a job run inside another graphics call of the same context, the reloads stay queued");
+        return Lvn_Result_Failure;
+    }
+
+    // old shader modules and pipelines may still be referenced by work in flight
+    if (graphicsctx->implWaitIdle)
+        graphicsctx->implWaitIdle(graphicsctx);
+
+    LvnResult result = Lvn_Result_Success;
+    uint32_t shaderCount = 0;
+
+    LvnShader* pendingShaders = graphicsctx->pPendingShaderReloads;
+    graphicsctx->pPendingShaderReloads = NULL;
+
+    for (LvnShader* shader = pendingShaders; shader; shader = shader->pNextPendingReload)
+    {
+        LvnShaderReloadCode* reload = shader->pReloadCode;
+        shader->pReloadCode = NULL;
+
+        // the pending stack holds the only reference left, nothing uses the shader anymore
+        if (shader->refCount == 1)
+        {
+            lvn_free(reload);
+            continue;
+        }
+
+        LvnShaderCreateInfo shaderCreateInfo = {0};
+        shaderCreateInfo.pCode = reload->code;
+        shaderCreateInfo.codeSize = reload->codeSize;
+
+        LvnShader newShader = {0};
+        newShader.graphicsctx = graphicsctx;
+        LvnResult shaderResult = graphicsctx->implCreateShader(graphicsctx, &newShader, &shaderCreateInfo);
+
+        // move the shader to its new code hash so later lvnCreateShader calls with the new code find it
+        if (shaderResult == Lvn_Result_Success)
+        {
+            if (shader->inTable)
+                lvn_hashTableRemove(&graphicsctx->shaderTable, shader->codeHash.low, shader);
+            shader->codeHash = lvnHash128(reload->code, reload->codeSize, 0);
+            shader->codeSize = reload->codeSize;
+            shader->inTable = lvn_hashTableInsert(&graphicsctx->shaderTable, shader->codeHash.low, shader);
+        }
+
+        lvn_free(reload);
+
+        if (shaderResult != Lvn_Result_Success)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to reload shader %p, keeping the previous shader", shader);
+            result = Lvn_Result_Failure;
+            continue;
+        }
+
+        // swap the native handle so every reference to the LvnShader stays valid, then destroy the old one
+        void* oldShader = shader->shader;
+        shader->shader = newShader.shader;
+        newShader.shader = oldShader;
+        graphicsctx->implDestroyShader(&newShader);
+        shader->reloadApplied = true;
+        shaderCount++;
+    }
+
+    // the list holds every live pipeline, a pipeline using several reloaded shaders is only rebuilt once
+    uint32_t recreatedCount = 0;
+    for (LvnPipeline* pipeline = shaderCount ? graphicsctx->pPipelines : NULL; pipeline; pipeline = pipeline->pNextPipeline)
+    {
+        bool reloadApplied = false;
+        for (uint32_t j = 0; j < pipeline->createInfo->stageCount; j++)
+            reloadApplied = reloadApplied || ((const LvnShader*) pipeline->createInfo->pStages[j].shader)->reloadApplied;
+
+        if (!reloadApplied)
+            continue;
+
+        LvnPipeline newPipeline = {0};
+        newPipeline.graphicsctx = graphicsctx;
+
+        if (graphicsctx->implCreatePipeline(graphicsctx, &newPipeline, pipeline->createInfo) != Lvn_Result_Success)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to recreate pipeline %p after shader reload, keeping the previous pipeline", pipeline);
+            result = Lvn_Result_Failure;
+            continue;
+        }
+
+        void* oldPipeline = pipeline->pipeline;
+        pipeline->pipeline = newPipeline.pipeline;
+        newPipeline.pipeline = oldPipeline;
+        graphicsctx->implDestroyPipeline(&newPipeline);
+        recreatedCount++;
+    }
+
+    // drop the references taken when the reloads were queued, shaders destroyed meanwhile are freed here
+    while (pendingShaders)
+    {
+        LvnShader* shader = pendingShaders;
+        pendingShaders = shader->pNextPendingReload;
+        shader->pNextPendingReload = NULL;
+        shader->reloadApplied = false;
+        lvn_releaseShader(shader);
+    }
+
+    lvn_gateLeaveExclusive(graphicsctx);
+
+    LVN_LOG_TRACE(graphicsctx->coreLogger, "applied reloads for graphics context (%p), shaders reloaded: %u, pipelines recreated: %u", graphicsctx, shaderCount, recreatedCount);
+    return result;
+}
+
+LvnResult lvnGraphicsContextBeginFrame(LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+
+    graphicsctx->frameIndex = (graphicsctx->frameIndex + 1) % graphicsctx->framesInFlight;
+    lvn_atomicStore32(&graphicsctx->uniformHead, 0);
+
+    if (!graphicsctx->implBeginFrame)
+        return Lvn_Result_Success;
+
+    return graphicsctx->implBeginFrame(graphicsctx);
+}
+
+uint32_t lvnGraphicsContextGetFrameIndex(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+    return graphicsctx->frameIndex;
+}
+
+LvnResult lvnAllocateUniformData(const LvnGraphicsContext* graphicsctx, uint64_t size, LvnUniformAllocation* allocation)
+{
+    LVN_ASSERT(graphicsctx && allocation, "graphicsctx and allocation cannot be null");
+
+    uint64_t alignedSize = (size + graphicsctx->uniformAlignment - 1) & ~(graphicsctx->uniformAlignment - 1);
+
+    if (!graphicsctx->uniformBuffer || !size || alignedSize > graphicsctx->uniformSlotSize)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate %llu bytes of uniform data, the size is zero or larger than the frame slot",
+                      (unsigned long long) size);
+        return Lvn_Result_Failure;
+    }
+
+    // sizes are rounded up to the alignment, so every offset handed out stays aligned.
+    // the head only moves when the range fits, failed calls leave it untouched so it never wraps
+    volatile uint32_t* head = (volatile uint32_t*) &graphicsctx->uniformHead;
+    uint32_t offset;
+    do
+    {
+        offset = lvn_atomicLoad32(head);
+        if ((uint64_t) offset + alignedSize > graphicsctx->uniformSlotSize)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to allocate %llu bytes of uniform data, the frame slot is full (%u bytes), raise LvnGraphicsContextCreateInfo::uniformBufferSize",
+                          (unsigned long long) size, graphicsctx->uniformSlotSize);
+            return Lvn_Result_Failure;
+        }
+    } while (!lvn_atomicCas32(head, offset, offset + (uint32_t) alignedSize));
+
+    allocation->buffer = graphicsctx->uniformBuffer;
+    allocation->offset = (uint64_t) graphicsctx->uniformSlotSize * graphicsctx->frameIndex + offset;
+    allocation->pData = (uint8_t*) graphicsctx->uniformBuffer->pMapped + allocation->offset;
+    return Lvn_Result_Success;
+}
+
+LvnBuffer* lvnGraphicsContextGetUniformBuffer(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+    return graphicsctx->uniformBuffer;
+}
+
+const LvnDescriptorLayout* lvnGraphicsContextGetBindlessLayout(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+    return graphicsctx->bindlessLayout;
+}
+
+LvnDescriptorSet* lvnGraphicsContextGetBindlessSet(const LvnGraphicsContext* graphicsctx)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+    return graphicsctx->bindlessSet;
+}
+
+LvnCommandBuffer* lvnAllocateCommandBuffer(const LvnGraphicsContext* graphicsctx, LvnCommandBufferLevel level)
+{
+    LVN_ASSERT(graphicsctx, "graphicsctx cannot be null");
+
+    if (!graphicsctx->implAllocateCommandBuffer)
+        return NULL;
+
+    return graphicsctx->implAllocateCommandBuffer(graphicsctx, level);
+}
+
+LvnResult lvnBeginCommandBuffer(LvnCommandBuffer* commandBuffer, const LvnRenderPass* renderPass)
+{
+    LVN_ASSERT(commandBuffer, "commandBuffer cannot be null");
+    return commandBuffer->graphicsctx->implBeginCommandBuffer(commandBuffer, renderPass);
+}
+
+LvnResult lvnEndCommandBuffer(LvnCommandBuffer* commandBuffer)
+{
+    LVN_ASSERT(commandBuffer, "commandBuffer cannot be null");
+    return commandBuffer->graphicsctx->implEndCommandBuffer(commandBuffer);
+}
+
+LvnDescriptorSet* lvnAllocateDescriptorSet(const LvnGraphicsContext* graphicsctx, const LvnDescriptorLayout* descriptorLayout)
+{
+    LVN_ASSERT(graphicsctx && descriptorLayout, "graphicsctx and descriptorLayout cannot be null");
+
+    if (!graphicsctx->implAllocateDescriptorSet)
+        return NULL;
+
+    return graphicsctx->implAllocateDescriptorSet(graphicsctx, descriptorLayout);
+}
+
+LvnResult lvnUpdateDescriptorSet(LvnDescriptorSet* descriptorSet, const LvnDescriptorBufferInfo* pBufferInfos, uint32_t count)
+{
+    LVN_ASSERT(descriptorSet && (pBufferInfos || !count), "descriptorSet and pBufferInfos cannot be null");
+
+    const LvnDescriptorLayout* descriptorLayout = descriptorSet->descriptorLayout;
+    if (count != descriptorLayout->descriptorCount)
+    {
+        LVN_LOG_ERROR(descriptorSet->graphicsctx->coreLogger, "failed to update descriptor set %p, %u buffer infos were given but its layout has %u descriptors",
+                      descriptorSet, count, descriptorLayout->descriptorCount);
+        return Lvn_Result_Failure;
+    }
+
+    const LvnGraphicsContext* graphicsctx = descriptorSet->graphicsctx;
+
+    // buffer infos are packed in binding order, each binding takes descriptorCount of them
+    uint32_t bindingIndex = 0, bindingUsed = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        while (bindingUsed >= (descriptorLayout->pBindings[bindingIndex].descriptorCount ? descriptorLayout->pBindings[bindingIndex].descriptorCount : 1))
+        {
+            bindingIndex++;
+            bindingUsed = 0;
+        }
+        bindingUsed++;
+
+        const LvnDescriptorBufferInfo* info = &pBufferInfos[i];
+        if (!info->buffer)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to update descriptor set %p, pBufferInfos[%u].buffer is null", descriptorSet, i);
+            return Lvn_Result_Failure;
+        }
+
+        if (info->offset > info->buffer->size)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to update descriptor set %p, pBufferInfos[%u].offset (%llu) is past the end of the buffer (%llu bytes)",
+                          descriptorSet, i, (unsigned long long) info->offset, (unsigned long long) info->buffer->size);
+            return Lvn_Result_Failure;
+        }
+
+        LvnDescriptorType type = descriptorLayout->pBindings[bindingIndex].descriptorType;
+        bool dynamic = type == Lvn_DescriptorType_UniformBufferDynamic || type == Lvn_DescriptorType_StorageBufferDynamic;
+        bool uniform = type == Lvn_DescriptorType_UniformBuffer || type == Lvn_DescriptorType_UniformBufferDynamic;
+
+        // a whole buffer range on a dynamic descriptor would cover every element plus the dynamic offset
+        if (dynamic && !info->range)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to update descriptor set %p, pBufferInfos[%u] is a dynamic descriptor and needs an explicit range", descriptorSet, i);
+            return Lvn_Result_Failure;
+        }
+
+        uint64_t range = info->range ? info->range : info->buffer->size - info->offset;
+        if (range > info->buffer->size - info->offset)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to update descriptor set %p, pBufferInfos[%u] range (%llu) at offset (%llu) exceeds the buffer (%llu bytes)",
+                          descriptorSet, i, (unsigned long long) range, (unsigned long long) info->offset, (unsigned long long) info->buffer->size);
+            return Lvn_Result_Failure;
+        }
+
+        uint64_t maxRange = uniform ? graphicsctx->maxUniformRange : graphicsctx->maxStorageRange;
+        if (maxRange && range > maxRange)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to update descriptor set %p, pBufferInfos[%u] range (%llu) exceeds the device limit of %llu bytes for %s descriptors",
+                          descriptorSet, i, (unsigned long long) range, (unsigned long long) maxRange, uniform ? "uniform" : "storage");
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (count)
+        graphicsctx->implUpdateDescriptorSet(descriptorSet, pBufferInfos);
+
+    return Lvn_Result_Success;
+}
+
+LvnResult lvnSubmitCommandBuffers(const LvnGraphicsContext* graphicsctx, LvnCommandBuffer* const* pCommandBuffers, uint32_t count)
+{
+    LVN_ASSERT(graphicsctx && (pCommandBuffers || !count), "graphicsctx and pCommandBuffers cannot be null");
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pCommandBuffers[i]->level != Lvn_CommandBufferLevel_Primary)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to submit command buffers, command buffer %p is not a primary command buffer", pCommandBuffers[i]);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (!count)
+        return Lvn_Result_Success;
+
+    if (lvn_flushUniformData(graphicsctx) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    return graphicsctx->implSubmitCommandBuffers(graphicsctx, pCommandBuffers, count);
+}
+
+void lvnCmdBeginRenderPass(LvnCommandBuffer* commandBuffer, const LvnRenderPassBeginInfo* beginInfo)
+{
+    LVN_ASSERT(commandBuffer && beginInfo && beginInfo->surface, "commandBuffer, beginInfo, and beginInfo->surface cannot be null");
+    commandBuffer->graphicsctx->implCmdBeginRenderPass(commandBuffer, beginInfo);
+}
+
+void lvnCmdEndRenderPass(LvnCommandBuffer* commandBuffer)
+{
+    LVN_ASSERT(commandBuffer, "commandBuffer cannot be null");
+    commandBuffer->graphicsctx->implCmdEndRenderPass(commandBuffer);
+}
+
+void lvnCmdBindPipeline(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline)
+{
+    LVN_ASSERT(commandBuffer && pipeline, "commandBuffer and pipeline cannot be null");
+    commandBuffer->graphicsctx->implCmdBindPipeline(commandBuffer, pipeline);
+}
+
+void lvnCmdSetViewport(LvnCommandBuffer* commandBuffer, const LvnPipelineViewport* viewport)
+{
+    LVN_ASSERT(commandBuffer && viewport, "commandBuffer and viewport cannot be null");
+    commandBuffer->graphicsctx->implCmdSetViewport(commandBuffer, viewport);
+}
+
+void lvnCmdSetScissor(LvnCommandBuffer* commandBuffer, const LvnPipelineScissor* scissor)
+{
+    LVN_ASSERT(commandBuffer && scissor, "commandBuffer and scissor cannot be null");
+    commandBuffer->graphicsctx->implCmdSetScissor(commandBuffer, scissor);
+}
+
+void lvnCmdBindVertexBuffers(LvnCommandBuffer* commandBuffer, uint32_t firstBinding, LvnBuffer* const* pBuffers, const uint64_t* pOffsets, uint32_t count)
+{
+    LVN_ASSERT(commandBuffer && (pBuffers || !count), "commandBuffer and pBuffers cannot be null");
+
+    if (!count)
+        return;
+
+    commandBuffer->graphicsctx->implCmdBindVertexBuffers(commandBuffer, firstBinding, pBuffers, pOffsets, count);
+}
+
+void lvnCmdBindDescriptorSets(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, uint32_t firstSet, LvnDescriptorSet* const* pDescriptorSets, uint32_t count, const uint32_t* pDynamicOffsets, uint32_t dynamicOffsetCount)
+{
+    LVN_ASSERT(commandBuffer && pipeline && (pDescriptorSets || !count) && (pDynamicOffsets || !dynamicOffsetCount),
+               "commandBuffer, pipeline, pDescriptorSets, and pDynamicOffsets cannot be null");
+
+    if (!count)
+        return;
+
+    commandBuffer->graphicsctx->implCmdBindDescriptorSets(commandBuffer, pipeline, firstSet, pDescriptorSets, count, pDynamicOffsets, dynamicOffsetCount);
+}
+
+void lvnCmdPushConstants(LvnCommandBuffer* commandBuffer, const LvnPipeline* pipeline, LvnShaderStageFlags shaderStages, uint32_t offset, uint32_t size, const void* pValues)
+{
+    LVN_ASSERT(commandBuffer && pipeline && (pValues || !size), "commandBuffer, pipeline, and pValues cannot be null");
+    LVN_ASSERT(offset % 4 == 0 && size % 4 == 0, "push constant offset and size must be multiples of 4");
+
+    if (!size)
+        return;
+
+    commandBuffer->graphicsctx->implCmdPushConstants(commandBuffer, pipeline, shaderStages, offset, size, pValues);
+}
+
+void lvnCmdBindIndexBuffer(LvnCommandBuffer* commandBuffer, const LvnBuffer* buffer, uint64_t offset, LvnIndexType indexType)
+{
+    LVN_ASSERT(commandBuffer && buffer, "commandBuffer and buffer cannot be null");
+    commandBuffer->graphicsctx->implCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+}
+
+void lvnCmdDraw(LvnCommandBuffer* commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    LVN_ASSERT(commandBuffer, "commandBuffer cannot be null");
+    commandBuffer->graphicsctx->implCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void lvnCmdDrawIndexed(LvnCommandBuffer* commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    LVN_ASSERT(commandBuffer, "commandBuffer cannot be null");
+    commandBuffer->graphicsctx->implCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void lvnCmdExecuteCommands(LvnCommandBuffer* commandBuffer, LvnCommandBuffer* const* pSecondaryCommandBuffers, uint32_t count)
+{
+    LVN_ASSERT(commandBuffer && (pSecondaryCommandBuffers || !count), "commandBuffer and pSecondaryCommandBuffers cannot be null");
+
+    if (!count)
+        return;
+
+    commandBuffer->graphicsctx->implCmdExecuteCommands(commandBuffer, pSecondaryCommandBuffers, count);
+}
+
+LvnResult lvnSurfaceBeginFrame(LvnSurface* surface)
+{
+    LVN_ASSERT(surface, "surface cannot be null");
+    LvnGraphicsContext* graphicsctx = (LvnGraphicsContext*) surface->graphicsctx;
+
+    // the slot's fences are waited on first, so the image acquire below reuses a semaphore the gpu is done with
+    if (lvnGraphicsContextBeginFrame(graphicsctx) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    return graphicsctx->implSurfaceBeginFrame(surface);
+}
+
+LvnResult lvnSurfaceEndFrame(LvnSurface* surface, LvnCommandBuffer* const* pCommandBuffers, uint32_t count)
+{
+    LVN_ASSERT(surface && (pCommandBuffers || !count), "surface and pCommandBuffers cannot be null");
+    const LvnGraphicsContext* graphicsctx = surface->graphicsctx;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pCommandBuffers[i]->level != Lvn_CommandBufferLevel_Primary)
+        {
+            LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to end frame of surface %p, command buffer %p is not a primary command buffer", surface, pCommandBuffers[i]);
+            return Lvn_Result_Failure;
+        }
+    }
+
+    if (lvn_flushUniformData(graphicsctx) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    return graphicsctx->implSurfaceEndFrame(surface, pCommandBuffers, count);
 }
 
 LvnRenderPass* lvnSurfaceGetRenderPass(LvnSurface* surface)
@@ -180,6 +1848,23 @@ LvnRenderPass* lvnSurfaceGetRenderPass(LvnSurface* surface)
     return &surface->renderPass;
 }
 
+void lvnSurfaceResize(LvnSurface* surface, uint32_t width, uint32_t height)
+{
+    LVN_ASSERT(surface, "surface cannot be null");
+
+    // a minimized window has no size, keep the current swapchain until it is restored
+    if (!width || !height)
+        return;
+
+    surface->graphicsctx->implSurfaceResize(surface, width, height);
+}
+
+void lvnSurfaceGetExtent(const LvnSurface* surface, uint32_t* width, uint32_t* height)
+{
+    LVN_ASSERT(surface && width && height, "surface, width, and height cannot be null");
+    surface->graphicsctx->implSurfaceGetExtent(surface, width, height);
+}
+
 LvnPipelineFixedFunctions lvnConfigPipelineFixedFunctions(void)
 {
     LvnPipelineFixedFunctions pipelineFixedFunctions = {0};
@@ -7,7 +7,8 @@
 
 struct LvnRenderPass
 {
-    void* renderPassHandle;
+    void* renderPassHandle;                            // null with dynamic rendering
+    uint32_t colorFormat;                              // color attachment format of the graphics api
 };
 
 struct LvnSurface
@@ -22,20 +23,107 @@ struct LvnDescriptorLayout
 {
     const LvnGraphicsContext* graphicsctx;
     void* descriptorLayout;
+    void* updateTemplate;
+
+    LvnDescriptorBinding* pBindings;                   // sorted by binding, descriptorCount is at least 1
+    uint32_t bindingCount;
+    uint32_t descriptorCount;                          // buffer infos written by lvnUpdateDescriptorSet
+    uint64_t hash;                                     // key in the context descriptorLayoutTable
+    uint32_t refCount;                                 // one per lvnCreateDescriptorLayout call that returned this layout and one per pipeline built with it, guarded by the context descriptorLayoutTableLock
+    bool inTable;
+};
+
+struct LvnDescriptorSet
+{
+    const LvnGraphicsContext* graphicsctx;
+    const LvnDescriptorLayout* descriptorLayout;
+    void* descriptorSet;
 };
 
+// replacement code queued by lvnShaderQueueReload, one allocation so the code and its size are swapped together
+typedef struct LvnShaderReloadCode
+{
+    size_t codeSize;
+    uint8_t code[];
+} LvnShaderReloadCode;
+
 struct LvnShader
 {
     const LvnGraphicsContext* graphicsctx;
     void* shader;
+
+    LvnShaderReloadCode* pReloadCode;                  // queued replacement code, swapped in atomically by lvnShaderQueueReload
+    LvnShader* pNextPendingReload;                     // next shader in the context pending reload stack
+    bool reloadApplied;                                // set while lvnGraphicsContextApplyReloads rebuilds the pipelines using this shader
+
+    LvnHash128 codeHash;                               // hash of the current code, low is the key in the context shaderTable and high is compared on lookup
+    size_t codeSize;
+    uint32_t refCount;                                 // one per lvnCreateShader call, pipeline and pending reload using this shader, guarded by the context shaderTableLock
+    bool inTable;
+};
+
+struct LvnCommandBuffer
+{
+    const LvnGraphicsContext* graphicsctx;
+    void* commandBuffer;
+    LvnCommandBufferLevel level;
+    void* renderingImage;                              // image rendered to between lvnCmdBeginRenderPass and lvnCmdEndRenderPass with dynamic rendering
+};
+
+struct LvnBuffer
+{
+    const LvnGraphicsContext* graphicsctx;
+    void* buffer;
+    void* bufferMemory;
+    void* pMapped;                                     // persistently mapped pointer, null for gpu only buffers
+    uint32_t bindlessIndex;                            // LVN_BINDLESS_INVALID_INDEX unless the buffer is in the bindless set
+    uint64_t size;
+    LvnBufferUsageFlags usage;
+    LvnMemoryAccess memoryAccess;
 };
 
+// flattened create info identifying a pipeline, see lvn_createPipelineKey
+typedef struct LvnPipelineKey
+{
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    uint64_t hash;
+} LvnPipelineKey;
+
+// shared by the job ranges of one lvnCreateShadersFromSource call, every array has one entry per shader
+typedef struct LvnShaderSourceBatch
+{
+    const LvnGraphicsContext* graphicsctx;
+    const LvnShaderSourceCreateInfo* pCreateInfos;
+    uint8_t** ppCodes;
+    size_t* pCodeSizes;
+    LvnResult* pResults;
+} LvnShaderSourceBatch;
+
 struct LvnPipeline
 {
     const LvnGraphicsContext* graphicsctx;
     void* pipeline;
+
+    LvnPipelineCreateInfo* createInfo;                 // deep copy of the create info used to recreate the pipeline on shader reload, holds a reference on every stage shader and descriptor layout
+    LvnPipeline* pPrevPipeline;                        // links in the context pipeline list, guarded by the context pipelineTableLock
+    LvnPipeline* pNextPipeline;
+
+    LvnPipelineKey key;
+    uint32_t refCount;                                 // one per lvnCreatePipeline call that returned this pipeline, guarded by the context pipelineTableLock
+    bool inTable;                                      // false once the pipeline can no longer be shared
 };
 
+#define LVN_GRAPHICS_GATE_SLOT_COUNT 64
+
+// one counter per cache line so threads entering the gate never write the same line
+typedef struct LvnGraphicsGateSlot
+{
+    uint32_t count;
+    uint8_t padding[60];
+} LvnGraphicsGateSlot;
+
 struct LvnGraphicsContext
 {
     LvnGraphicsApi            graphicsapi;
@@ -44,6 +132,33 @@ struct LvnGraphicsContext
     LvnPresentationModeFlags  presentModeFlags;
     bool                      enableGraphicsApiDebugLogging;
 
+    LvnShader*                pPendingShaderReloads;    // lock free stack of shaders with queued code linked through LvnShader::pNextPendingReload
+
+    // object calls enter the gate by counting themselves in the slot of their thread, lvnGraphicsContextApplyReloads
+    // takes it exclusively by setting gateExclusive and waiting for every slot to drain
+    LvnGraphicsGateSlot       gateSlots[LVN_GRAPHICS_GATE_SLOT_COUNT];
+    uint32_t                  gateExclusive;
+
+    LvnHashTable              pipelineTable;            // pipelines by key hash, identical create infos share one pipeline
+    LvnPipeline*              pPipelines;               // every live pipeline, including ones missing from the table, rebuilt on shader reload
+    uint32_t                  pipelineTableLock;        // guards the pipeline table, the pipeline list and pipeline reference counts
+    LvnHashTable              shaderTable;              // shaders by code hash, identical code shares one shader
+    uint32_t                  shaderTableLock;
+    LvnHashTable              descriptorLayoutTable;    // descriptor layouts by binding hash, identical bindings share one layout
+    uint32_t                  descriptorLayoutTableLock;
+    char*                     shaderCacheDirectory;     // compiled spir-v cache, null if disabled
+    uint32_t                  framesInFlight;
+    uint32_t                  frameIndex;               // current frame slot, command buffers are allocated from its pools
+
+    LvnBuffer*                uniformBuffer;            // per frame uniform data, framesInFlight slots of uniformSlotSize bytes
+    uint32_t                  uniformSlotSize;
+    uint32_t                  uniformHead;              // bytes allocated in the current slot, never exceeds uniformSlotSize
+    uint64_t                  uniformAlignment;         // minimum dynamic offset alignment of uniform and storage buffers, set by the implementation
+    uint64_t                  maxUniformRange;          // largest range of a uniform descriptor, set by the implementation, 0 when unlimited
+    uint64_t                  maxStorageRange;          // largest range of a storage descriptor, set by the implementation, 0 when unlimited
+    LvnDescriptorLayout*      bindlessLayout;           // set by the implementation when bindless mode is enabled and supported
+    LvnDescriptorSet*         bindlessSet;
+
     // graphics implementation
     void*                     implData;
     LvnResult                 (*implCreateSurface)(const LvnGraphicsContext*, LvnSurface*, const LvnSurfaceCreateInfo*);
@@ -51,8 +166,50 @@ struct LvnGraphicsContext
     LvnResult                 (*implCreateShader)(const LvnGraphicsContext*, LvnShader*, const LvnShaderCreateInfo*);
     void                      (*implDestroyShader)(LvnShader*);
     LvnResult                 (*implCreatePipeline)(const LvnGraphicsContext*, LvnPipeline*, const LvnPipelineCreateInfo*);
+    LvnResult                 (*implCreatePipelines)(const LvnGraphicsContext*, LvnPipeline**, const LvnPipelineCreateInfo*, uint32_t);
     void                      (*implDestroyPipeline)(LvnPipeline*);
+    LvnResult                 (*implCreateBuffer)(const LvnGraphicsContext*, LvnBuffer*, const LvnBufferCreateInfo*);
+    void                      (*implDestroyBuffer)(LvnBuffer*);
+    LvnResult                 (*implCreateDescriptorLayout)(const LvnGraphicsContext*, LvnDescriptorLayout*);
+    void                      (*implDestroyDescriptorLayout)(LvnDescriptorLayout*);
+    LvnResult                 (*implFlushBuffer)(LvnBuffer*, uint64_t, uint64_t);
+    LvnResult                 (*implInvalidateBuffer)(LvnBuffer*, uint64_t, uint64_t);
+    LvnResult                 (*implUploadBuffer)(LvnBuffer*, const void*, uint64_t, uint64_t);
+    void                      (*implWaitIdle)(const LvnGraphicsContext*);
+    LvnResult                 (*implLoadPipelineCache)(const LvnGraphicsContext*, const uint8_t*, size_t);
+    LvnResult                 (*implGetPipelineCacheData)(const LvnGraphicsContext*, uint8_t**, size_t*);  // data is allocated with lvn_malloc
+    LvnPipelineCacheStats     (*implGetPipelineCacheStats)(const LvnGraphicsContext*);
+    LvnGraphicsMemoryStats    (*implGetMemoryStats)(const LvnGraphicsContext*);
+    LvnResult                 (*implBeginFrame)(LvnGraphicsContext*);
+    LvnResult                 (*implSurfaceBeginFrame)(LvnSurface*);
+    LvnResult                 (*implSurfaceEndFrame)(LvnSurface*, LvnCommandBuffer* const*, uint32_t);
+    void                      (*implSurfaceResize)(LvnSurface*, uint32_t, uint32_t);
+    void                      (*implSurfaceGetExtent)(const LvnSurface*, uint32_t*, uint32_t*);
+    LvnCommandBuffer*         (*implAllocateCommandBuffer)(const LvnGraphicsContext*, LvnCommandBufferLevel);
+    LvnResult                 (*implBeginCommandBuffer)(LvnCommandBuffer*, const LvnRenderPass*);
+    LvnResult                 (*implEndCommandBuffer)(LvnCommandBuffer*);
+    LvnResult                 (*implSubmitCommandBuffers)(const LvnGraphicsContext*, LvnCommandBuffer* const*, uint32_t);
+    LvnDescriptorSet*         (*implAllocateDescriptorSet)(const LvnGraphicsContext*, const LvnDescriptorLayout*);
+    void                      (*implUpdateDescriptorSet)(LvnDescriptorSet*, const LvnDescriptorBufferInfo*);
+    void                      (*implCmdBeginRenderPass)(LvnCommandBuffer*, const LvnRenderPassBeginInfo*);
+    void                      (*implCmdEndRenderPass)(LvnCommandBuffer*);
+    void                      (*implCmdBindPipeline)(LvnCommandBuffer*, const LvnPipeline*);
+    void                      (*implCmdSetViewport)(LvnCommandBuffer*, const LvnPipelineViewport*);
+    void                      (*implCmdSetScissor)(LvnCommandBuffer*, const LvnPipelineScissor*);
+    void                      (*implCmdBindVertexBuffers)(LvnCommandBuffer*, uint32_t, LvnBuffer* const*, const uint64_t*, uint32_t);
+    void                      (*implCmdBindDescriptorSets)(LvnCommandBuffer*, const LvnPipeline*, uint32_t, LvnDescriptorSet* const*, uint32_t, const uint32_t*, uint32_t);
+    void                      (*implCmdPushConstants)(LvnCommandBuffer*, const LvnPipeline*, LvnShaderStageFlags, uint32_t, uint32_t, const void*);
+    void                      (*implCmdBindIndexBuffer)(LvnCommandBuffer*, const LvnBuffer*, uint64_t, LvnIndexType);
+    void                      (*implCmdDraw)(LvnCommandBuffer*, uint32_t, uint32_t, uint32_t, uint32_t);
+    void                      (*implCmdDrawIndexed)(LvnCommandBuffer*, uint32_t, uint32_t, uint32_t, int32_t, uint32_t);
+    void                      (*implCmdExecuteCommands)(LvnCommandBuffer*, LvnCommandBuffer* const*, uint32_t);
 };
 
 
+// lvn_shader_compiler.c
+LvnResult lvn_shaderCompilerInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContextCreateInfo* createInfo);
+void      lvn_shaderCompilerTerminate(LvnGraphicsContext* graphicsctx);
+LvnResult lvn_compileShaderSource(const LvnGraphicsContext* graphicsctx, const LvnShaderSourceCreateInfo* createInfo, uint8_t** ppCode, size_t* pCodeSize); // *ppCode is allocated with lvn_malloc
+
+
 #endif // HG_LVN_GRAPHICS_INTERNAL_H
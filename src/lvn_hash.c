@@ -0,0 +1,609 @@
+#include "levikno_internal.h"
+
+#include <string.h>
+
+// the hash works on 64 byte stripes split into 8 lanes of 64 bit accumulators:
+//   acc[i]     += lo32(data[i] ^ key[i]) * hi32(data[i] ^ key[i])
+//   acc[i ^ 1] += data[i]
+// every 16 stripes the accumulators are scrambled. the key of a stripe slides one word through the secret
+// for each stripe in a block, so identical stripes at different positions do not cancel out.
+// the last 1..64 bytes are always accumulated as a separate final stripe with its own key, which lets the
+// streaming state hold back the tail of the input and still produce the same result as the one-shot functions.
+//
+// every simd path computes exactly the same lane operations as the scalar path, only the order of independent
+// lanes differs, so the output does not depend on the implementation or the platform.
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define LVN_HASH_X86
+    #include <emmintrin.h>
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+    #define LVN_HASH_NEON
+    #include <arm_neon.h>
+#endif
+
+#define LVN_HASH_STRIPE_SIZE        64
+#define LVN_HASH_STRIPES_PER_BLOCK  16
+#define LVN_HASH_LAST_STRIPE_KEY    16    // secret word offset of the key for the final stripe
+#define LVN_HASH_SCRAMBLE_KEY       24    // secret word offset of the scramble key
+#define LVN_HASH_MERGE_KEY_LOW      3
+#define LVN_HASH_MERGE_KEY_HIGH     11
+#define LVN_HASH_SHORT_MAX          16
+
+#define LVN_PRIME32_1 0x9e3779b1u
+#define LVN_PRIME32_2 0x85ebca77u
+#define LVN_PRIME32_3 0xc2b2ae3du
+#define LVN_PRIME64_1 0x9e3779b185ebca87ull
+#define LVN_PRIME64_2 0xc2b2ae3d27d4eb4full
+#define LVN_PRIME64_3 0x165667b19e3779f9ull
+#define LVN_PRIME64_4 0x85ebca77c2b2ae63ull
+#define LVN_PRIME64_5 0x27d4eb2f165667c5ull
+
+typedef void (*LvnHashAccumulateFn)(uint64_t* acc, const uint8_t* data, size_t stripeCount, const uint64_t* key);
+typedef void (*LvnHashScrambleFn)(uint64_t* acc, const uint64_t* key);
+
+// these values are part of the hash output and must never change
+static const uint64_t s_LvnHashSecret[32] =
+{
+    0xe0e663837417a50full, 0x2577751d9f304a81ull, 0xb6e8fac4eef046acull, 0xe27b601767a383baull,
+    0x9efd4ad697231111ull, 0x9ba03093eef79cd1ull, 0x8c429da7f5436f15ull, 0x957ef1328641d4ffull,
+    0x50f4f213ce109473ull, 0xdf12f401fe947837ull, 0xdfbc0fa476e18744ull, 0x7a4e4b76095ea936ull,
+    0xae506366c8346a92ull, 0xc68d8f8cdfe31806ull, 0x513c1e6b678a6c36ull, 0x3c33e88b8a8219ebull,
+    0x973ac19482f9a40eull, 0x95cf02ad1ec9bd6eull, 0x22f23b81c86d9777ull, 0xca84c62a2f45103dull,
+    0xa118e45ad79d7a05ull, 0x45fbd961ba575c01ull, 0xad529b07216ee22cull, 0xc86ee8ab5f03f5ffull,
+    0x6cdc541e32e884dbull, 0xd4eb402f6fc709c4ull, 0xf83c22c1e401dc1full, 0x18b9e897d36fe591ull,
+    0x53ea6f23f1dc7c04ull, 0x96da70ba7c306168ull, 0xeb7683c2a4c6c121ull, 0x8ecc9f95f7e468a2ull,
+};
+
+static const uint64_t s_LvnHashInitAcc[8] =
+{
+    LVN_PRIME32_3, LVN_PRIME64_1, LVN_PRIME64_2, LVN_PRIME64_3,
+    LVN_PRIME64_4, LVN_PRIME32_2, LVN_PRIME64_5, LVN_PRIME32_1,
+};
+
+
+static uint64_t lvn_hashRead64(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(uint64_t));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static uint64_t lvn_hashReadPartial64(const uint8_t* p, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+        value |= (uint64_t) p[i] << (8 * i);
+    return value;
+}
+
+static uint64_t lvn_mul128Fold64(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+    uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+    uint64_t loLo = aLo * bLo;
+    uint64_t hiLo = aHi * bLo;
+    uint64_t loHi = aLo * bHi;
+    uint64_t hiHi = aHi * bHi;
+    uint64_t cross = (loLo >> 32) + (hiLo & 0xffffffff) + loHi;
+    uint64_t high = hiHi + (hiLo >> 32) + (cross >> 32);
+    uint64_t low = (cross << 32) | (loLo & 0xffffffff);
+    return low ^ high;
+#endif
+}
+
+static uint64_t lvn_hashAvalanche(uint64_t h)
+{
+    h ^= h >> 37;
+    h *= 0x165667919e3779f9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+static void lvn_hashAccumulateScalar(uint64_t* acc, const uint8_t* data, size_t stripeCount, const uint64_t* key)
+{
+    for (size_t s = 0; s < stripeCount; s++)
+    {
+        const uint8_t* stripe = data + s * LVN_HASH_STRIPE_SIZE;
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            uint64_t value = lvn_hashRead64(stripe + i * 8);
+            uint64_t keyed = value ^ key[s + i];
+            acc[i ^ 1] += value;
+            acc[i] += (keyed & 0xffffffff) * (keyed >> 32);
+        }
+    }
+}
+
+static void lvn_hashScrambleScalar(uint64_t* acc, const uint64_t* key)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= key[i];
+        a *= LVN_PRIME32_1;
+        acc[i] = a;
+    }
+}
+
+#if defined(LVN_HASH_X86)
+static void lvn_hashAccumulateSse2(uint64_t* acc, const uint8_t* data, size_t stripeCount, const uint64_t* key)
+{
+    __m128i* xacc = (__m128i*) acc;
+    __m128i a0 = _mm_loadu_si128(xacc + 0), a1 = _mm_loadu_si128(xacc + 1);
+    __m128i a2 = _mm_loadu_si128(xacc + 2), a3 = _mm_loadu_si128(xacc + 3);
+
+    for (size_t s = 0; s < stripeCount; s++)
+    {
+        const __m128i* xdata = (const __m128i*) (data + s * LVN_HASH_STRIPE_SIZE);
+        const __m128i* xkey = (const __m128i*) (key + s);
+
+#define LVN_HASH_SSE2_LANE(accReg, index) \
+        { \
+            __m128i value = _mm_loadu_si128(xdata + index); \
+            __m128i keyed = _mm_xor_si128(value, _mm_loadu_si128(xkey + index)); \
+            __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1))); \
+            __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)); \
+            accReg = _mm_add_epi64(accReg, _mm_add_epi64(product, swapped)); \
+        }
+
+        LVN_HASH_SSE2_LANE(a0, 0)
+        LVN_HASH_SSE2_LANE(a1, 1)
+        LVN_HASH_SSE2_LANE(a2, 2)
+        LVN_HASH_SSE2_LANE(a3, 3)
+
+#undef LVN_HASH_SSE2_LANE
+    }
+
+    _mm_storeu_si128(xacc + 0, a0); _mm_storeu_si128(xacc + 1, a1);
+    _mm_storeu_si128(xacc + 2, a2); _mm_storeu_si128(xacc + 3, a3);
+}
+
+static void lvn_hashScrambleSse2(uint64_t* acc, const uint64_t* key)
+{
+    __m128i* xacc = (__m128i*) acc;
+    const __m128i* xkey = (const __m128i*) key;
+    const __m128i prime = _mm_set1_epi32((int) LVN_PRIME32_1);
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        __m128i a = _mm_loadu_si128(xacc + i);
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128(xkey + i));
+
+        // 64 bit by 32 bit multiply from two 32x32 products
+        __m128i productLo = _mm_mul_epu32(a, prime);
+        __m128i productHi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        _mm_storeu_si128(xacc + i, _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32)));
+    }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define LVN_HASH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define LVN_HASH_TARGET_AVX2
+#endif
+
+LVN_HASH_TARGET_AVX2
+static void lvn_hashAccumulateAvx2(uint64_t* acc, const uint8_t* data, size_t stripeCount, const uint64_t* key)
+{
+    __m256i* yacc = (__m256i*) acc;
+    __m256i a0 = _mm256_loadu_si256(yacc + 0);
+    __m256i a1 = _mm256_loadu_si256(yacc + 1);
+
+    for (size_t s = 0; s < stripeCount; s++)
+    {
+        const __m256i* ydata = (const __m256i*) (data + s * LVN_HASH_STRIPE_SIZE);
+        const __m256i* ykey = (const __m256i*) (key + s);
+
+#define LVN_HASH_AVX2_LANE(accReg, index) \
+        { \
+            __m256i value = _mm256_loadu_si256(ydata + index); \
+            __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(ykey + index)); \
+            __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1))); \
+            __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)); \
+            accReg = _mm256_add_epi64(accReg, _mm256_add_epi64(product, swapped)); \
+        }
+
+        LVN_HASH_AVX2_LANE(a0, 0)
+        LVN_HASH_AVX2_LANE(a1, 1)
+
+#undef LVN_HASH_AVX2_LANE
+    }
+
+    _mm256_storeu_si256(yacc + 0, a0);
+    _mm256_storeu_si256(yacc + 1, a1);
+}
+
+LVN_HASH_TARGET_AVX2
+static void lvn_hashScrambleAvx2(uint64_t* acc, const uint64_t* key)
+{
+    __m256i* yacc = (__m256i*) acc;
+    const __m256i* ykey = (const __m256i*) key;
+    const __m256i prime = _mm256_set1_epi32((int) LVN_PRIME32_1);
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        __m256i a = _mm256_loadu_si256(yacc + i);
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(a, _mm256_loadu_si256(ykey + i));
+
+        __m256i productLo = _mm256_mul_epu32(a, prime);
+        __m256i productHi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        _mm256_storeu_si256(yacc + i, _mm256_add_epi64(productLo, _mm256_slli_epi64(productHi, 32)));
+    }
+}
+
+static bool lvn_cpuSupportsAvx2(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // avx2 also needs the os to save the ymm registers
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif // LVN_HASH_X86
+
+#if defined(LVN_HASH_NEON)
+static void lvn_hashAccumulateNeon(uint64_t* acc, const uint8_t* data, size_t stripeCount, const uint64_t* key)
+{
+    uint64x2_t a[4];
+    for (uint32_t i = 0; i < 4; i++)
+        a[i] = vld1q_u64(acc + i * 2);
+
+    for (size_t s = 0; s < stripeCount; s++)
+    {
+        const uint8_t* stripe = data + s * LVN_HASH_STRIPE_SIZE;
+        const uint64_t* stripeKey = key + s;
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(stripe + i * 16));
+            uint64x2_t keyed = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8((const uint8_t*) (stripeKey + i * 2))));
+            uint64x2_t product = vmull_u32(vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+            uint64x2_t swapped = vextq_u64(value, value, 1);
+            a[i] = vaddq_u64(a[i], vaddq_u64(product, swapped));
+        }
+    }
+
+    for (uint32_t i = 0; i < 4; i++)
+        vst1q_u64(acc + i * 2, a[i]);
+}
+
+static void lvn_hashScrambleNeon(uint64_t* acc, const uint64_t* key)
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        uint64x2_t a = vld1q_u64(acc + i * 2);
+        a = veorq_u64(a, vshrq_n_u64(a, 47));
+        a = veorq_u64(a, vreinterpretq_u64_u8(vld1q_u8((const uint8_t*) (key + i * 2))));
+
+        uint64x2_t productLo = vmull_n_u32(vmovn_u64(a), LVN_PRIME32_1);
+        uint64x2_t productHi = vmull_n_u32(vshrn_n_u64(a, 32), LVN_PRIME32_1);
+        vst1q_u64(acc + i * 2, vaddq_u64(productLo, vshlq_n_u64(productHi, 32)));
+    }
+}
+#endif // LVN_HASH_NEON
+
+
+typedef struct LvnHashImplFns
+{
+    LvnHashImpl impl;
+    LvnHashAccumulateFn accumulate;
+    LvnHashScrambleFn scramble;
+} LvnHashImplFns;
+
+static const LvnHashImplFns s_LvnHashImplScalar = { Lvn_HashImpl_Scalar, lvn_hashAccumulateScalar, lvn_hashScrambleScalar };
+#if defined(LVN_HASH_X86)
+static const LvnHashImplFns s_LvnHashImplSse2 = { Lvn_HashImpl_Sse2, lvn_hashAccumulateSse2, lvn_hashScrambleSse2 };
+static const LvnHashImplFns s_LvnHashImplAvx2 = { Lvn_HashImpl_Avx2, lvn_hashAccumulateAvx2, lvn_hashScrambleAvx2 };
+#endif
+#if defined(LVN_HASH_NEON)
+static const LvnHashImplFns s_LvnHashImplNeon = { Lvn_HashImpl_Neon, lvn_hashAccumulateNeon, lvn_hashScrambleNeon };
+#endif
+
+// published with one atomic pointer store so a hash running on another thread sees both functions of one implementation
+static const LvnHashImplFns* s_LvnHashImplFns = NULL;
+
+static bool lvn_hashImplSupported(LvnHashImpl impl)
+{
+    switch (impl)
+    {
+        case Lvn_HashImpl_Auto:
+        case Lvn_HashImpl_Scalar:
+            return true;
+#if defined(LVN_HASH_X86)
+        case Lvn_HashImpl_Sse2:
+            return true;
+        case Lvn_HashImpl_Avx2:
+            return lvn_cpuSupportsAvx2();
+#endif
+#if defined(LVN_HASH_NEON)
+        case Lvn_HashImpl_Neon:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+static LvnHashImpl lvn_hashBestImpl(void)
+{
+#if defined(LVN_HASH_X86)
+    return lvn_cpuSupportsAvx2() ? Lvn_HashImpl_Avx2 : Lvn_HashImpl_Sse2;
+#elif defined(LVN_HASH_NEON)
+    return Lvn_HashImpl_Neon;
+#else
+    return Lvn_HashImpl_Scalar;
+#endif
+}
+
+static void lvn_hashSelectImpl(LvnHashImpl impl)
+{
+    const LvnHashImplFns* fns = &s_LvnHashImplScalar;
+
+    switch (impl)
+    {
+#if defined(LVN_HASH_X86)
+        case Lvn_HashImpl_Sse2: { fns = &s_LvnHashImplSse2; break; }
+        case Lvn_HashImpl_Avx2: { fns = &s_LvnHashImplAvx2; break; }
+#endif
+#if defined(LVN_HASH_NEON)
+        case Lvn_HashImpl_Neon: { fns = &s_LvnHashImplNeon; break; }
+#endif
+        default: { break; }
+    }
+
+    lvn_atomicStorePtr((void* volatile*) &s_LvnHashImplFns, (void*) fns);
+}
+
+// every implementation gives the same results, so a hash keeps the functions it loaded even if the selection changes meanwhile
+static const LvnHashImplFns* lvn_hashEnsureImpl(void)
+{
+    const LvnHashImplFns* fns = (const LvnHashImplFns*) lvn_atomicLoadPtr((void* volatile*) &s_LvnHashImplFns);
+    if (fns)
+        return fns;
+
+    // selection is idempotent, racing first calls all store the same pointer
+    lvn_hashSelectImpl(lvn_hashBestImpl());
+    return (const LvnHashImplFns*) lvn_atomicLoadPtr((void* volatile*) &s_LvnHashImplFns);
+}
+
+static void lvn_hashInitAcc(uint64_t* acc, uint64_t seed)
+{
+    for (uint32_t i = 0; i < 8; i++)
+        acc[i] = s_LvnHashInitAcc[i] + ((i & 1) ? (0 - seed) : seed);
+}
+
+static void lvn_hashConsumeStripes(const LvnHashImplFns* fns, uint64_t* acc, const uint8_t* data, size_t stripeCount, uint64_t* totalStripeCount)
+{
+    while (stripeCount)
+    {
+        size_t blockStripe = (size_t) (*totalStripeCount % LVN_HASH_STRIPES_PER_BLOCK);
+        size_t count = LVN_HASH_STRIPES_PER_BLOCK - blockStripe;
+        if (count > stripeCount)
+            count = stripeCount;
+
+        fns->accumulate(acc, data, count, s_LvnHashSecret + blockStripe);
+
+        data += count * LVN_HASH_STRIPE_SIZE;
+        stripeCount -= count;
+        *totalStripeCount += count;
+
+        if (*totalStripeCount % LVN_HASH_STRIPES_PER_BLOCK == 0)
+            fns->scramble(acc, s_LvnHashSecret + LVN_HASH_SCRAMBLE_KEY);
+    }
+}
+
+static uint64_t lvn_hashMerge(const uint64_t* acc, const uint64_t* key, uint64_t start)
+{
+    uint64_t result = start;
+    for (uint32_t i = 0; i < 4; i++)
+        result += lvn_mul128Fold64(acc[2 * i] ^ key[2 * i], acc[2 * i + 1] ^ key[2 * i + 1]);
+    return lvn_hashAvalanche(result);
+}
+
+// inputs of up to 16 bytes skip the accumulators entirely, they are mostly small keys in hash maps
+static LvnHash128 lvn_hashShort(const uint8_t* data, size_t size, uint64_t seed)
+{
+    size_t loSize = size < 8 ? size : 8;
+    uint64_t lo = lvn_hashReadPartial64(data, loSize);
+    uint64_t hi = lvn_hashReadPartial64(data + loSize, size - loSize);
+
+    LvnHash128 hash;
+    hash.low = lvn_hashAvalanche(lvn_mul128Fold64(lo ^ (s_LvnHashSecret[0] + seed), hi ^ (s_LvnHashSecret[1] - seed)) + size * LVN_PRIME64_1);
+    hash.high = lvn_hashAvalanche(lvn_mul128Fold64(lo ^ (s_LvnHashSecret[2] - seed), hi ^ (s_LvnHashSecret[3] + seed)) + size * LVN_PRIME64_2 + seed);
+    return hash;
+}
+
+static LvnHash128 lvn_hashFinalize(const LvnHashImplFns* fns, uint64_t* acc, const uint8_t* lastStripe, uint64_t totalSize)
+{
+    fns->accumulate(acc, lastStripe, 1, s_LvnHashSecret + LVN_HASH_LAST_STRIPE_KEY);
+
+    LvnHash128 hash;
+    hash.low = lvn_hashMerge(acc, s_LvnHashSecret + LVN_HASH_MERGE_KEY_LOW, totalSize * LVN_PRIME64_1);
+    hash.high = lvn_hashMerge(acc, s_LvnHashSecret + LVN_HASH_MERGE_KEY_HIGH, ~(totalSize * LVN_PRIME64_2));
+    return hash;
+}
+
+static LvnHash128 lvn_hash(const void* data, size_t size, uint64_t seed)
+{
+    LVN_ASSERT((data || size == 0), "data cannot be null when size is not zero");
+
+    const uint8_t* bytes = (const uint8_t*) data;
+
+    if (size <= LVN_HASH_SHORT_MAX)
+        return lvn_hashShort(bytes, size, seed);
+
+    const LvnHashImplFns* fns = lvn_hashEnsureImpl();
+
+    uint64_t acc[8];
+    uint64_t stripeCount = 0;
+    lvn_hashInitAcc(acc, seed);
+
+    // the last 1..64 bytes are left for the final stripe
+    lvn_hashConsumeStripes(fns, acc, bytes, (size - 1) / LVN_HASH_STRIPE_SIZE, &stripeCount);
+
+    if (size >= LVN_HASH_STRIPE_SIZE)
+        return lvn_hashFinalize(fns, acc, bytes + size - LVN_HASH_STRIPE_SIZE, size);
+
+    uint8_t lastStripe[LVN_HASH_STRIPE_SIZE] = {0};
+    memcpy(lastStripe, bytes, size);
+    return lvn_hashFinalize(fns, acc, lastStripe, size);
+}
+
+uint64_t lvnHash64(const void* data, size_t size, uint64_t seed)
+{
+    return lvn_hash(data, size, seed).low;
+}
+
+LvnHash128 lvnHash128(const void* data, size_t size, uint64_t seed)
+{
+    return lvn_hash(data, size, seed);
+}
+
+void lvnHashStateInit(LvnHashState* state, uint64_t seed)
+{
+    LVN_ASSERT(state, "state cannot be null");
+
+    memset(state, 0, sizeof(LvnHashState));
+    state->seed = seed;
+    lvn_hashInitAcc(state->acc, seed);
+}
+
+void lvnHashStateUpdate(LvnHashState* state, const void* data, size_t size)
+{
+    LVN_ASSERT(state, "state cannot be null");
+    LVN_ASSERT((data || size == 0), "data cannot be null when size is not zero");
+
+    const uint8_t* bytes = (const uint8_t*) data;
+    state->totalSize += size;
+
+    // always hold back 1..64 bytes so the final stripe is known when the digest is taken
+    if (state->bufferSize + size <= LVN_HASH_STRIPE_SIZE)
+    {
+        memcpy(state->buffer + state->bufferSize, bytes, size);
+        state->bufferSize += (uint32_t) size;
+        return;
+    }
+
+    const LvnHashImplFns* fns = lvn_hashEnsureImpl();
+
+    if (state->bufferSize)
+    {
+        size_t fill = LVN_HASH_STRIPE_SIZE - state->bufferSize;
+        memcpy(state->buffer + state->bufferSize, bytes, fill);
+        bytes += fill;
+        size -= fill;
+
+        lvn_hashConsumeStripes(fns, state->acc, state->buffer, 1, &state->stripeCount);
+        memcpy(state->lastStripe, state->buffer, LVN_HASH_STRIPE_SIZE);
+        state->bufferSize = 0;
+    }
+
+    size_t stripeCount = (size - 1) / LVN_HASH_STRIPE_SIZE;
+    if (stripeCount)
+    {
+        lvn_hashConsumeStripes(fns, state->acc, bytes, stripeCount, &state->stripeCount);
+        memcpy(state->lastStripe, bytes + (stripeCount - 1) * LVN_HASH_STRIPE_SIZE, LVN_HASH_STRIPE_SIZE);
+        bytes += stripeCount * LVN_HASH_STRIPE_SIZE;
+        size -= stripeCount * LVN_HASH_STRIPE_SIZE;
+    }
+
+    memcpy(state->buffer, bytes, size);
+    state->bufferSize = (uint32_t) size;
+}
+
+LvnHash128 lvnHashStateDigest128(const LvnHashState* state)
+{
+    LVN_ASSERT(state, "state cannot be null");
+
+    if (state->totalSize <= LVN_HASH_SHORT_MAX)
+        return lvn_hashShort(state->buffer, (size_t) state->totalSize, state->seed);
+
+    const LvnHashImplFns* fns = lvn_hashEnsureImpl();
+
+    uint64_t acc[8];
+    memcpy(acc, state->acc, sizeof(acc));
+
+    // the final stripe is the last 64 bytes of the input, part of it may already have been consumed
+    uint8_t lastStripe[LVN_HASH_STRIPE_SIZE] = {0};
+    if (state->totalSize >= LVN_HASH_STRIPE_SIZE)
+    {
+        size_t consumedSize = LVN_HASH_STRIPE_SIZE - state->bufferSize;
+        memcpy(lastStripe, state->lastStripe + state->bufferSize, consumedSize);
+        memcpy(lastStripe + consumedSize, state->buffer, state->bufferSize);
+    }
+    else
+    {
+        memcpy(lastStripe, state->buffer, state->bufferSize);
+    }
+
+    return lvn_hashFinalize(fns, acc, lastStripe, state->totalSize);
+}
+
+uint64_t lvnHashStateDigest64(const LvnHashState* state)
+{
+    return lvnHashStateDigest128(state).low;
+}
+
+LvnResult lvnHashSetImpl(LvnHashImpl impl)
+{
+    if (!lvn_hashImplSupported(impl))
+        return Lvn_Result_Failure;
+
+    lvn_hashSelectImpl(impl == Lvn_HashImpl_Auto ? lvn_hashBestImpl() : impl);
+    return Lvn_Result_Success;
+}
+
+LvnHashImpl lvnHashGetImpl(void)
+{
+    return lvn_hashEnsureImpl()->impl;
+}
+
+const char* lvnHashGetImplName(LvnHashImpl impl)
+{
+    switch (impl)
+    {
+        case Lvn_HashImpl_Auto:   { return "auto"; }
+        case Lvn_HashImpl_Scalar: { return "scalar"; }
+        case Lvn_HashImpl_Sse2:   { return "sse2"; }
+        case Lvn_HashImpl_Avx2:   { return "avx2"; }
+        case Lvn_HashImpl_Neon:   { return "neon"; }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,647 @@
+#include "levikno_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// every worker owns a chase-lev deque: the owner pushes and pops jobs at the bottom without locking while
+// idle workers steal from the top of other deques. jobs submitted from threads that are not workers, and jobs
+// that do not fit in a full deque, go to a mutex guarded injection queue shared by everyone.
+//
+// a counter packs the number of unfinished jobs and a lock bit into a single word. the lock only guards the
+// list of jobs waiting on the counter, and the store that brings the counter to zero is always the last access
+// to it, so a waiter is free to release the counter as soon as it reads zero.
+//
+// idle threads spin for a short while and then sleep on a condition variable. wakers only take the mutex when
+// someone is asleep; both sides issue a full fence between publishing their state and checking the other side.
+
+#define LVN_JOB_DEQUE_CAPACITY      4096             // must be a power of two
+#define LVN_JOB_DEQUE_MASK          (LVN_JOB_DEQUE_CAPACITY - 1)
+#define LVN_JOB_COUNTER_LOCK        0x80000000u
+#define LVN_JOB_SPIN_COUNT          64
+#define LVN_JOB_BATCHES_PER_THREAD  4                // default parallel for split, gives stealing room to balance uneven batches
+#define LVN_JOB_CACHE_LINE_SIZE     64
+
+typedef struct LvnJobBatch LvnJobBatch;
+
+typedef struct LvnJob
+{
+    LvnJobFn func;
+    void* userData;
+    LvnJobCounter* counter;
+    LvnJobBatch* batch;
+    struct LvnJob* next;                             // link in the injection queue or in a counter waiting list
+} LvnJob;
+
+// jobs from one submit share a single allocation, freed by whichever job finishes last
+struct LvnJobBatch
+{
+    uint32_t remaining;
+    LvnJob jobs[];
+};
+
+typedef struct LvnJobDeque
+{
+    int64_t top;                                     // stolen from by other threads
+    uint8_t topPadding[LVN_JOB_CACHE_LINE_SIZE - sizeof(int64_t)];
+    int64_t bottom;                                  // only written by the owner
+    uint8_t bottomPadding[LVN_JOB_CACHE_LINE_SIZE - sizeof(int64_t)];
+    LvnJob* buffer[LVN_JOB_DEQUE_CAPACITY];
+} LvnJobDeque;
+
+typedef struct LvnJobWorker
+{
+    LvnJobDeque deque;
+    LvnJobSystem* system;
+    void* thread;
+    uint32_t index;
+    uint32_t cpu;                                    // UINT32_MAX if the worker is not pinned
+    uint32_t rng;                                    // xorshift state for picking steal victims
+} LvnJobWorker;
+
+struct LvnJobSystem
+{
+    LvnJobWorker* pWorkers;
+    uint32_t workerCount;
+
+    void* mutex;                                     // guards the injection queue and sleeping
+    void* wakeCondVar;
+    LvnJob* injectHead;
+    LvnJob* injectTail;
+    uint32_t sleeperCount;
+    uint32_t shutdown;
+};
+
+typedef struct LvnJobRange
+{
+    LvnJobRangeFn func;
+    void* userData;
+    uint32_t begin;
+    uint32_t end;
+} LvnJobRange;
+
+static LVN_THREAD_LOCAL LvnJobWorker* s_LvnJobWorker = NULL;
+static LVN_THREAD_LOCAL uint32_t s_LvnJobThreadRng = 0;
+
+
+static uint32_t lvn_jobRandom(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static LvnJobWorker* lvn_jobGetWorker(const LvnJobSystem* system)
+{
+    return (s_LvnJobWorker && s_LvnJobWorker->system == system) ? s_LvnJobWorker : NULL;
+}
+
+static bool lvn_jobDequePush(LvnJobDeque* deque, LvnJob* job)
+{
+    int64_t bottom = lvn_atomicLoad64(&deque->bottom);
+    int64_t top = lvn_atomicLoad64(&deque->top);
+    if (bottom - top >= LVN_JOB_DEQUE_CAPACITY)
+        return false;
+
+    lvn_atomicStorePtr((void* volatile*) &deque->buffer[bottom & LVN_JOB_DEQUE_MASK], job);
+    lvn_atomicStore64(&deque->bottom, bottom + 1);
+    return true;
+}
+
+static LvnJob* lvn_jobDequePop(LvnJobDeque* deque)
+{
+    int64_t bottom = lvn_atomicLoad64(&deque->bottom) - 1;
+    lvn_atomicStore64(&deque->bottom, bottom);
+    lvn_atomicFence();
+    int64_t top = lvn_atomicLoad64(&deque->top);
+
+    if (top > bottom)
+    {
+        lvn_atomicStore64(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+
+    LvnJob* job = (LvnJob*) lvn_atomicLoadPtr((void* volatile*) &deque->buffer[bottom & LVN_JOB_DEQUE_MASK]);
+    if (top == bottom)
+    {
+        // last job in the deque, race the thieves for it
+        if (!lvn_atomicCas64(&deque->top, top, top + 1))
+            job = NULL;
+        lvn_atomicStore64(&deque->bottom, bottom + 1);
+    }
+
+    return job;
+}
+
+static LvnJob* lvn_jobDequeSteal(LvnJobDeque* deque)
+{
+    int64_t top = lvn_atomicLoad64(&deque->top);
+    lvn_atomicFence();
+    int64_t bottom = lvn_atomicLoad64(&deque->bottom);
+
+    if (top >= bottom)
+        return NULL;
+
+    LvnJob* job = (LvnJob*) lvn_atomicLoadPtr((void* volatile*) &deque->buffer[top & LVN_JOB_DEQUE_MASK]);
+    if (!lvn_atomicCas64(&deque->top, top, top + 1))
+        return NULL;
+
+    return job;
+}
+
+static bool lvn_jobHasWork(LvnJobSystem* system)
+{
+    if (lvn_atomicLoadPtr((void* volatile*) &system->injectHead))
+        return true;
+
+    for (uint32_t i = 0; i < system->workerCount; i++)
+    {
+        LvnJobDeque* deque = &system->pWorkers[i].deque;
+        if (lvn_atomicLoad64(&deque->bottom) > lvn_atomicLoad64(&deque->top))
+            return true;
+    }
+
+    return false;
+}
+
+static void lvn_jobWake(LvnJobSystem* system, bool all)
+{
+    lvn_atomicFence();
+    if (!lvn_atomicLoad32(&system->sleeperCount))
+        return;
+
+    lvn_platformLockMutex(system->mutex);
+    if (all)
+        lvn_platformBroadcastCondVar(system->wakeCondVar);
+    else
+        lvn_platformSignalCondVar(system->wakeCondVar);
+    lvn_platformUnlockMutex(system->mutex);
+}
+
+static void lvn_jobSleep(LvnJobSystem* system, const LvnJobCounter* counter)
+{
+    lvn_platformLockMutex(system->mutex);
+    lvn_atomicFetchAdd32(&system->sleeperCount, 1);
+    lvn_atomicFence();
+
+    if (!lvn_jobHasWork(system) && !lvn_atomicLoad32(&system->shutdown) && !(counter && lvnJobCounterIsDone(counter)))
+        lvn_platformWaitCondVar(system->wakeCondVar, system->mutex);
+
+    lvn_atomicFetchAdd32(&system->sleeperCount, (uint32_t) -1);
+    lvn_platformUnlockMutex(system->mutex);
+}
+
+// push a list of jobs linked through next, onto the calling worker deque when possible
+static void lvn_jobPushList(LvnJobSystem* system, LvnJob* first)
+{
+    LvnJobWorker* worker = lvn_jobGetWorker(system);
+    LvnJob* overflowHead = NULL;
+    LvnJob* overflowTail = NULL;
+    uint32_t count = 0;
+
+    for (LvnJob* job = first; job; )
+    {
+        LvnJob* next = job->next;
+        job->next = NULL;
+        count++;
+
+        if (!worker || !lvn_jobDequePush(&worker->deque, job))
+        {
+            if (overflowTail)
+                overflowTail->next = job;
+            else
+                overflowHead = job;
+            overflowTail = job;
+        }
+
+        job = next;
+    }
+
+    if (overflowHead)
+    {
+        lvn_platformLockMutex(system->mutex);
+        if (system->injectTail)
+            system->injectTail->next = overflowHead;
+        else
+            lvn_atomicStorePtr((void* volatile*) &system->injectHead, overflowHead);
+        system->injectTail = overflowTail;
+        lvn_platformUnlockMutex(system->mutex);
+    }
+
+    lvn_jobWake(system, count > 1);
+}
+
+static LvnJob* lvn_jobFind(LvnJobSystem* system, LvnJobWorker* worker)
+{
+    LvnJob* job = NULL;
+
+    if (worker && (job = lvn_jobDequePop(&worker->deque)))
+        return job;
+
+    if (lvn_atomicLoadPtr((void* volatile*) &system->injectHead))
+    {
+        lvn_platformLockMutex(system->mutex);
+        job = system->injectHead;
+        if (job)
+        {
+            lvn_atomicStorePtr((void* volatile*) &system->injectHead, job->next);
+            if (!job->next)
+                system->injectTail = NULL;
+            job->next = NULL;
+        }
+        lvn_platformUnlockMutex(system->mutex);
+
+        if (job)
+            return job;
+    }
+
+    uint32_t* rng = worker ? &worker->rng : &s_LvnJobThreadRng;
+    if (!*rng)
+        *rng = (uint32_t) lvn_platformGetThreadId() | 1;
+
+    uint32_t start = lvn_jobRandom(rng);
+    for (uint32_t i = 0; i < system->workerCount; i++)
+    {
+        LvnJobWorker* victim = &system->pWorkers[(start + i) % system->workerCount];
+        if (victim == worker)
+            continue;
+
+        if ((job = lvn_jobDequeSteal(&victim->deque)))
+            return job;
+    }
+
+    return NULL;
+}
+
+static uint32_t lvn_jobCounterLock(LvnJobCounter* counter)
+{
+    for (;;)
+    {
+        uint32_t state = lvn_atomicLoad32(&counter->state);
+        if (!(state & LVN_JOB_COUNTER_LOCK) && lvn_atomicCas32(&counter->state, state, state | LVN_JOB_COUNTER_LOCK))
+            return state;
+    }
+}
+
+static void lvn_jobCounterAdd(LvnJobCounter* counter, uint32_t count)
+{
+    for (;;)
+    {
+        uint32_t state = lvn_atomicLoad32(&counter->state);
+        if (!(state & LVN_JOB_COUNTER_LOCK) && lvn_atomicCas32(&counter->state, state, state + count))
+            return;
+    }
+}
+
+static void lvn_jobCounterDecrement(LvnJobSystem* system, LvnJobCounter* counter)
+{
+    for (;;)
+    {
+        uint32_t state = lvn_atomicLoad32(&counter->state);
+        if (state & LVN_JOB_COUNTER_LOCK)
+            continue;
+
+        if (state != 1)
+        {
+            if (lvn_atomicCas32(&counter->state, state, state - 1))
+                return;
+            continue;
+        }
+
+        // last job, take the waiting jobs before the counter becomes zero
+        if (!lvn_atomicCas32(&counter->state, state, LVN_JOB_COUNTER_LOCK))
+            continue;
+
+        LvnJob* waiting = (LvnJob*) counter->pWaitingJobs;
+        counter->pWaitingJobs = NULL;
+        lvn_atomicStore32(&counter->state, 0);
+
+        if (waiting)
+            lvn_jobPushList(system, waiting);
+
+        lvn_jobWake(system, true);
+        return;
+    }
+}
+
+// park a list of jobs until the counter reaches zero, returns false if it already is zero
+static bool lvn_jobCounterPark(LvnJobCounter* counter, LvnJob* first, LvnJob* last)
+{
+    uint32_t state = lvn_jobCounterLock(counter);
+    if (state == 0)
+    {
+        lvn_atomicStore32(&counter->state, state);
+        return false;
+    }
+
+    last->next = (LvnJob*) counter->pWaitingJobs;
+    counter->pWaitingJobs = first;
+    lvn_atomicStore32(&counter->state, state);
+    return true;
+}
+
+static void lvn_jobRun(LvnJobSystem* system, LvnJob* job)
+{
+    LvnJobCounter* counter = job->counter;
+    LvnJobBatch* batch = job->batch;
+
+    job->func(job->userData);
+
+    if (counter)
+        lvn_jobCounterDecrement(system, counter);
+
+    if (lvn_atomicFetchAdd32(&batch->remaining, (uint32_t) -1) == 1)
+        lvn_free(batch);
+}
+
+static void lvn_jobWorkerMain(void* arg)
+{
+    LvnJobWorker* worker = (LvnJobWorker*) arg;
+    LvnJobSystem* system = worker->system;
+    s_LvnJobWorker = worker;
+
+    if (worker->cpu != UINT32_MAX)
+        lvn_platformSetThreadAffinity(worker->cpu);
+
+#ifdef LVN_ENABLE_PROFILER
+    char threadName[32];
+    snprintf(threadName, sizeof(threadName), "lvn worker %u", worker->index);
+    lvnProfilerSetThreadName(threadName);
+#endif
+
+    uint32_t idleCount = 0;
+    for (;;)
+    {
+        LvnJob* job = lvn_jobFind(system, worker);
+        if (job)
+        {
+            lvn_jobRun(system, job);
+            idleCount = 0;
+            continue;
+        }
+
+        // queues are drained before exiting so no submitted job is lost
+        if (lvn_atomicLoad32(&system->shutdown))
+            break;
+
+        if (++idleCount < LVN_JOB_SPIN_COUNT)
+        {
+            lvn_platformYieldThread();
+            continue;
+        }
+
+        lvn_jobSleep(system, NULL);
+        idleCount = 0;
+    }
+
+    s_LvnJobWorker = NULL;
+}
+
+static LvnResult lvn_jobSubmit(LvnJobSystem* system, LvnJobCounter* dependency, const LvnJobDesc* pJobs, uint32_t jobCount, LvnJobCounter* counter)
+{
+    LVN_ASSERT((pJobs || jobCount == 0), "pJobs cannot be null when jobCount is not zero");
+
+    if (!jobCount)
+        return Lvn_Result_Success;
+
+    LvnJobBatch* batch = (LvnJobBatch*) lvn_malloc(sizeof(LvnJobBatch) + sizeof(LvnJob) * jobCount);
+    if (!batch)
+        return Lvn_Result_Failure;
+
+    batch->remaining = jobCount;
+    for (uint32_t i = 0; i < jobCount; i++)
+    {
+        LVN_ASSERT(pJobs[i].func, "job func cannot be null");
+
+        LvnJob* job = &batch->jobs[i];
+        job->func = pJobs[i].func;
+        job->userData = pJobs[i].userData;
+        job->counter = counter;
+        job->batch = batch;
+        job->next = (i + 1 < jobCount) ? &batch->jobs[i + 1] : NULL;
+    }
+
+    // count the jobs before any of them can run and finish
+    if (counter)
+        lvn_jobCounterAdd(counter, jobCount);
+
+    if (dependency && lvn_jobCounterPark(dependency, &batch->jobs[0], &batch->jobs[jobCount - 1]))
+        return Lvn_Result_Success;
+
+    lvn_jobPushList(system, &batch->jobs[0]);
+    return Lvn_Result_Success;
+}
+
+static void lvn_jobRunRange(void* userData)
+{
+    const LvnJobRange* range = (const LvnJobRange*) userData;
+    range->func(range->begin, range->end, range->userData);
+}
+
+LvnResult lvn_jobSystemCreate(LvnContext* ctx, const LvnContextCreateInfo* createInfo)
+{
+    uint32_t workerCount = createInfo ? createInfo->jobs.workerThreadCount : 0;
+    if (!workerCount)
+    {
+        uint32_t cpuCount = lvn_platformGetCpuCount();
+        workerCount = cpuCount > 1 ? cpuCount - 1 : 1;
+    }
+
+    LvnJobSystem* system = (LvnJobSystem*) lvn_calloc(sizeof(LvnJobSystem));
+    if (!system)
+        return Lvn_Result_Failure;
+
+    system->pWorkers = (LvnJobWorker*) lvn_calloc(sizeof(LvnJobWorker) * workerCount);
+    system->mutex = lvn_platformCreateMutex();
+    system->wakeCondVar = lvn_platformCreateCondVar();
+
+    if (!system->pWorkers || !system->mutex || !system->wakeCondVar)
+    {
+        LVN_LOG_ERROR(&ctx->coreLogger, "failed to allocate job system with %u workers", workerCount);
+        goto fail_cleanup;
+    }
+
+    system->workerCount = workerCount;
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        LvnJobWorker* worker = &system->pWorkers[i];
+        worker->system = system;
+        worker->index = i;
+        worker->rng = (i + 1) * 0x9e3779b9u;
+        worker->cpu = UINT32_MAX;
+
+        if (createInfo && createInfo->jobs.pWorkerCpus && createInfo->jobs.workerCpuCount)
+            worker->cpu = createInfo->jobs.pWorkerCpus[i % createInfo->jobs.workerCpuCount];
+    }
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        system->pWorkers[i].thread = lvn_platformCreateThread(lvn_jobWorkerMain, &system->pWorkers[i]);
+        if (!system->pWorkers[i].thread)
+        {
+            LVN_LOG_ERROR(&ctx->coreLogger, "failed to create job system worker thread %u", i);
+            goto fail_cleanup;
+        }
+    }
+
+    ctx->jobSystem = system;
+
+    LVN_LOG_TRACE(&ctx->coreLogger, "job system created with %u worker threads", workerCount);
+    return Lvn_Result_Success;
+
+fail_cleanup:
+    if (system->pWorkers)
+    {
+        lvn_atomicStore32(&system->shutdown, 1);
+        lvn_jobWake(system, true);
+        for (uint32_t i = 0; i < system->workerCount; i++)
+        {
+            if (system->pWorkers[i].thread)
+                lvn_platformJoinThread(system->pWorkers[i].thread);
+        }
+    }
+    if (system->wakeCondVar)
+        lvn_platformDestroyCondVar(system->wakeCondVar);
+    if (system->mutex)
+        lvn_platformDestroyMutex(system->mutex);
+    lvn_free(system->pWorkers);
+    lvn_free(system);
+    return Lvn_Result_Failure;
+}
+
+void lvn_jobSystemDestroy(LvnContext* ctx)
+{
+    LvnJobSystem* system = ctx->jobSystem;
+    if (!system)
+        return;
+
+    lvn_atomicStore32(&system->shutdown, 1);
+
+    lvn_platformLockMutex(system->mutex);
+    lvn_platformBroadcastCondVar(system->wakeCondVar);
+    lvn_platformUnlockMutex(system->mutex);
+
+    for (uint32_t i = 0; i < system->workerCount; i++)
+        lvn_platformJoinThread(system->pWorkers[i].thread);
+
+    lvn_platformDestroyCondVar(system->wakeCondVar);
+    lvn_platformDestroyMutex(system->mutex);
+    lvn_free(system->pWorkers);
+    lvn_free(system);
+    ctx->jobSystem = NULL;
+}
+
+LvnResult lvnJobSubmit(LvnContext* ctx, const LvnJobDesc* pJobs, uint32_t jobCount, LvnJobCounter* counter)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+    return lvn_jobSubmit(ctx->jobSystem, NULL, pJobs, jobCount, counter);
+}
+
+LvnResult lvnJobSubmitAfter(LvnContext* ctx, LvnJobCounter* dependency, const LvnJobDesc* pJobs, uint32_t jobCount, LvnJobCounter* counter)
+{
+    LVN_ASSERT(ctx && dependency, "ctx and dependency cannot be null");
+    LVN_ASSERT(dependency != counter, "a job cannot depend on its own counter");
+    return lvn_jobSubmit(ctx->jobSystem, dependency, pJobs, jobCount, counter);
+}
+
+void lvnJobWait(LvnContext* ctx, LvnJobCounter* counter)
+{
+    LVN_ASSERT(ctx && counter, "ctx and counter cannot be null");
+
+    LvnJobSystem* system = ctx->jobSystem;
+    LvnJobWorker* worker = lvn_jobGetWorker(system);
+    uint32_t idleCount = 0;
+
+    while (!lvnJobCounterIsDone(counter))
+    {
+        LvnJob* job = lvn_jobFind(system, worker);
+        if (job)
+        {
+            lvn_jobRun(system, job);
+            idleCount = 0;
+            continue;
+        }
+
+        if (++idleCount < LVN_JOB_SPIN_COUNT)
+        {
+            lvn_platformYieldThread();
+            continue;
+        }
+
+        lvn_jobSleep(system, counter);
+        idleCount = 0;
+    }
+}
+
+bool lvnJobCounterIsDone(const LvnJobCounter* counter)
+{
+    LVN_ASSERT(counter, "counter cannot be null");
+    return lvn_atomicLoad32((volatile uint32_t*) &counter->state) == 0;
+}
+
+void lvnJobParallelFor(LvnContext* ctx, uint32_t count, uint32_t batchSize, LvnJobRangeFn func, void* userData)
+{
+    LVN_ASSERT(ctx && func, "ctx and func cannot be null");
+
+    if (!count)
+        return;
+
+    if (!batchSize)
+    {
+        uint64_t parts = (uint64_t) (ctx->jobSystem->workerCount + 1) * LVN_JOB_BATCHES_PER_THREAD;
+        batchSize = (uint32_t) (((uint64_t) count + parts - 1) / parts);
+    }
+
+    uint32_t batchCount = (uint32_t) (((uint64_t) count + batchSize - 1) / batchSize);
+    if (batchCount == 1)
+    {
+        func(0, count, userData);
+        return;
+    }
+
+    LvnJobRange* pRanges = (LvnJobRange*) lvn_malloc((sizeof(LvnJobRange) + sizeof(LvnJobDesc)) * batchCount);
+    if (!pRanges)
+    {
+        func(0, count, userData);
+        return;
+    }
+
+    LvnJobDesc* pJobs = (LvnJobDesc*) (pRanges + batchCount);
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        pRanges[i].func = func;
+        pRanges[i].userData = userData;
+        pRanges[i].begin = i * batchSize;
+        pRanges[i].end = (count - pRanges[i].begin > batchSize) ? pRanges[i].begin + batchSize : count;
+        pJobs[i].func = lvn_jobRunRange;
+        pJobs[i].userData = &pRanges[i];
+    }
+
+    LvnJobCounter counter = {0};
+    if (lvn_jobSubmit(ctx->jobSystem, NULL, pJobs, batchCount, &counter) != Lvn_Result_Success)
+    {
+        func(0, count, userData);
+        lvn_free(pRanges);
+        return;
+    }
+
+    lvnJobWait(ctx, &counter);
+    lvn_free(pRanges);
+}
+
+uint32_t lvnJobGetWorkerCount(const LvnContext* ctx)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+    return ctx->jobSystem->workerCount;
+}
+
+int32_t lvnJobGetWorkerIndex(const LvnContext* ctx)
+{
+    LVN_ASSERT(ctx, "ctx cannot be null");
+
+    LvnJobWorker* worker = lvn_jobGetWorker(ctx->jobSystem);
+    return worker ? (int32_t) worker->index : -1;
+}
@@ -1,8 +1,28 @@
+// pthread_setaffinity_np and cpu_set_t are gnu extensions
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
 #include "levikno_internal.h"
 
+#include <stdio.h>
+#include <string.h>
+
 #if defined(LVN_PLATFORM_UNIX)
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if defined(LVN_PLATFORM_LINUX)
+    #include <sys/syscall.h>
+#endif
 
 void* lvn_platformLoadModule(const char* path)
 {
@@ -21,6 +41,532 @@ LvnProc lvn_platformGetModuleSymbol(void* handle, const char* name)
     return proc;
 }
 
+void* lvn_platformMapFile(const char* filepath, size_t* size)
+{
+    *size = 0;
+
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void* data = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // mapping stays valid after the descriptor is closed
+
+    if (data == MAP_FAILED)
+        return NULL;
+
+    // files are mostly read front to back once (shaders, assets), let the kernel read ahead
+    madvise(data, (size_t) st.st_size, MADV_SEQUENTIAL);
+    madvise(data, (size_t) st.st_size, MADV_WILLNEED);
+
+    *size = (size_t) st.st_size;
+    return data;
+}
+
+void lvn_platformUnmapFile(void* data, size_t size)
+{
+    munmap(data, size);
+}
+
+bool lvn_platformFileOpen(const char* filepath, intptr_t* handle, size_t* size)
+{
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    *handle = fd;
+    *size = (size_t) st.st_size;
+    return true;
+}
+
+int64_t lvn_platformFileRead(intptr_t handle, void* dst, size_t size, uint64_t offset)
+{
+    ssize_t result;
+    do
+    {
+        result = pread((int) handle, dst, size, (off_t) offset);
+    } while (result < 0 && errno == EINTR);
+
+    return result;
+}
+
+void lvn_platformFileClose(intptr_t handle)
+{
+    close((int) handle);
+}
+
+bool lvn_platformWriteFileAtomic(const char* filepath, const void* data, size_t size)
+{
+    // the thread id keeps temporary files of concurrent writers, including other processes, apart
+    size_t tempPathSize = strlen(filepath) + 32;
+    char* tempPath = (char*) lvn_malloc(tempPathSize);
+    if (!tempPath)
+        return false;
+
+    snprintf(tempPath, tempPathSize, "%s.%llu.tmp", filepath, (unsigned long long) lvn_platformGetThreadId());
+
+    int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        lvn_free(tempPath);
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*) data;
+    size_t written = 0;
+    while (written < size)
+    {
+        ssize_t result = write(fd, bytes + written, size - written);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            break;
+        written += (size_t) result;
+    }
+
+    // the data has to reach the disk before the rename, otherwise a crash can leave an empty file behind
+    bool success = written == size && fsync(fd) == 0;
+    success = close(fd) == 0 && success;
+    success = success && rename(tempPath, filepath) == 0;
+
+    if (!success)
+        unlink(tempPath);
+
+    lvn_free(tempPath);
+    return success;
+}
+
+typedef struct LvnPlatformThreadStart
+{
+    LvnThreadFn func;
+    void* arg;
+} LvnPlatformThreadStart;
+
+static void* lvn_platformThreadEntry(void* arg)
+{
+    LvnPlatformThreadStart start = *(LvnPlatformThreadStart*) arg;
+    lvn_free(arg);
+    start.func(start.arg);
+    return NULL;
+}
+
+void* lvn_platformCreateThread(LvnThreadFn func, void* arg)
+{
+    pthread_t* thread = (pthread_t*) lvn_calloc(sizeof(pthread_t));
+    LvnPlatformThreadStart* start = (LvnPlatformThreadStart*) lvn_calloc(sizeof(LvnPlatformThreadStart));
+    start->func = func;
+    start->arg = arg;
+
+    if (pthread_create(thread, NULL, lvn_platformThreadEntry, start) != 0)
+    {
+        lvn_free(start);
+        lvn_free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+void lvn_platformJoinThread(void* thread)
+{
+    pthread_join(*(pthread_t*) thread, NULL);
+    lvn_free(thread);
+}
+
+void* lvn_platformCreateMutex(void)
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*) lvn_calloc(sizeof(pthread_mutex_t));
+    pthread_mutex_init(mutex, NULL);
+    return mutex;
+}
+
+void lvn_platformDestroyMutex(void* mutex)
+{
+    pthread_mutex_destroy((pthread_mutex_t*) mutex);
+    lvn_free(mutex);
+}
+
+void lvn_platformLockMutex(void* mutex)
+{
+    pthread_mutex_lock((pthread_mutex_t*) mutex);
+}
+
+void lvn_platformUnlockMutex(void* mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t*) mutex);
+}
+
+void* lvn_platformCreateCondVar(void)
+{
+    pthread_cond_t* condVar = (pthread_cond_t*) lvn_calloc(sizeof(pthread_cond_t));
+    pthread_cond_init(condVar, NULL);
+    return condVar;
+}
+
+void lvn_platformDestroyCondVar(void* condVar)
+{
+    pthread_cond_destroy((pthread_cond_t*) condVar);
+    lvn_free(condVar);
+}
+
+void lvn_platformWaitCondVar(void* condVar, void* mutex)
+{
+    pthread_cond_wait((pthread_cond_t*) condVar, (pthread_mutex_t*) mutex);
+}
+
+void lvn_platformSignalCondVar(void* condVar)
+{
+    pthread_cond_signal((pthread_cond_t*) condVar);
+}
+
+void lvn_platformBroadcastCondVar(void* condVar)
+{
+    pthread_cond_broadcast((pthread_cond_t*) condVar);
+}
+
+uint32_t lvn_platformGetCpuCount(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t) count : 1;
+}
+
+uint64_t lvn_platformGetMonotonicTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+uint64_t lvn_platformGetThreadId(void)
+{
+#if defined(LVN_PLATFORM_LINUX)
+    return (uint64_t) syscall(SYS_gettid);
+#else
+    return (uint64_t) (uintptr_t) pthread_self();
+#endif
+}
+
+void lvn_platformYieldThread(void)
+{
+    sched_yield();
+}
+
+bool lvn_platformSetThreadAffinity(uint32_t cpu)
+{
+#if defined(LVN_PLATFORM_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+#if defined(LVN_INCLUDE_IO_URING)
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+struct LvnIoRing
+{
+    int fd;
+
+    void* sqRing;
+    size_t sqRingSize;
+    uint32_t* sqHead;
+    uint32_t* sqTail;
+    uint32_t* sqMask;
+    uint32_t* sqArray;
+    uint32_t sqEntries;
+    uint32_t sqLocalTail;      // tail of pushed entries not yet published to the kernel
+    uint32_t sqUnsubmitted;    // entries published but not yet consumed by io_uring_enter
+
+    struct io_uring_sqe* sqes;
+    size_t sqesSize;
+
+    void* cqRing;
+    size_t cqRingSize;
+    uint32_t* cqHead;
+    uint32_t* cqTail;
+    uint32_t* cqMask;
+    struct io_uring_cqe* cqes;
+};
+
+LvnIoRing* lvn_platformIoRingCreate(uint32_t entries)
+{
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    int fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0)
+        return NULL; // kernel without io_uring or disabled via sysctl/seccomp
+
+    // the read opcode (5.6+) avoids keeping an iovec alive per request, check that it exists
+    size_t probeSize = sizeof(struct io_uring_probe) + IORING_OP_LAST * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*) lvn_calloc(probeSize);
+    int probeResult = (int) syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST);
+    bool readSupported = probeResult >= 0 && probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+    lvn_free(probe);
+
+    if (!readSupported)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    LvnIoRing* ring = (LvnIoRing*) lvn_calloc(sizeof(LvnIoRing));
+    ring->fd = fd;
+    ring->sqEntries = params.sq_entries;
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+    {
+        if (ring->cqRingSize > ring->sqRingSize)
+            ring->sqRingSize = ring->cqRingSize;
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED)
+        goto fail_cleanup;
+
+    ring->cqRing = singleMmap
+        ? ring->sqRing
+        : mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (ring->cqRing == MAP_FAILED)
+        goto fail_cleanup;
+
+    ring->sqes = (struct io_uring_sqe*) mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED)
+        goto fail_cleanup;
+
+    uint8_t* sq = (uint8_t*) ring->sqRing;
+    ring->sqHead = (uint32_t*) (sq + params.sq_off.head);
+    ring->sqTail = (uint32_t*) (sq + params.sq_off.tail);
+    ring->sqMask = (uint32_t*) (sq + params.sq_off.ring_mask);
+    ring->sqArray = (uint32_t*) (sq + params.sq_off.array);
+    ring->sqLocalTail = *ring->sqTail;
+
+    uint8_t* cq = (uint8_t*) ring->cqRing;
+    ring->cqHead = (uint32_t*) (cq + params.cq_off.head);
+    ring->cqTail = (uint32_t*) (cq + params.cq_off.tail);
+    ring->cqMask = (uint32_t*) (cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+
+    return ring;
+
+fail_cleanup:
+    if (ring->sqes && ring->sqes != MAP_FAILED)
+        munmap(ring->sqes, ring->sqesSize);
+    if (ring->cqRing && ring->cqRing != MAP_FAILED && ring->cqRing != ring->sqRing)
+        munmap(ring->cqRing, ring->cqRingSize);
+    if (ring->sqRing && ring->sqRing != MAP_FAILED)
+        munmap(ring->sqRing, ring->sqRingSize);
+    close(fd);
+    lvn_free(ring);
+    return NULL;
+}
+
+void lvn_platformIoRingDestroy(LvnIoRing* ring)
+{
+    munmap(ring->sqes, ring->sqesSize);
+    if (ring->cqRing != ring->sqRing)
+        munmap(ring->cqRing, ring->cqRingSize);
+    munmap(ring->sqRing, ring->sqRingSize);
+    close(ring->fd);
+    lvn_free(ring);
+}
+
+bool lvn_platformIoRingPushRead(LvnIoRing* ring, intptr_t handle, void* dst, uint32_t size, uint64_t offset, uint64_t userData)
+{
+    uint32_t head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+    if (ring->sqLocalTail - head >= ring->sqEntries)
+        return false;
+
+    uint32_t index = ring->sqLocalTail & *ring->sqMask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = (int) handle;
+    sqe->addr = (uint64_t) (uintptr_t) dst;
+    sqe->len = size;
+    sqe->off = offset;
+    sqe->user_data = userData;
+
+    ring->sqArray[index] = index;
+    ring->sqLocalTail++;
+    return true;
+}
+
+bool lvn_platformIoRingSubmit(LvnIoRing* ring, uint32_t waitCount)
+{
+    uint32_t tail = *ring->sqTail;
+    ring->sqUnsubmitted += ring->sqLocalTail - tail;
+    __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+
+    if (!ring->sqUnsubmitted && !waitCount)
+        return true;
+
+    unsigned int flags = waitCount ? IORING_ENTER_GETEVENTS : 0;
+    int result;
+    do
+    {
+        result = (int) syscall(__NR_io_uring_enter, ring->fd, ring->sqUnsubmitted, waitCount, flags, NULL, 0);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0)
+        return false;
+
+    ring->sqUnsubmitted -= (uint32_t) result;
+    return true;
+}
+
+bool lvn_platformIoRingPopCompletion(LvnIoRing* ring, uint64_t* userData, int32_t* result)
+{
+    uint32_t head = *ring->cqHead;
+    uint32_t tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+        return false;
+
+    struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cqMask];
+    *userData = cqe->user_data;
+    *result = cqe->res;
+
+    __atomic_store_n(ring->cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+#else
+
+LvnIoRing* lvn_platformIoRingCreate(uint32_t entries) { (void)entries; return NULL; }
+void       lvn_platformIoRingDestroy(LvnIoRing* ring) { (void)ring; }
+bool       lvn_platformIoRingPushRead(LvnIoRing* ring, intptr_t handle, void* dst, uint32_t size, uint64_t offset, uint64_t userData) { return false; }
+bool       lvn_platformIoRingSubmit(LvnIoRing* ring, uint32_t waitCount) { return false; }
+bool       lvn_platformIoRingPopCompletion(LvnIoRing* ring, uint64_t* userData, int32_t* result) { return false; }
+
+#endif
+
+uint64_t lvn_platformGetFileModifiedTime(const char* filepath)
+{
+    struct stat st;
+    if (stat(filepath, &st) != 0)
+        return 0;
+
+#if defined(LVN_PLATFORM_MACOS)
+    return (uint64_t) st.st_mtimespec.tv_sec * 1000000000ull + (uint64_t) st.st_mtimespec.tv_nsec;
+#else
+    return (uint64_t) st.st_mtim.tv_sec * 1000000000ull + (uint64_t) st.st_mtim.tv_nsec;
+#endif
+}
+
+#if defined(LVN_PLATFORM_LINUX)
+
+#include <sys/inotify.h>
+
+struct LvnDirWatcher
+{
+    int fd;
+    size_t bufferSize;
+    size_t bufferOffset;
+    union
+    {
+        uint64_t align;                                // keeps the buffer aligned for the event structs
+        char bytes[4096];
+    } buffer;
+};
+
+LvnDirWatcher* lvn_platformDirWatcherCreate(void)
+{
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        return NULL;
+
+    LvnDirWatcher* watcher = (LvnDirWatcher*) lvn_calloc(sizeof(LvnDirWatcher));
+    watcher->fd = fd;
+    return watcher;
+}
+
+void lvn_platformDirWatcherDestroy(LvnDirWatcher* watcher)
+{
+    close(watcher->fd);
+    lvn_free(watcher);
+}
+
+int32_t lvn_platformDirWatcherAdd(LvnDirWatcher* watcher, const char* dirpath)
+{
+    // editors often save by writing a temp file and renaming it over the original, so watch the
+    // directory for renames as well as in place writes instead of watching the file inode itself
+    return inotify_add_watch(watcher->fd, dirpath, IN_CLOSE_WRITE | IN_MOVED_TO);
+}
+
+void lvn_platformDirWatcherRemove(LvnDirWatcher* watcher, int32_t watchId)
+{
+    inotify_rm_watch(watcher->fd, watchId);
+}
+
+bool lvn_platformDirWatcherRead(LvnDirWatcher* watcher, int32_t* watchId, const char** filename)
+{
+    for (;;)
+    {
+        if (watcher->bufferOffset >= watcher->bufferSize)
+        {
+            ssize_t size = read(watcher->fd, watcher->buffer.bytes, sizeof(watcher->buffer.bytes));
+            if (size <= 0)
+                return false;
+
+            watcher->bufferSize = (size_t) size;
+            watcher->bufferOffset = 0;
+        }
+
+        const struct inotify_event* event = (const struct inotify_event*) (watcher->buffer.bytes + watcher->bufferOffset);
+        watcher->bufferOffset += sizeof(struct inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+            *watchId = -1;
+            *filename = NULL;
+            return true;
+        }
+
+        if (!event->len)
+            continue;
+
+        *watchId = event->wd;
+        *filename = event->name;
+        return true;
+    }
+}
+
+#else
+
+LvnDirWatcher* lvn_platformDirWatcherCreate(void) { return NULL; }
+void           lvn_platformDirWatcherDestroy(LvnDirWatcher* watcher) { (void)watcher; }
+int32_t        lvn_platformDirWatcherAdd(LvnDirWatcher* watcher, const char* dirpath) { return -1; }
+void           lvn_platformDirWatcherRemove(LvnDirWatcher* watcher, int32_t watchId) { }
+bool           lvn_platformDirWatcherRead(LvnDirWatcher* watcher, int32_t* watchId, const char** filename) { return false; }
+
+#endif
+
 #elif defined(LVN_PLATFORM_WINDOWS)
 
 #include <windows.h>
@@ -40,4 +586,265 @@ LvnProc lvn_platformGetModuleSymbol(void* handle, const char* name)
     return (LvnProc) GetProcAddress((HMODULE) handle, name);
 }
 
-#endif
\ No newline at end of file
+void* lvn_platformMapFile(const char* filepath, size_t* size)
+{
+    *size = 0;
+
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    LARGE_INTEGER filesize;
+    if (!GetFileSizeEx(file, &filesize) || filesize.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (!mapping)
+        return NULL;
+
+    // the view keeps the mapping alive after its handle is closed
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (!data)
+        return NULL;
+
+    *size = (size_t) filesize.QuadPart;
+    return data;
+}
+
+void lvn_platformUnmapFile(void* data, size_t size)
+{
+    (void)size;
+    UnmapViewOfFile(data);
+}
+
+bool lvn_platformFileOpen(const char* filepath, intptr_t* handle, size_t* size)
+{
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER filesize;
+    if (!GetFileSizeEx(file, &filesize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    *handle = (intptr_t) file;
+    *size = (size_t) filesize.QuadPart;
+    return true;
+}
+
+int64_t lvn_platformFileRead(intptr_t handle, void* dst, size_t size, uint64_t offset)
+{
+    OVERLAPPED overlapped = {0};
+    overlapped.Offset = (DWORD) (offset & 0xffffffff);
+    overlapped.OffsetHigh = (DWORD) (offset >> 32);
+
+    DWORD bytesRead = 0;
+    DWORD readSize = size > 0x7fffffff ? 0x7fffffff : (DWORD) size;
+    if (!ReadFile((HANDLE) handle, dst, readSize, &bytesRead, &overlapped) && GetLastError() != ERROR_HANDLE_EOF)
+        return -1;
+
+    return bytesRead;
+}
+
+void lvn_platformFileClose(intptr_t handle)
+{
+    CloseHandle((HANDLE) handle);
+}
+
+bool lvn_platformWriteFileAtomic(const char* filepath, const void* data, size_t size)
+{
+    // the thread id keeps temporary files of concurrent writers, including other processes, apart
+    size_t tempPathSize = strlen(filepath) + 32;
+    char* tempPath = (char*) lvn_malloc(tempPathSize);
+    if (!tempPath)
+        return false;
+
+    snprintf(tempPath, tempPathSize, "%s.%llu.tmp", filepath, (unsigned long long) lvn_platformGetThreadId());
+
+    HANDLE file = CreateFileA(tempPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        lvn_free(tempPath);
+        return false;
+    }
+
+    const uint8_t* bytes = (const uint8_t*) data;
+    size_t written = 0;
+    while (written < size)
+    {
+        DWORD chunkWritten = 0;
+        DWORD chunkSize = size - written > 0x7fffffff ? 0x7fffffff : (DWORD) (size - written);
+        if (!WriteFile(file, bytes + written, chunkSize, &chunkWritten, NULL) || !chunkWritten)
+            break;
+        written += chunkWritten;
+    }
+
+    bool success = written == size && FlushFileBuffers(file);
+    success = CloseHandle(file) && success;
+
+    // fails while another process has filepath mapped, the caller keeps the old file in that case
+    success = success && MoveFileExA(tempPath, filepath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+    if (!success)
+        DeleteFileA(tempPath);
+
+    lvn_free(tempPath);
+    return success;
+}
+
+typedef struct LvnPlatformThreadStart
+{
+    LvnThreadFn func;
+    void* arg;
+} LvnPlatformThreadStart;
+
+static DWORD WINAPI lvn_platformThreadEntry(LPVOID arg)
+{
+    LvnPlatformThreadStart start = *(LvnPlatformThreadStart*) arg;
+    lvn_free(arg);
+    start.func(start.arg);
+    return 0;
+}
+
+void* lvn_platformCreateThread(LvnThreadFn func, void* arg)
+{
+    LvnPlatformThreadStart* start = (LvnPlatformThreadStart*) lvn_calloc(sizeof(LvnPlatformThreadStart));
+    start->func = func;
+    start->arg = arg;
+
+    HANDLE thread = CreateThread(NULL, 0, lvn_platformThreadEntry, start, 0, NULL);
+    if (!thread)
+        lvn_free(start);
+
+    return thread;
+}
+
+void lvn_platformJoinThread(void* thread)
+{
+    WaitForSingleObject((HANDLE) thread, INFINITE);
+    CloseHandle((HANDLE) thread);
+}
+
+void* lvn_platformCreateMutex(void)
+{
+    SRWLOCK* mutex = (SRWLOCK*) lvn_calloc(sizeof(SRWLOCK));
+    InitializeSRWLock(mutex);
+    return mutex;
+}
+
+void lvn_platformDestroyMutex(void* mutex)
+{
+    lvn_free(mutex);
+}
+
+void lvn_platformLockMutex(void* mutex)
+{
+    AcquireSRWLockExclusive((SRWLOCK*) mutex);
+}
+
+void lvn_platformUnlockMutex(void* mutex)
+{
+    ReleaseSRWLockExclusive((SRWLOCK*) mutex);
+}
+
+void* lvn_platformCreateCondVar(void)
+{
+    CONDITION_VARIABLE* condVar = (CONDITION_VARIABLE*) lvn_calloc(sizeof(CONDITION_VARIABLE));
+    InitializeConditionVariable(condVar);
+    return condVar;
+}
+
+void lvn_platformDestroyCondVar(void* condVar)
+{
+    lvn_free(condVar);
+}
+
+void lvn_platformWaitCondVar(void* condVar, void* mutex)
+{
+    SleepConditionVariableSRW((CONDITION_VARIABLE*) condVar, (SRWLOCK*) mutex, INFINITE, 0);
+}
+
+void lvn_platformSignalCondVar(void* condVar)
+{
+    WakeConditionVariable((CONDITION_VARIABLE*) condVar);
+}
+
+void lvn_platformBroadcastCondVar(void* condVar)
+{
+    WakeAllConditionVariable((CONDITION_VARIABLE*) condVar);
+}
+
+uint32_t lvn_platformGetCpuCount(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (uint32_t) info.dwNumberOfProcessors : 1;
+}
+
+uint64_t lvn_platformGetMonotonicTimeNs(void)
+{
+    static LARGE_INTEGER s_Frequency;
+    if (!s_Frequency.QuadPart)
+        QueryPerformanceFrequency(&s_Frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    // split the conversion so counter * 1e9 cannot overflow
+    uint64_t frequency = (uint64_t) s_Frequency.QuadPart;
+    uint64_t ticks = (uint64_t) counter.QuadPart;
+    return (ticks / frequency) * 1000000000ull + (ticks % frequency) * 1000000000ull / frequency;
+}
+
+uint64_t lvn_platformGetThreadId(void)
+{
+    return (uint64_t) GetCurrentThreadId();
+}
+
+void lvn_platformYieldThread(void)
+{
+    SwitchToThread();
+}
+
+bool lvn_platformSetThreadAffinity(uint32_t cpu)
+{
+    if (cpu >= sizeof(DWORD_PTR) * 8)
+        return false;
+
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) 1 << cpu) != 0;
+}
+
+// no io_uring equivalent is used on windows, the file loader falls back to its thread pool
+LvnIoRing* lvn_platformIoRingCreate(uint32_t entries) { (void)entries; return NULL; }
+void       lvn_platformIoRingDestroy(LvnIoRing* ring) { (void)ring; }
+bool       lvn_platformIoRingPushRead(LvnIoRing* ring, intptr_t handle, void* dst, uint32_t size, uint64_t offset, uint64_t userData) { return false; }
+bool       lvn_platformIoRingSubmit(LvnIoRing* ring, uint32_t waitCount) { return false; }
+bool       lvn_platformIoRingPopCompletion(LvnIoRing* ring, uint64_t* userData, int32_t* result) { return false; }
+
+uint64_t lvn_platformGetFileModifiedTime(const char* filepath)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(filepath, GetFileExInfoStandard, &data))
+        return 0;
+
+    return ((uint64_t) data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+}
+
+// the file watcher falls back to polling modification times on windows
+LvnDirWatcher* lvn_platformDirWatcherCreate(void) { return NULL; }
+void           lvn_platformDirWatcherDestroy(LvnDirWatcher* watcher) { (void)watcher; }
+int32_t        lvn_platformDirWatcherAdd(LvnDirWatcher* watcher, const char* dirpath) { return -1; }
+void           lvn_platformDirWatcherRemove(LvnDirWatcher* watcher, int32_t watchId) { }
+bool           lvn_platformDirWatcherRead(LvnDirWatcher* watcher, int32_t* watchId, const char** filename) { return false; }
+
+#endif
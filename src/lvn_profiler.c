@@ -0,0 +1,344 @@
+#include "levikno_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// every thread records into its own list of fixed size chunks, only the owning thread writes to them.
+// an event becomes visible to lvnProfilerWriteTrace once the chunk count is published with a release store,
+// so recording never takes a lock and the trace can be written while other threads keep recording.
+// thread records are pushed onto a global lock-free list the first time a thread records an event and are
+// kept for the lifetime of the process, events of threads that already exited still show up in the trace.
+// each thread keeps at most LVN_PROFILER_MAX_CHUNK_COUNT chunks, once they are full the oldest chunk is reused so long
+// runs keep their latest events in bounded memory. reusing a chunk or clearing takes the thread's lock, which
+// lvnProfilerWriteTrace holds while it reads the thread; the recording thread only tries the lock and drops the
+// event if the trace writer has it, dropped and overwritten events are counted and reported in the trace.
+
+#define LVN_PROFILER_CHUNK_EVENT_COUNT  4096
+#define LVN_PROFILER_MAX_CHUNK_COUNT    64
+#define LVN_PROFILER_THREAD_NAME_SIZE   64
+
+typedef enum LvnProfileEventType
+{
+    Lvn_ProfileEventType_Begin,
+    Lvn_ProfileEventType_End,
+    Lvn_ProfileEventType_Instant,
+} LvnProfileEventType;
+
+typedef struct LvnProfileEvent
+{
+    const char* name;
+    uint64_t timeNs;
+    LvnProfileEventType type;
+} LvnProfileEvent;
+
+typedef struct LvnProfileChunk
+{
+    struct LvnProfileChunk* next;
+    uint32_t count;
+    LvnProfileEvent events[LVN_PROFILER_CHUNK_EVENT_COUNT];
+} LvnProfileChunk;
+
+typedef struct LvnProfileThread
+{
+    struct LvnProfileThread* next;
+    uint64_t threadId;
+    LvnProfileChunk* head;           // changed by the owning thread only while it holds the lock
+    LvnProfileChunk* tail;           // only accessed by the owning thread
+    uint32_t chunkCount;             // only accessed by the owning thread
+    uint32_t droppedCount;           // events overwritten or dropped since the last clear
+    int64_t clearTimeNs;             // the last lvnProfilerClear this thread has applied, only accessed by the owning thread
+    uint32_t lock;
+    char name[LVN_PROFILER_THREAD_NAME_SIZE];
+} LvnProfileThread;
+
+static LvnProfileThread* s_LvnProfilerThreads = NULL;
+static uint32_t s_LvnProfilerEnabled = 1;
+static int64_t s_LvnProfilerClearTimeNs = 0;     // events recorded before are left out of traces
+static LVN_THREAD_LOCAL LvnProfileThread* s_LvnProfilerThread = NULL;
+
+
+static LvnProfileThread* lvn_profilerGetThread(void)
+{
+    if (s_LvnProfilerThread)
+        return s_LvnProfilerThread;
+
+    LvnProfileThread* thread = (LvnProfileThread*) lvn_calloc(sizeof(LvnProfileThread));
+    LvnProfileChunk* chunk = (LvnProfileChunk*) lvn_calloc(sizeof(LvnProfileChunk));
+    if (!thread || !chunk)
+    {
+        lvn_free(thread);
+        lvn_free(chunk);
+        return NULL;
+    }
+
+    thread->threadId = lvn_platformGetThreadId();
+    thread->head = chunk;
+    thread->tail = chunk;
+    thread->chunkCount = 1;
+    thread->clearTimeNs = lvn_atomicLoad64(&s_LvnProfilerClearTimeNs);
+
+    LvnProfileThread* head;
+    do
+    {
+        head = (LvnProfileThread*) lvn_atomicLoadPtr((void* volatile*) &s_LvnProfilerThreads);
+        thread->next = head;
+    } while (!lvn_atomicCasPtr((void* volatile*) &s_LvnProfilerThreads, head, thread));
+
+    s_LvnProfilerThread = thread;
+    return thread;
+}
+
+// frees every chunk but the first and empties it, the caller is the owning thread and holds the lock
+static void lvn_profilerResetThread(LvnProfileThread* thread, int64_t clearTimeNs)
+{
+    LvnProfileChunk* chunk = thread->head->next;
+    while (chunk)
+    {
+        LvnProfileChunk* next = chunk->next;
+        lvn_free(chunk);
+        chunk = next;
+    }
+
+    thread->head->next = NULL;
+    thread->head->count = 0;
+    thread->tail = thread->head;
+    thread->chunkCount = 1;
+    thread->droppedCount = 0;
+    thread->clearTimeNs = clearTimeNs;
+}
+
+// moves the oldest chunk to the end of the list, the caller is the owning thread and holds the lock
+static LvnProfileChunk* lvn_profilerReuseChunk(LvnProfileThread* thread)
+{
+    LvnProfileChunk* chunk = thread->head;
+    thread->head = chunk->next;
+    lvn_atomicFetchAdd32(&thread->droppedCount, chunk->count);
+
+    chunk->next = NULL;
+    chunk->count = 0;
+    thread->tail->next = chunk;
+    thread->tail = chunk;
+    return chunk;
+}
+
+static void lvn_profilerRecord(const char* name, LvnProfileEventType type)
+{
+    if (!lvn_atomicLoad32(&s_LvnProfilerEnabled))
+        return;
+
+    LvnProfileThread* thread = lvn_profilerGetThread();
+    if (!thread)
+        return;
+
+    // a clear is applied by the owning thread, a trace being written delays it to the next event
+    int64_t clearTimeNs = lvn_atomicLoad64(&s_LvnProfilerClearTimeNs);
+    if (thread->clearTimeNs != clearTimeNs && lvn_atomicCas32(&thread->lock, 0, 1))
+    {
+        lvn_profilerResetThread(thread, clearTimeNs);
+        lvn_spinUnlock(&thread->lock);
+    }
+
+    LvnProfileChunk* chunk = thread->tail;
+    uint32_t count = chunk->count;
+
+    if (count == LVN_PROFILER_CHUNK_EVENT_COUNT)
+    {
+        if (thread->chunkCount < LVN_PROFILER_MAX_CHUNK_COUNT)
+        {
+            LvnProfileChunk* newChunk = (LvnProfileChunk*) lvn_calloc(sizeof(LvnProfileChunk));
+            if (!newChunk)
+            {
+                lvn_atomicFetchAdd32(&thread->droppedCount, 1);
+                return;
+            }
+
+            lvn_atomicStorePtr((void* volatile*) &chunk->next, newChunk);
+            thread->tail = newChunk;
+            thread->chunkCount++;
+            chunk = newChunk;
+        }
+        else if (lvn_atomicCas32(&thread->lock, 0, 1))
+        {
+            chunk = lvn_profilerReuseChunk(thread);
+            lvn_spinUnlock(&thread->lock);
+        }
+        else
+        {
+            lvn_atomicFetchAdd32(&thread->droppedCount, 1);
+            return;
+        }
+
+        count = 0;
+    }
+
+    LvnProfileEvent* event = &chunk->events[count];
+    event->name = name;
+    event->timeNs = lvnTimeNowNs();
+    event->type = type;
+
+    lvn_atomicStore32(&chunk->count, count + 1);
+}
+
+void lvnProfilerBegin(const char* name)
+{
+    lvn_profilerRecord(name, Lvn_ProfileEventType_Begin);
+}
+
+void lvnProfilerEnd(void)
+{
+    lvn_profilerRecord(NULL, Lvn_ProfileEventType_End);
+}
+
+void lvnProfilerInstant(const char* name)
+{
+    lvn_profilerRecord(name, Lvn_ProfileEventType_Instant);
+}
+
+void lvnProfilerSetThreadName(const char* name)
+{
+    LVN_ASSERT(name, "name cannot be null");
+
+    LvnProfileThread* thread = lvn_profilerGetThread();
+    if (!thread)
+        return;
+
+    snprintf(thread->name, LVN_PROFILER_THREAD_NAME_SIZE, "%s", name);
+}
+
+void lvnProfilerEnable(bool enable)
+{
+    lvn_atomicStore32(&s_LvnProfilerEnabled, enable ? 1 : 0);
+}
+
+void lvnProfilerClear(void)
+{
+    // threads free their chunks when they next record, until then their old events are skipped by the timestamp
+    int64_t nowNs = (int64_t) lvnTimeNowNs();
+    int64_t clearTimeNs = lvn_atomicLoad64(&s_LvnProfilerClearTimeNs);
+    lvn_atomicStore64(&s_LvnProfilerClearTimeNs, nowNs > clearTimeNs ? nowNs : clearTimeNs + 1);
+}
+
+static void lvn_profilerWriteString(FILE* file, const char* str)
+{
+    fputc('"', file);
+    for (const char* c = str; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            fprintf(file, "\\%c", *c);
+        else if ((unsigned char) *c < 0x20)
+            fprintf(file, "\\u%04x", (unsigned int) (unsigned char) *c);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+LvnResult lvnProfilerWriteTrace(const char* filepath)
+{
+    LVN_ASSERT(filepath, "filepath cannot be null");
+
+    FILE* file = fopen(filepath, "wb");
+    if (!file)
+        return Lvn_Result_Failure;
+
+    LvnProfileThread* threads = (LvnProfileThread*) lvn_atomicLoadPtr((void* volatile*) &s_LvnProfilerThreads);
+    uint64_t clearTimeNs = (uint64_t) lvn_atomicLoad64(&s_LvnProfilerClearTimeNs);
+
+    // timestamps are written relative to the earliest event kept so they stay readable, chunks are in time order
+    uint64_t startNs = UINT64_MAX;
+    for (LvnProfileThread* thread = threads; thread; thread = thread->next)
+    {
+        bool found = false;
+        lvn_spinLock(&thread->lock);
+        for (LvnProfileChunk* chunk = thread->head; chunk && !found; chunk = (LvnProfileChunk*) lvn_atomicLoadPtr((void* volatile*) &chunk->next))
+        {
+            uint32_t count = lvn_atomicLoad32(&chunk->count);
+            for (uint32_t i = 0; i < count && !found; i++)
+            {
+                found = chunk->events[i].timeNs >= clearTimeNs;
+                if (found && chunk->events[i].timeNs < startNs)
+                    startNs = chunk->events[i].timeNs;
+            }
+        }
+        lvn_spinUnlock(&thread->lock);
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    bool first = true;
+    for (LvnProfileThread* thread = threads; thread; thread = thread->next)
+    {
+        if (thread->name[0])
+        {
+            fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,\"args\":{\"name\":",
+                    first ? "" : ",", (unsigned long long) thread->threadId);
+            lvn_profilerWriteString(file, thread->name);
+            fprintf(file, "}}");
+            first = false;
+        }
+
+        // the owning thread cannot reuse or free chunks meanwhile, it drops events instead
+        lvn_spinLock(&thread->lock);
+
+        bool reportDropped = thread->clearTimeNs == (int64_t) clearTimeNs;
+        for (LvnProfileChunk* chunk = thread->head; chunk; chunk = (LvnProfileChunk*) lvn_atomicLoadPtr((void* volatile*) &chunk->next))
+        {
+            uint32_t count = lvn_atomicLoad32(&chunk->count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const LvnProfileEvent* event = &chunk->events[i];
+                if (event->timeNs < clearTimeNs)
+                    continue;
+
+                uint64_t timeNs = event->timeNs - startNs;
+
+                // scopes begun before the oldest kept event end without a begin, the marker shows where the kept events start
+                uint32_t droppedCount = reportDropped ? lvn_atomicLoad32(&thread->droppedCount) : 0;
+                if (droppedCount)
+                {
+                    fprintf(file, "%s\n{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%u events dropped\",\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%llu}",
+                            first ? "" : ",", droppedCount, (unsigned long long) (timeNs / 1000), (unsigned long long) (timeNs % 1000), (unsigned long long) thread->threadId);
+                    first = false;
+                }
+                reportDropped = false;
+
+                fprintf(file, "%s\n{", first ? "" : ",");
+                first = false;
+
+                switch (event->type)
+                {
+                    case Lvn_ProfileEventType_Begin:
+                    {
+                        fprintf(file, "\"ph\":\"B\",\"name\":");
+                        lvn_profilerWriteString(file, event->name ? event->name : "");
+                        break;
+                    }
+                    case Lvn_ProfileEventType_End:
+                    {
+                        fprintf(file, "\"ph\":\"E\"");
+                        break;
+                    }
+                    case Lvn_ProfileEventType_Instant:
+                    {
+                        fprintf(file, "\"ph\":\"i\",\"s\":\"t\",\"name\":");
+                        lvn_profilerWriteString(file, event->name ? event->name : "");
+                        break;
+                    }
+                }
+
+                fprintf(file, ",\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%llu}",
+                        (unsigned long long) (timeNs / 1000), (unsigned long long) (timeNs % 1000), (unsigned long long) thread->threadId);
+            }
+        }
+
+        lvn_spinUnlock(&thread->lock);
+    }
+
+    fprintf(file, "\n]}\n");
+
+    bool failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed)
+        return Lvn_Result_Failure;
+
+    return Lvn_Result_Success;
+}
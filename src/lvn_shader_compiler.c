@@ -0,0 +1,393 @@
+#include "lvn_graphics_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef LVN_INCLUDE_GLSLANG
+    #include <glslang/Include/glslang_c_interface.h>
+    #include <glslang/Public/resource_limits_c.h>
+    #include <glslang/build_info.h>
+#endif
+
+#define LVN_SHADER_MAX_PATH 1024
+#define LVN_SHADER_CACHE_VERSION 1
+#define LVN_SPIRV_MAGIC 0x07230203
+
+#ifdef LVN_INCLUDE_GLSLANG
+
+// state shared by the include callbacks of one compile
+typedef struct LvnShaderIncludeContext
+{
+    const LvnGraphicsContext* graphicsctx;
+    const LvnShaderSourceCreateInfo* createInfo;
+    bool failed;
+} LvnShaderIncludeContext;
+
+// the include result handed to glslang, the resolved header name is stored after the struct
+typedef struct LvnShaderIncludeResult
+{
+    glsl_include_result_t result;
+    LvnFile file;
+} LvnShaderIncludeResult;
+
+// every input that changes the spir-v for the same preprocessed source
+typedef struct LvnShaderCacheKeyHeader
+{
+    uint32_t cacheVersion;
+    uint32_t compilerVersion[3];
+    uint32_t stage;
+    uint32_t client;
+    uint32_t clientVersion;
+    uint32_t targetLanguageVersion;
+} LvnShaderCacheKeyHeader;
+
+static size_t                   lvn_pathDirLength(const char* path);
+static bool                     lvn_pathJoin(char* dst, const char* dir, size_t dirLength, const char* subdir, size_t subdirLength, const char* name);
+static glsl_include_result_t*   lvn_includeResult(LvnShaderIncludeContext* includeCtx, const char* resolvedPath, LvnFile file);
+static glsl_include_result_t*   lvn_includeLocal(void* ctx, const char* headerName, const char* includerName, size_t includeDepth);
+static glsl_include_result_t*   lvn_includeSystem(void* ctx, const char* headerName, const char* includerName, size_t includeDepth);
+static glsl_include_result_t*   lvn_includeFind(LvnShaderIncludeContext* includeCtx, const char* headerName, const char* includerName, bool local);
+static int                      lvn_includeFree(void* ctx, glsl_include_result_t* result);
+static char*                    lvn_createShaderPreamble(const LvnShaderSourceCreateInfo* createInfo);
+static bool                     lvn_loadCachedSpirv(const char* cachePath, uint8_t** ppCode, size_t* pCodeSize);
+
+#endif
+
+
+LvnResult lvn_shaderCompilerInit(LvnGraphicsContext* graphicsctx, const LvnGraphicsContextCreateInfo* createInfo)
+{
+    if (createInfo->shaderCacheDirectory)
+    {
+        graphicsctx->shaderCacheDirectory = lvn_strdup(createInfo->shaderCacheDirectory);
+        if (!graphicsctx->shaderCacheDirectory)
+            return Lvn_Result_Failure;
+    }
+
+#ifdef LVN_INCLUDE_GLSLANG
+    // glslang keeps a process wide reference count, every context holds one
+    if (!glslang_initialize_process())
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to initialize glslang");
+        lvn_free(graphicsctx->shaderCacheDirectory);
+        graphicsctx->shaderCacheDirectory = NULL;
+        return Lvn_Result_Failure;
+    }
+#endif
+
+    return Lvn_Result_Success;
+}
+
+void lvn_shaderCompilerTerminate(LvnGraphicsContext* graphicsctx)
+{
+#ifdef LVN_INCLUDE_GLSLANG
+    glslang_finalize_process();
+#endif
+
+    lvn_free(graphicsctx->shaderCacheDirectory);
+    graphicsctx->shaderCacheDirectory = NULL;
+}
+
+#ifdef LVN_INCLUDE_GLSLANG
+
+static size_t lvn_pathDirLength(const char* path)
+{
+    if (!path)
+        return 0;
+
+    size_t length = 0;
+    for (size_t i = 0; path[i]; i++)
+    {
+        if (path[i] == '/' || path[i] == '\\')
+            length = i + 1;
+    }
+
+    return length;
+}
+
+static bool lvn_pathJoin(char* dst, const char* dir, size_t dirLength, const char* subdir, size_t subdirLength, const char* name)
+{
+    size_t nameLength = strlen(name);
+    bool separator = dirLength && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
+
+    if (dirLength + separator + subdirLength + nameLength + 1 > LVN_SHADER_MAX_PATH)
+        return false;
+
+    memcpy(dst, dir, dirLength);
+    dst += dirLength;
+    if (separator)
+        *dst++ = '/';
+    memcpy(dst, subdir, subdirLength);
+    dst += subdirLength;
+    memcpy(dst, name, nameLength + 1);
+    return true;
+}
+
+static glsl_include_result_t* lvn_includeResult(LvnShaderIncludeContext* includeCtx, const char* resolvedPath, LvnFile file)
+{
+    size_t nameSize = strlen(resolvedPath) + 1;
+    LvnShaderIncludeResult* includeResult = (LvnShaderIncludeResult*) lvn_calloc(sizeof(LvnShaderIncludeResult) + nameSize);
+    if (!includeResult)
+    {
+        includeCtx->failed = true;
+        lvnUnloadFile(&file);
+        return NULL;
+    }
+
+    char* name = (char*) (includeResult + 1);
+    memcpy(name, resolvedPath, nameSize);
+
+    // glslang reports a missing include when its header name is empty, failed lookups still hand back
+    // a valid empty result since older versions dereference it unconditionally
+    includeResult->file = file;
+    includeResult->result.header_name = file.data ? name : "";
+    includeResult->result.header_data = file.data ? (const char*) file.data : "";
+    includeResult->result.header_length = file.size;
+    return &includeResult->result;
+}
+
+static glsl_include_result_t* lvn_includeFind(LvnShaderIncludeContext* includeCtx, const char* headerName, const char* includerName, bool local)
+{
+    const LvnShaderSourceCreateInfo* createInfo = includeCtx->createInfo;
+    char path[LVN_SHADER_MAX_PATH];
+    LvnFile file = {0};
+
+    // depending on the glslang version a nested includer is named by its resolved path or by the name it
+    // was included as, so also try its directory relative to the source; the top level includer has no name
+    bool nested = includerName && includerName[0];
+    const char* includerDir = nested ? includerName : createInfo->sourcePath;
+    size_t includerDirLength = lvn_pathDirLength(includerDir);
+
+    if (local && lvn_pathJoin(path, includerDir, includerDirLength, "", 0, headerName))
+        file = lvnLoadFileBin(path);
+
+    if (local && nested && !file.data &&
+        lvn_pathJoin(path, createInfo->sourcePath, lvn_pathDirLength(createInfo->sourcePath), includerName, includerDirLength, headerName))
+        file = lvnLoadFileBin(path);
+
+    for (uint32_t i = 0; !file.data && i < createInfo->includeDirCount; i++)
+    {
+        const char* includeDir = createInfo->pIncludeDirs[i];
+        if (lvn_pathJoin(path, includeDir, strlen(includeDir), "", 0, headerName))
+            file = lvnLoadFileBin(path);
+    }
+
+    if (!file.data)
+    {
+        LVN_LOG_ERROR(includeCtx->graphicsctx->coreLogger, "failed to find shader include \"%s\" included from \"%s\"",
+                      headerName, includerDir ? includerDir : "<source>");
+        includeCtx->failed = true;
+        path[0] = '\0';
+    }
+
+    return lvn_includeResult(includeCtx, path, file);
+}
+
+static glsl_include_result_t* lvn_includeLocal(void* ctx, const char* headerName, const char* includerName, size_t includeDepth)
+{
+    return lvn_includeFind((LvnShaderIncludeContext*) ctx, headerName, includerName, true);
+}
+
+static glsl_include_result_t* lvn_includeSystem(void* ctx, const char* headerName, const char* includerName, size_t includeDepth)
+{
+    return lvn_includeFind((LvnShaderIncludeContext*) ctx, headerName, includerName, false);
+}
+
+static int lvn_includeFree(void* ctx, glsl_include_result_t* result)
+{
+    if (!result)
+        return 0;
+
+    LvnShaderIncludeResult* includeResult = (LvnShaderIncludeResult*) result;
+    lvnUnloadFile(&includeResult->file);
+    lvn_free(includeResult);
+    return 0;
+}
+
+// defines go into the preamble so they are part of the preprocessed source the cache key is made from
+static char* lvn_createShaderPreamble(const LvnShaderSourceCreateInfo* createInfo)
+{
+    static const char* s_IncludeExtension = "#extension GL_GOOGLE_include_directive : enable\n";
+
+    size_t size = strlen(s_IncludeExtension) + 1;
+    for (uint32_t i = 0; i < createInfo->defineCount; i++)
+    {
+        const LvnShaderDefine* define = &createInfo->pDefines[i];
+        size += strlen("#define  \n") + strlen(define->name) + (define->value ? strlen(define->value) : 0);
+    }
+
+    char* preamble = (char*) lvn_malloc(size);
+    if (!preamble)
+        return NULL;
+
+    char* dst = preamble;
+    dst += sprintf(dst, "%s", s_IncludeExtension);
+    for (uint32_t i = 0; i < createInfo->defineCount; i++)
+    {
+        const LvnShaderDefine* define = &createInfo->pDefines[i];
+        dst += sprintf(dst, "#define %s %s\n", define->name, define->value ? define->value : "");
+    }
+
+    return preamble;
+}
+
+static bool lvn_loadCachedSpirv(const char* cachePath, uint8_t** ppCode, size_t* pCodeSize)
+{
+    LvnFile file = lvnLoadFileBin(cachePath);
+    if (!file.data)
+        return false;
+
+    // entries are written atomically, anything malformed was not written by us
+    if (file.size % sizeof(uint32_t) != 0 || file.size < sizeof(uint32_t) || *(const uint32_t*) file.data != LVN_SPIRV_MAGIC)
+    {
+        lvnUnloadFile(&file);
+        return false;
+    }
+
+    *ppCode = file.data;
+    *pCodeSize = file.size;
+    return true;
+}
+
+#endif
+
+LvnResult lvn_compileShaderSource(const LvnGraphicsContext* graphicsctx, const LvnShaderSourceCreateInfo* createInfo, uint8_t** ppCode, size_t* pCodeSize)
+{
+    *ppCode = NULL;
+    *pCodeSize = 0;
+
+#ifdef LVN_INCLUDE_GLSLANG
+    const char* sourceName = createInfo->sourcePath ? createInfo->sourcePath : "<source>";
+    LvnResult result = Lvn_Result_Failure;
+    glslang_shader_t* shader = NULL;
+    glslang_program_t* program = NULL;
+
+    char* preamble = lvn_createShaderPreamble(createInfo);
+    if (!preamble)
+        return Lvn_Result_Failure;
+
+    LVN_PROFILE_BEGIN("lvn_compileShaderSource");
+
+    LvnShaderIncludeContext includeCtx = {0};
+    includeCtx.graphicsctx = graphicsctx;
+    includeCtx.createInfo = createInfo;
+
+    glslang_input_t input = {0};
+    input.language = GLSLANG_SOURCE_GLSL;
+    input.stage = createInfo->stage == Lvn_ShaderStage_Fragment ? GLSLANG_STAGE_FRAGMENT : GLSLANG_STAGE_VERTEX;
+    input.client = GLSLANG_CLIENT_VULKAN;
+    input.client_version = GLSLANG_TARGET_VULKAN_1_2;
+    input.target_language = GLSLANG_TARGET_SPV;
+    input.target_language_version = GLSLANG_TARGET_SPV_1_5;
+    input.code = createInfo->pSource;
+    input.default_version = 450;
+    input.default_profile = GLSLANG_NO_PROFILE;
+    input.messages = (glslang_messages_t) (GLSLANG_MSG_SPV_RULES_BIT | GLSLANG_MSG_VULKAN_RULES_BIT);
+    input.resource = glslang_default_resource();
+    input.callbacks.include_local = lvn_includeLocal;
+    input.callbacks.include_system = lvn_includeSystem;
+    input.callbacks.free_include_result = lvn_includeFree;
+    input.callbacks_ctx = &includeCtx;
+
+    shader = glslang_shader_create(&input);
+    if (!shader)
+        goto fail_cleanup;
+
+    glslang_shader_set_preamble(shader, preamble);
+
+    if (!glslang_shader_preprocess(shader, &input) || includeCtx.failed)
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to preprocess shader \"%s\":\n%s", sourceName, glslang_shader_get_info_log(shader));
+        goto fail_cleanup;
+    }
+
+    // the preprocessed source already has includes and defines expanded, so it is the content key
+    // together with everything else that changes the generated code
+    char cachePath[LVN_SHADER_MAX_PATH];
+    bool useCache = false;
+
+    if (graphicsctx->shaderCacheDirectory)
+    {
+        LvnShaderCacheKeyHeader keyHeader = {0};
+        keyHeader.cacheVersion = LVN_SHADER_CACHE_VERSION;
+        keyHeader.compilerVersion[0] = GLSLANG_VERSION_MAJOR;
+        keyHeader.compilerVersion[1] = GLSLANG_VERSION_MINOR;
+        keyHeader.compilerVersion[2] = GLSLANG_VERSION_PATCH;
+        keyHeader.stage = (uint32_t) input.stage;
+        keyHeader.client = (uint32_t) input.client;
+        keyHeader.clientVersion = (uint32_t) input.client_version;
+        keyHeader.targetLanguageVersion = (uint32_t) input.target_language_version;
+
+        const char* preprocessed = glslang_shader_get_preprocessed_code(shader);
+
+        LvnHashState hashState;
+        lvnHashStateInit(&hashState, 0);
+        lvnHashStateUpdate(&hashState, &keyHeader, sizeof(keyHeader));
+        lvnHashStateUpdate(&hashState, preprocessed, strlen(preprocessed));
+        LvnHash128 key = lvnHashStateDigest128(&hashState);
+
+        int written = snprintf(cachePath, sizeof(cachePath), "%s/%016llx%016llx.spv", graphicsctx->shaderCacheDirectory,
+                               (unsigned long long) key.high, (unsigned long long) key.low);
+        useCache = written > 0 && (size_t) written < sizeof(cachePath);
+
+        if (useCache && lvn_loadCachedSpirv(cachePath, ppCode, pCodeSize))
+        {
+            LVN_LOG_TRACE(graphicsctx->coreLogger, "shader \"%s\" loaded from cache \"%s\"", sourceName, cachePath);
+            result = Lvn_Result_Success;
+            goto fail_cleanup;
+        }
+    }
+
+    if (!glslang_shader_parse(shader, &input))
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to compile shader \"%s\":\n%s", sourceName, glslang_shader_get_info_log(shader));
+        goto fail_cleanup;
+    }
+
+    program = glslang_program_create();
+    if (!program)
+        goto fail_cleanup;
+
+    glslang_program_add_shader(program, shader);
+
+    if (!glslang_program_link(program, input.messages))
+    {
+        LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to link shader \"%s\":\n%s", sourceName, glslang_program_get_info_log(program));
+        goto fail_cleanup;
+    }
+
+    glslang_program_SPIRV_generate(program, input.stage);
+
+    const char* spirvMessages = glslang_program_SPIRV_get_messages(program);
+    if (spirvMessages && spirvMessages[0])
+        LVN_LOG_WARN(graphicsctx->coreLogger, "spir-v generation for shader \"%s\":\n%s", sourceName, spirvMessages);
+
+    size_t codeSize = glslang_program_SPIRV_get_size(program) * sizeof(uint32_t);
+    uint8_t* code = (uint8_t*) lvn_malloc(codeSize);
+    if (!code)
+        goto fail_cleanup;
+
+    glslang_program_SPIRV_get(program, (unsigned int*) code);
+
+    // a failed write only costs a recompile on the next run
+    if (useCache && !lvn_platformWriteFileAtomic(cachePath, code, codeSize))
+        LVN_LOG_WARN(graphicsctx->coreLogger, "failed to write shader cache \"%s\"", cachePath);
+
+    *ppCode = code;
+    *pCodeSize = codeSize;
+    result = Lvn_Result_Success;
+
+fail_cleanup:
+    if (program)
+        glslang_program_delete(program);
+    if (shader)
+        glslang_shader_delete(shader);
+    lvn_free(preamble);
+    LVN_PROFILE_END();
+    return result;
+
+#else
+    LVN_LOG_ERROR(graphicsctx->coreLogger, "failed to compile shader \"%s\", levikno was built without glslang support",
+                  createInfo->sourcePath ? createInfo->sourcePath : "<source>");
+    return Lvn_Result_Failure;
+#endif
+}
@@ -0,0 +1,150 @@
+// lvnframeloop - renders frames to a headless surface and checks every step of the frame loop
+//
+// usage: lvnframeloop [frames]
+//
+// every frame clears the surface image in a render pass and presents it, halfway through the surface is resized so the
+// swapchain goes out of date and is recreated, the new extent is checked once the next frame has begun.
+// exits with 0 on success, 1 on a failure, 2 on bad arguments and 77 if no vulkan device with headless surfaces is available.
+// runs on a software driver such as lavapipe, no window system is needed
+
+#include "levikno.h"
+#include "lvn_graphics.h"
+#include "lvn_graphics_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LVN_FRAMES_DEFAULT_COUNT     120
+#define LVN_FRAMES_EXIT_UNSUPPORTED  77
+
+#define LVN_FRAMES_WIDTH             64
+#define LVN_FRAMES_HEIGHT            64
+#define LVN_FRAMES_RESIZE_WIDTH      96
+#define LVN_FRAMES_RESIZE_HEIGHT     48
+
+
+static LvnResult lvn_framesRecord(LvnSurface* surface, LvnCommandBuffer** commandBuffer, uint32_t frame)
+{
+    const LvnGraphicsContext* graphicsctx = surface->graphicsctx;
+
+    *commandBuffer = lvnAllocateCommandBuffer(graphicsctx, Lvn_CommandBufferLevel_Primary);
+    if (!*commandBuffer || lvnBeginCommandBuffer(*commandBuffer, NULL) != Lvn_Result_Success)
+        return Lvn_Result_Failure;
+
+    // a different clear color every frame, so a stale image would show in a capture
+    LvnRenderPassBeginInfo beginInfo = {0};
+    beginInfo.surface = surface;
+    beginInfo.clearColor[0] = (float) (frame % 256) / 255.0f;
+    beginInfo.clearColor[3] = 1.0f;
+
+    lvnCmdBeginRenderPass(*commandBuffer, &beginInfo);
+    lvnCmdEndRenderPass(*commandBuffer);
+
+    return lvnEndCommandBuffer(*commandBuffer);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frameCount = LVN_FRAMES_DEFAULT_COUNT;
+    if (argc > 1)
+        frameCount = (uint32_t) strtoul(argv[1], NULL, 10);
+
+    if (argc > 2 || frameCount < 2)
+    {
+        fprintf(stderr, "usage: lvnframeloop [frames], at least 2 frames\n");
+        return 2;
+    }
+
+    LvnContextCreateInfo ctxCreateInfo = {0};
+    ctxCreateInfo.appName = "lvnframeloop";
+
+    LvnContext* ctx;
+    if (lvnCreateContext(&ctx, &ctxCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "failed to create context\n");
+        return 1;
+    }
+
+    // null handles select VK_EXT_headless_surface
+    LvnPlatformData platformData = {0};
+
+    LvnGraphicsContextCreateInfo graphicsCreateInfo = {0};
+    graphicsCreateInfo.graphicsapi = Lvn_GraphicsApi_Vulkan;
+    graphicsCreateInfo.presentationModeFlags = Lvn_PresentationModeFlag_Headless | Lvn_PresentationModeFlag_Surface;
+    graphicsCreateInfo.platformData = &platformData;
+
+    LvnGraphicsContext* graphicsctx;
+    LvnSurface* surface = NULL;
+    LvnSurfaceCreateInfo surfaceCreateInfo = {0};
+    surfaceCreateInfo.width = LVN_FRAMES_WIDTH;
+    surfaceCreateInfo.height = LVN_FRAMES_HEIGHT;
+
+    if (lvnCreateGraphicsContext(ctx, &graphicsctx, &graphicsCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "no vulkan device with headless surface support, skipping\n");
+        lvnDestroyContext(ctx);
+        return LVN_FRAMES_EXIT_UNSUPPORTED;
+    }
+
+    // the library may have been built without vulkan, the context is then created without a backend
+    if (!graphicsctx->implCreateSurface || lvnCreateSurface(graphicsctx, &surface, &surfaceCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "failed to create headless surface, skipping\n");
+        lvnDestroyGraphicsContext(graphicsctx);
+        lvnDestroyContext(ctx);
+        return LVN_FRAMES_EXIT_UNSUPPORTED;
+    }
+
+    int result = 0;
+    uint32_t resizeFrame = frameCount / 2;
+    uint32_t frame = 0;
+
+    for (; frame < frameCount; frame++)
+    {
+        if (lvnSurfaceBeginFrame(surface) != Lvn_Result_Success)
+        {
+            fprintf(stderr, "frame %u: lvnSurfaceBeginFrame failed\n", frame);
+            result = 1;
+            break;
+        }
+
+        // the swapchain was recreated by the begin above, headless surfaces take the requested size as is
+        uint32_t width, height;
+        lvnSurfaceGetExtent(surface, &width, &height);
+        uint32_t expectedWidth = frame > resizeFrame ? LVN_FRAMES_RESIZE_WIDTH : LVN_FRAMES_WIDTH;
+        uint32_t expectedHeight = frame > resizeFrame ? LVN_FRAMES_RESIZE_HEIGHT : LVN_FRAMES_HEIGHT;
+        if (width != expectedWidth || height != expectedHeight)
+        {
+            fprintf(stderr, "frame %u: surface extent is %ux%u, expected %ux%u\n", frame, width, height, expectedWidth, expectedHeight);
+            result = 1;
+        }
+
+        LvnCommandBuffer* commandBuffer = NULL;
+        if (lvn_framesRecord(surface, &commandBuffer, frame) != Lvn_Result_Success)
+        {
+            fprintf(stderr, "frame %u: failed to record the command buffer\n", frame);
+            result = 1;
+        }
+
+        // ending the frame is required even after a failed recording, it consumes the acquired image
+        if (lvnSurfaceEndFrame(surface, &commandBuffer, result ? 0 : 1) != Lvn_Result_Success)
+        {
+            fprintf(stderr, "frame %u: lvnSurfaceEndFrame failed\n", frame);
+            result = 1;
+        }
+
+        if (result)
+            break;
+
+        if (frame == resizeFrame)
+            lvnSurfaceResize(surface, LVN_FRAMES_RESIZE_WIDTH, LVN_FRAMES_RESIZE_HEIGHT);
+    }
+
+    printf("frames: %u of %u, swapchain recreated at frame %u, %s\n", frame, frameCount, resizeFrame + 1, result ? "FAILED" : "ok");
+
+    lvnDestroySurface(surface);
+    lvnDestroyGraphicsContext(graphicsctx);
+    lvnDestroyContext(ctx);
+
+    return result;
+}
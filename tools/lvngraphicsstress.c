@@ -0,0 +1,279 @@
+// lvngraphicsstress - creates and destroys shaders and pipelines from many threads at once and checks deduplication and reference counts
+//
+// usage: lvngraphicsstress <vertex spir-v> <fragment spir-v> [threads] [iterations]
+//
+// every thread creates the same shaders and pipeline in a loop, each call must return the objects the main thread holds.
+// the main thread queues shader reloads meanwhile so lvnGraphicsContextApplyReloads competes with the object calls.
+// exits with 0 on success, 1 on a mismatch, 2 on bad arguments and 77 if no vulkan device with headless surfaces is available.
+// runs on a software driver such as lavapipe, no window system is needed
+
+#include "levikno.h"
+#include "lvn_graphics.h"
+#include "lvn_graphics_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LVN_STRESS_DEFAULT_THREADS    8
+#define LVN_STRESS_DEFAULT_ITERATIONS 2000
+#define LVN_STRESS_EXIT_UNSUPPORTED   77
+
+
+typedef struct LvnStressState
+{
+    const LvnGraphicsContext* graphicsctx;
+    LvnShaderCreateInfo vertCreateInfo;
+    LvnShaderCreateInfo fragCreateInfo;
+    LvnRenderPass* renderPass;
+
+    // held by the main thread for the whole run, every create call must return these
+    LvnShader* vertShader;
+    LvnShader* fragShader;
+    LvnPipeline* pipeline;
+
+    uint32_t iterations;
+    uint32_t failures;
+} LvnStressState;
+
+
+static LvnResult lvn_stressCreatePipeline(const LvnStressState* state, LvnPipeline** pipeline, LvnShader* vertShader, LvnShader* fragShader)
+{
+    LvnPipelineShaderStageCreateInfo stages[] =
+    {
+        { Lvn_ShaderStage_Vertex, vertShader, "main" },
+        { Lvn_ShaderStage_Fragment, fragShader, "main" },
+    };
+
+    LvnPipelineFixedFunctions fixedFunctions = lvnConfigPipelineFixedFunctions();
+    fixedFunctions.viewport.width = 64;
+    fixedFunctions.viewport.height = 64;
+    fixedFunctions.scissor.extent.width = 64;
+    fixedFunctions.scissor.extent.height = 64;
+
+    LvnPipelineCreateInfo createInfo = {0};
+    createInfo.pipelineFixedFunctions = &fixedFunctions;
+    createInfo.pStages = stages;
+    createInfo.stageCount = LVN_ARRAY_LEN(stages);
+    createInfo.renderPass = state->renderPass;
+
+    return lvnCreatePipeline(state->graphicsctx, pipeline, &createInfo);
+}
+
+static void lvn_stressFail(LvnStressState* state, const char* message, uint32_t iteration)
+{
+    fprintf(stderr, "iteration %u: %s\n", iteration, message);
+    lvn_atomicFetchAdd32(&state->failures, 1);
+}
+
+static void lvn_stressJob(void* userData)
+{
+    LvnStressState* state = (LvnStressState*) userData;
+
+    for (uint32_t i = 0; i < state->iterations && !lvn_atomicLoad32(&state->failures); i++)
+    {
+        LvnShader* vertShader = NULL;
+        LvnShader* fragShader = NULL;
+        LvnPipeline* pipeline = NULL;
+
+        if (lvnCreateShader(state->graphicsctx, &vertShader, &state->vertCreateInfo) != Lvn_Result_Success ||
+            lvnCreateShader(state->graphicsctx, &fragShader, &state->fragCreateInfo) != Lvn_Result_Success)
+            lvn_stressFail(state, "failed to create shader", i);
+        else if (vertShader != state->vertShader || fragShader != state->fragShader)
+            lvn_stressFail(state, "identical code returned a different shader", i);
+        else if (lvn_stressCreatePipeline(state, &pipeline, vertShader, fragShader) != Lvn_Result_Success)
+            lvn_stressFail(state, "failed to create pipeline", i);
+        else if (pipeline != state->pipeline)
+            lvn_stressFail(state, "identical create info returned a different pipeline", i);
+
+        // pipelines keep their shaders alive, so either destruction order is valid
+        if (i & 1)
+        {
+            if (vertShader) lvnDestroyShader(vertShader);
+            if (fragShader) lvnDestroyShader(fragShader);
+            if (pipeline) lvnDestroyPipeline(pipeline);
+        }
+        else
+        {
+            if (pipeline) lvnDestroyPipeline(pipeline);
+            if (vertShader) lvnDestroyShader(vertShader);
+            if (fragShader) lvnDestroyShader(fragShader);
+        }
+    }
+}
+
+static int lvn_stressCheckCounts(const LvnStressState* state)
+{
+    const LvnGraphicsContext* graphicsctx = state->graphicsctx;
+    int result = 0;
+
+    // the main thread holds one reference on each object and the pipeline holds one on each shader
+    if (state->vertShader->refCount != 2 || state->fragShader->refCount != 2)
+    {
+        fprintf(stderr, "shader reference counts are %u and %u, expected 2\n", state->vertShader->refCount, state->fragShader->refCount);
+        result = 1;
+    }
+    if (state->pipeline->refCount != 1)
+    {
+        fprintf(stderr, "pipeline reference count is %u, expected 1\n", state->pipeline->refCount);
+        result = 1;
+    }
+    if (graphicsctx->shaderTable.count != 2 || graphicsctx->pipelineTable.count != 1)
+    {
+        fprintf(stderr, "tables hold %u shaders and %u pipelines, expected 2 and 1\n", graphicsctx->shaderTable.count, graphicsctx->pipelineTable.count);
+        result = 1;
+    }
+    if (graphicsctx->pPipelines != state->pipeline || state->pipeline->pNextPipeline)
+    {
+        fprintf(stderr, "the context pipeline list does not hold exactly the reference pipeline\n");
+        result = 1;
+    }
+    if (graphicsctx->pPendingShaderReloads)
+    {
+        fprintf(stderr, "shader reloads are still pending after lvnGraphicsContextApplyReloads\n");
+        result = 1;
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t threadCount = LVN_STRESS_DEFAULT_THREADS;
+    uint32_t iterations = LVN_STRESS_DEFAULT_ITERATIONS;
+    if (argc > 3)
+        threadCount = (uint32_t) strtoul(argv[3], NULL, 10);
+    if (argc > 4)
+        iterations = (uint32_t) strtoul(argv[4], NULL, 10);
+
+    if (argc < 3 || argc > 5 || threadCount == 0 || iterations == 0)
+    {
+        fprintf(stderr, "usage: lvngraphicsstress <vertex spir-v> <fragment spir-v> [threads] [iterations]\n");
+        return 2;
+    }
+
+    LvnFile vertFile = lvnLoadFileBin(argv[1]);
+    LvnFile fragFile = lvnLoadFileBin(argv[2]);
+    if (!vertFile.data || !fragFile.data)
+    {
+        fprintf(stderr, "failed to load %s or %s\n", argv[1], argv[2]);
+        lvnUnloadFile(&vertFile);
+        lvnUnloadFile(&fragFile);
+        return 2;
+    }
+
+    LvnContextCreateInfo ctxCreateInfo = {0};
+    ctxCreateInfo.appName = "lvngraphicsstress";
+    ctxCreateInfo.jobs.workerThreadCount = threadCount;
+
+    LvnContext* ctx;
+    if (lvnCreateContext(&ctx, &ctxCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "failed to create context\n");
+        lvnUnloadFile(&vertFile);
+        lvnUnloadFile(&fragFile);
+        return 1;
+    }
+
+    // null handles select VK_EXT_headless_surface
+    LvnPlatformData platformData = {0};
+
+    LvnGraphicsContextCreateInfo graphicsCreateInfo = {0};
+    graphicsCreateInfo.graphicsapi = Lvn_GraphicsApi_Vulkan;
+    graphicsCreateInfo.presentationModeFlags = Lvn_PresentationModeFlag_Headless | Lvn_PresentationModeFlag_Surface;
+    graphicsCreateInfo.platformData = &platformData;
+
+    LvnGraphicsContext* graphicsctx;
+    LvnSurface* surface = NULL;
+    LvnSurfaceCreateInfo surfaceCreateInfo = {0};
+    surfaceCreateInfo.width = 64;
+    surfaceCreateInfo.height = 64;
+
+    if (lvnCreateGraphicsContext(ctx, &graphicsctx, &graphicsCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "no vulkan device with headless surface support, skipping\n");
+        lvnDestroyContext(ctx);
+        lvnUnloadFile(&vertFile);
+        lvnUnloadFile(&fragFile);
+        return LVN_STRESS_EXIT_UNSUPPORTED;
+    }
+
+    // the library may have been built without vulkan, the context is then created without a backend
+    if (!graphicsctx->implCreateSurface || lvnCreateSurface(graphicsctx, &surface, &surfaceCreateInfo) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "failed to create headless surface, skipping\n");
+        lvnDestroyGraphicsContext(graphicsctx);
+        lvnDestroyContext(ctx);
+        lvnUnloadFile(&vertFile);
+        lvnUnloadFile(&fragFile);
+        return LVN_STRESS_EXIT_UNSUPPORTED;
+    }
+
+    LvnStressState state = {0};
+    state.graphicsctx = graphicsctx;
+    state.vertCreateInfo.pCode = (const uint8_t*) vertFile.data;
+    state.vertCreateInfo.codeSize = vertFile.size;
+    state.fragCreateInfo.pCode = (const uint8_t*) fragFile.data;
+    state.fragCreateInfo.codeSize = fragFile.size;
+    state.renderPass = lvnSurfaceGetRenderPass(surface);
+    state.iterations = iterations;
+
+    int result = 0;
+    if (lvnCreateShader(graphicsctx, &state.vertShader, &state.vertCreateInfo) != Lvn_Result_Success ||
+        lvnCreateShader(graphicsctx, &state.fragShader, &state.fragCreateInfo) != Lvn_Result_Success ||
+        lvn_stressCreatePipeline(&state, &state.pipeline, state.vertShader, state.fragShader) != Lvn_Result_Success)
+    {
+        fprintf(stderr, "failed to create the reference shaders and pipeline\n");
+        result = 1;
+        goto cleanup;
+    }
+
+    LvnJobDesc* pJobs = (LvnJobDesc*) malloc(threadCount * sizeof(LvnJobDesc));
+    if (!pJobs)
+    {
+        fprintf(stderr, "failed to allocate %u jobs\n", threadCount);
+        result = 1;
+        goto cleanup;
+    }
+
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        pJobs[i].func = lvn_stressJob;
+        pJobs[i].userData = &state;
+    }
+
+    LvnJobCounter counter = {0};
+    lvnJobSubmit(ctx, pJobs, threadCount, &counter);
+
+    // reloading with the same code rebuilds the pipeline without changing any key, so lookups keep matching
+    uint32_t reloadCount = 0;
+    while (!lvnJobCounterIsDone(&counter))
+    {
+        lvnShaderQueueReload(state.vertShader, &state.vertCreateInfo);
+        if (lvnGraphicsContextApplyReloads(graphicsctx) != Lvn_Result_Success)
+            lvn_stressFail(&state, "failed to apply shader reload", reloadCount);
+        reloadCount++;
+    }
+
+    lvnJobWait(ctx, &counter);
+    free(pJobs);
+
+    result = state.failures ? 1 : lvn_stressCheckCounts(&state);
+    printf("threads: %u, iterations: %u, reloads: %u, failures: %u, %s\n",
+           threadCount, iterations, reloadCount, state.failures, result ? "FAILED" : "ok");
+
+cleanup:
+    if (state.pipeline)
+        lvnDestroyPipeline(state.pipeline);
+    if (state.vertShader)
+        lvnDestroyShader(state.vertShader);
+    if (state.fragShader)
+        lvnDestroyShader(state.fragShader);
+
+    lvnDestroySurface(surface);
+    lvnDestroyGraphicsContext(graphicsctx);
+    lvnDestroyContext(ctx);
+    lvnUnloadFile(&vertFile);
+    lvnUnloadFile(&fragFile);
+
+    return result;
+}
@@ -0,0 +1,163 @@
+// lvnhashbench - measures the throughput of every lvnHash64 implementation supported by the cpu
+//
+// usage: lvnhashbench [size in bytes]
+//
+// throughput is reported in bytes per cycle on x86 (time stamp counter) and in GB/s everywhere.
+// every implementation is also checked against the scalar implementation, including the streaming api.
+
+#include "levikno.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LVN_PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LVN_BENCH_HAS_TSC
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+#define LVN_BENCH_DEFAULT_SIZE (1024 * 1024)
+#define LVN_BENCH_MIN_TIME_NS  200000000ull
+
+
+static uint64_t lvn_benchNowNs(void)
+{
+#ifdef LVN_PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t) ((double) counter.QuadPart * 1e9 / (double) frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+static uint64_t lvn_benchCycles(void)
+{
+#ifdef LVN_BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// checks one-shot and streaming results of the current implementation against the scalar reference
+static bool lvn_benchVerify(const uint8_t* data, size_t size, LvnHashImpl impl)
+{
+    static const size_t splits[] = { 1, 3, 16, 63, 64, 65, 127, 1000 };
+
+    for (size_t length = 0; length <= size && length <= 4096; length += (length < 300 ? 1 : 61))
+    {
+        lvnHashSetImpl(Lvn_HashImpl_Scalar);
+        LvnHash128 expected = lvnHash128(data, length, length);
+
+        lvnHashSetImpl(impl);
+        LvnHash128 hash = lvnHash128(data, length, length);
+        if (hash.low != expected.low || hash.high != expected.high || lvnHash64(data, length, length) != expected.low)
+            return false;
+
+        for (size_t i = 0; i < sizeof(splits) / sizeof(splits[0]); i++)
+        {
+            LvnHashState state;
+            lvnHashStateInit(&state, length);
+            for (size_t offset = 0; offset < length; offset += splits[i])
+            {
+                size_t chunk = length - offset < splits[i] ? length - offset : splits[i];
+                lvnHashStateUpdate(&state, data + offset, chunk);
+            }
+
+            LvnHash128 streamed = lvnHashStateDigest128(&state);
+            if (streamed.low != expected.low || streamed.high != expected.high)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    size_t size = LVN_BENCH_DEFAULT_SIZE;
+    if (argc > 1)
+        size = (size_t) strtoull(argv[1], NULL, 10);
+
+    if (argc > 2 || size == 0)
+    {
+        fprintf(stderr, "usage: lvnhashbench [size in bytes]\n");
+        return 1;
+    }
+
+    uint8_t* data = (uint8_t*) malloc(size);
+    if (!data)
+    {
+        fprintf(stderr, "failed to allocate %zu bytes\n", size);
+        return 1;
+    }
+
+    uint64_t x = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        data[i] = (uint8_t) x;
+    }
+
+    static const LvnHashImpl impls[] = { Lvn_HashImpl_Scalar, Lvn_HashImpl_Sse2, Lvn_HashImpl_Avx2, Lvn_HashImpl_Neon };
+    int result = 0;
+
+    printf("input size: %zu bytes\n", size);
+    printf("%-8s %12s %12s %8s\n", "impl", "bytes/cycle", "GB/s", "verify");
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++)
+    {
+        if (lvnHashSetImpl(impls[i]) != Lvn_Result_Success)
+        {
+            printf("%-8s %12s\n", lvnHashGetImplName(impls[i]), "unsupported");
+            continue;
+        }
+
+        // warm up caches and branch predictors before timing
+        uint64_t sink = lvnHash64(data, size, 0);
+
+        uint64_t iterations = 0;
+        uint64_t startNs = lvn_benchNowNs();
+        uint64_t startCycles = lvn_benchCycles();
+        uint64_t elapsedNs;
+        do
+        {
+            sink ^= lvnHash64(data, size, iterations);
+            iterations++;
+            elapsedNs = lvn_benchNowNs() - startNs;
+        } while (elapsedNs < LVN_BENCH_MIN_TIME_NS);
+        uint64_t elapsedCycles = lvn_benchCycles() - startCycles;
+
+        double bytes = (double) size * (double) iterations;
+        bool verified = lvn_benchVerify(data, size, impls[i]);
+        if (!verified)
+            result = 1;
+
+        char bytesPerCycle[32] = "n/a";
+        if (elapsedCycles)
+            snprintf(bytesPerCycle, sizeof(bytesPerCycle), "%.2f", bytes / (double) elapsedCycles);
+
+        printf("%-8s %12s %12.2f %8s   (%016llx)\n", lvnHashGetImplName(impls[i]), bytesPerCycle,
+               bytes / (double) elapsedNs, verified ? "ok" : "FAILED", (unsigned long long) sink);
+    }
+
+    lvnHashSetImpl(Lvn_HashImpl_Auto);
+    printf("auto selects: %s\n", lvnHashGetImplName(lvnHashGetImpl()));
+
+    free(data);
+    return result;
+}
@@ -0,0 +1,460 @@
+// lvnpack - builds a levikno pack file from a directory
+//
+// usage: lvnpack [-z] <input directory> <output pack>
+//   -z    compress entries with lz4 when it makes them smaller
+//
+// entries are keyed by their path relative to the input directory with forward slashes,
+// eg. "shaders/vert.spv" is loaded at runtime with lvnPackLoadFile(pack, lvnPackHashPath("shaders/vert.spv"))
+
+#include "levikno_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LVN_PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+#define LVN_PACK_LZ4_HASH_BITS     16
+#define LVN_PACK_LZ4_MIN_MATCH     4
+#define LVN_PACK_LZ4_LAST_LITERALS 5        // the last 5 bytes of a block are always literals
+#define LVN_PACK_LZ4_MFLIMIT       12       // a match cannot start in the last 12 bytes of a block
+#define LVN_PACK_LZ4_MAX_OFFSET    65535
+
+
+typedef struct LvnPackToolFile
+{
+    char* path;              // path relative to the input directory
+    char* fullpath;
+    uint64_t pathHash;
+    LvnFile data;
+    uint8_t* compressed;     // lz4 block, null if the entry is stored uncompressed
+    const uint8_t* blob;
+    size_t blobSize;
+    size_t uncompressedSize;
+    uint32_t flags;
+    uint64_t offset;
+} LvnPackToolFile;
+
+typedef struct LvnPackToolFileList
+{
+    LvnPackToolFile* pFiles;
+    uint32_t count;
+    uint32_t capacity;
+} LvnPackToolFileList;
+
+
+static char* lvn_packToolJoinPath(const char* a, const char* b)
+{
+    size_t lenA = strlen(a), lenB = strlen(b);
+    char* path = (char*) malloc(lenA + lenB + 2);
+    memcpy(path, a, lenA);
+    path[lenA] = '/';
+    memcpy(path + lenA + 1, b, lenB + 1);
+    return path;
+}
+
+static void lvn_packToolAddFile(LvnPackToolFileList* list, const char* path, const char* fullpath)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : 64;
+        list->pFiles = (LvnPackToolFile*) realloc(list->pFiles, list->capacity * sizeof(LvnPackToolFile));
+    }
+
+    LvnPackToolFile* file = &list->pFiles[list->count++];
+    memset(file, 0, sizeof(LvnPackToolFile));
+    file->path = strdup(path);
+    file->fullpath = strdup(fullpath);
+
+    for (char* c = file->path; *c; c++)
+        if (*c == '\\') *c = '/';
+}
+
+#ifdef LVN_PLATFORM_WINDOWS
+static bool lvn_packToolCollectFiles(LvnPackToolFileList* list, const char* dir, const char* relative)
+{
+    char* pattern = lvn_packToolJoinPath(dir, "*");
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA(pattern, &findData);
+    free(pattern);
+
+    if (find == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+        const char* name = findData.cFileName;
+        if (!strcmp(name, ".") || !strcmp(name, ".."))
+            continue;
+
+        char* fullpath = lvn_packToolJoinPath(dir, name);
+        char* path = relative[0] ? lvn_packToolJoinPath(relative, name) : strdup(name);
+
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            lvn_packToolCollectFiles(list, fullpath, path);
+        else
+            lvn_packToolAddFile(list, path, fullpath);
+
+        free(path);
+        free(fullpath);
+    } while (FindNextFileA(find, &findData));
+
+    FindClose(find);
+    return true;
+}
+#else
+static bool lvn_packToolCollectFiles(LvnPackToolFileList* list, const char* dir, const char* relative)
+{
+    DIR* d = opendir(dir);
+    if (!d)
+        return false;
+
+    struct dirent* ent;
+    while ((ent = readdir(d)))
+    {
+        const char* name = ent->d_name;
+        if (!strcmp(name, ".") || !strcmp(name, ".."))
+            continue;
+
+        char* fullpath = lvn_packToolJoinPath(dir, name);
+        char* path = relative[0] ? lvn_packToolJoinPath(relative, name) : strdup(name);
+
+        struct stat st;
+        if (stat(fullpath, &st) == 0)
+        {
+            if (S_ISDIR(st.st_mode))
+                lvn_packToolCollectFiles(list, fullpath, path);
+            else if (S_ISREG(st.st_mode))
+                lvn_packToolAddFile(list, path, fullpath);
+        }
+
+        free(path);
+        free(fullpath);
+    }
+
+    closedir(d);
+    return true;
+}
+#endif
+
+static int lvn_packToolCompareFiles(const void* a, const void* b)
+{
+    return strcmp(((const LvnPackToolFile*) a)->path, ((const LvnPackToolFile*) b)->path);
+}
+
+static uint32_t lvn_packToolRead32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(uint32_t));
+    return value;
+}
+
+static uint8_t* lvn_packToolWriteLength(uint8_t* op, size_t length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t) length;
+    return op;
+}
+
+static uint8_t* lvn_packToolWriteSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    uint8_t* token = op++;
+    *token = (uint8_t) ((literalLength >= 15 ? 15 : literalLength) << 4);
+    if (literalLength >= 15)
+        op = lvn_packToolWriteLength(op, literalLength - 15);
+
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    if (!matchLength)
+        return op;
+
+    *op++ = (uint8_t) (offset & 0xff);
+    *op++ = (uint8_t) (offset >> 8);
+
+    matchLength -= LVN_PACK_LZ4_MIN_MATCH;
+    *token |= (uint8_t) (matchLength >= 15 ? 15 : matchLength);
+    if (matchLength >= 15)
+        op = lvn_packToolWriteLength(op, matchLength - 15);
+
+    return op;
+}
+
+// greedy single pass lz4 block compressor, dst must hold lvn_packToolLz4Bound(srcSize) bytes
+static size_t lvn_packToolLz4Bound(size_t srcSize)
+{
+    return srcSize + srcSize / 255 + 16;
+}
+
+static size_t lvn_packToolLz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst)
+{
+    uint8_t* op = dst;
+    size_t anchor = 0;
+
+    if (srcSize > LVN_PACK_LZ4_MFLIMIT)
+    {
+        uint32_t* table = (uint32_t*) calloc((size_t) 1 << LVN_PACK_LZ4_HASH_BITS, sizeof(uint32_t));
+        size_t matchStartLimit = srcSize - LVN_PACK_LZ4_MFLIMIT;
+        size_t matchEndLimit = srcSize - LVN_PACK_LZ4_LAST_LITERALS;
+        size_t ip = 0;
+
+        while (ip < matchStartLimit)
+        {
+            uint32_t sequence = lvn_packToolRead32(src + ip);
+            uint32_t hash = (sequence * 2654435761u) >> (32 - LVN_PACK_LZ4_HASH_BITS);
+            size_t candidate = table[hash];
+            table[hash] = (uint32_t) (ip + 1); // zero means empty
+
+            if (!candidate || ip - (candidate - 1) > LVN_PACK_LZ4_MAX_OFFSET || lvn_packToolRead32(src + candidate - 1) != sequence)
+            {
+                ip++;
+                continue;
+            }
+
+            size_t match = candidate - 1;
+            size_t matchLength = LVN_PACK_LZ4_MIN_MATCH;
+            while (ip + matchLength < matchEndLimit && src[match + matchLength] == src[ip + matchLength])
+                matchLength++;
+
+            op = lvn_packToolWriteSequence(op, src + anchor, ip - anchor, ip - match, matchLength);
+            ip += matchLength;
+            anchor = ip;
+        }
+
+        free(table);
+    }
+
+    op = lvn_packToolWriteSequence(op, src + anchor, srcSize - anchor, 0, 0);
+    return (size_t) (op - dst);
+}
+
+static bool lvn_packToolLoadFile(LvnPackToolFile* file, bool compress)
+{
+    LvnFile data = lvnLoadFileBin(file->fullpath);
+
+    file->pathHash = lvnPackHashPath(file->path);
+    file->data = data;
+    file->uncompressedSize = data.size;
+    file->blob = data.data;
+    file->blobSize = data.size;
+
+    // lvnLoadFileBin also returns an empty file for empty files, only a missing file is an error
+    if (!data.data)
+    {
+        FILE* exists = fopen(file->fullpath, "rb");
+        if (exists) fclose(exists);
+        return exists != NULL;
+    }
+
+    if (!compress)
+        return true;
+
+    uint8_t* compressed = (uint8_t*) malloc(lvn_packToolLz4Bound(data.size));
+    size_t compressedSize = lvn_packToolLz4Compress(data.data, data.size, compressed);
+
+    // keep small wins uncompressed so the entry can still be viewed in place
+    if (compressedSize < data.size - data.size / 8)
+    {
+        file->compressed = compressed;
+        file->blob = compressed;
+        file->blobSize = compressedSize;
+        file->flags |= Lvn_PackEntryFlag_Lz4;
+    }
+    else
+    {
+        free(compressed);
+    }
+
+    return true;
+}
+
+static uint64_t lvn_packToolAlign(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool lvn_packToolWritePack(const LvnPackToolFileList* list, const char* outpath)
+{
+    uint32_t indexCapacity = 1;
+    while (indexCapacity < list->count * 2)
+        indexCapacity <<= 1;
+
+    LvnPackEntry* pEntries = (LvnPackEntry*) calloc(indexCapacity, sizeof(LvnPackEntry));
+
+    LvnPackHeader header = {0};
+    header.magic = LVN_PACK_MAGIC;
+    header.version = LVN_PACK_VERSION;
+    header.entryCount = list->count;
+    header.indexCapacity = indexCapacity;
+    header.indexOffset = sizeof(LvnPackHeader);
+
+    uint64_t offset = lvn_packToolAlign(header.indexOffset + indexCapacity * sizeof(LvnPackEntry), LVN_PACK_BLOB_ALIGNMENT);
+    for (uint32_t i = 0; i < list->count; i++)
+    {
+        LvnPackToolFile* file = &list->pFiles[i];
+        file->offset = offset;
+        offset = lvn_packToolAlign(offset + file->blobSize, LVN_PACK_BLOB_ALIGNMENT);
+
+        uint32_t slot = (uint32_t) file->pathHash & (indexCapacity - 1);
+        while (pEntries[slot].pathHash)
+        {
+            if (pEntries[slot].pathHash == file->pathHash)
+            {
+                fprintf(stderr, "lvnpack: path hash collision on '%s', rename the file\n", file->path);
+                free(pEntries);
+                return false;
+            }
+            slot = (slot + 1) & (indexCapacity - 1);
+        }
+
+        LvnPackEntry* entry = &pEntries[slot];
+        entry->pathHash = file->pathHash;
+        entry->offset = file->offset;
+        entry->size = file->blobSize;
+        entry->uncompressedSize = file->uncompressedSize;
+        entry->flags = file->flags;
+    }
+    header.fileSize = list->count
+        ? list->pFiles[list->count - 1].offset + list->pFiles[list->count - 1].blobSize
+        : header.indexOffset + indexCapacity * sizeof(LvnPackEntry);
+
+    FILE* out = fopen(outpath, "wb");
+    if (!out)
+    {
+        fprintf(stderr, "lvnpack: failed to open '%s' for writing\n", outpath);
+        free(pEntries);
+        return false;
+    }
+
+    static const uint8_t padding[LVN_PACK_BLOB_ALIGNMENT] = {0};
+    uint64_t written = 0;
+
+    fwrite(&header, sizeof(LvnPackHeader), 1, out);
+    fwrite(pEntries, sizeof(LvnPackEntry), indexCapacity, out);
+    written = sizeof(LvnPackHeader) + indexCapacity * sizeof(LvnPackEntry);
+
+    for (uint32_t i = 0; i < list->count; i++)
+    {
+        const LvnPackToolFile* file = &list->pFiles[i];
+        fwrite(padding, 1, (size_t) (file->offset - written), out);
+        fwrite(file->blob, 1, file->blobSize, out);
+        written = file->offset + file->blobSize;
+    }
+
+    bool success = !ferror(out);
+    success = fclose(out) == 0 && success;
+    free(pEntries);
+
+    if (!success)
+        fprintf(stderr, "lvnpack: failed to write '%s'\n", outpath);
+
+    return success;
+}
+
+// reopen the pack through the runtime api and compare every entry against its source file
+static bool lvn_packToolVerify(const LvnPackToolFileList* list, const char* outpath)
+{
+    LvnContext* ctx;
+    LvnContextCreateInfo ctxCreateInfo = {0};
+    if (lvnCreateContext(&ctx, &ctxCreateInfo) != Lvn_Result_Success)
+        return false;
+
+    LvnPack* pack;
+    if (lvnCreatePack(ctx, &pack, outpath) != Lvn_Result_Success)
+    {
+        lvnDestroyContext(ctx);
+        return false;
+    }
+
+    bool success = lvnPackGetEntryCount(pack) == list->count;
+    for (uint32_t i = 0; i < list->count && success; i++)
+    {
+        const LvnPackToolFile* file = &list->pFiles[i];
+        LvnFile source = lvnLoadFileBin(file->fullpath);
+        LvnFile packed = lvnPackLoadFile(pack, file->pathHash);
+
+        success = lvnPackContains(pack, file->pathHash) &&
+            source.size == packed.size &&
+            (source.size == 0 || !memcmp(source.data, packed.data, source.size));
+
+        if (!success)
+            fprintf(stderr, "lvnpack: verification failed for '%s'\n", file->path);
+
+        lvnUnloadFile(&source);
+        lvnUnloadFile(&packed);
+    }
+
+    lvnDestroyPack(pack);
+    lvnDestroyContext(ctx);
+    return success;
+}
+
+int main(int argc, char** argv)
+{
+    bool compress = false;
+    const char* inputDir = NULL;
+    const char* outpath = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-z"))
+            compress = true;
+        else if (!inputDir)
+            inputDir = argv[i];
+        else if (!outpath)
+            outpath = argv[i];
+    }
+
+    if (!inputDir || !outpath)
+    {
+        fprintf(stderr, "usage: lvnpack [-z] <input directory> <output pack>\n");
+        return 1;
+    }
+
+    LvnPackToolFileList list = {0};
+    if (!lvn_packToolCollectFiles(&list, inputDir, ""))
+    {
+        fprintf(stderr, "lvnpack: failed to read directory '%s'\n", inputDir);
+        return 1;
+    }
+
+    // sorted order keeps the output deterministic and groups files of the same directory together
+    qsort(list.pFiles, list.count, sizeof(LvnPackToolFile), lvn_packToolCompareFiles);
+
+    bool success = true;
+    size_t totalSize = 0, storedSize = 0;
+    for (uint32_t i = 0; i < list.count && success; i++)
+    {
+        success = lvn_packToolLoadFile(&list.pFiles[i], compress);
+        if (!success)
+            fprintf(stderr, "lvnpack: failed to read '%s'\n", list.pFiles[i].fullpath);
+
+        totalSize += list.pFiles[i].uncompressedSize;
+        storedSize += list.pFiles[i].blobSize;
+    }
+
+    success = success && lvn_packToolWritePack(&list, outpath) && lvn_packToolVerify(&list, outpath);
+
+    if (success)
+        printf("lvnpack: wrote %u files to '%s' (%zu bytes, %zu bytes stored)\n", list.count, outpath, totalSize, storedSize);
+
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        free(list.pFiles[i].path);
+        free(list.pFiles[i].fullpath);
+        free(list.pFiles[i].compressed);
+        lvnUnloadFile(&list.pFiles[i].data);
+    }
+    free(list.pFiles);
+
+    return success ? 0 : 1;
+}